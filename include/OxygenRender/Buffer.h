@@ -13,7 +13,8 @@ namespace OxyRender
     enum class BufferType
     {
         Vertex, // 顶点缓冲
-        Index   // 索引缓冲
+        Index,  // 索引缓冲
+        Uniform // uniform 缓冲（std140 块）
     };
 
     enum class BufferUsage
@@ -83,6 +84,8 @@ namespace OxyRender
         void addAttribute(const std::string &name, int location, VertexAttribType type);
         const std::vector<VertexAttribute> &getAttributes() const noexcept { return attributes; }
         size_t getStride() const noexcept { return stride; }
+        // 由各属性的 location / 类型 / 偏移与步长计算，用于管线状态的哈希
+        uint64_t getHash() const noexcept;
 
     private:
         std::vector<VertexAttribute> attributes;
@@ -115,11 +118,32 @@ namespace OxyRender
         void unbind() const noexcept override;
         void setData(const void *data, size_t size, size_t offset = 0) override;
         inline uint32_t getCount() const noexcept override;
+        // 由 OpenGLVertexArray::setIndexBuffer 记录所属 VAO，setData 时绑定它而非当前 VAO
+        inline void setVertexArray(GLuint vao) noexcept { m_vertexArray = vao; }
 
     private:
         GLuint m_rendererID;
         GLenum m_usage;
         uint32_t m_count;
+        GLuint m_vertexArray = 0;
+    };
+
+    // OpenGL实现UniformBuffer
+    class OpenGLUniformBuffer : public IBuffer
+    {
+    public:
+        OpenGLUniformBuffer(BufferUsage usage);
+        ~OpenGLUniformBuffer();
+
+        void bind() const noexcept override;
+        void unbind() const noexcept override;
+        void setData(const void *data, size_t size, size_t offset = 0) override;
+        // 绑定到 uniform 块绑定点
+        void bindBase(uint32_t binding) const noexcept;
+
+    private:
+        GLuint m_rendererID;
+        GLenum m_usage;
     };
 
     // OpenGL实现VertexArray
@@ -160,6 +184,8 @@ namespace OxyRender
         void bind();
         void unbind();
         void setData(const void *data, size_t size, size_t offset = 0);
+        // 仅 Uniform 类型：绑定到 uniform 块绑定点
+        void bindBase(uint32_t binding);
 
         inline BufferType getType() const noexcept { return m_type; }
         inline IBuffer *asIBuffer() noexcept { return m_buffer.get(); }
@@ -0,0 +1,88 @@
+#pragma once
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "OxygenRender/Buffer.h"
+
+// 内置着色器共享的每帧 uniform 块（std140），与 FrameData 结构体逐字节对应。
+// 用法：R"(#version 330 core)" "\n" OXY_FRAME_UNIFORMS_GLSL R"(... 其余源码 ...)"
+#define OXY_FRAME_UNIFORMS_GLSL                 \
+    "struct FrameLight {\n"                     \
+    "    vec4 position;\n"                      \
+    "    vec4 ambient;\n"                       \
+    "    vec4 diffuse;\n"                       \
+    "    vec4 specular;\n"                      \
+    "};\n"                                      \
+    "layout(std140) uniform FrameData {\n"      \
+    "    mat4 uView;\n"                         \
+    "    mat4 uProjection;\n"                   \
+    "    mat4 uViewProjection;\n"               \
+    "    vec4 uCameraPos;\n"                    \
+    "    vec4 uTime;\n" /* x 总时间, y 帧间隔 */ \
+    "    ivec4 uLightCount;\n"                  \
+    "    FrameLight uLights[4];\n"              \
+    "};\n"
+
+namespace OxyRender
+{
+    class Camera;
+
+    // 与 GLSL FrameLight 对应，xyz 有效
+    struct FrameLight
+    {
+        glm::vec4 position{5.0f, 5.0f, 5.0f, 1.0f};
+        glm::vec4 ambient{0.2f, 0.2f, 0.2f, 0.0f};
+        glm::vec4 diffuse{1.0f, 1.0f, 1.0f, 0.0f};
+        glm::vec4 specular{1.0f, 1.0f, 1.0f, 0.0f};
+    };
+
+    // 与 GLSL FrameData 块的 std140 布局对应
+    struct FrameData
+    {
+        static constexpr int kMaxLights = 4;
+
+        glm::mat4 view{1.0f};
+        glm::mat4 projection{1.0f};
+        glm::mat4 viewProjection{1.0f};
+        glm::vec4 cameraPos{0.0f};
+        glm::vec4 time{0.0f};
+        glm::ivec4 lightCount{1, 0, 0, 0};
+        FrameLight lights[kMaxLights];
+    };
+    static_assert(sizeof(FrameData) == 3 * 64 + 3 * 16 + FrameData::kMaxLights * 64, "FrameData must match std140 layout");
+
+    // 每帧相机/光照 uniform 缓冲，由 Renderer 持有。
+    // 着色器链接时若声明了 FrameData 块，自动绑定到 kBindingPoint；
+    // 各 set 接口只修改 CPU 副本，bind() 在有改动时整块上传一次，之后所有程序共享，
+    // 不再逐程序设置 view / projection / viewPos / 光源。
+    class FrameUniforms
+    {
+    public:
+        static constexpr uint32_t kBindingPoint = 0;
+        static constexpr const char *kBlockName = "FrameData";
+
+        FrameUniforms();
+
+        // 相机位置由 view 的逆矩阵求得
+        void setCamera(const glm::mat4 &view, const glm::mat4 &projection);
+        void setCamera(const Camera &camera, int screenWidth, int screenHeight);
+        void setTime(float totalTime, float deltaTime);
+        void setLight(int index, const FrameLight &light);
+        void setLight(int index, const glm::vec3 &position, const glm::vec3 &ambient,
+                      const glm::vec3 &diffuse, const glm::vec3 &specular);
+        void setLightCount(int count);
+
+        // 有改动时上传并绑定到 kBindingPoint，绘制前调用
+        void bind();
+
+        inline const FrameData &getData() const noexcept { return m_data; }
+        // 累计上传次数
+        inline uint64_t getUploadCount() const noexcept { return m_uploads; }
+
+    private:
+        FrameData m_data;
+        Buffer m_buffer;
+        bool m_dirty = true;
+        uint64_t m_uploads = 0;
+    };
+}
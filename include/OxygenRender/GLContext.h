@@ -0,0 +1,68 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace OxyRender
+{
+    // 当前 GL 上下文的公共信息
+    // 窗口在 GLAD 初始化后调用 created() 登记上下文及其函数加载器（GLFW 为 glfwGetProcAddress，无头窗口为 eglGetProcAddress），
+    // GLAD 未生成的入口（程序二进制、glTexStorage2D 等）统一经由 getProcAddress 加载。
+    // 多个窗口各有独立（不共享对象）的上下文：窗口切换当前上下文时调用 madeCurrent()，
+    // 每次登记、切换或销毁上下文代数加一，按上下文缓存的能力检测比较 getGeneration() 决定是否重新检测；
+    // 持有 GL 对象的进程级缓存以 getCurrentId() 区分上下文。
+    // 窗口销毁上下文前调用 destroying()，各缓存经 addTeardownCallback 释放属于该上下文的 GL 对象，
+    // 避免它们在静态析构时（上下文已不存在）才调用 glDelete*，其他窗口的条目不受影响。只能在上下文线程使用。
+    class GLContext
+    {
+    public:
+        using ProcLoader = void *(*)(const char *name);
+
+        GLContext(const GLContext &) = delete;
+        GLContext &operator=(const GLContext &) = delete;
+        static GLContext &getInstance();
+
+        // 新上下文已为当前且 GLAD 已加载：登记句柄（GLFWwindow* / EGLContext）与加载器，代数加一，GL 状态缓存重置为未知
+        void created(const void *handle, ProcLoader loader);
+        // 窗口把自己的上下文设为当前；与上次不同时切换加载器，代数加一，GL 状态缓存重置为未知。
+        // nullptr（只是释放当前上下文，如移交渲染线程）不改变记录
+        void madeCurrent(const void *handle);
+        // 上下文即将销毁：设为当前后按登记的逆序执行销毁回调，再注销该上下文，之后没有当前上下文
+        void destroying(const void *handle);
+
+        // 登记上下文销毁回调（通常在单例构造时），参数为即将销毁的上下文 id，回调须释放属于它的全部 GL 对象
+        void addTeardownCallback(std::function<void(uint64_t context)> callback);
+
+        // 未登记上下文时返回 nullptr
+        void *getProcAddress(const char *name) const;
+        // 当前上下文是否支持扩展（逐个比较 glGetStringi(GL_EXTENSIONS, i)）
+        bool hasExtension(const char *name) const;
+        // 当前上下文的 GL 版本不低于 major.minor
+        bool hasVersion(int major, int minor) const;
+
+        inline uint64_t getGeneration() const noexcept { return m_generation; }
+        // 当前上下文的 id（从 1 开始，不复用），没有当前上下文时为 0；可在任意线程读取
+        inline uint64_t getCurrentId() const noexcept { return m_currentId.load(std::memory_order_acquire); }
+        inline size_t getContextCount() const noexcept { return m_contexts.size(); }
+
+    private:
+        GLContext() = default;
+
+        struct Record
+        {
+            const void *handle;
+            ProcLoader loader;
+            uint64_t id;
+        };
+        void switchTo(const Record *record);
+
+        std::vector<Record> m_contexts;
+        const void *m_current = nullptr;
+        std::atomic<uint64_t> m_currentId{0};
+        uint64_t m_nextId = 1;
+        ProcLoader m_loader = nullptr;
+        uint64_t m_generation = 0;
+        std::vector<std::function<void(uint64_t)>> m_teardown;
+    };
+}
@@ -0,0 +1,106 @@
+#pragma once
+#include <cstdint>
+#include <glad/glad.h>
+
+namespace OxyRender
+{
+    struct RenderStateStats
+    {
+        uint64_t issued = 0;  // 实际调用的 GL 状态函数
+        uint64_t skipped = 0; // 状态未变而省去的调用
+    };
+
+    // GL 状态缓存
+    // 记录当前上下文的程序、VAO、缓冲绑定、各纹理单元绑定、开关、混合函数、深度、模板、剔除面、线宽与多边形模式，
+    // 与目标状态相同时跳过调用。Buffer / Texture / Shader / OpenGLRenderer 的绑定都经由此处，
+    // 初始状态视为未知，第一次设置总会调用。
+    // 绕过它直接修改 GL 状态的代码（如第三方 UI 库）之后须调用 invalidate()。只能在上下文线程使用。
+    class GLStateCache
+    {
+    public:
+        static constexpr uint32_t kMaxTextureUnits = 32;
+        static constexpr uint32_t kMaxUniformBindings = 16;
+
+        GLStateCache(const GLStateCache &) = delete;
+        GLStateCache &operator=(const GLStateCache &) = delete;
+        static GLStateCache &getInstance();
+
+        void useProgram(GLuint program);
+        // 切换 VAO 后 GL_ELEMENT_ARRAY_BUFFER 随之改变（属于 VAO 状态）
+        void bindVertexArray(GLuint vao);
+        // 缓存 ARRAY / ELEMENT_ARRAY / UNIFORM / PIXEL_UNPACK，其余目标直接调用
+        void bindBuffer(GLenum target, GLuint buffer);
+        // 仅缓存 GL_UNIFORM_BUFFER 的前 kMaxUniformBindings 个绑定点
+        void bindBufferBase(GLenum target, GLuint index, GLuint buffer);
+        // 绑定到当前活动纹理单元
+        void bindTexture(GLenum target, GLuint texture);
+        // 切换到 unit 并绑定
+        void bindTexture(GLenum target, GLuint texture, uint32_t unit);
+
+        void setEnabled(GLenum cap, bool enable);
+        void blendFunc(GLenum sfactor, GLenum dfactor);
+        void depthFunc(GLenum func);
+        void depthMask(bool enable);
+        void stencilFunc(GLenum func, GLint ref, GLuint mask);
+        void stencilOp(GLenum sfail, GLenum dpfail, GLenum dppass);
+        void cullFace(GLenum mode);
+        void lineWidth(float width);
+        void polygonMode(GLenum mode);
+
+        // 删除对象并清除指向它的缓存绑定（GL 会把这些绑定重置为 0）
+        void deleteProgram(GLuint program);
+        void deleteVertexArray(GLuint vao);
+        void deleteBuffer(GLuint buffer);
+        void deleteTexture(GLuint texture);
+
+        // 全部状态重置为未知
+        void invalidate();
+        // invalidate() 的调用次数，用于判断在此之前记录的状态是否仍然有效
+        inline uint64_t getEpoch() const noexcept { return m_epoch; }
+
+        // 开始新的一帧（OpenGLRenderer::clear 调用）：当前帧计数转入上一帧
+        void beginFrame();
+        inline RenderStateStats getFrameStats() const noexcept { return m_frame; }
+        inline RenderStateStats getLastFrameStats() const noexcept { return m_lastFrame; }
+        inline RenderStateStats getTotalStats() const noexcept
+        {
+            return RenderStateStats{m_total.issued + m_frame.issued, m_total.skipped + m_frame.skipped};
+        }
+
+    private:
+        static constexpr GLuint kUnknown = 0xFFFFFFFFu;
+        static constexpr int kCapCount = 6;
+
+        GLStateCache();
+
+        // 状态相同时计为跳过并返回 false
+        bool change(bool differs);
+        int bufferSlot(GLenum target) const noexcept;
+        int textureTarget(GLenum target) const noexcept;
+        int capSlot(GLenum cap) const noexcept;
+        void activeTexture(uint32_t unit);
+
+        GLuint m_program;
+        GLuint m_vao;
+        GLuint m_buffers[4];
+        GLuint m_uniformBindings[kMaxUniformBindings];
+        uint32_t m_activeUnit;
+        GLuint m_textures[kMaxTextureUnits][2]; // [单元][2D / CUBE_MAP]
+        int8_t m_caps[kCapCount];               // -1 未知
+        GLenum m_blendSrc, m_blendDst;
+        GLenum m_depthFunc;
+        int8_t m_depthMask;
+        GLenum m_stencilFunc;
+        GLint m_stencilRef;
+        GLuint m_stencilMask;
+        GLenum m_stencilOps[3];
+        GLenum m_cullFace;
+        float m_lineWidth;
+        GLenum m_polygonMode;
+
+        RenderStateStats m_frame;
+        RenderStateStats m_lastFrame;
+        RenderStateStats m_total; // 不含当前帧
+        uint64_t m_epoch = 0;
+    };
+}
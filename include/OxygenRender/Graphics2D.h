@@ -2,6 +2,7 @@
 #include "OxygenRender/Window.h"
 #include "OxygenRender/Renderer.h"
 #include "OxygenRender/Shader.h"
+#include "OxygenRender/ShaderVariants.h"
 #include "OxygenRender/Buffer.h"
 #include "OxygenRender/Camera.h"
 #include "OxygenRender/Texture.h"
@@ -22,8 +23,8 @@ namespace OxyRender
         Camera &getCamera();
         void clear();
         void setClearColor(const OxyColor &color);
-        void setShader(Shader *shader) { m_customShader = shader; }
-        void setTextureShader(Shader *shader) { m_customTextureShader = shader; }
+        void setShader(Shader *shader);
+        void setTextureShader(Shader *shader);
         void begin();
 
         void drawRect(float x, float y, float width, float height, OxyColor color = {1.0f, 0.0f, 0.0f, 1.0f});
@@ -120,8 +121,9 @@ namespace OxyRender
         Window &m_window;
         Renderer &m_renderer;
         Camera m_camera;
-        Shader m_shader;
-        Shader m_textureShader;
+        ShaderVariants m_shaders; // 内置着色器的变体
+        Shader &m_shader;         // 纯色变体
+        Shader &m_textureShader;  // TEXTURED 变体
         Shader *m_customShader = nullptr;
         Shader *m_customTextureShader = nullptr;
 
@@ -129,6 +131,12 @@ namespace OxyRender
         Buffer m_vbo;
         Buffer m_ebo;
 
+        // 2D 固定功能状态（混合、无深度测试），着色器改变时另建管线
+        PipelineDesc m_pipelineDesc;
+        const PipelineState *m_pipeline = nullptr;
+        const PipelineState *m_texturePipeline = nullptr;
+        const PipelineState *createPipeline(Shader &shader);
+
         // 三角形批次
         std::vector<Vertex> m_triVertices;
         std::vector<unsigned int> m_triIndices;
@@ -146,10 +154,10 @@ namespace OxyRender
         // 辅助方法
         void addTextureVertex(float x, float y, float u, float v, OxyColor color);
         void flushTextureBatches();
+        // 设置相机矩阵（内置着色器只需合并后的 uViewProjection）
+        void setCameraUniforms(Shader &shader);
 
         static const char *m_vertexShaderSrc;
         static const char *m_fragmentShaderSrc;
-        static const char *m_textureVertexShaderSrc;
-        static const char *m_textureFragmentShaderSrc;
     };
 }
@@ -4,10 +4,14 @@
 #include "OxygenRender/Shader.h"
 #include "OxygenRender/Buffer.h"
 #include "OxygenRender/Camera.h"
+#include "OxygenRender/OcclusionCulling.h"
+#include "OxygenRender/RenderThread.h"
 #include "OxygenRender/OxygenMathLite.h"
 #include <vector>
 #include <cmath>
+#include <cstdint>
 #include <functional>
+#include <unordered_map>
 
 namespace OxyRender
 {
@@ -20,9 +24,21 @@ namespace OxyRender
         Camera &getCamera();
         void clear();
         void setClearColor(const OxyColor &color);
-        void setShader(Shader *shader) { m_customShader = shader; }
+        void setShader(Shader *shader);
         // 启用/禁用视锥体裁剪
         void setFrustumCullingEnabled(bool enabled) { m_frustumCullingEnabled = enabled; }
+        // 启用/禁用 CPU 遮挡剔除，遮挡体需在 begin() 之后、被遮挡物绘制之前添加
+        void setOcclusionCullingEnabled(bool enabled) { m_occlusionCullingEnabled = enabled; }
+        void addOccluder(const MathLite::Vec3 &center, const MathLite::Vec3 &size);
+        OcclusionCuller &getOcclusionCuller() { return m_occlusionCuller; }
+        // 球体/圆柱按屏幕投影尺寸自动选择细分级别（stacks/slices 作为最高级别）
+        void setAutoLodEnabled(bool enabled) { m_autoLodEnabled = enabled; }
+        // 全局 LOD 偏移（以级别为单位）：正值更粗糙，负值更精细
+        static void setLodBias(float bias) { s_lodBias = bias; }
+        static float getLodBias() { return s_lodBias; }
+        // 设置后 clear / setClearColor / begin / flush 中的 GL 工作经由渲染线程执行（其未启动时立即执行），
+        // 几何生成与裁剪仍在调用线程；nullptr 恢复直接调用
+        void setRenderThread(RenderThread *renderThread) { m_renderThread = renderThread; }
         void begin();
 
         void drawTriangle(const MathLite::Vec3 &p1,
@@ -50,13 +66,16 @@ namespace OxyRender
                         int stacks = 16,
                         int slices = 24,
                         const OxyColor &color = {0.2f, 0.6f, 0.9f, 1.0f});
+        // y = func(x, z) 的曲面；网格较大时在 ThreadPool 上并行细分。
+        // func 默认在调用线程上依次求值；parallel 为 true 时也并行求值，此时 func 须可并发调用
         void drawFunction(
             const MathLite::Vec2 &xValues,
             const MathLite::Vec2 &yValues,
             const std::function<float(float, float)> &func,
             const OxyColor &color = {0.2f, 0.6f, 0.9f, 1.0f},
             const float &dx = 0.1f,
-            const float &dy = 0.1f);
+            const float &dy = 0.1f,
+            bool parallel = false);
         void drawCylinder(const MathLite::Vec3 &center,
                           float radius,
                           float height,
@@ -94,16 +113,62 @@ namespace OxyRender
             std::vector<Vertex> vertices;
         };
 
+        // 缓存的单位图元网格（球半径为 1，圆柱半径、高度为 1）
+        struct PrimitiveMesh
+        {
+            std::vector<MathLite::Vec3> positions;
+            std::vector<MathLite::Vec3> normals;
+            std::vector<unsigned int> indices;
+        };
+
+        // flush 时从当前批次取出的一帧绘制数据，可移交渲染线程
+        struct FrameBatch
+        {
+            Shader *shader = nullptr;
+            const PipelineState *pipeline = nullptr;
+            const PipelineState *pointPipeline = nullptr;
+            std::vector<Vertex> triVertices;
+            std::vector<unsigned int> triIndices;
+            size_t triIndexCount = 0;
+            std::vector<LineBatch> lineBatches;
+            std::vector<PointBatch> pointBatches;
+        };
+
+        // 每个图元上一次选择的级别，用于滞后切换
+        struct LodState
+        {
+            int level = 0;
+            uint64_t frame = 0;
+        };
+
+        const PrimitiveMesh &getSphereMesh(int stacks, int slices);
+        const PrimitiveMesh &getCylinderMesh(int slices, bool capped);
+        int selectLod(uint64_t key, const MathLite::Vec3 &center, float radius);
+        void appendPrimitive(const PrimitiveMesh &mesh, const MathLite::Vec3 &center, const MathLite::Vec3 &scale, const OxyColor &color);
+        // 视锥裁剪并以面法线追加三个顶点，被裁剪时返回 false
+        bool appendTriangle(std::vector<Vertex> &out, const MathLite::Vec3 &p1, const MathLite::Vec3 &p2,
+                            const MathLite::Vec3 &p3, const OxyColor &color) const;
+        void drawBatch(const FrameBatch &batch);
+        template <typename F>
+        void submitGL(F &&func);
+
         Window &m_window;
         Renderer &m_renderer;
         Camera m_camera;
         Shader m_shader;
         Shader *m_customShader = nullptr;
+        RenderThread *m_renderThread = nullptr;
 
         VertexArray m_vao;
         Buffer m_vbo;
         Buffer m_ebo;
 
+        // 面/线与点（可编程点大小）两条管线，着色器改变时重建
+        PipelineDesc m_pipelineDesc;
+        const PipelineState *m_pipeline = nullptr;
+        const PipelineState *m_pointPipeline = nullptr;
+        void createPipelines(Shader &shader);
+
         // 三角形批次
         std::vector<Vertex> m_triVertices;
         std::vector<unsigned int> m_triIndices;
@@ -122,5 +187,19 @@ namespace OxyRender
         // 视锥体裁剪
         bool m_frustumCullingEnabled = true;
         Plane m_frustumPlanes[6]{}; // L, R, B, T, N, F
+
+        // 遮挡剔除
+        bool m_occlusionCullingEnabled = false;
+        OcclusionCuller m_occlusionCuller;
+
+        // 图元 LOD
+        static constexpr int LOD_LEVELS = 4;
+        static float s_lodBias;
+        bool m_autoLodEnabled = true;
+        uint64_t m_frameIndex = 0;
+        MathLite::Vec3 m_lodEye;
+        float m_lodProjScale = 1.0f; // 屏幕高度 / (2 * tan(fov / 2))
+        std::unordered_map<uint64_t, PrimitiveMesh> m_primitiveCache;
+        std::unordered_map<uint64_t, LodState> m_lodStates;
     };
 }
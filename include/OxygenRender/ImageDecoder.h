@@ -0,0 +1,82 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "OxygenRender/Texture.h"
+
+namespace OxyRender
+{
+    // 图像解码器接口：按文件头识别格式，输出自上而下的行（翻转由注册表统一处理）
+    class IImageDecoder
+    {
+    public:
+        virtual ~IImageDecoder() = default;
+        virtual const char *getName() const noexcept = 0;
+        virtual bool canDecode(const unsigned char *data, size_t size) const noexcept = 0;
+        // 失败时抛出异常
+        virtual ImageData decode(const unsigned char *data, size_t size) const = 0;
+    };
+
+    // stb_image 兜底解码器（PNG/JPG/BMP/TGA/PSD/GIF/HDR/PIC/PNM）
+    class StbImageDecoder : public IImageDecoder
+    {
+    public:
+        const char *getName() const noexcept override { return "stb_image"; }
+        bool canDecode(const unsigned char *data, size_t size) const noexcept override;
+        ImageData decode(const unsigned char *data, size_t size) const override;
+    };
+
+    // QOI（Quite OK Image）解码器，解码速度远快于 PNG
+    class QoiDecoder : public IImageDecoder
+    {
+    public:
+        const char *getName() const noexcept override { return "qoi"; }
+        bool canDecode(const unsigned char *data, size_t size) const noexcept override;
+        ImageData decode(const unsigned char *data, size_t size) const override;
+
+        // 编码 3/4 通道图像，供离线转换工具使用
+        static std::vector<unsigned char> encode(const ImageData &image);
+    };
+
+    // 图像解码器注册表
+    // 后注册的解码器优先匹配，stb_image 始终作为最后的兜底；内置 QOI。
+    // 大图的翻转与灰度扩展按行在 ThreadPool 上并行完成。默认把 1/2 通道图像扩展为 RGB/RGBA 以便直接上传，
+    // 离线工具（OxyTexConv、TextureBake）传 expandChannels = false 保留原通道数。
+    class ImageDecoderRegistry
+    {
+    public:
+        ImageDecoderRegistry(const ImageDecoderRegistry &) = delete;
+        ImageDecoderRegistry &operator=(const ImageDecoderRegistry &) = delete;
+        static ImageDecoderRegistry &getInstance();
+
+        void registerDecoder(std::shared_ptr<IImageDecoder> decoder);
+        // 未找到时返回 stb_image 兜底解码器
+        std::shared_ptr<IImageDecoder> findDecoder(const unsigned char *data, size_t size) const;
+
+        // 线程安全，失败时抛出异常
+        ImageData decode(const unsigned char *data, size_t size, bool flipVertically = true,
+                         bool expandChannels = true) const;
+        ImageData decodeFile(const std::string &path, bool flipVertically = true, bool expandChannels = true) const;
+
+        // 在线程池上并行解码多个文件，结果顺序与输入一致；失败的文件输出错误并返回无效图像
+        std::vector<ImageData> decodeFiles(const std::vector<std::string> &paths, bool flipVertically = true) const;
+
+        // 像素数不小于该值时行处理并行执行（默认 512x512）
+        inline void setParallelRowThreshold(size_t pixels) noexcept { m_parallelRowThreshold = pixels; }
+        inline size_t getParallelRowThreshold() const noexcept { return m_parallelRowThreshold; }
+
+    private:
+        ImageDecoderRegistry();
+        ~ImageDecoderRegistry() = default;
+
+        ImageData finalize(ImageData image, bool flipVertically, bool expandChannels) const;
+
+        mutable std::mutex m_mutex;
+        std::vector<std::shared_ptr<IImageDecoder>> m_decoders; // 优先级从高到低
+        std::shared_ptr<IImageDecoder> m_fallback;
+        size_t m_parallelRowThreshold = 512 * 512;
+    };
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+namespace OxyRender
+{
+    // 只读内存映射文件，析构时自动解除映射
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        explicit MappedFile(const std::string &path) { open(path); }
+        ~MappedFile();
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+        MappedFile(MappedFile &&other) noexcept;
+        MappedFile &operator=(MappedFile &&other) noexcept;
+
+        // 映射失败（文件不存在、为空等）返回 false
+        bool open(const std::string &path);
+        void close();
+
+        inline bool isOpen() const noexcept { return m_data != nullptr; }
+        inline const unsigned char *data() const noexcept { return m_data; }
+        inline size_t size() const noexcept { return m_size; }
+
+    private:
+        const unsigned char *m_data = nullptr;
+        size_t m_size = 0;
+#ifdef _WIN32
+        void *m_file = nullptr;
+        void *m_mapping = nullptr;
+#endif
+    };
+}
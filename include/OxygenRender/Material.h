@@ -0,0 +1,51 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "OxygenRender/Shader.h"
+#include "OxygenRender/ShaderVariants.h"
+#include "OxygenRender/Texture.h"
+
+namespace OxyRender
+{
+    struct Texture;
+
+    // 网格材质：加载时按纹理类型生成采样器名（texture_diffuse1、texture_normal1 ...）并分配纹理单元，
+    // 采样器名预先哈希为 UniformID，bind 只做纹理绑定和按 ID 设置采样器（值未变时不调用 GL），
+    // 不拼接字符串、不分配内存。
+    class Material
+    {
+    public:
+        Material();
+        explicit Material(const std::vector<Texture> &textures);
+
+        // 绑定全部纹理并设置采样器 uniform，着色器中不存在的采样器被跳过
+        void bind(Shader &shader);
+
+        // 替换某个槽位的纹理（如异步加载完成后替换占位纹理），不影响已解析的位置
+        void setTexture(size_t slot, std::shared_ptr<Texture2D> texture);
+
+        // 按纹理类型得出的着色器特性（ShaderFeature 位），用于选择最小变体
+        inline uint32_t getFeatures() const noexcept { return m_features; }
+
+        // 创建时分配的编号（拷贝共享同一编号），用于渲染队列排序
+        inline uint32_t getId() const noexcept { return m_id; }
+
+        inline size_t getTextureCount() const noexcept { return m_slots.size(); }
+        inline const std::string &getSamplerName(size_t slot) const { return m_slots[slot].sampler; }
+
+    private:
+        struct Slot
+        {
+            std::string sampler; // 采样器 uniform 名
+            UniformID samplerID;
+            std::shared_ptr<Texture2D> texture;
+        };
+
+        std::vector<Slot> m_slots;
+        uint32_t m_features = 0;
+        uint32_t m_id;
+    };
+}
@@ -3,10 +3,13 @@
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "OxygenRender/Buffer.h"
+#include "OxygenRender/Material.h"
 #include "OxygenRender/Shader.h"
 #include "OxygenRender/Renderer.h"
 #include "OxygenRender/Texture.h"
@@ -41,19 +44,58 @@ namespace OxyRender
         std::string path;
     };
 
+    // 一级 LOD 在共享索引缓冲中的区间
+    struct MeshLod
+    {
+        uint32_t indexOffset = 0; // 起始索引
+        uint32_t indexCount = 0;  // 索引数量
+        float error = 0.0f;       // 相对原网格的几何误差（模型空间）
+    };
+
     class Mesh
     {
     public:
         // mesh Data
         std::vector<Vertex> vertices;
         std::vector<unsigned int> indices;
-        std::vector<Texture> textures;
+        std::vector<Texture> textures; // 替换纹理请用 setTexture，以同步到材质
 
         // constructor
         Mesh(Renderer& renderer,std::vector<Vertex> vertices, std::vector<unsigned int> indices, std::vector<Texture> textures);
 
-        // render the mesh
-        void Draw(Shader &shader);
+        // 从外部内存（如映射的 .oxmesh 缓存）构建：直接由外部内存上传 VBO/IBO，不复制到 vertices/indices（二者为空），
+        // source 保持外部内存存活，供 LOD 生成等 CPU 端处理经 getVertexData/getIndexData 读取。
+        // 包围盒使用给定值而不重新计算
+        Mesh(Renderer &renderer, std::shared_ptr<const void> source, const Vertex *vertexData, size_t vertexCount,
+             const unsigned int *indexData, size_t indexCount, std::vector<Texture> textures,
+             const glm::vec3 &boundsMin, const glm::vec3 &boundsMax);
+
+        // render the mesh, lod 超出范围时取最粗一级
+        void Draw(Shader &shader, int lod = 0);
+
+        // 替换纹理并同步到材质
+        void setTexture(size_t index, std::shared_ptr<Texture2D> texture);
+        inline Material &getMaterial() noexcept { return m_Material; }
+        inline const Material &getMaterial() const noexcept { return m_Material; }
+
+        // 按三角形比例（如 0.5/0.25/0.1）生成简化级别，所有级别共享顶点缓冲，
+        // 索引依次拼接到同一个索引缓冲中。重复调用会重建。
+        void buildLods(const std::vector<float> &ratios);
+
+        inline const std::vector<MeshLod> &getLods() const noexcept { return m_Lods; }
+        // lod 超出范围时取最粗一级；没有 LOD 时返回 nullptr
+        const MeshLod *getLod(int lod) const noexcept;
+        inline const VertexArray &getVertexArray() const noexcept { return m_VAO; }
+
+        // 顶点/索引数据（vertices / indices 的内容，或外部内存）
+        inline const Vertex *getVertexData() const noexcept { return m_VertexData; }
+        inline size_t getVertexCount() const noexcept { return m_VertexCount; }
+        inline const unsigned int *getIndexData() const noexcept { return m_IndexData; }
+        inline size_t getIndexCount() const noexcept { return m_IndexCount; }
+        inline const glm::vec3 &getBoundsCenter() const noexcept { return m_BoundsCenter; }
+        inline float getBoundsRadius() const noexcept { return m_BoundsRadius; }
+        // 单位模型空间长度对应的 UV 跨度（按面积加权），纹理流送据此估算所需的 mip 级别
+        inline float getUvDensity() const noexcept { return m_UvDensity; }
 
     private:
         VertexArray m_VAO;
@@ -61,7 +103,20 @@ namespace OxyRender
         Buffer m_EBO;
 
         Renderer& m_Renderer; 
+        Material m_Material; // 由 textures 构建
+        std::shared_ptr<const void> m_Source; // 外部顶点/索引内存的所有者
+        const Vertex *m_VertexData = nullptr;
+        size_t m_VertexCount = 0;
+        const unsigned int *m_IndexData = nullptr;
+        size_t m_IndexCount = 0;
+        std::vector<MeshLod> m_Lods; // [0] 为原始网格
+        glm::vec3 m_BoundsCenter{0.0f};
+        float m_BoundsRadius = 0.0f;
+        float m_UvDensity = 0.0f;
+
         void setupMesh();
+        void computeBounds();
+        void computeUvDensity();
     };
 
 } // namespace OxyRender
\ No newline at end of file
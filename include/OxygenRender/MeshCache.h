@@ -0,0 +1,103 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "OxygenRender/MappedFile.h"
+#include "OxygenRender/Mesh.h"
+
+namespace OxyRender
+{
+    // .oxmesh 二进制网格缓存
+    // 布局：文件头 | 网格表 | 纹理引用表 | 依赖表 | 字符串区 | 各网格顶点/索引数据（16 字节对齐）
+    // 顶点数据与 Vertex 内存布局一致，可直接从映射内存上传到 GPU。
+    // 按小端序存储，源文件及各依赖文件的大小 + 修改时间或内容哈希一致才视为有效；
+    // 仅修改时间变化（重新检出等）时把新的修改时间写回文件，之后不再重复计算哈希。
+    namespace MeshCacheFormat
+    {
+        constexpr uint32_t MAGIC = 0x48534D4F; // "OMSH"
+        constexpr uint32_t VERSION = 2;
+
+        struct Header
+        {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t vertexStride; // sizeof(Vertex)，顶点结构变化时缓存失效
+            uint32_t meshCount;
+            uint64_t sourceSize;
+            int64_t sourceMtime;
+            uint64_t sourceHash; // 源文件内容 FNV-1a 哈希
+            uint32_t textureCount;
+            uint32_t stringBytes;
+            uint32_t dependencyCount;
+            uint32_t reserved;
+        };
+
+        struct MeshEntry
+        {
+            uint64_t vertexOffset;
+            uint64_t indexOffset;
+            uint32_t vertexCount;
+            uint32_t indexCount;
+            float boundsMin[3];
+            float boundsMax[3];
+            uint32_t firstTexture;
+            uint32_t textureCount;
+        };
+
+        struct TextureRef
+        {
+            uint32_t typeOffset, typeLength; // 相对字符串区
+            uint32_t pathOffset, pathLength;
+        };
+
+        // 源文件之外影响导入结果的文件（如 .obj 的 .mtl），记录时不存在则大小与时间为 0。
+        // 纹理不在其中：修改纹理不需要重新导入网格
+        struct Dependency
+        {
+            uint32_t pathOffset, pathLength; // 相对字符串区
+            uint64_t size;
+            int64_t mtime;
+            uint64_t hash;
+        };
+    }
+
+    // 缓存中的一个网格，指针指向映射内存
+    struct CachedMesh
+    {
+        const Vertex *vertices = nullptr;
+        size_t vertexCount = 0;
+        const unsigned int *indices = nullptr;
+        size_t indexCount = 0;
+        glm::vec3 boundsMin{0.0f};
+        glm::vec3 boundsMax{0.0f};
+        std::vector<std::pair<std::string, std::string>> textures; // (type, path)
+    };
+
+    class MeshCache
+    {
+    public:
+        static std::string cachePathFor(const std::string &sourcePath) { return sourcePath + ".oxmesh"; }
+
+        // 将导入后的网格写入缓存，失败只打印警告。
+        // dependencies 为导入时读取的其他文件（如 .mtl）
+        static bool write(const std::string &cachePath, const std::string &sourcePath, const std::vector<Mesh> &meshes,
+                          const std::vector<std::string> &dependencies = {});
+        // 同上，数据来自 CPU 端网格（不需要上下文，可在工作线程调用），包围盒由顶点重新计算
+        static bool write(const std::string &cachePath, const std::string &sourcePath, const std::vector<CachedMesh> &meshes,
+                          const std::vector<std::string> &dependencies = {});
+
+        // 映射并校验缓存（源文件与依赖、偏移范围与对齐、索引范围）；失败返回 false，调用方应重新导入。
+        // 成功后 getMeshes() 中的指针在本对象存活期间有效
+        bool open(const std::string &cachePath, const std::string &sourcePath);
+        void close();
+
+        inline bool isOpen() const noexcept { return m_file.isOpen(); }
+        inline const std::vector<CachedMesh> &getMeshes() const noexcept { return m_meshes; }
+
+    private:
+        MappedFile m_file;
+        std::vector<CachedMesh> m_meshes;
+    };
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+namespace OxyRender
+{
+    // 网格离线/加载期处理工具（与渲染后端无关，只操作 CPU 端数据）
+    namespace MeshOptimizer
+    {
+        // 二次误差度量（QEM）网格简化
+        // 只折叠边到已有顶点，结果索引复用原顶点缓冲；
+        // UV 接缝与开放边界只允许沿自身方向折叠，接缝两侧的顶点按 UV 就近选择。
+        // positions/texcoords 为带步长（字节）的 float 数组，texcoords 可为 nullptr。
+        // 返回简化后的三角形索引，outError 输出最大几何误差（与位置同单位）。
+        std::vector<unsigned int> simplify(const unsigned int *indices, size_t indexCount,
+                                           const float *positions, size_t vertexCount, size_t positionStride,
+                                           const float *texcoords, size_t texcoordStride,
+                                           size_t targetIndexCount, float *outError = nullptr);
+
+        // 顶点后变换缓存统计（FIFO 缓存模拟）
+        struct VertexCacheStats
+        {
+            size_t transformed = 0; // 缓存未命中次数，即顶点着色器执行次数
+            float acmr = 0.0f;      // 每三角形平均未命中数，理想值约 0.5
+            float atvr = 0.0f;      // 未命中数 / 被引用顶点数，理想值 1.0
+        };
+
+        VertexCacheStats analyzeVertexCache(const unsigned int *indices, size_t indexCount, size_t vertexCount,
+                                            unsigned int cacheSize = 16);
+
+        // Tipsify 顶点缓存重排（Sander 等, 2007），dst 可与 indices 相同
+        void optimizeVertexCache(unsigned int *dst, const unsigned int *indices, size_t indexCount, size_t vertexCount,
+                                 unsigned int cacheSize = 16);
+
+        // 过度绘制优化：在缓存重排结果上按缓存断点切分簇，簇按朝外程度排序（外侧先画），
+        // threshold 为允许的 ACMR 放大倍数。应在 optimizeVertexCache 之后调用。
+        void optimizeOverdraw(unsigned int *dst, const unsigned int *indices, size_t indexCount,
+                              const float *positions, size_t vertexCount, size_t positionStride,
+                              float threshold = 1.05f, unsigned int cacheSize = 16);
+
+        // 顶点拉取优化：按首次使用顺序生成重映射表（未引用顶点映射为 ~0u），返回保留的顶点数
+        size_t optimizeVertexFetchRemap(unsigned int *remap, const unsigned int *indices, size_t indexCount,
+                                        size_t vertexCount);
+
+        // 按重映射表改写索引 / 顶点
+        void remapIndexBuffer(unsigned int *dst, const unsigned int *indices, size_t indexCount, const unsigned int *remap);
+
+        template <typename T>
+        std::vector<T> remapVertexBuffer(const std::vector<T> &vertices, const unsigned int *remap, size_t uniqueCount)
+        {
+            std::vector<T> result(uniqueCount);
+            for (size_t i = 0; i < vertices.size(); ++i)
+                if (remap[i] != ~0u)
+                    result[remap[i]] = vertices[i];
+            return result;
+        }
+    }
+}
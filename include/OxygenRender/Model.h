@@ -8,6 +8,7 @@
 
 #include "OxygenRender/Mesh.h"
 #include "OxygenRender/Shader.h"
+#include "OxygenRender/ShaderVariants.h"
 #include "OxygenRender/Texture.h"
 struct aiNode;
 struct aiScene;
@@ -16,6 +17,36 @@ struct aiMaterial;
 namespace OxyRender
 {
     class Renderer;
+    class Camera;
+    class MeshCache;
+    class AsyncModelLoader;
+    class RenderQueue;
+
+    // 模型处理统计，由对应步骤填写
+    struct ModelStats
+    {
+        // 加载：是否来自 .oxmesh 缓存，总耗时与其中 Assimp 解析的耗时（毫秒），使用的线程数（含调用线程）
+        bool fromMeshCache = false;
+        double loadMs = 0.0;
+        double parseMs = 0.0;
+        size_t loadThreads = 0;
+
+        // generateLods：全部网格在原始级别与最粗级别的三角形数
+        size_t lodTrianglesFull = 0;
+        size_t lodTrianglesCoarsest = 0;
+
+        // 导入时的顶点缓存优化（FIFO 缓存模拟的顶点变换次数），从网格缓存加载时为 0
+        size_t triangles = 0;
+        size_t vertices = 0;
+        size_t transformedBefore = 0;
+        size_t transformedAfter = 0;
+
+        // 每三角形（ACMR）与每顶点（ATVR）的平均变换次数
+        float acmrBefore() const { return triangles ? float(transformedBefore) / triangles : 0.0f; }
+        float acmrAfter() const { return triangles ? float(transformedAfter) / triangles : 0.0f; }
+        float atvrBefore() const { return vertices ? float(transformedBefore) / vertices : 0.0f; }
+        float atvrAfter() const { return vertices ? float(transformedAfter) / vertices : 0.0f; }
+    };
 
     class Model
     {
@@ -29,10 +60,65 @@ namespace OxyRender
         ~Model();
         void Draw(Shader &shader);
 
+        // 按投影误差选择 LOD：取屏幕误差不超过阈值的最粗级别；
+        // 使用流式纹理时同时按 UV 密度与屏幕尺寸向 TextureStreamer 上报所需的 mip 级别。
+        // 会设置 model 与法线矩阵；view / projection / 光源来自 Renderer 的 FrameUniforms
+        void Draw(Shader &shader, const glm::mat4 &modelMatrix, const Camera &camera, int screenHeight);
+
+        // 按网格材质选择最小的着色器变体（见 CreateDefaultShaderVariants），变体切换时设置 model 与法线矩阵
+        void Draw(ShaderVariants &variants, const glm::mat4 &modelMatrix);
+        void Draw(ShaderVariants &variants, const glm::mat4 &modelMatrix, const Camera &camera, int screenHeight);
+
+        // 与带相机的 Draw 相同地选择 LOD 与变体，但只把网格作为绘制包提交到队列，由 RenderQueue::flush 排序执行。
+        // pipeline 为固定功能状态（其 shader 字段被忽略），blend 为真时按半透明提交
+        void Submit(RenderQueue &queue, ShaderVariants &variants, const glm::mat4 &modelMatrix, const Camera &camera,
+                    int screenHeight, const PipelineDesc &pipeline = PipelineDesc(), uint8_t layer = 0);
+
+        // 为所有网格生成简化级别（三角形比例），之后可用带相机的 Draw 自动选择
+        void generateLods(const std::vector<float> &ratios = {0.5f, 0.25f, 0.1f});
+
+        // LOD 允许的屏幕误差（像素）
+        inline void setLodErrorThreshold(float pixels) { m_lodErrorThreshold = pixels; }
+        inline float getLodErrorThreshold() const { return m_lodErrorThreshold; }
+
+        inline const ModelStats &getStats() const noexcept { return m_stats; }
+
+        // 启用全部纹理特性的默认着色器
         static Shader CreateDefaultShader();
+        // 默认着色器的变体集合，缺少的贴图在编译期去掉对应采样（无漫反射贴图时使用 uBaseColor）
+        static ShaderVariants CreateDefaultShaderVariants();
+        // 设置 model 及 CPU 计算的法线矩阵 normalMatrix（配合不带 modelMatrix 的 Draw 使用）
+        static void setModelMatrix(Shader &shader, const glm::mat4 &modelMatrix);
+
+        // 是否使用 .oxmesh 网格缓存（默认开启，缓存文件写在源文件旁）
+        static void setMeshCacheEnabled(bool enabled) { s_meshCacheEnabled = enabled; }
+        static bool isMeshCacheEnabled() { return s_meshCacheEnabled; }
+
+        // 是否以流式纹理加载（默认关闭）。开启后纹理先只驻留粗糙级别，
+        // 需每帧调用 TextureStreamer::update() 并使用带相机的 Draw 才会调入细节
+        static void setTextureStreamingEnabled(bool enabled) { s_textureStreaming = enabled; }
+        static bool isTextureStreamingEnabled() { return s_textureStreaming; }
+
+        // 导入线程数（含调用线程），0 表示使用全局线程池
+        static void setImportThreadCount(size_t threads) { s_importThreadCount = threads; }
+        static size_t getImportThreadCount() { return s_importThreadCount; }
 
     private:
+        friend class AsyncModelLoader;
+
+        // 空模型，由异步加载器逐步填充网格
+        explicit Model(Renderer &renderer);
+
+        // 为每个网格选择 LOD 并上报纹理流送需求，visit(mesh, level, distance)
+        template <typename Visit>
+        void forEachLod(const glm::mat4 &modelMatrix, const Camera &camera, int screenHeight, Visit &&visit);
+
         Renderer &m_Renderer;
+        float m_lodErrorThreshold = 1.0f;
+        ModelStats m_stats;
+        static bool s_meshCacheEnabled;
+        static bool s_textureStreaming;
+        static size_t s_importThreadCount;
         static const char *s_vertexShaderSrc;
         static const char *s_fragmentShaderSrc;
         struct Impl;
@@ -0,0 +1,106 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "OxygenRender/Model.h"
+
+namespace OxyRender
+{
+    class Renderer;
+    struct ModelLoadShared;
+
+    enum class ModelLoadState
+    {
+        Loading,
+        Ready,
+        Failed
+    };
+
+    // 异步加载句柄：模型立即可绘制，网格在上传后逐个出现，纹理在解码前使用占位纹理
+    class ModelLoadHandle
+    {
+    public:
+        inline ModelLoadState getState() const noexcept { return m_state; }
+        inline bool isReady() const noexcept { return m_state == ModelLoadState::Ready; }
+        inline bool isFailed() const noexcept { return m_state == ModelLoadState::Failed; }
+        inline const std::string &getPath() const noexcept { return m_path; }
+        inline const std::string &getError() const noexcept { return m_error; }
+
+        // 已上传的网格与纹理占总数的比例，场景解析完成前为 0
+        float getProgress() const;
+
+        inline Model &getModel() noexcept { return *m_model; }
+
+        // 回调都在 AsyncModelLoader::update() 中（上下文线程）触发
+        inline void setProgressCallback(std::function<void(float)> callback) { m_onProgress = std::move(callback); }
+        inline void setCompleteCallback(std::function<void(ModelLoadHandle &)> callback) { m_onComplete = std::move(callback); }
+
+    private:
+        friend class AsyncModelLoader;
+        explicit ModelLoadHandle(const std::string &path);
+
+        std::string m_path;
+        std::unique_ptr<Model> m_model;
+        std::shared_ptr<ModelLoadShared> m_shared; // 与工作线程共享的状态
+        uint64_t m_context = 0;                    // 发起加载时的 GLContext id，上传只在该上下文中进行
+
+        ModelLoadState m_state = ModelLoadState::Loading;
+        std::string m_error;
+        size_t m_uploadedMeshes = 0;
+        size_t m_uploadedTextures = 0;
+        std::unordered_map<std::string, std::shared_ptr<Texture2D>> m_placeholders; // 按纹理类型
+        std::chrono::steady_clock::time_point m_start;
+
+        std::function<void(float)> m_onProgress;
+        std::function<void(ModelLoadHandle &)> m_onComplete;
+    };
+
+    // 异步模型加载器
+    // 解析、网格转换与纹理解码在线程池中进行，GPU 上传在每帧的 update() 中按预算完成。
+    class AsyncModelLoader
+    {
+    public:
+        AsyncModelLoader(const AsyncModelLoader &) = delete;
+        AsyncModelLoader &operator=(const AsyncModelLoader &) = delete;
+        static AsyncModelLoader &getInstance();
+
+        // 立即返回句柄（需在上下文线程调用）
+        std::shared_ptr<ModelLoadHandle> load(Renderer &renderer, const std::string &path);
+
+        // 每帧上传预算，0 表示不限制；每帧至少上传一项以保证进度
+        void setUploadBudget(size_t bytesPerFrame, double millisecondsPerFrame);
+        inline size_t getUploadBudgetBytes() const noexcept { return m_budgetBytes; }
+        inline double getUploadBudgetMilliseconds() const noexcept { return m_budgetMs; }
+
+        // 每帧在上下文线程调用一次（多窗口时各窗口的上下文为当前时分别调用）
+        void update();
+
+        inline size_t getActiveCount() const noexcept { return m_active.size(); }
+
+    private:
+        AsyncModelLoader();
+        ~AsyncModelLoader() = default;
+
+        // 上下文销毁时放弃在其中发起的未完成加载，释放它们已上传的网格与占位纹理
+        void releaseContext(uint64_t context);
+
+        // 返回 true 表示该句柄已结束（完成或失败）
+        bool process(const std::shared_ptr<ModelLoadHandle> &handle);
+        bool withinBudget() const;
+        std::shared_ptr<Texture2D> placeholderFor(ModelLoadHandle &handle, const std::string &type);
+
+        std::vector<std::shared_ptr<ModelLoadHandle>> m_active;
+        size_t m_budgetBytes = 8 * 1024 * 1024;
+        double m_budgetMs = 4.0;
+
+        // 当前帧的上传统计
+        std::chrono::steady_clock::time_point m_frameStart;
+        size_t m_frameBytes = 0;
+        size_t m_frameItems = 0;
+    };
+}
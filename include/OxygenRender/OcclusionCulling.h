@@ -0,0 +1,75 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace OxyRender
+{
+    // 遮挡剔除统计（每帧 beginFrame 时清零）
+    struct OcclusionStats
+    {
+        uint32_t occluderTriangles = 0; // 光栅化的遮挡体三角形数
+        uint32_t tested = 0;            // 被测试的包围盒数（含屏幕外）
+        uint32_t offscreen = 0;         // 完全在屏幕外的包围盒数，不计入 culled
+        uint32_t culled = 0;            // 在屏幕内但被遮挡的包围盒数
+
+        // 屏幕内包围盒中被遮挡的比例
+        float culledFraction() const
+        {
+            const uint32_t onscreen = tested - offscreen;
+            return onscreen ? float(culled) / float(onscreen) : 0.0f;
+        }
+    };
+
+    // CPU 软件遮挡剔除
+    // 遮挡体三角形被光栅化到低分辨率深度缓冲（存储 1/w，越大越近），
+    // 每 8x8 像素块维护最远深度组成分层深度（Hi-Z），包围盒先按块再按像素测试。
+    // 不依赖 OpenGL 上下文，可在无窗口环境下运行。
+    class OcclusionCuller
+    {
+    public:
+        static constexpr int TILE_SIZE = 8; // 块大小，同时是 AVX2 一次处理的像素数
+
+        OcclusionCuller(int width = 256, int height = 128);
+
+        // 设置深度缓冲分辨率（向上取整到 TILE_SIZE 的倍数）
+        void resize(int width, int height);
+        inline int getWidth() const noexcept { return m_width; }
+        inline int getHeight() const noexcept { return m_height; }
+
+        // 清空深度缓冲并设置本帧的 VP 矩阵
+        void beginFrame(const glm::mat4 &viewProjection);
+
+        // 添加世界空间中的遮挡体
+        void addOccluderTriangles(const glm::vec3 *vertices, const uint32_t *indices, size_t triangleCount);
+        void addOccluderBox(const glm::vec3 &center, const glm::vec3 &halfExtents);
+
+        // 可见性测试，返回 false 表示被完全遮挡
+        bool isAABBVisible(const glm::vec3 &center, const glm::vec3 &halfExtents);
+        bool isSphereVisible(const glm::vec3 &center, float radius);
+
+        inline const OcclusionStats &getStats() const noexcept { return m_stats; }
+        inline const std::vector<float> &getDepthBuffer() const noexcept { return m_depth; }
+
+        // 当前 CPU 是否使用 AVX2 光栅化路径
+        static bool hasAVX2();
+
+    private:
+        void rasterizeTriangle(const glm::vec4 &c0, const glm::vec4 &c1, const glm::vec4 &c2);
+        void updateHiZ();
+
+        int m_width = 0;
+        int m_height = 0;
+        int m_tilesX = 0;
+        int m_tilesY = 0;
+
+        glm::mat4 m_viewProjection{1.0f};
+        std::vector<float> m_depth;   // 每像素 1/w，0 表示无穷远
+        std::vector<float> m_tileMin; // 每块最小 1/w（即最远深度）
+        bool m_hizDirty = false;
+        bool m_useAVX2 = false;
+
+        OcclusionStats m_stats;
+    };
+}
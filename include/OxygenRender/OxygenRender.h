@@ -3,12 +3,22 @@
 #include "./Graphics2D.h"
 #include "./Graphics3D.h"
 #include "./Window.h"
+#include "./GLContext.h"
 #include "./Renderer.h"
+#include "./RenderQueue.h"
+#include "./RenderThread.h"
+#include "./FrameUniforms.h"
 #include "./Shader.h"
+#include "./ProgramCache.h"
+#include "./ShaderVariants.h"
 #include "./Buffer.h"
 #include "./Camera.h"
 #include "./Texture.h"
+#include "./PngEncoder.h"
+#include "./Material.h"
 #include "./Model.h"
+#include "./ModelLoader.h"
+#include "./TextureStreamer.h"
 #include "./EventSystem.h"
 #include "./ResourcesManager.h"
 #include "./Timer.h"
@@ -0,0 +1,25 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "OxygenRender/Texture.h"
+
+namespace OxyRender
+{
+    // PNG 编码器，不依赖 zlib
+    // 每行在 None / Sub / Up 滤波中取绝对值和最小者，deflate 用固定 Huffman 表与单槽哈希的贪心 LZ77，
+    // 以编码速度优先（批量导出），对图表等大面积纯色图像压缩率仍然很高。线程安全。
+    class PngEncoder
+    {
+    public:
+        // 8 位 1~4 通道（灰度 / 灰度+Alpha / RGB / RGBA）；
+        // flipVertically 为 true 时按自下而上的行序读取（glReadPixels 的结果）
+        static std::vector<unsigned char> encode(const unsigned char *pixels, uint32_t width, uint32_t height,
+                                                 uint32_t channels, bool flipVertically = false);
+        static std::vector<unsigned char> encode(const ImageData &image, bool flipVertically = false);
+
+        // 失败时抛出异常
+        static void write(const std::string &path, const ImageData &image, bool flipVertically = false);
+    };
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "OxygenRender/Shader.h"
+
+namespace OxyRender
+{
+    struct ProgramCacheStats
+    {
+        size_t shared = 0;       // 进程内复用已链接的程序
+        size_t diskHits = 0;     // 由磁盘二进制直接恢复
+        size_t diskRejected = 0; // 二进制被驱动拒绝（驱动更新等），已回退编译
+        size_t compiled = 0;     // 从源码编译链接
+        size_t stored = 0;       // 写入磁盘的二进制
+    };
+
+    // GL 程序缓存
+    // 进程内：同一上下文中顶点/片元源码完全相同的 Shader 共享同一个已链接程序（及其 uniform 表）。
+    // 磁盘：以源码 + GL_VENDOR/GL_RENDERER/GL_VERSION 的 64 位 FNV-1a 哈希为键，
+    // 通过 glGetProgramBinary / glProgramBinary（GL 4.1 或 ARB_get_program_binary）保存与恢复，
+    // 二进制被拒绝时删除缓存文件并回退到编译。驱动不支持或未设置目录时只做进程内共享。
+    // 可选异步编译，见 setAsyncCompilation。所有接口都须在上下文线程调用。
+    class ProgramCache
+    {
+    public:
+        ProgramCache(const ProgramCache &) = delete;
+        ProgramCache &operator=(const ProgramCache &) = delete;
+        static ProgramCache &getInstance();
+
+        // 获取已链接的程序；编译或链接失败时抛出异常
+        std::shared_ptr<OpenGLProgram> acquire(const std::string &name, const std::string &vertexSource,
+                                               const std::string &fragmentSource);
+
+        // 二进制缓存目录（不存在时自动创建）；默认为空即不使用磁盘缓存，由应用指定可写的位置后开启
+        inline void setDirectory(const std::string &directory) { m_directory = directory; }
+        inline const std::string &getDirectory() const noexcept { return m_directory; }
+
+        // 当前上下文是否支持程序二进制（每个上下文检测一次，入口经 GLContext 的加载器获取）
+        bool isBinarySupported();
+
+        // 异步编译（默认关闭）：创建 Shader 时只提交编译和链接，不等待结果，
+        // 首次 use / 设置 uniform 时才检查（编译错误也在那时以异常抛出）。
+        // 驱动支持 KHR/ARB_parallel_shader_compile 时由驱动的多个线程并行编译，可用 isReady 轮询；
+        // 不支持时驱动通常仍会推迟实际编译，只是无法非阻塞地查询完成状态。
+        inline void setAsyncCompilation(bool enabled) { m_async = enabled; }
+        inline bool isAsyncCompilation() const noexcept { return m_async; }
+        bool isParallelCompileSupported();
+
+        // 程序是否已可无阻塞使用；不支持并行编译扩展时，未检查的程序总是返回 false
+        bool isReady(OpenGLProgram &program);
+        // 当前上下文中尚未检查结果的程序数
+        size_t getPendingCount();
+        // 等待当前上下文中全部未完成的程序（如加载结束时）；有失败时记录全部错误并抛出第一个
+        void finishPending();
+
+        inline ProgramCacheStats getStats() const noexcept { return m_stats; }
+        inline void resetStats() noexcept { m_stats = ProgramCacheStats(); }
+
+    private:
+        ProgramCache();
+
+        // 上下文更换（GLContext 代数变化）后清除能力检测结果
+        void syncContext();
+        // 上下文销毁：丢弃该上下文的共享表条目与未完成列表，以及能力检测结果
+        void releaseContext(uint64_t context);
+        static std::string contextPrefix(uint64_t context);
+
+        // 提交编译链接；binaryPath 非空时链接成功后写入磁盘缓存
+        std::shared_ptr<OpenGLProgram> compile(const std::string &name, const std::string &vertexSource,
+                                               const std::string &fragmentSource, const std::string &binaryPath,
+                                               uint64_t key);
+        uint64_t binaryKey(const std::string &vertexSource, const std::string &fragmentSource);
+        std::string binaryPath(uint64_t key) const;
+        unsigned int loadBinary(const std::string &path, uint64_t key);
+        void storeBinary(unsigned int program, const std::string &path, uint64_t key);
+
+        std::unordered_map<std::string, std::weak_ptr<OpenGLProgram>> m_programs; // 键为 上下文 id '\0' 顶点源码 '\0' 片元源码
+        std::string m_directory;
+        int m_binarySupport = -1; // -1 表示尚未检测
+        int m_parallelSupport = -1;
+        uint64_t m_contextGeneration = 0;
+        bool m_async = false;
+        struct PendingProgram
+        {
+            uint64_t context; // GLContext id
+            std::weak_ptr<OpenGLProgram> program;
+        };
+        std::vector<PendingProgram> m_pending;
+        ProgramCacheStats m_stats;
+    };
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "OxygenRender/Renderer.h"
+#include "OxygenRender/GLStateCache.h"
+
+namespace OxyRender
+{
+    class Material;
+    class VertexArray;
+
+    // 一次索引绘制，提交时只记录，不调用 GL
+    struct DrawPacket
+    {
+        const PipelineState *pipeline = nullptr; // 必须；其着色器用于材质与矩阵
+        Material *material = nullptr;            // 可空
+        const VertexArray *vertexArray = nullptr;
+        uint32_t indexCount = 0;
+        uint32_t firstIndex = 0;
+        glm::mat4 model{1.0f};   // 写入 model / normalMatrix（着色器中不存在时跳过）
+        float depth = 0.0f;      // 到相机的距离
+        uint8_t layer = 0;       // 0-15，小的先画（如 0 场景、1 天空盒、2 界面）
+        bool translucent = false; // 半透明：同层内排在不透明之后，由远到近
+    };
+
+    struct RenderQueueStats
+    {
+        size_t packets = 0;
+        size_t pipelineChanges = 0;
+        size_t materialChanges = 0;
+        size_t vertexArrayChanges = 0;
+        size_t matrixChanges = 0;
+        double sortMs = 0.0;
+        RenderStateStats glState; // 执行期间 GLStateCache 实际调用/省去的状态函数
+    };
+
+    // 排序键渲染队列
+    // submit 记录绘制包并生成 64 位键，flush 时按键基数排序后依次执行，只在管线/材质/矩阵改变时设置状态：
+    //   不透明  [layer:4][0][pipeline:16][material:16][depth:24][0:3]   同状态内由近到远（利于 early-z）
+    //   半透明  [layer:4][1][~depth:24][pipeline:16][material:16][0:3] 由远到近，其次才按状态
+    // 深度按 setDepthRange 的范围线性量化。只能在上下文线程使用。
+    class RenderQueue
+    {
+    public:
+        explicit RenderQueue(Renderer &renderer);
+
+        // 深度量化范围（默认 0.1 ~ 1000），超出范围的夹到两端
+        void setDepthRange(float nearDistance, float farDistance);
+
+        void submit(const DrawPacket &packet);
+        // 排序并执行全部绘制包，然后清空；统计见 getStats
+        void flush();
+        // 丢弃未执行的绘制包
+        void clear();
+
+        inline size_t size() const noexcept { return m_packets.size(); }
+        // 最近一次 flush 的统计
+        inline const RenderQueueStats &getStats() const noexcept { return m_stats; }
+
+        static uint64_t makeKey(uint8_t layer, bool translucent, uint32_t pipelineId, uint32_t materialId, uint32_t depth24);
+
+    private:
+        struct Entry
+        {
+            uint64_t key;
+            uint32_t index;
+        };
+
+        void sort();
+        void execute();
+
+        Renderer &m_renderer;
+        std::vector<DrawPacket> m_packets;
+        std::vector<Entry> m_entries;
+        std::vector<Entry> m_scratch;
+        float m_depthNear = 0.1f;
+        float m_depthScale = 1.0f / (1000.0f - 0.1f);
+        RenderQueueStats m_stats;
+    };
+}
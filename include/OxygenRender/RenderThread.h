@@ -0,0 +1,161 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "OxygenRender/Window.h"
+
+namespace OxyRender
+{
+    // 命令流：在连续内存块中记录闭包，execute 按记录顺序调用并析构
+    // 块在 reset 后保留复用，稳定后每帧不再分配内存（闭包捕获的容器除外）。
+    class CommandStream
+    {
+    public:
+        CommandStream() = default;
+        ~CommandStream();
+
+        CommandStream(const CommandStream &) = delete;
+        CommandStream &operator=(const CommandStream &) = delete;
+
+        template <typename F>
+        void record(F &&func)
+        {
+            using Fn = std::decay_t<F>;
+            static_assert(alignof(Fn) <= kAlign, "command alignment too large");
+            constexpr size_t payloadOffset = alignUp(sizeof(Header));
+            constexpr size_t size = alignUp(payloadOffset + sizeof(Fn));
+            unsigned char *p = reserve(size);
+            new (p + payloadOffset) Fn(std::forward<F>(func));
+            new (p) Header{&call<Fn>, static_cast<uint32_t>(size)};
+            m_blocks[m_current].used += size;
+            ++m_count;
+        }
+
+        // 依次执行全部命令后清空；某条命令抛出时其余命令只析构不执行，异常继续抛出
+        void execute();
+        // 不执行，析构全部命令
+        void reset();
+
+        inline size_t size() const noexcept { return m_count; }
+        inline bool empty() const noexcept { return m_count == 0; }
+
+    private:
+        static constexpr size_t kAlign = alignof(std::max_align_t);
+        static constexpr size_t kBlockSize = 64 * 1024;
+
+        struct Header
+        {
+            void (*call)(void *payload, bool invoke);
+            uint32_t size; // 含头部，已对齐
+        };
+
+        struct Block
+        {
+            std::unique_ptr<unsigned char[]> data;
+            size_t capacity = 0;
+            size_t used = 0;
+        };
+
+        static constexpr size_t alignUp(size_t size) noexcept { return (size + kAlign - 1) & ~(kAlign - 1); }
+
+        template <typename Fn>
+        static void call(void *payload, bool invoke)
+        {
+            Fn *func = static_cast<Fn *>(payload);
+            if (invoke)
+            {
+                // 调用抛出时仍须析构
+                struct Destroy
+                {
+                    Fn *func;
+                    ~Destroy() { func->~Fn(); }
+                } destroy{func};
+                (*func)();
+            }
+            else
+                func->~Fn();
+        }
+
+        // 返回当前块中至少 size 字节的空闲位置，构造成功后才计入 used
+        unsigned char *reserve(size_t size);
+        void consume(bool invoke);
+
+        std::vector<Block> m_blocks;
+        size_t m_current = 0; // 正在写入的块
+        size_t m_count = 0;
+    };
+
+    struct RenderThreadStats
+    {
+        uint64_t frames = 0;       // 已执行完的帧
+        double recordWaitMs = 0.0; // 主线程在 endFrame 中等待渲染线程的累计时间
+        double executeMs = 0.0;    // 渲染线程执行命令（含交换缓冲）的累计时间
+    };
+
+    // 渲染线程
+    // start 后由独立线程持有窗口的 GL 上下文：主线程把第 N 帧的 GL 工作记录到命令流，
+    // 渲染线程同时执行第 N-1 帧。两条命令流轮换，通过两个原子帧计数无锁交接，
+    // 最多一帧在途；主线程领先两帧时在 endFrame 中等待。
+    // 启动期间主线程不得直接调用 GL（包括创建/销毁 Buffer、Texture、Shader 等对象），
+    // 需要时用 enqueue 提交或先 stop；事件轮询仍在主线程。
+    // 运行期间 ThreadPool 的主线程指向渲染线程，runOnMainThread 任务在每帧执行完命令后运行。
+    // 未启动时 enqueue 立即执行、endFrame 直接交换缓冲，调用方无需区分两种模式。
+    class RenderThread
+    {
+    public:
+        explicit RenderThread(Window &window);
+        ~RenderThread();
+
+        RenderThread(const RenderThread &) = delete;
+        RenderThread &operator=(const RenderThread &) = delete;
+
+        // 在当前持有上下文的线程调用
+        void start();
+        // 执行完所有已记录的命令，上下文交回调用线程；渲染线程中的异常在此抛出
+        void stop();
+        inline bool isRunning() const noexcept { return m_thread.joinable(); }
+
+        // 闭包按值捕获本帧数据，执行时主线程可能已在修改下一帧
+        template <typename F>
+        void enqueue(F &&func)
+        {
+            if (isRunning())
+                m_streams[m_submitted.load(std::memory_order_relaxed) & 1].record(std::forward<F>(func));
+            else
+                func();
+        }
+
+        // 记录交换缓冲并移交本帧；渲染线程中的异常在此抛出
+        void endFrame();
+        // 等待已移交的帧全部执行完
+        void finish();
+
+        RenderThreadStats getStats() const;
+
+    private:
+        void threadLoop();
+        void submitFrame();
+        void waitForCompleted(uint64_t frames);
+        void rethrowError();
+
+        Window &m_window;
+        std::thread m_thread;
+        CommandStream m_streams[2];
+        std::atomic<uint64_t> m_submitted{0}; // 主线程写
+        std::atomic<uint64_t> m_completed{0}; // 渲染线程写
+        std::atomic<bool> m_stop{false};
+        // 单槽：渲染线程在 m_hasError 为 false 时写入，主线程取走后清除；槽被占用时后续异常只打印
+        std::exception_ptr m_error;
+        std::atomic<bool> m_hasError{false};
+        std::atomic<uint64_t> m_waitNs{0};
+        std::atomic<uint64_t> m_executeNs{0};
+    };
+}
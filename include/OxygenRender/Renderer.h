@@ -2,10 +2,15 @@
 #include "OxygenRender/GraphicsTypes.h"
 #include "OxygenRender/Window.h"
 #include "OxygenRender/Buffer.h"
+#include "OxygenRender/FrameUniforms.h"
+#include "OxygenRender/GLStateCache.h"
 #include <memory>
+#include <unordered_map>
 
 namespace OxyRender
 {
+    class Shader;
+
     // ================= 渲染状态相关 =================
     enum class RenderCapability
     {
@@ -45,8 +50,8 @@ namespace OxyRender
         Point
     };
 
-    // ================= 模板测试相关 =================
-    enum class StencilFunc
+    // ================= 深度/模板测试相关 =================
+    enum class CompareFunc
     {
         Always,
         Equal,
@@ -57,6 +62,7 @@ namespace OxyRender
         Gequal,
         Never
     };
+    using StencilFunc = CompareFunc;
 
     enum class StencilOp
     {
@@ -70,6 +76,68 @@ namespace OxyRender
         Invert
     };
 
+    enum class CullMode
+    {
+        Back,
+        Front,
+        FrontAndBack
+    };
+
+    // ================= 管线状态 =================
+    // 一次绘制所需的全部固定功能状态 + 着色器 + 顶点布局
+    struct PipelineDesc
+    {
+        // 混合
+        bool blend = false;
+        RenderBlendFunc srcBlend = RenderBlendFunc::SrcAlpha;
+        RenderBlendFunc dstBlend = RenderBlendFunc::OneMinusSrcAlpha;
+        // 深度
+        bool depthTest = true;
+        bool depthWrite = true;
+        CompareFunc depthFunc = CompareFunc::Less;
+        // 模板
+        bool stencilTest = false;
+        CompareFunc stencilFunc = CompareFunc::Always;
+        int stencilRef = 0;
+        uint32_t stencilMask = 0xFFu;
+        StencilOp stencilFail = StencilOp::Keep;
+        StencilOp stencilDepthFail = StencilOp::Keep;
+        StencilOp stencilPass = StencilOp::Keep;
+        // 剔除与光栅化
+        bool cullFace = false;
+        CullMode cullMode = CullMode::Back;
+        RenderPolygonMode polygonMode = RenderPolygonMode::Fill;
+        bool multisample = true;
+        bool programPointSize = false;
+        // 为空时绑定管线不切换程序
+        Shader *shader = nullptr;
+        // VertexLayout::getHash()；GL 中格式由 VAO 携带，这里只参与哈希与排序
+        uint64_t vertexLayout = 0;
+
+        bool operator==(const PipelineDesc &other) const noexcept;
+        inline bool operator!=(const PipelineDesc &other) const noexcept { return !(*this == other); }
+        uint64_t hash() const noexcept;
+    };
+
+    // 不可变的管线状态对象，由 Renderer::createPipeline 创建并按内容去重，生命周期与 Renderer 相同
+    class PipelineState
+    {
+    public:
+        inline const PipelineDesc &getDesc() const noexcept { return m_desc; }
+        inline uint64_t getHash() const noexcept { return m_hash; }
+        // 按创建顺序编号，可作为排序键的一部分
+        inline uint32_t getId() const noexcept { return m_id; }
+
+    private:
+        friend class Renderer;
+        PipelineState(const PipelineDesc &desc, uint64_t hash, uint32_t id)
+            : m_desc(desc), m_hash(hash), m_id(id) {}
+
+        const PipelineDesc m_desc;
+        const uint64_t m_hash;
+        const uint32_t m_id;
+    };
+
     // ================= 渲染器抽象接口类 =================
     class IRenderer
     {
@@ -82,7 +150,9 @@ namespace OxyRender
         virtual void setPolygonMode(RenderPolygonMode mod, bool enable) = 0;
 
         // 绘制
-        virtual void drawTriangles(const VertexArray &vao, size_t indexCount) = 0;
+        // firstIndex 为索引缓冲中的起始索引；虚函数不带默认参数，由非虚重载补齐
+        inline void drawTriangles(const VertexArray &vao, size_t indexCount) { drawTriangles(vao, indexCount, 0); }
+        virtual void drawTriangles(const VertexArray &vao, size_t indexCount, size_t firstIndex) = 0;
         virtual void drawLines(const VertexArray &vao, size_t indexCount, float thickness) = 0;
         virtual void drawPoints(const VertexArray &vao, size_t vertexCount) = 0;
 
@@ -93,6 +163,14 @@ namespace OxyRender
         // 混合
         virtual void setBlendFunc(RenderBlendFunc sfactor, RenderBlendFunc dfactor) = 0;
 
+        // 状态调用统计：上一帧（两次 clear 之间）实际调用与省去的状态切换数
+        virtual RenderStateStats getStateStats() const = 0;
+
+        // 管线：各字段经 GLStateCache 与当前 GL 状态比较，只调用有变化的部分；
+        // 单独的 setCapability 等调用或 GLStateCache::invalidate() 之后 getBoundPipeline 返回空
+        virtual void bindPipeline(const PipelineState &pipeline) = 0;
+        virtual const PipelineState *getBoundPipeline() const noexcept = 0;
+
         // // 模板测试
         // virtual void setStencilFunc(StencilFunc func, GLint ref, GLuint mask) = 0;
         // virtual void setStencilOp(StencilOp sfail, StencilOp dpfail, StencilOp dppass) = 0;
@@ -104,6 +182,7 @@ namespace OxyRender
     };
 
     // ================= OpenGL渲染器实现类 =================
+    // 所有状态设置经由 GLStateCache，与当前状态相同的调用被跳过；绘制后不再解绑 VAO
     class OpenGLRenderer : public IRenderer
     {
     public:
@@ -113,18 +192,25 @@ namespace OxyRender
         void setCapability(RenderCapability cap, bool enable) override;
         void setPolygonMode(RenderPolygonMode mod, bool enable) override;
         
-        void drawTriangles(const VertexArray &vao, size_t indexCount) override;
+        using IRenderer::drawTriangles;
+        void drawTriangles(const VertexArray &vao, size_t indexCount, size_t firstIndex) override;
         void drawLines(const VertexArray &vao, size_t indexCount, float thickness) override;
         void drawPoints(const VertexArray &vao, size_t vertexCount) override;
         void setBlendFunc(RenderBlendFunc sfactor, RenderBlendFunc dfactor) override;
+        // 同时开始新一帧的状态统计
         void clear() override;
+        RenderStateStats getStateStats() const override;
+        void bindPipeline(const PipelineState &pipeline) override;
+        const PipelineState *getBoundPipeline() const noexcept override;
 
         // void setStencilFunc(StencilFunc func, GLint ref, GLuint mask) override;
         // void setStencilOp(StencilOp sfail, StencilOp dpfail, StencilOp dppass) override;
         // void setStencilMask(GLuint mask) override;
         // void clearStencil() override;
 
-    // private:
+    private:
+        const PipelineState *m_boundPipeline = nullptr;
+        uint64_t m_boundEpoch = 0; // 绑定时 GLStateCache 的重置次数
     //     GLenum convertStencilFunc(StencilFunc func);
     //     GLenum convertStencilOp(StencilOp op);
     };
@@ -151,6 +237,9 @@ namespace OxyRender
     private:
         std::unique_ptr<IRenderer> renderer;
         Window &m_window;
+        std::unique_ptr<FrameUniforms> m_frameUniforms;
+        std::unordered_map<uint64_t, std::unique_ptr<PipelineState>> m_pipelines;
+        const PipelineState *m_defaultPipeline = nullptr;
 
     public:
         explicit Renderer(Window &window);
@@ -163,7 +252,7 @@ namespace OxyRender
         void setBlendFunc(RenderBlendFunc sfactor, RenderBlendFunc dfactor);
 
         // 绘制
-        void drawTriangles(const VertexArray &vao, size_t indexCount);
+        void drawTriangles(const VertexArray &vao, size_t indexCount, size_t firstIndex = 0);
         void drawLines(const VertexArray &vao, size_t indexCount, float thickness);
         void drawPoints(const VertexArray &vao, size_t vertexCount);
 
@@ -171,6 +260,21 @@ namespace OxyRender
         void setClearColor(const OxyColor &color);
         void clear();
 
+        // 内置着色器共享的每帧相机/光照 uniform 缓冲
+        inline FrameUniforms &getFrameUniforms() { return *m_frameUniforms; }
+
+        // 上一帧的状态调用统计（skipped 为省去的冗余调用）
+        RenderStateStats getStateStats() const;
+
+        // 管线状态：相同描述返回同一对象，应在初始化时创建，之后每次绘制只绑定
+        const PipelineState *createPipeline(const PipelineDesc &desc);
+        // PipelineDesc 默认值（深度测试、不混合），构造时绑定
+        inline const PipelineState &getDefaultPipeline() const noexcept { return *m_defaultPipeline; }
+        void bindPipeline(const PipelineState &pipeline);
+        // 最近绑定且未被单独的状态调用打破的管线，可能为空
+        const PipelineState *getBoundPipeline() const noexcept;
+        inline size_t getPipelineCount() const noexcept { return m_pipelines.size(); }
+
         // // 模板测试
         // void setStencilFunc(StencilFunc func, GLint ref, GLuint mask);
         // void setStencilOp(StencilOp sfail, StencilOp dpfail, StencilOp dppass);
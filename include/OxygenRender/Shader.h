@@ -4,9 +4,36 @@
 #include <sstream>
 #include <stdexcept>
 #include <memory>
+#include <cstdint>
+#include <unordered_map>
+#include <functional>
+#include <glm/glm.hpp>
 #include "OxygenRender/GraphicsTypes.h"
 namespace OxyRender
 {
+    // uniform 名的 32 位 FNV-1a 哈希，可在编译期计算，如 static constexpr UniformID kModel("model");
+    // 结构体成员与数组元素使用完整名字（"light.position"、"bones[0]"），数组名本身也可直接使用
+    struct UniformID
+    {
+        uint32_t hash = 0;
+
+        constexpr UniformID() = default;
+        constexpr UniformID(const char *name) : hash(hashName(name)) {}
+        UniformID(const std::string &name) : hash(hashName(name.c_str())) {}
+
+        static constexpr uint32_t hashName(const char *name)
+        {
+            uint32_t h = 2166136261u;
+            while (*name)
+            {
+                h ^= static_cast<unsigned char>(*name++);
+                h *= 16777619u;
+            }
+            return h;
+        }
+        constexpr bool operator==(const UniformID &other) const { return hash == other.hash; }
+    };
+
     // 渲染器抽象接口类
     class IShader
     {
@@ -22,28 +49,114 @@ namespace OxyRender
         IShader(std::string name, std::string path_vertex, std::string path_fragment);
         IShader(std::string name, std::string vertex_source, std::string fragment_source, bool from_source);
         virtual void use() = 0;
+        // 按名字设置，类型由链接时查询到的 uniform 类型决定；不存在或大小不符时抛出异常。
+        // 例外：声明了 FrameData 块的程序中，已移入该块的旧相机/光源 uniform
+        // （view、projection、viewPos、lightPos、light.*）不生效并在首次设置时输出警告，其值改由 Renderer 的 FrameUniforms 提供
         virtual void setUniformData(const std::string &name, const void *data, size_t size) = 0;
+        // 查询 uniform 位置，不存在时返回 -1（不抛出异常）
+        virtual int getUniformLocation(const std::string &name) = 0;
+        virtual bool hasUniform(UniformID id) const = 0;
+
+        // 类型化设置，着色器中不存在的 uniform 被忽略，值未变化时不调用 GL；需要上传时会绑定本程序
+        virtual void setInt(UniformID id, int value) = 0;
+        virtual void setFloat(UniformID id, float value) = 0;
+        virtual void setVec2(UniformID id, const glm::vec2 &value) = 0;
+        virtual void setVec3(UniformID id, const glm::vec3 &value) = 0;
+        virtual void setVec4(UniformID id, const glm::vec4 &value) = 0;
+        virtual void setMat3(UniformID id, const glm::mat3 &value) = 0;
+        virtual void setMat4(UniformID id, const glm::mat4 &value) = 0;
+
+        // 编译链接是否已完成（异步编译时不阻塞地查询）
+        virtual bool isReady() = 0;
+
         virtual unsigned int getID() = 0;
         virtual ~IShader() = default;
     };
+    // 已链接的 GL 程序及其 uniform 表（链接后由 glGetActiveUniform 建立，附带最近一次设置的值）。
+    // 源码相同的 Shader 经 ProgramCache 共享同一对象，值缓存随程序共享才不会失效
+    class OpenGLProgram
+    {
+    public:
+        struct UniformInfo
+        {
+            int location = -1;
+            unsigned int type = 0; // GL 类型，如 GL_FLOAT_VEC3
+            size_t size = 0;       // 单个元素的字节数
+            bool cached = false;
+            alignas(16) unsigned char value[64];
+        };
+
+        // 接管已链接成功的程序并建立 uniform 表
+        OpenGLProgram(std::string name, unsigned int programId);
+        // 接管已提交编译/链接的程序，finishLink 在首次使用时检查结果（失败时抛出异常）
+        OpenGLProgram(std::string name, unsigned int programId, std::function<void()> finishLink);
+        ~OpenGLProgram();
+        OpenGLProgram(const OpenGLProgram &) = delete;
+        OpenGLProgram &operator=(const OpenGLProgram &) = delete;
+
+        inline unsigned int getID() const noexcept { return m_programId; }
+        inline const std::string &getName() const noexcept { return m_name; }
+        // 以下接口会先等待链接完成
+        UniformInfo *findUniform(UniformID id);
+        bool hasUniform(UniformID id);
+        // 是否声明了共享的 FrameData uniform 块
+        bool hasFrameBlock();
+
+        // 等待编译链接完成并建立 uniform 表；失败时抛出异常（之后每次调用都抛出同样的错误）
+        void finish();
+        inline bool isPending() const noexcept { return static_cast<bool>(m_finishLink); }
+
+    private:
+        void buildUniformTable();
+
+        std::string m_name;
+        unsigned int m_programId;
+        std::function<void()> m_finishLink; // 非空表示链接结果尚未检查
+        std::string m_error;
+        std::unordered_map<uint32_t, UniformInfo> m_uniforms;
+        bool m_frameBlock = false;
+    };
+
     // OpenGL实现Shader
     class OpenGLShader : public IShader
     {
     private:
-        unsigned int m_programId;
+        using UniformInfo = OpenGLProgram::UniformInfo;
+
+        std::shared_ptr<OpenGLProgram> m_program;
+        uint32_t m_ignoredFrameNames = 0; // 已警告过的 FrameData 旧 uniform 名（位掩码）
 
         static std::string loadFile(const std::string &path);
-        static unsigned int compileShader(unsigned int type, const std::string &source);
+
+        // 值与缓存相同时直接返回；否则先绑定本程序（glUniform* 作用于当前程序），再更新缓存并上传
+        void store(UniformInfo &uniform, const void *data, size_t size);
+        static void upload(const UniformInfo &uniform, const void *data);
+        template <typename T>
+        void setTyped(UniformID id, const T &value, unsigned int glType);
 
     public:
         OpenGLShader(std::string name, std::string path_vertex, std::string path_fragment);
         OpenGLShader(std::string name, std::string vertex_source, std::string fragment_source, bool from_source);
-        virtual ~OpenGLShader() override;
+        virtual ~OpenGLShader() override = default;
         virtual void use() override;
-        inline virtual unsigned int getID() override { return m_programId; }
+        inline virtual unsigned int getID() override
+        {
+            m_program->finish();
+            return m_program->getID();
+        }
+        virtual bool isReady() override;
 
         virtual void setUniformData(const std::string &name, const void *data, size_t size) override;
+        virtual int getUniformLocation(const std::string &name) override;
+        virtual bool hasUniform(UniformID id) const override;
 
+        virtual void setInt(UniformID id, int value) override;
+        virtual void setFloat(UniformID id, float value) override;
+        virtual void setVec2(UniformID id, const glm::vec2 &value) override;
+        virtual void setVec3(UniformID id, const glm::vec3 &value) override;
+        virtual void setVec4(UniformID id, const glm::vec4 &value) override;
+        virtual void setMat3(UniformID id, const glm::mat3 &value) override;
+        virtual void setMat4(UniformID id, const glm::mat4 &value) override;
     };
     // 渲染器工厂类
     class ShaderFactory
@@ -104,7 +217,17 @@ namespace OxyRender
         ~Shader() = default;
 
         inline unsigned int getID() { return m_Shader->getID(); }
+        inline bool isReady() { return m_Shader->isReady(); }
         inline void use() { m_Shader->use(); }
         inline void setUniformData(const std::string &name, const void *data, size_t size) { m_Shader->setUniformData(name, data, size); }
+        inline int getUniformLocation(const std::string &name) { return m_Shader->getUniformLocation(name); }
+        inline bool hasUniform(UniformID id) const { return m_Shader->hasUniform(id); }
+        inline void setInt(UniformID id, int value) { m_Shader->setInt(id, value); }
+        inline void setFloat(UniformID id, float value) { m_Shader->setFloat(id, value); }
+        inline void setVec2(UniformID id, const glm::vec2 &value) { m_Shader->setVec2(id, value); }
+        inline void setVec3(UniformID id, const glm::vec3 &value) { m_Shader->setVec3(id, value); }
+        inline void setVec4(UniformID id, const glm::vec4 &value) { m_Shader->setVec4(id, value); }
+        inline void setMat3(UniformID id, const glm::mat3 &value) { m_Shader->setMat3(id, value); }
+        inline void setMat4(UniformID id, const glm::mat4 &value) { m_Shader->setMat4(id, value); }
     };
 };
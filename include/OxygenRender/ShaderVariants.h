@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "OxygenRender/Shader.h"
+
+namespace OxyRender
+{
+    // 着色器特性位，对应模板中的 #ifdef 宏
+    namespace ShaderFeature
+    {
+        constexpr uint32_t Textured = 1u << 0;    // TEXTURED：漫反射/颜色纹理
+        constexpr uint32_t NormalMap = 1u << 1;   // NORMAL_MAP：切线空间法线贴图
+        constexpr uint32_t SpecularMap = 1u << 2; // SPECULAR_MAP：高光贴图
+        constexpr uint32_t Count = 3;
+
+        // 特性位对应的宏名
+        const char *defineName(uint32_t bit);
+    }
+
+    // 着色器变体：一份源码模板 + 特性位组合，按需在 #version 之后插入 #define 编译，
+    // 编译结果按组合缓存（相同源码还会经 ProgramCache 共享/落盘）。
+    // 绘制时按网格或批次实际用到的特性取最小变体，省去无用的纹理采样和分支。
+    class ShaderVariants
+    {
+    public:
+        // supportedFeatures 为模板实际使用的特性，其余位在 get 时被忽略
+        ShaderVariants(std::string name, std::string vertexTemplate, std::string fragmentTemplate,
+                       uint32_t supportedFeatures);
+
+        // 取得（必要时编译）变体；编译失败时抛出异常
+        Shader &get(uint32_t features);
+
+        inline uint32_t getSupportedFeatures() const noexcept { return m_supported; }
+        inline size_t getVariantCount() const noexcept { return m_variants.size(); }
+
+        // 在 #version 行之后插入特性宏
+        static std::string applyFeatures(const std::string &source, uint32_t features);
+
+    private:
+        std::string m_name;
+        std::string m_vertexTemplate;
+        std::string m_fragmentTemplate;
+        uint32_t m_supported;
+        std::unordered_map<uint32_t, std::unique_ptr<Shader>> m_variants;
+    };
+}
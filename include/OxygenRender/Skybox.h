@@ -13,11 +13,15 @@ public:
     Skybox(Renderer& renderer, const std::vector<std::string>& faces);
     ~Skybox();
     
+    // 使用 Renderer 的 FrameUniforms 中的相机绘制
+    void draw(Shader& shader);
+    // 使用给定相机绘制，矩阵只作为天空盒着色器的 skyboxViewProjection 上传，不修改 FrameUniforms
     void draw(Shader& shader, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix);
     static Shader createDefaultShader();
     
 private:
     Renderer& m_renderer;
+    const PipelineState* m_pipeline; // 深度 LEQUAL、不写深度
     Cubemap m_cubemap;
     VertexArray m_vao;
     Buffer m_vbo;
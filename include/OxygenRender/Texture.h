@@ -13,8 +13,21 @@ namespace OxyRender
     {
         RGBA8,
         RGB8,
-        DEPTH24STENCIL8
+        R8, // 单通道（采样时扩展为灰度）
+        DEPTH24STENCIL8,
+        // 块压缩格式（4x4 像素一块）
+        BC1, // RGB(A) 4bpp，1 位 alpha
+        BC3, // RGBA 8bpp
+        BC4, // 单通道 4bpp（R）
+        BC5, // 双通道 8bpp（RG，适合法线贴图）
+        BC7  // RGBA 8bpp，高质量
     };
+
+    inline bool isCompressedFormat(TextureFormat format) noexcept
+    {
+        return format == TextureFormat::BC1 || format == TextureFormat::BC3 || format == TextureFormat::BC4 ||
+               format == TextureFormat::BC5 || format == TextureFormat::BC7;
+    }
     // Texture过滤和环绕模式
     enum class TextureFilter
     {
@@ -27,6 +40,62 @@ namespace OxyRender
         Repeat,
         ClampToEdge
     };
+    // CPU 端解码后的图像，可在任意线程解码，再在上下文线程上传
+    struct ImageData
+    {
+        std::shared_ptr<unsigned char> pixels;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t channels = 0;
+
+        inline bool valid() const noexcept { return pixels != nullptr; }
+
+        // 线程安全；翻转设置只作用于当前线程，失败时抛出异常
+        // expandChannels 为 false 时保留 1/2 通道（供离线压缩），否则扩展为 RGB/RGBA
+        static ImageData load(const std::string &path, bool flipVertically = true, bool expandChannels = true);
+        static ImageData loadFromMemory(const unsigned char *data, size_t size, bool flipVertically = true,
+                                        bool expandChannels = true);
+    };
+
+    // 预处理好的 GPU 纹理数据及其 mip 链（BC 压缩格式，或 .oxtex 中的 RGBA8/RGB8/R8）
+    // 来源为 KTX2 / DDS / .oxtex 容器或 TextureCompression。
+    // 各级数据指向 storage 持有的内存（映射文件或缓冲区），拷贝只增加引用计数。
+    // 行序与 ImageData 翻转后一致（首行为图像底部），由 OxyTexConv / OxyTexBake 生成的文件满足此约定。
+    struct CompressedImageData
+    {
+        struct Level
+        {
+            const unsigned char *data = nullptr;
+            size_t size = 0;
+            uint32_t width = 0;
+            uint32_t height = 0;
+        };
+
+        TextureFormat format = TextureFormat::BC1;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t rowAlignment = 1; // 未压缩格式的行对齐（1/2/4/8），上传时设为 GL_UNPACK_ALIGNMENT
+        std::vector<Level> levels; // levels[0] 为最大一级
+        std::shared_ptr<const void> storage;
+        // 行序自上而下（无法在加载时翻转的 KTX2 数据，如 BC7），采样时 V 方向与其他纹理相反
+        bool topDown = false;
+
+        inline bool valid() const noexcept { return !levels.empty() && storage != nullptr; }
+        size_t totalBytes() const noexcept;
+
+        // 每块字节数（BC1/BC4 为 8，其余 16；未压缩格式为每像素字节数）与某一级的数据大小
+        static size_t blockBytes(TextureFormat format) noexcept;
+        static size_t levelSize(TextureFormat format, uint32_t width, uint32_t height, uint32_t rowAlignment = 1) noexcept;
+
+        // 是否为 KTX2 / DDS / .oxtex 文件头
+        static bool isContainer(const unsigned char *data, size_t size) noexcept;
+
+        // 解析 KTX2 / DDS / .oxtex，data 须在 storage 生命周期内有效；失败时抛出异常
+        static CompressedImageData parse(const unsigned char *data, size_t size, std::shared_ptr<const void> storage);
+        // 映射并解析文件，线程安全
+        static CompressedImageData load(const std::string &path);
+    };
+
     // Texture 抽象接口类
     class ITexture
     {
@@ -35,6 +104,8 @@ namespace OxyRender
         virtual void bind(uint32_t slot = 0) const noexcept = 0;
         virtual void unbind() const noexcept = 0;
         virtual void setData(const void *data, uint32_t width, uint32_t height) = 0;
+        // 更新子矩形，data 为紧密排列的行
+        virtual void setSubData(const void *data, uint32_t x, uint32_t y, uint32_t width, uint32_t height) = 0;
         virtual uint32_t getWidth() const noexcept = 0;
         virtual uint32_t getHeight() const noexcept = 0;
     };
@@ -46,24 +117,100 @@ namespace OxyRender
         OpenGLTexture2D(const std::string &path,
                         TextureFilter filter = TextureFilter::Linear,
                         TextureWrap wrap = TextureWrap::Repeat);
+        OpenGLTexture2D(const ImageData &image,
+                        TextureFilter filter = TextureFilter::Linear,
+                        TextureWrap wrap = TextureWrap::Repeat);
+        // 直接上传预计算的 mip 链，不再运行时生成 mipmap
+        OpenGLTexture2D(const CompressedImageData &image,
+                        TextureFilter filter = TextureFilter::Linear,
+                        TextureWrap wrap = TextureWrap::Repeat);
 
         ~OpenGLTexture2D();
 
         void bind(uint32_t slot = 0) const noexcept override;
         void unbind() const noexcept override;
 
+        // 更新 level 0；有 mipmap 时随后重新生成其余级别
         void setData(const void *data, uint32_t width, uint32_t height) override;
+        void setSubData(const void *data, uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
 
         inline uint32_t getWidth() const noexcept override { return m_width; }
         inline uint32_t getHeight() const noexcept override { return m_height; }
 
+        // 当前上下文是否支持该压缩格式（BC1/BC3 需 S3TC 扩展，BC7 需 BPTC 或 GL 4.2）
+        static bool isFormatSupported(TextureFormat format);
+
     private:
+        void upload(const ImageData &image, TextureFilter filter, TextureWrap wrap);
+        void upload(const CompressedImageData &image, TextureFilter filter, TextureWrap wrap);
+        void createTexture(TextureFilter filter, TextureWrap wrap);
+
         uint32_t m_rendererID;
         uint32_t m_width, m_height;
         uint32_t m_format;
         uint32_t m_internalFormat;
         uint32_t m_filter;
         uint32_t m_wrap;
+        bool m_mipmapped = false;
+    };
+
+    struct DynamicTextureStats
+    {
+        size_t uploads = 0; // 更新次数
+        size_t bytes = 0;   // 上传字节数
+        size_t stalls = 0;  // 等待 PBO 传输完成的次数（环形缓冲不足时增加）
+    };
+
+    // OpenGL 动态纹理：存储只分配一次，更新经 PBO 环形缓冲异步传输。
+    // CPU 写入第 N+1 帧时第 N 帧仍可在传输中，不会阻塞在 glTexImage2D 上。
+    class OpenGLDynamicTexture2D : public ITexture
+    {
+    public:
+        OpenGLDynamicTexture2D(uint32_t width, uint32_t height,
+                               TextureFormat format = TextureFormat::RGBA8,
+                               uint32_t bufferCount = 2,
+                               TextureFilter filter = TextureFilter::Linear,
+                               TextureWrap wrap = TextureWrap::ClampToEdge);
+        ~OpenGLDynamicTexture2D();
+
+        OpenGLDynamicTexture2D(const OpenGLDynamicTexture2D &) = delete;
+        OpenGLDynamicTexture2D &operator=(const OpenGLDynamicTexture2D &) = delete;
+
+        void bind(uint32_t slot = 0) const noexcept override;
+        void unbind() const noexcept override;
+
+        // 尺寸必须与创建时一致
+        void setData(const void *data, uint32_t width, uint32_t height) override;
+        void setSubData(const void *data, uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+
+        // 零拷贝更新：返回映射的 PBO 内存（紧密排列的行），写完后调用 endUpdate
+        void *beginUpdate(uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+        void endUpdate();
+
+        inline uint32_t getWidth() const noexcept override { return m_width; }
+        inline uint32_t getHeight() const noexcept override { return m_height; }
+        inline uint32_t getBufferCount() const noexcept { return static_cast<uint32_t>(m_slots.size()); }
+        inline const DynamicTextureStats &getStats() const noexcept { return m_stats; }
+        inline void resetStats() noexcept { m_stats = {}; }
+
+    private:
+        struct Slot
+        {
+            uint32_t buffer = 0;
+            void *fence = nullptr; // GLsync，传输完成前不可复用
+        };
+
+        uint32_t m_rendererID = 0;
+        uint32_t m_width, m_height;
+        uint32_t m_format;
+        uint32_t m_internalFormat;
+        uint32_t m_bytesPerPixel;
+        std::vector<Slot> m_slots;
+        size_t m_next = 0;
+        // 正在映射的区域
+        bool m_mapped = false;
+        uint32_t m_regionX = 0, m_regionY = 0, m_regionWidth = 0, m_regionHeight = 0;
+        DynamicTextureStats m_stats;
     };
 
     // Texture2D类对外接口
@@ -72,16 +219,110 @@ namespace OxyRender
     private:
         std::shared_ptr<ITexture> m_texture;
 
+    protected:
+        explicit Texture2D(std::shared_ptr<ITexture> texture) : m_texture(std::move(texture)) {}
+
     public:
         Texture2D() = default;
         Texture2D(const std::string &path, TextureFilter filter = TextureFilter::Linear, TextureWrap wrap = TextureWrap::Repeat);
+        // 从已解码的图像创建（需在上下文线程调用）
+        Texture2D(const ImageData &image, TextureFilter filter = TextureFilter::Linear, TextureWrap wrap = TextureWrap::Repeat);
+        Texture2D(const CompressedImageData &image, TextureFilter filter = TextureFilter::Linear, TextureWrap wrap = TextureWrap::Repeat);
         inline void bind(uint32_t slot = 0) const { m_texture->bind(slot); }
         inline void unbind() const { m_texture->unbind(); }
         inline void setData(const void *data, uint32_t width, uint32_t height) { m_texture->setData(data, width, height); }
+        inline void setSubData(const void *data, uint32_t x, uint32_t y, uint32_t width, uint32_t height) { m_texture->setSubData(data, x, y, width, height); }
         inline uint32_t getWidth() const noexcept { return m_texture->getWidth(); }
         inline uint32_t getHeight() const noexcept { return m_texture->getHeight(); }
     };
 
+    // 动态纹理对外接口，可直接当作 Texture2D 使用（如 Graphics2D::drawRect）
+    class DynamicTexture2D : public Texture2D
+    {
+    private:
+        std::shared_ptr<OpenGLDynamicTexture2D> m_dynamic;
+
+        explicit DynamicTexture2D(std::shared_ptr<OpenGLDynamicTexture2D> dynamic)
+            : Texture2D(dynamic), m_dynamic(std::move(dynamic)) {}
+
+    public:
+        // bufferCount 为 PBO 数量，2 即双缓冲；更新频繁且尺寸大时可增加到 3
+        DynamicTexture2D(uint32_t width, uint32_t height,
+                         TextureFormat format = TextureFormat::RGBA8,
+                         uint32_t bufferCount = 2,
+                         TextureFilter filter = TextureFilter::Linear,
+                         TextureWrap wrap = TextureWrap::ClampToEdge);
+        inline void *beginUpdate(uint32_t x, uint32_t y, uint32_t width, uint32_t height) { return m_dynamic->beginUpdate(x, y, width, height); }
+        inline void endUpdate() { m_dynamic->endUpdate(); }
+        inline const DynamicTextureStats &getStats() const noexcept { return m_dynamic->getStats(); }
+        inline void resetStats() noexcept { m_dynamic->resetStats(); }
+    };
+
+    // OpenGL 流式纹理：完整 mip 链只有 [residentLevel, levelCount) 驻留显存，
+    // 采样范围由 GL_TEXTURE_BASE_LEVEL 限制，按需逐级调入更精细的级别或释放已驻留的级别。
+    // 只读，由 TextureStreamer 管理
+    class OpenGLStreamingTexture2D : public ITexture
+    {
+    public:
+        // 只上传 firstLevel 及更粗的级别，source 须包含完整 mip 链
+        OpenGLStreamingTexture2D(const CompressedImageData &source, uint32_t firstLevel,
+                                 TextureFilter filter = TextureFilter::Linear,
+                                 TextureWrap wrap = TextureWrap::Repeat);
+        ~OpenGLStreamingTexture2D();
+
+        OpenGLStreamingTexture2D(const OpenGLStreamingTexture2D &) = delete;
+        OpenGLStreamingTexture2D &operator=(const OpenGLStreamingTexture2D &) = delete;
+
+        void bind(uint32_t slot = 0) const noexcept override;
+        void unbind() const noexcept override;
+
+        // 流式纹理不支持直接写入，调用时抛出异常
+        void setData(const void *data, uint32_t width, uint32_t height) override;
+        void setSubData(const void *data, uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+
+        // 完整分辨率（level 0）
+        inline uint32_t getWidth() const noexcept override { return m_width; }
+        inline uint32_t getHeight() const noexcept override { return m_height; }
+
+        // 调入 residentLevel - 1 级，source 的格式与尺寸须与创建时一致
+        void uploadLevel(const CompressedImageData &source, uint32_t level);
+        // 释放比 level 更精细的级别
+        void evictTo(uint32_t level);
+
+        // source 是否与本纹理的格式和 mip 链一致（源文件在运行中被替换时可能不一致）
+        bool isCompatible(const CompressedImageData &source) const noexcept;
+
+        inline uint32_t getResidentLevel() const noexcept { return m_residentLevel; }
+        inline uint32_t getLevelCount() const noexcept { return static_cast<uint32_t>(m_levelBytes.size()); }
+        inline size_t getLevelBytes(uint32_t level) const noexcept { return m_levelBytes[level]; }
+        size_t getResidentBytes() const noexcept;
+
+    private:
+        uint32_t m_rendererID = 0;
+        uint32_t m_width, m_height;
+        TextureFormat m_sourceFormat;
+        uint32_t m_format;         // 压缩格式为 0
+        uint32_t m_internalFormat;
+        uint32_t m_residentLevel;
+        std::vector<size_t> m_levelBytes;
+    };
+
+    // 流式纹理对外接口，可直接当作 Texture2D 使用
+    class StreamingTexture2D : public Texture2D
+    {
+    private:
+        friend class TextureStreamer;
+        std::shared_ptr<OpenGLStreamingTexture2D> m_streaming;
+
+        explicit StreamingTexture2D(std::shared_ptr<OpenGLStreamingTexture2D> streaming)
+            : Texture2D(streaming), m_streaming(std::move(streaming)) {}
+
+    public:
+        inline uint32_t getResidentLevel() const noexcept { return m_streaming->getResidentLevel(); }
+        inline uint32_t getLevelCount() const noexcept { return m_streaming->getLevelCount(); }
+        inline size_t getResidentBytes() const noexcept { return m_streaming->getResidentBytes(); }
+    };
+
     class ICubemap
     {
     public:
@@ -0,0 +1,86 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+#include "OxygenRender/Texture.h"
+
+namespace OxyRender
+{
+    // .oxtex 预烘焙纹理容器
+    // 布局：文件头 | 级别表 | 各级像素数据（16 字节对齐）
+    // 数据即 GPU 上传格式（BC 块或按 rowAlignment 对齐的行），映射后直接交给
+    // glCompressedTexImage2D / glTexImage2D，冷启动加载只剩文件 I/O。
+    // 按小端序存储，源文件大小 + 修改时间或内容哈希一致才视为有效；源文件不存在时（只发布烘焙结果）直接使用。
+    namespace TextureBakeFormat
+    {
+        constexpr uint32_t MAGIC = 0x5845544F; // "OTEX"
+        constexpr uint32_t VERSION = 1;
+        constexpr uint32_t FLAG_FLIPPED = 1u; // 首行为图像底部
+
+        // 格式编码与 TextureFormat 解耦，枚举调整不影响已有文件
+        enum FormatCode : uint32_t
+        {
+            RGBA8 = 1,
+            RGB8 = 2,
+            R8 = 3,
+            BC1 = 10,
+            BC3 = 11,
+            BC4 = 12,
+            BC5 = 13,
+            BC7 = 14
+        };
+
+        struct Header
+        {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t format; // FormatCode
+            uint32_t width;
+            uint32_t height;
+            uint32_t levelCount;
+            uint32_t flags;
+            uint32_t rowAlignment;
+            uint64_t sourceSize;
+            int64_t sourceMtime;
+            uint64_t sourceHash; // 源文件内容 FNV-1a 哈希，与 TextureCache 的内容键一致
+        };
+
+        struct LevelEntry
+        {
+            uint64_t offset;
+            uint64_t size;
+            uint32_t width;
+            uint32_t height;
+        };
+    }
+
+    struct TextureBakeOptions
+    {
+        // RGBA8 表示不压缩（保留源图像的灰度/RGB/RGBA 通道，灰度 + alpha 展开为 RGBA），也可选 BC 格式
+        TextureFormat format = TextureFormat::RGBA8;
+        bool generateMips = true;
+        bool flipVertically = true; // 与运行时 ImageData::load 的默认行为一致
+    };
+
+    class TextureBake
+    {
+    public:
+        static std::string bakedPathFor(const std::string &sourcePath) { return sourcePath + ".oxtex"; }
+
+        // 解码源图像、生成 mip 链（可选压缩）并写入 .oxtex；失败打印原因并返回 false
+        static bool bake(const std::string &sourcePath, const std::string &bakedPath,
+                         const TextureBakeOptions &options = TextureBakeOptions());
+
+        // 写出已准备好的数据，sourcePath 为空时不记录源文件信息
+        static bool write(const std::string &bakedPath, const CompressedImageData &image, const std::string &sourcePath,
+                          bool flipped = true);
+
+        // 烘焙文件是否存在且与源文件一致（源文件不存在视为一致）
+        static bool isUpToDate(const std::string &bakedPath, const std::string &sourcePath);
+
+        // 映射并校验；源文件已变化、翻转方式不符或文件损坏时返回无效数据。
+        // outSourceHash 输出记录的源文件哈希，可用作缓存内容键
+        static CompressedImageData open(const std::string &bakedPath, const std::string &sourcePath,
+                                        bool flipVertically = true, uint64_t *outSourceHash = nullptr);
+    };
+}
@@ -0,0 +1,120 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "OxygenRender/Texture.h"
+
+namespace OxyRender
+{
+    struct TextureCacheStats
+    {
+        size_t hits = 0;          // 按路径或内容命中
+        size_t misses = 0;        // 需要新建纹理
+        size_t evictions = 0;     // 因超出预算被释放的纹理数
+        size_t residentBytes = 0; // 估算的显存占用（含 mipmap）
+        size_t textureCount = 0;
+    };
+
+    // 解码结果（可在工作线程生成）
+    struct DecodedTexture
+    {
+        std::string key;  // 规范化路径
+        uint64_t contentHash = 0;
+        ImageData image;
+        CompressedImageData compressed; // KTX2 / DDS / .oxtex 文件，有效时代替 image
+
+        // 上传到 GPU 的字节数（未压缩纹理不含运行时生成的 mipmap）
+        size_t uploadBytes() const noexcept
+        {
+            if (compressed.valid())
+                return compressed.totalBytes();
+            return size_t(image.width) * image.height * image.channels;
+        }
+    };
+
+    // 进程级纹理缓存
+    // 以规范化路径 + 采样参数 + 当前上下文为键，同内容不同路径的文件按内容哈希共享同一纹理。
+    // 返回的 shared_ptr 即引用计数句柄；只有缓存自身持有的纹理才会在超出预算时按 LRU 释放。
+    // GPU 相关操作（load/insert/回收）须在上下文线程调用，find/decode 可在任意线程调用。
+    class TextureCache
+    {
+    public:
+        TextureCache(const TextureCache &) = delete;
+        TextureCache &operator=(const TextureCache &) = delete;
+        static TextureCache &getInstance();
+
+        // 命中直接返回，否则解码并上传；失败抛出异常
+        std::shared_ptr<Texture2D> load(const std::string &path,
+                                        TextureFilter filter = TextureFilter::Linear,
+                                        TextureWrap wrap = TextureWrap::Repeat);
+
+        // 只查询，不加载；未命中返回 nullptr（不计入 misses）
+        std::shared_ptr<Texture2D> find(const std::string &path,
+                                        TextureFilter filter = TextureFilter::Linear,
+                                        TextureWrap wrap = TextureWrap::Repeat);
+
+        // 读取文件、计算内容哈希并解码，线程安全。
+        // 同目录下存在未过期的 <path>.oxtex 时直接映射它，跳过解码与 mipmap 生成
+        static DecodedTexture decode(const std::string &path, bool flipVertically = true);
+
+        // 是否优先使用 TextureBake 烘焙的 .oxtex（默认开启）
+        inline void setBakedTexturesEnabled(bool enabled) noexcept { m_bakedTextures = enabled; }
+        inline bool isBakedTexturesEnabled() const noexcept { return m_bakedTextures; }
+
+        // 上传已解码的纹理；内容已存在时复用已有纹理
+        std::shared_ptr<Texture2D> insert(const DecodedTexture &decoded,
+                                          TextureFilter filter = TextureFilter::Linear,
+                                          TextureWrap wrap = TextureWrap::Repeat);
+
+        // 显存预算（字节），0 表示不限制
+        void setMemoryBudget(size_t bytes);
+        inline size_t getMemoryBudget() const noexcept { return m_budget; }
+
+        // 释放未被引用的纹理直到满足预算；clear 释放全部未被引用的纹理
+        void collectGarbage();
+        void clear();
+
+        TextureCacheStats getStats() const;
+        void resetStats();
+
+        // 规范化路径（找不到文件时经 ResourcesManager 解析）
+        static std::string resolvePath(const std::string &path);
+
+    private:
+        TextureCache();
+        ~TextureCache() = default;
+
+        // 上下文销毁时丢弃属于它的条目（仍被外部引用的纹理由引用方负责），避免静态析构时再调用 glDeleteTextures
+        void releaseContext(uint64_t context);
+
+        // 每份内容一个条目，多个路径可指向同一条目
+        struct Entry
+        {
+            std::shared_ptr<Texture2D> texture;
+            std::string contentKey;
+            std::vector<std::string> pathKeys;
+            size_t bytes = 0;
+            uint64_t context = 0; // 创建纹理的 GLContext id
+            std::list<Entry *>::iterator lru;
+        };
+
+        static std::string keySuffix(TextureFilter filter, TextureWrap wrap);
+        void touch(Entry &entry);
+        void evict(size_t targetBytes);
+        void erase(Entry *entry);
+
+        mutable std::mutex m_mutex;
+        std::unordered_map<std::string, std::unique_ptr<Entry>> m_byContent;
+        std::unordered_map<std::string, Entry *> m_byPath;
+        std::list<Entry *> m_lru; // 前端为最近使用
+        size_t m_budget = 512ull * 1024 * 1024;
+        std::atomic<bool> m_bakedTextures{true};
+        TextureCacheStats m_stats;
+    };
+}
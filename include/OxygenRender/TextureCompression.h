@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "OxygenRender/Texture.h"
+
+namespace OxyRender
+{
+    // BC 块压缩与 KTX2 / DDS 写出（离线转换工具使用，只操作 CPU 端数据）
+    namespace TextureCompression
+    {
+        // 把 RGBA8 像素压缩为 BC 块，宽高无需是 4 的倍数（边缘块复制边界像素）
+        // BC4 取 R 通道，BC5 取 RG 通道；按块行在 ThreadPool 上并行
+        std::vector<unsigned char> compress(const unsigned char *rgba, uint32_t width, uint32_t height, TextureFormat format);
+
+        // 按 2x2 盒式滤波生成完整 mip 链（通道数不变），chain[0] 与输入共享像素
+        std::vector<ImageData> buildMipChain(const ImageData &image);
+
+        // 把未压缩的 mip 链（1/3/4 通道）拼接为 R8/RGB8/RGBA8 数据，每行按 rowAlignment 对齐；
+        // 2 通道（灰度 + alpha）展开为 RGBA8
+        CompressedImageData packMipChain(const std::vector<ImageData> &chain, uint32_t rowAlignment = 4);
+
+        // 生成完整 mip 链后逐级转为 RGBA8 并压缩
+        CompressedImageData compress(const ImageData &image, TextureFormat format, bool generateMips = true);
+
+        // 写出容器文件，失败返回 false。
+        // KTX2 写入 KTXorientation=ru（行序自下而上）；DDS 的 BC7 使用 DX10 扩展头
+        bool writeKTX2(const std::string &path, const CompressedImageData &image);
+        bool writeDDS(const std::string &path, const CompressedImageData &image);
+    }
+}
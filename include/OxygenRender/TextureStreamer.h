@@ -0,0 +1,125 @@
+#pragma once
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "OxygenRender/Texture.h"
+#include "OxygenRender/TextureCache.h"
+
+namespace OxyRender
+{
+    struct TextureStreamerStats
+    {
+        size_t textureCount = 0;
+        size_t residentBytes = 0;  // 当前驻留显存
+        size_t requiredBytes = 0;  // 满足本帧所需精度的总量（未受预算限制时）
+        size_t pendingLoads = 0;   // 后台读取中的纹理数
+        size_t budgetLimited = 0;  // 本帧因预算被降级的纹理数
+        size_t uploadedLevels = 0; // 以下为累计值
+        size_t uploadedBytes = 0;
+        size_t evictedLevels = 0;
+        size_t evictedBytes = 0;
+    };
+
+    // mip 级纹理流送
+    // 纹理加载时只上传不超过 initialResolution 的粗糙级别；绘制时按网格 UV 密度与屏幕尺寸
+    // 上报所需的 mip 级别，update() 在显存预算内后台读取并逐级调入更精细的级别，
+    // 长时间不再需要的细节被释放。预算不足时优先降级最久未使用、占用最大的纹理。
+    // 源文件为 .oxtex / KTX2 / DDS 时直接从映射内存读取各级；普通图片需重新解码，建议先用 OxyTexBake 烘焙。
+    // 除 decode 外所有接口都须在上下文线程调用。
+    class TextureStreamer
+    {
+    public:
+        TextureStreamer(const TextureStreamer &) = delete;
+        TextureStreamer &operator=(const TextureStreamer &) = delete;
+        static TextureStreamer &getInstance();
+
+        // 同步读取并创建流式纹理；同一路径与采样参数共享同一纹理。失败时抛出异常
+        std::shared_ptr<StreamingTexture2D> load(const std::string &path,
+                                                 TextureFilter filter = TextureFilter::Linear,
+                                                 TextureWrap wrap = TextureWrap::Repeat);
+
+        // 只查询已创建的纹理，未命中返回 nullptr
+        std::shared_ptr<StreamingTexture2D> find(const std::string &path,
+                                                 TextureFilter filter = TextureFilter::Linear,
+                                                 TextureWrap wrap = TextureWrap::Repeat);
+
+        // 读取完整 mip 链（普通图片在此生成 mipmap），可在工作线程调用；结果的 compressed 总是有效
+        static DecodedTexture decode(const std::string &path, bool flipVertically = true);
+
+        // 用 decode 的结果创建流式纹理
+        std::shared_ptr<StreamingTexture2D> insert(const DecodedTexture &decoded,
+                                                   TextureFilter filter = TextureFilter::Linear,
+                                                   TextureWrap wrap = TextureWrap::Repeat);
+
+        // 上报本帧的精度需求：uvPerPixel 为一个屏幕像素覆盖的 UV 跨度，
+        // 所需级别为 log2(uvPerPixel * 纹理尺寸)。非流式纹理直接忽略
+        void request(const Texture2D &texture, float uvPerPixel);
+
+        // 每帧调用一次：计算目标级别、释放多余细节、提交后台读取并在上传预算内调入新级别
+        void update();
+
+        // 显存预算（字节），0 表示不限制；初始级别总是驻留，不受预算限制
+        inline void setMemoryBudget(size_t bytes) noexcept { m_budget = bytes; }
+        inline size_t getMemoryBudget() const noexcept { return m_budget; }
+
+        // 每帧上传字节数上限，0 表示不限制；每帧至少上传一级以保证进度
+        inline void setUploadBudget(size_t bytesPerFrame) noexcept { m_uploadBudget = bytesPerFrame; }
+        inline size_t getUploadBudget() const noexcept { return m_uploadBudget; }
+
+        // 新建纹理初始驻留的最大边长（像素）
+        inline void setInitialResolution(uint32_t pixels) noexcept { m_initialResolution = pixels; }
+        inline uint32_t getInitialResolution() const noexcept { return m_initialResolution; }
+
+        // 细节连续多少帧不被需要后才释放，避免在级别边界来回调入调出
+        inline void setEvictionDelay(uint32_t frames) noexcept { m_evictionDelay = frames; }
+        inline uint32_t getEvictionDelay() const noexcept { return m_evictionDelay; }
+
+        // 所需级别的偏移，正值降低精度（节省显存），负值提高精度
+        inline void setLevelBias(float bias) noexcept { m_levelBias = bias; }
+        inline float getLevelBias() const noexcept { return m_levelBias; }
+
+        inline size_t getTextureCount() const noexcept { return m_records.size(); }
+        TextureStreamerStats getStats() const;
+        void resetStats();
+
+    private:
+        TextureStreamer() = default;
+        ~TextureStreamer() = default;
+
+        struct Record
+        {
+            std::weak_ptr<StreamingTexture2D> owner;
+            const Texture2D *handle = nullptr;           // m_byTexture 的键
+            OpenGLStreamingTexture2D *texture = nullptr; // owner 存活期间有效
+            std::string key;                             // 路径 + 采样参数
+            std::string path;
+            CompressedImageData source;                  // 完整 mip 链，空闲或调入完成后释放
+            std::future<DecodedTexture> pending;
+            bool failed = false;                         // 重新读取失败后不再尝试调入
+            uint32_t minLevel = 0;                       // 始终驻留的最粗部分的起始级别
+            float requestedLevel = 0.0f;                 // 本帧所需的最精细级别
+            uint64_t lastRequestFrame = 0;
+            uint64_t lastDetailFrame = 0;                // 最近一次需要当前驻留精度的帧
+            uint32_t targetLevel = 0;
+        };
+
+        uint32_t initialLevel(const CompressedImageData &source) const;
+        void computeTargets();
+        void applyBudget();
+        bool ensureSource(Record &record);
+
+        std::unordered_map<std::string, std::unique_ptr<Record>> m_records;
+        std::unordered_map<const Texture2D *, Record *> m_byTexture;
+        uint64_t m_frame = 1;
+        size_t m_budget = 256ull * 1024 * 1024;
+        size_t m_uploadBudget = 16 * 1024 * 1024;
+        uint32_t m_initialResolution = 64;
+        uint32_t m_evictionDelay = 120;
+        float m_levelBias = 0.0f;
+        TextureStreamerStats m_stats;
+    };
+}
@@ -0,0 +1,188 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace OxyRender
+{
+    class ThreadPool;
+
+    // 任务计数器：ThreadPool::run / runAfter 提交时加一，任务结束时减一，归零即全部完成。
+    // 可作为 runAfter 的依赖；在 ThreadPool::wait 返回前不能销毁。
+    class JobCounter
+    {
+    public:
+        JobCounter() = default;
+        JobCounter(const JobCounter &) = delete;
+        JobCounter &operator=(const JobCounter &) = delete;
+
+        inline bool isDone() const noexcept { return m_count.load(std::memory_order_acquire) == 0; }
+        inline size_t getPending() const noexcept { return m_count.load(std::memory_order_acquire); }
+
+    private:
+        friend class ThreadPool;
+
+        void add();
+        // 记录第一个异常
+        void fail(std::exception_ptr error);
+        // 减一，归零时执行等待中的后续任务并返回 true
+        bool release();
+        // 已归零时立即执行，否则等归零时执行
+        void then(std::function<void()> continuation);
+
+        std::atomic<size_t> m_count{0};
+        std::mutex m_mutex;
+        std::vector<std::function<void()>> m_continuations;
+        std::exception_ptr m_error;
+    };
+
+    // 工作窃取线程池
+    // 每个工作线程一个双端队列：自己提交的任务压到队尾并从队尾取（后进先出，缓存更热），
+    // 空闲时从其他线程队首窃取；非工作线程提交的任务进入单独的外部队列。
+    // 等待（wait / parallelFor）的线程会一起执行任务，因此任务内可以嵌套 parallelFor；无任务可做时短暂自旋后阻塞等待。
+    // 任务不能调用 OpenGL，GPU 工作用 runOnMainThread 交给主线程（持有 GL 上下文的线程）。
+    // 主线程由 setMainThread 指定：Window 创建时设为创建线程，RenderThread 运行期间设为渲染线程；
+    // Window::update 与渲染线程每帧调用 pumpMainThread。
+    class ThreadPool
+    {
+    public:
+        // threadCount 为 0 时不创建工作线程，任务在提交线程上直接执行
+        explicit ThreadPool(size_t threadCount);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        // 全局共享线程池，线程数为硬件线程数 - 1（调用线程也参与 parallelFor）
+        static ThreadPool &getInstance();
+
+        template <typename F>
+        auto submit(F &&func) -> std::future<std::invoke_result_t<std::decay_t<F>>>
+        {
+            using Result = std::invoke_result_t<std::decay_t<F>>;
+            auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(func));
+            std::future<Result> future = task->get_future();
+            push([task]()
+                 { (*task)(); });
+            return future;
+        }
+
+        // 提交任务并计入 counter，异常由 wait(counter) 重新抛出
+        template <typename F>
+        void run(JobCounter &counter, F &&func)
+        {
+            counter.add();
+            push(wrap(counter, std::forward<F>(func)));
+        }
+
+        // dependency 归零后才开始执行 func，同样计入 counter
+        template <typename F>
+        void runAfter(JobCounter &dependency, JobCounter &counter, F &&func)
+        {
+            counter.add();
+            dependency.then([this, task = wrap(counter, std::forward<F>(func))]() mutable
+                            { push(std::move(task)); });
+        }
+
+        // 等待 counter 归零，期间执行池中任务（在主线程上还执行 runOnMainThread 排队的任务）；
+        // 任务抛出的第一个异常在此重新抛出
+        void wait(JobCounter &counter);
+
+        // 并行执行 func(i)，i ∈ [begin, end)，调用线程也参与执行，返回时全部完成。
+        // grain 为每个任务处理的元素数，0 时按线程数自动划分
+        void parallelFor(size_t begin, size_t end, const std::function<void(size_t)> &func, size_t grain = 0);
+
+        // 在主线程上执行（如 GPU 上传）；在主线程上调用时立即执行，否则排队到 pumpMainThread。
+        // 尚未指定主线程时总是排队
+        template <typename F>
+        auto runOnMainThread(F &&func) -> std::future<std::invoke_result_t<std::decay_t<F>>>
+        {
+            using Result = std::invoke_result_t<std::decay_t<F>>;
+            auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(func));
+            std::future<Result> future = task->get_future();
+            if (isMainThread())
+            {
+                (*task)();
+                return future;
+            }
+            {
+                std::lock_guard<std::mutex> lock(m_mainMutex);
+                m_mainTasks.emplace_back([task]()
+                                         { (*task)(); });
+                m_mainPending.fetch_add(1, std::memory_order_seq_cst);
+            }
+            wakeWaiters();
+            return future;
+        }
+
+        // 指定主线程（默认为调用线程）；上下文移交到其他线程时随之更新
+        void setMainThread(std::thread::id id = std::this_thread::get_id()) noexcept;
+        // 在主线程上执行排队的主线程任务，返回执行的数量；其他线程调用时不执行并返回 0
+        size_t pumpMainThread();
+        bool isMainThread() const noexcept;
+
+        inline size_t getThreadCount() const noexcept { return m_workers.size(); }
+        // 累计从其他线程队列窃取的任务数
+        inline uint64_t getStealCount() const noexcept { return m_steals.load(std::memory_order_relaxed); }
+
+    private:
+        struct WorkQueue
+        {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        template <typename F>
+        std::function<void()> wrap(JobCounter &counter, F &&func)
+        {
+            return [this, &counter, func = std::forward<F>(func)]() mutable
+            {
+                try
+                {
+                    func();
+                }
+                catch (...)
+                {
+                    counter.fail(std::current_exception());
+                }
+                // 归零后 counter 可能已被等待方销毁，只能再访问线程池
+                if (counter.release())
+                    wakeWaiters();
+            };
+        }
+
+        // 唤醒阻塞在 wait 中的线程（没有等待者时几乎无开销）
+        void wakeWaiters();
+
+        void push(std::function<void()> task);
+        // 依次尝试：自己的队列、外部队列、窃取
+        bool pop(std::function<void()> &task);
+        bool runOne();
+        void workerLoop(size_t index);
+
+        std::vector<std::thread> m_workers;
+        std::vector<std::unique_ptr<WorkQueue>> m_queues; // 每个工作线程一个，最后一个为外部队列
+        std::atomic<size_t> m_pending{0};
+        std::atomic<uint64_t> m_steals{0};
+        std::mutex m_sleepMutex;
+        std::condition_variable m_condition;     // 工作线程等待新任务
+        std::condition_variable m_waitCondition; // wait 中的线程等待计数归零、新任务或主线程任务
+        std::atomic<size_t> m_waiters{0};
+        bool m_stop = false;
+
+        std::atomic<std::thread::id> m_mainThread{};
+        std::mutex m_mainMutex;
+        std::deque<std::function<void()>> m_mainTasks;
+        std::atomic<size_t> m_mainPending{0};
+    };
+}
@@ -1,6 +1,9 @@
 #pragma once
 #include <string>
 #include "OxygenRender/GraphicsTypes.h"
+#include "OxygenRender/Texture.h"
+#include <cstdint>
+#include <future>
 #include <memory>
 
 struct GLFWwindow;
@@ -14,6 +17,13 @@ namespace OxyRender
         Hidden
     };
 
+    // 窗口后端
+    enum class WindowBackend
+    {
+        GLFW,    // 可见窗口
+        Headless // 无显示器的离屏渲染
+    };
+
     // Window 抽象接口类
     class IWindow
     {
@@ -41,6 +51,13 @@ namespace OxyRender
 
         virtual double getTime() = 0;
         virtual void waitEventsTimeout(double timeout) = 0;
+
+        // 在调用线程绑定/释放 GL 上下文（上下文同一时刻只能属于一个线程）；
+        // 多个窗口时，切换到另一个窗口绘制前须先调用 makeContextCurrent(true)
+        virtual void makeContextCurrent(bool current) = 0;
+
+        // 读回当前帧（交换缓冲前调用）为 RGBA8，行自下而上（GL 约定）
+        virtual ImageData readPixels();
     };
     // GLFW实现Window
     class GLFWWindow : public IWindow
@@ -62,13 +79,60 @@ namespace OxyRender
 
         double getTime() override;
         void waitEventsTimeout(double timeout) override;
+
+        void makeContextCurrent(bool current) override;
+    };
+    // 无显示器的离屏窗口，用于服务器上批量导出图像
+    // 运行时加载 libEGL 创建 OpenGL 3.3 Core 上下文（Mesa llvmpipe 等纯 CPU 驱动亦可）：
+    // 优先 surfaceless 平台，不可用时退回默认显示 + pbuffer。
+    // 渲染目标是 width x height 的 FBO，samples > 0 时为多重采样并在读回前解析；
+    // 没有事件，swapBuffers 只计帧。没有 EGL 的平台构造时抛出异常。
+    class HeadlessWindow : public IWindow
+    {
+    public:
+        HeadlessWindow(int width, int height, std::string title, int samples = 0);
+        ~HeadlessWindow() override;
+        void setViewport(int x, int y, int width, int height) override;
+        bool shouldClose() override;
+        void shutdown() override;
+        void swapBuffers() override;
+        void pollEvents() override;
+
+        void setCursorPos(float x, float y) override;
+        void setCursorMode(CursorMode mode) override;
+
+        double getTime() override;
+        void waitEventsTimeout(double timeout) override;
+
+        void makeContextCurrent(bool current) override;
+
+        ImageData readPixels() override;
+
+        inline uint64_t getFrameCount() const noexcept { return m_frames; }
+
+    private:
+        struct EGLState;
+        std::unique_ptr<EGLState> m_egl;
+        unsigned int m_framebuffer = 0;
+        unsigned int m_colorBuffer = 0;
+        unsigned int m_depthBuffer = 0;
+        unsigned int m_resolveFramebuffer = 0; // 仅多重采样时
+        unsigned int m_resolveBuffer = 0;
+        int m_samples = 0;
+        bool m_shouldClose = false;
+        uint64_t m_frames = 0;
+        double m_startTime = 0.0;
     };
+
     // Window工厂类
     class WindowFactory
     {
     public:
-        static std::unique_ptr<IWindow> createWindow(int width, int height, const std::string &title)
+        static std::unique_ptr<IWindow> createWindow(int width, int height, const std::string &title,
+                                                     WindowBackend backend = WindowBackend::GLFW)
         {
+            if (backend == WindowBackend::Headless)
+                return std::make_unique<HeadlessWindow>(width, height, title);
             return std::make_unique<GLFWWindow>(width, height, title);
         }
     };
@@ -79,7 +143,9 @@ namespace OxyRender
         std::unique_ptr<IWindow> m_window;
 
     public:
-        Window(int width, int height, std::string title);
+        Window(int width, int height, std::string title, WindowBackend backend = WindowBackend::GLFW);
+        // 使用自定义后端，如指定采样数的 HeadlessWindow
+        explicit Window(std::unique_ptr<IWindow> window);
         void setViewport(int x, int y, int width, int height);
         bool shouldClose();
         void shutdown();
@@ -94,5 +160,14 @@ namespace OxyRender
 
         double getTime();
         void waitEventsTimeout(double timeout);
+
+        void makeContextCurrent(bool current);
+
+        // 读回当前帧，交换缓冲前调用
+        ImageData readPixels();
+        // 读回当前帧并保存为 PNG，失败时抛出异常
+        void saveFrame(const std::string &path);
+        // 读回在调用线程完成，PNG 编码与写盘在 ThreadPool 上进行，批量导出时与下一帧渲染重叠
+        std::future<void> saveFrameAsync(const std::string &path);
     };
 } // namespace OxyRender
\ No newline at end of file
@@ -1,4 +1,5 @@
 ﻿#include "OxygenRender/Buffer.h"
+#include "OxygenRender/GLStateCache.h"
 #include <stdexcept>
 namespace OxyRender
 {
@@ -70,6 +71,23 @@ namespace OxyRender
         attributes.push_back({name, location, type, stride});
         stride += sizeOfAttribType(type);
     }
+    uint64_t VertexLayout::getHash() const noexcept
+    {
+        uint64_t h = 1469598103934665603ull;
+        auto mix = [&h](uint64_t value)
+        {
+            h ^= value;
+            h *= 1099511628211ull;
+        };
+        for (const auto &attr : attributes)
+        {
+            mix(static_cast<uint64_t>(attr.location));
+            mix(static_cast<uint64_t>(attr.type));
+            mix(attr.offset);
+        }
+        mix(stride);
+        return h;
+    }
     // OpenGL实现VertexBuffer
     OpenGLVertexBuffer::OpenGLVertexBuffer(BufferUsage usage)
     {
@@ -94,17 +112,17 @@ namespace OxyRender
     
     OpenGLVertexBuffer::~OpenGLVertexBuffer()
     {
-        glDeleteBuffers(1, &m_rendererID);
+        GLStateCache::getInstance().deleteBuffer(m_rendererID);
     }
 
     void OpenGLVertexBuffer::bind() const noexcept
     {
-        glBindBuffer(GL_ARRAY_BUFFER, m_rendererID);
+        GLStateCache::getInstance().bindBuffer(GL_ARRAY_BUFFER, m_rendererID);
     }
 
     void OpenGLVertexBuffer::unbind() const noexcept
     {
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        GLStateCache::getInstance().bindBuffer(GL_ARRAY_BUFFER, 0);
     }
 
     void OpenGLVertexBuffer::setData(const void *data, size_t size, size_t offset)
@@ -144,21 +162,23 @@ namespace OxyRender
 
     OpenGLIndexBuffer::~OpenGLIndexBuffer()
     {
-        glDeleteBuffers(1, &m_rendererID);
+        GLStateCache::getInstance().deleteBuffer(m_rendererID);
     }
 
     void OpenGLIndexBuffer::bind() const noexcept
     {
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_rendererID);
+        GLStateCache::getInstance().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_rendererID);
     }
 
     void OpenGLIndexBuffer::unbind() const noexcept
     {
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        GLStateCache::getInstance().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
     }
 
     void OpenGLIndexBuffer::setData(const void *data, size_t size, size_t offset)
     {
+        // 索引缓冲绑定属于 VAO 状态：先切到所属 VAO（未挂接时为 0），避免改动上一次绘制留下的其它 VAO
+        GLStateCache::getInstance().bindVertexArray(m_vertexArray);
         bind();
         m_count = static_cast<uint32_t>(size / sizeof(uint32_t));
         if (offset == 0)
@@ -176,6 +196,60 @@ namespace OxyRender
         return m_count;
     }
 
+    // OpenGL实现UniformBuffer
+    OpenGLUniformBuffer::OpenGLUniformBuffer(BufferUsage usage)
+    {
+        GLenum glUsage = GL_DYNAMIC_DRAW;
+        switch (usage)
+        {
+        case BufferUsage::StaticDraw:
+            glUsage = GL_STATIC_DRAW;
+            break;
+        case BufferUsage::DynamicDraw:
+            glUsage = GL_DYNAMIC_DRAW;
+            break;
+        case BufferUsage::StreamDraw:
+            glUsage = GL_STREAM_DRAW;
+            break;
+        }
+        m_usage = glUsage;
+        glGenBuffers(1, &m_rendererID);
+    }
+
+    OpenGLUniformBuffer::~OpenGLUniformBuffer()
+    {
+        GLStateCache::getInstance().deleteBuffer(m_rendererID);
+    }
+
+    void OpenGLUniformBuffer::bind() const noexcept
+    {
+        GLStateCache::getInstance().bindBuffer(GL_UNIFORM_BUFFER, m_rendererID);
+    }
+
+    void OpenGLUniformBuffer::unbind() const noexcept
+    {
+        GLStateCache::getInstance().bindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+
+    void OpenGLUniformBuffer::setData(const void *data, size_t size, size_t offset)
+    {
+        bind();
+        if (offset == 0)
+        {
+            // 整块更新时重新分配存储，避免等待仍在使用旧数据的绘制
+            glBufferData(GL_UNIFORM_BUFFER, size, data, m_usage);
+        }
+        else
+        {
+            glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+        }
+    }
+
+    void OpenGLUniformBuffer::bindBase(uint32_t binding) const noexcept
+    {
+        GLStateCache::getInstance().bindBufferBase(GL_UNIFORM_BUFFER, binding, m_rendererID);
+    }
+
     OpenGLVertexArray::OpenGLVertexArray()
     {
         glGenVertexArrays(1, &m_rendererID);
@@ -183,17 +257,17 @@ namespace OxyRender
 
     OpenGLVertexArray::~OpenGLVertexArray()
     {
-        glDeleteVertexArrays(1, &m_rendererID);
+        GLStateCache::getInstance().deleteVertexArray(m_rendererID);
     }
 
     void OpenGLVertexArray::bind() const noexcept
     {
-        glBindVertexArray(m_rendererID);
+        GLStateCache::getInstance().bindVertexArray(m_rendererID);
     }
 
     void OpenGLVertexArray::unbind() const noexcept
     {
-        glBindVertexArray(0);
+        GLStateCache::getInstance().bindVertexArray(0);
     }
 
     // 设置顶点缓冲和布局
@@ -227,6 +301,7 @@ namespace OxyRender
     void OpenGLVertexArray::setIndexBuffer(IndexBuffer *indexBuffer)
     {
         m_indexBuffer = indexBuffer;
+        static_cast<OpenGLIndexBuffer *>(indexBuffer)->setVertexArray(m_rendererID);
         bind();
         m_indexBuffer->bind();
     }
@@ -250,6 +325,10 @@ namespace OxyRender
             {
                 return std::make_unique<OpenGLIndexBuffer>(usage);
             }
+            else if (type == BufferType::Uniform)
+            {
+                return std::make_unique<OpenGLUniformBuffer>(usage);
+            }
         }
         throw std::runtime_error("Unsupported backend or buffer type");
     }
@@ -269,6 +348,12 @@ namespace OxyRender
     {
         m_buffer->setData(data, size, offset);
     }
+    void Buffer::bindBase(uint32_t binding)
+    {
+        if (m_type != BufferType::Uniform)
+            throw std::runtime_error("bindBase: Buffer is not a UniformBuffer");
+        static_cast<OpenGLUniformBuffer *>(m_buffer.get())->bindBase(binding);
+    }
     std::unique_ptr<IVertexArray> VertexArrayFactory::create()
     {
         if (Backends::OXYG_CurrentBackend == RendererBackend::OpenGL)
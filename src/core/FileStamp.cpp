@@ -0,0 +1,68 @@
+#include "FileStamp.h"
+#include "OxygenRender/MappedFile.h"
+#include <filesystem>
+#include <fstream>
+
+namespace OxyRender
+{
+    namespace FileStamp
+    {
+        bool stat(const std::string &path, uint64_t &size, int64_t &mtime)
+        {
+            std::error_code ec;
+            size = std::filesystem::file_size(path, ec);
+            if (ec)
+                return false;
+            auto time = std::filesystem::last_write_time(path, ec);
+            if (ec)
+                return false;
+            mtime = static_cast<int64_t>(time.time_since_epoch().count());
+            return true;
+        }
+
+        uint64_t hash(const std::string &path)
+        {
+            MappedFile file(path);
+            uint64_t hash = 14695981039346656037ull;
+            for (size_t i = 0; i < file.size(); ++i)
+            {
+                hash ^= file.data()[i];
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        Stamp make(const std::string &path)
+        {
+            Stamp stamp;
+            if (stat(path, stamp.size, stamp.mtime))
+                stamp.hash = hash(path);
+            else
+                stamp = Stamp{};
+            return stamp;
+        }
+
+        Result check(const std::string &path, const Stamp &recorded, int64_t &currentMtime)
+        {
+            const bool recordedExists = recorded.size != 0 || recorded.mtime != 0;
+            uint64_t size = 0;
+            if (!stat(path, size, currentMtime))
+                return recordedExists ? Result::Missing : Result::Match;
+            if (!recordedExists || size != recorded.size)
+                return Result::Changed;
+            if (currentMtime == recorded.mtime)
+                return Result::Match;
+            return hash(path) == recorded.hash ? Result::Touched : Result::Changed;
+        }
+
+        bool patch(const std::string &path, uint64_t offset, const void *data, size_t size)
+        {
+            std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+            if (!file)
+                return false;
+            file.seekp(static_cast<std::streamoff>(offset));
+            file.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+            return static_cast<bool>(file);
+        }
+    }
+}
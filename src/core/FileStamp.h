@@ -0,0 +1,38 @@
+#pragma once
+// 缓存文件对源文件的校验（内部头文件），.oxmesh 与 .oxtex 共用
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace OxyRender
+{
+    namespace FileStamp
+    {
+        // 文件大小 + 修改时间 + 内容 FNV-1a 哈希；记录时文件不存在则三者都为 0
+        struct Stamp
+        {
+            uint64_t size = 0;
+            int64_t mtime = 0;
+            uint64_t hash = 0;
+        };
+
+        enum class Result
+        {
+            Match,   // 大小与修改时间一致（或记录时与现在都不存在）
+            Touched, // 修改时间不同但内容一致（touch、重新检出），应写回新的修改时间
+            Changed, // 内容已变化或存在性改变
+            Missing  // 记录时存在、现在不存在
+        };
+
+        // 文件不存在时返回 false
+        bool stat(const std::string &path, uint64_t &size, int64_t &mtime);
+        uint64_t hash(const std::string &path);
+        Stamp make(const std::string &path);
+
+        // 只有修改时间不同时才计算哈希；返回 Touched 时 currentMtime 为文件当前的修改时间
+        Result check(const std::string &path, const Stamp &recorded, int64_t &currentMtime);
+
+        // 原地覆写文件中的一段（不改变文件大小），失败返回 false（如只读安装目录），不影响正确性
+        bool patch(const std::string &path, uint64_t offset, const void *data, size_t size);
+    }
+}
@@ -0,0 +1,69 @@
+#include "OxygenRender/FrameUniforms.h"
+#include "OxygenRender/Camera.h"
+#include <algorithm>
+
+namespace OxyRender
+{
+    FrameUniforms::FrameUniforms()
+        : m_buffer(BufferType::Uniform, BufferUsage::DynamicDraw)
+    {
+    }
+
+    void FrameUniforms::setCamera(const glm::mat4 &view, const glm::mat4 &projection)
+    {
+        m_data.view = view;
+        m_data.projection = projection;
+        m_data.viewProjection = projection * view;
+        m_data.cameraPos = glm::vec4(glm::vec3(glm::inverse(view)[3]), 1.0f);
+        m_dirty = true;
+    }
+
+    void FrameUniforms::setCamera(const Camera &camera, int screenWidth, int screenHeight)
+    {
+        setCamera(camera.getViewMatrix(), camera.getPerspectiveProjectionMatrix(screenWidth, screenHeight));
+        m_data.cameraPos = glm::vec4(camera.getPosition(), 1.0f);
+    }
+
+    void FrameUniforms::setTime(float totalTime, float deltaTime)
+    {
+        m_data.time = glm::vec4(totalTime, deltaTime, 0.0f, 0.0f);
+        m_dirty = true;
+    }
+
+    void FrameUniforms::setLight(int index, const FrameLight &light)
+    {
+        if (index < 0 || index >= FrameData::kMaxLights)
+            return;
+        m_data.lights[index] = light;
+        m_dirty = true;
+    }
+
+    void FrameUniforms::setLight(int index, const glm::vec3 &position, const glm::vec3 &ambient,
+                                 const glm::vec3 &diffuse, const glm::vec3 &specular)
+    {
+        FrameLight light;
+        light.position = glm::vec4(position, 1.0f);
+        light.ambient = glm::vec4(ambient, 0.0f);
+        light.diffuse = glm::vec4(diffuse, 0.0f);
+        light.specular = glm::vec4(specular, 0.0f);
+        setLight(index, light);
+    }
+
+    void FrameUniforms::setLightCount(int count)
+    {
+        m_data.lightCount.x = std::clamp(count, 0, FrameData::kMaxLights);
+        m_dirty = true;
+    }
+
+    void FrameUniforms::bind()
+    {
+        if (m_dirty)
+        {
+            m_buffer.setData(&m_data, sizeof(m_data));
+            m_dirty = false;
+            ++m_uploads;
+        }
+        // 其他代码可能占用同一绑定点，每次重新绑定（开销很小）
+        m_buffer.bindBase(kBindingPoint);
+    }
+}
@@ -0,0 +1,87 @@
+#include "OxygenRender/GLContext.h"
+#include "OxygenRender/GLStateCache.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cstring>
+
+namespace OxyRender
+{
+    GLContext &GLContext::getInstance()
+    {
+        static GLContext instance;
+        return instance;
+    }
+
+    void GLContext::created(const void *handle, ProcLoader loader)
+    {
+        m_contexts.push_back({handle, loader, m_nextId++});
+        switchTo(&m_contexts.back());
+    }
+
+    void GLContext::madeCurrent(const void *handle)
+    {
+        if (!handle || handle == m_current)
+            return;
+        for (const auto &record : m_contexts)
+            if (record.handle == handle)
+            {
+                switchTo(&record);
+                return;
+            }
+    }
+
+    void GLContext::destroying(const void *handle)
+    {
+        madeCurrent(handle);
+        auto it = std::find_if(m_contexts.begin(), m_contexts.end(), [handle](const Record &record)
+                               { return record.handle == handle; });
+        if (it == m_contexts.end())
+            return;
+        // 逆序执行：后登记的缓存可能引用先登记的
+        for (auto callback = m_teardown.rbegin(); callback != m_teardown.rend(); ++callback)
+            (*callback)(it->id);
+        m_contexts.erase(it);
+        switchTo(nullptr);
+    }
+
+    void GLContext::switchTo(const Record *record)
+    {
+        m_current = record ? record->handle : nullptr;
+        m_loader = record ? record->loader : nullptr;
+        m_currentId.store(record ? record->id : 0, std::memory_order_release);
+        ++m_generation;
+        // 换了上下文，之前记录的 GL 状态属于别的上下文
+        GLStateCache::getInstance().invalidate();
+    }
+
+    void GLContext::addTeardownCallback(std::function<void(uint64_t context)> callback)
+    {
+        m_teardown.push_back(std::move(callback));
+    }
+
+    void *GLContext::getProcAddress(const char *name) const
+    {
+        return m_loader ? m_loader(name) : nullptr;
+    }
+
+    bool GLContext::hasExtension(const char *name) const
+    {
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; ++i)
+        {
+            const char *extension = reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+            if (extension && std::strcmp(extension, name) == 0)
+                return true;
+        }
+        return false;
+    }
+
+    bool GLContext::hasVersion(int major, int minor) const
+    {
+        GLint contextMajor = 0, contextMinor = 0;
+        glGetIntegerv(GL_MAJOR_VERSION, &contextMajor);
+        glGetIntegerv(GL_MINOR_VERSION, &contextMinor);
+        return contextMajor > major || (contextMajor == major && contextMinor >= minor);
+    }
+}
@@ -0,0 +1,329 @@
+#include "OxygenRender/GLStateCache.h"
+
+namespace OxyRender
+{
+    namespace
+    {
+        constexpr GLenum kCaps[] = {GL_DEPTH_TEST, GL_BLEND, GL_CULL_FACE, GL_STENCIL_TEST, GL_MULTISAMPLE, GL_PROGRAM_POINT_SIZE};
+        constexpr GLenum kBufferTargets[] = {GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER, GL_UNIFORM_BUFFER, GL_PIXEL_UNPACK_BUFFER};
+    }
+
+    GLStateCache &GLStateCache::getInstance()
+    {
+        static GLStateCache instance;
+        return instance;
+    }
+
+    GLStateCache::GLStateCache()
+    {
+        invalidate();
+    }
+
+    void GLStateCache::invalidate()
+    {
+        ++m_epoch;
+        m_program = kUnknown;
+        m_vao = kUnknown;
+        for (auto &buffer : m_buffers)
+            buffer = kUnknown;
+        for (auto &binding : m_uniformBindings)
+            binding = kUnknown;
+        m_activeUnit = kUnknown;
+        for (auto &unit : m_textures)
+            unit[0] = unit[1] = kUnknown;
+        for (auto &cap : m_caps)
+            cap = -1;
+        m_blendSrc = m_blendDst = kUnknown;
+        m_depthFunc = kUnknown;
+        m_depthMask = -1;
+        m_stencilFunc = kUnknown;
+        m_stencilRef = 0;
+        m_stencilMask = 0;
+        m_stencilOps[0] = m_stencilOps[1] = m_stencilOps[2] = kUnknown;
+        m_cullFace = kUnknown;
+        m_lineWidth = -1.0f;
+        m_polygonMode = kUnknown;
+    }
+
+    bool GLStateCache::change(bool differs)
+    {
+        if (differs)
+            ++m_frame.issued;
+        else
+            ++m_frame.skipped;
+        return differs;
+    }
+
+    int GLStateCache::bufferSlot(GLenum target) const noexcept
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            if (kBufferTargets[i] == target)
+                return i;
+        }
+        return -1;
+    }
+
+    int GLStateCache::textureTarget(GLenum target) const noexcept
+    {
+        if (target == GL_TEXTURE_2D)
+            return 0;
+        if (target == GL_TEXTURE_CUBE_MAP)
+            return 1;
+        return -1;
+    }
+
+    int GLStateCache::capSlot(GLenum cap) const noexcept
+    {
+        for (int i = 0; i < kCapCount; ++i)
+        {
+            if (kCaps[i] == cap)
+                return i;
+        }
+        return -1;
+    }
+
+    void GLStateCache::useProgram(GLuint program)
+    {
+        if (change(m_program != program))
+        {
+            glUseProgram(program);
+            m_program = program;
+        }
+    }
+
+    void GLStateCache::bindVertexArray(GLuint vao)
+    {
+        if (change(m_vao != vao))
+        {
+            glBindVertexArray(vao);
+            m_vao = vao;
+            m_buffers[1] = kUnknown;
+        }
+    }
+
+    void GLStateCache::bindBuffer(GLenum target, GLuint buffer)
+    {
+        int slot = bufferSlot(target);
+        if (slot < 0)
+        {
+            ++m_frame.issued;
+            glBindBuffer(target, buffer);
+            return;
+        }
+        if (change(m_buffers[slot] != buffer))
+        {
+            glBindBuffer(target, buffer);
+            m_buffers[slot] = buffer;
+        }
+    }
+
+    void GLStateCache::bindBufferBase(GLenum target, GLuint index, GLuint buffer)
+    {
+        if (target != GL_UNIFORM_BUFFER || index >= kMaxUniformBindings)
+        {
+            ++m_frame.issued;
+            glBindBufferBase(target, index, buffer);
+            if (target == GL_UNIFORM_BUFFER)
+                m_buffers[2] = buffer;
+            return;
+        }
+        if (change(m_uniformBindings[index] != buffer))
+        {
+            // 同时改变通用绑定点
+            glBindBufferBase(target, index, buffer);
+            m_uniformBindings[index] = buffer;
+            m_buffers[2] = buffer;
+        }
+    }
+
+    void GLStateCache::activeTexture(uint32_t unit)
+    {
+        if (change(m_activeUnit != unit))
+        {
+            glActiveTexture(GL_TEXTURE0 + unit);
+            m_activeUnit = unit;
+        }
+    }
+
+    void GLStateCache::bindTexture(GLenum target, GLuint texture)
+    {
+        int slot = textureTarget(target);
+        if (slot < 0 || m_activeUnit >= kMaxTextureUnits)
+        {
+            // 未缓存的目标直接调用；活动单元未知时无法确定改动了哪个单元，清除该目标的全部记录
+            ++m_frame.issued;
+            glBindTexture(target, texture);
+            if (slot >= 0)
+            {
+                for (auto &unit : m_textures)
+                    unit[slot] = kUnknown;
+            }
+            return;
+        }
+        if (change(m_textures[m_activeUnit][slot] != texture))
+        {
+            glBindTexture(target, texture);
+            m_textures[m_activeUnit][slot] = texture;
+        }
+    }
+
+    void GLStateCache::bindTexture(GLenum target, GLuint texture, uint32_t unit)
+    {
+        activeTexture(unit);
+        bindTexture(target, texture);
+    }
+
+    void GLStateCache::setEnabled(GLenum cap, bool enable)
+    {
+        int slot = capSlot(cap);
+        if (slot < 0)
+        {
+            ++m_frame.issued;
+            if (enable)
+                glEnable(cap);
+            else
+                glDisable(cap);
+            return;
+        }
+        if (change(m_caps[slot] != static_cast<int8_t>(enable)))
+        {
+            if (enable)
+                glEnable(cap);
+            else
+                glDisable(cap);
+            m_caps[slot] = static_cast<int8_t>(enable);
+        }
+    }
+
+    void GLStateCache::blendFunc(GLenum sfactor, GLenum dfactor)
+    {
+        if (change(m_blendSrc != sfactor || m_blendDst != dfactor))
+        {
+            glBlendFunc(sfactor, dfactor);
+            m_blendSrc = sfactor;
+            m_blendDst = dfactor;
+        }
+    }
+
+    void GLStateCache::depthFunc(GLenum func)
+    {
+        if (change(m_depthFunc != func))
+        {
+            glDepthFunc(func);
+            m_depthFunc = func;
+        }
+    }
+
+    void GLStateCache::depthMask(bool enable)
+    {
+        if (change(m_depthMask != static_cast<int8_t>(enable)))
+        {
+            glDepthMask(enable ? GL_TRUE : GL_FALSE);
+            m_depthMask = static_cast<int8_t>(enable);
+        }
+    }
+
+    void GLStateCache::stencilFunc(GLenum func, GLint ref, GLuint mask)
+    {
+        if (change(m_stencilFunc != func || m_stencilRef != ref || m_stencilMask != mask))
+        {
+            glStencilFunc(func, ref, mask);
+            m_stencilFunc = func;
+            m_stencilRef = ref;
+            m_stencilMask = mask;
+        }
+    }
+
+    void GLStateCache::stencilOp(GLenum sfail, GLenum dpfail, GLenum dppass)
+    {
+        if (change(m_stencilOps[0] != sfail || m_stencilOps[1] != dpfail || m_stencilOps[2] != dppass))
+        {
+            glStencilOp(sfail, dpfail, dppass);
+            m_stencilOps[0] = sfail;
+            m_stencilOps[1] = dpfail;
+            m_stencilOps[2] = dppass;
+        }
+    }
+
+    void GLStateCache::cullFace(GLenum mode)
+    {
+        if (change(m_cullFace != mode))
+        {
+            glCullFace(mode);
+            m_cullFace = mode;
+        }
+    }
+
+    void GLStateCache::lineWidth(float width)
+    {
+        if (change(m_lineWidth != width))
+        {
+            glLineWidth(width);
+            m_lineWidth = width;
+        }
+    }
+
+    void GLStateCache::polygonMode(GLenum mode)
+    {
+        if (change(m_polygonMode != mode))
+        {
+            glPolygonMode(GL_FRONT_AND_BACK, mode);
+            m_polygonMode = mode;
+        }
+    }
+
+    void GLStateCache::deleteProgram(GLuint program)
+    {
+        glDeleteProgram(program);
+        // 正在使用的程序删除后仍保持使用，直到切换
+        if (m_program == program)
+            m_program = kUnknown;
+    }
+
+    void GLStateCache::deleteVertexArray(GLuint vao)
+    {
+        glDeleteVertexArrays(1, &vao);
+        if (m_vao == vao)
+        {
+            m_vao = 0;
+            m_buffers[1] = kUnknown;
+        }
+    }
+
+    void GLStateCache::deleteBuffer(GLuint buffer)
+    {
+        glDeleteBuffers(1, &buffer);
+        for (auto &bound : m_buffers)
+        {
+            if (bound == buffer)
+                bound = 0;
+        }
+        for (auto &binding : m_uniformBindings)
+        {
+            if (binding == buffer)
+                binding = 0;
+        }
+    }
+
+    void GLStateCache::deleteTexture(GLuint texture)
+    {
+        glDeleteTextures(1, &texture);
+        for (auto &unit : m_textures)
+        {
+            for (auto &bound : unit)
+            {
+                if (bound == texture)
+                    bound = 0;
+            }
+        }
+    }
+
+    void GLStateCache::beginFrame()
+    {
+        m_total.issued += m_frame.issued;
+        m_total.skipped += m_frame.skipped;
+        m_lastFrame = m_frame;
+        m_frame = RenderStateStats();
+    }
+}
@@ -0,0 +1,342 @@
+#include <glad/glad.h>
+#include "OxygenRender/Window.h"
+#include "OxygenRender/GLContext.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#ifndef _WIN32
+#include <dlfcn.h>
+#endif
+
+namespace OxyRender
+{
+    namespace
+    {
+        // 只声明用到的 EGL 类型与常量，libEGL 在运行时加载，构建时不依赖 EGL 头文件与库
+        using EGLDisplay = void *;
+        using EGLConfig = void *;
+        using EGLContext = void *;
+        using EGLSurface = void *;
+        using EGLint = int32_t;
+        using EGLBoolean = unsigned int;
+        using EGLenum = unsigned int;
+
+        constexpr EGLint kEglNone = 0x3038;
+        constexpr EGLint kEglExtensions = 0x3055;
+        constexpr EGLint kEglSurfaceType = 0x3033;
+        constexpr EGLint kEglPbufferBit = 0x0001;
+        constexpr EGLint kEglRenderableType = 0x3040;
+        constexpr EGLint kEglOpenGLBit = 0x0008;
+        constexpr EGLint kEglRedSize = 0x3024;
+        constexpr EGLint kEglGreenSize = 0x3023;
+        constexpr EGLint kEglBlueSize = 0x3022;
+        constexpr EGLint kEglAlphaSize = 0x3021;
+        constexpr EGLint kEglWidth = 0x3057;
+        constexpr EGLint kEglHeight = 0x3056;
+        constexpr EGLenum kEglOpenGLAPI = 0x30A2;
+        constexpr EGLint kEglContextMajorVersion = 0x3098;
+        constexpr EGLint kEglContextMinorVersion = 0x30FB;
+        constexpr EGLint kEglContextProfileMask = 0x30FD;
+        constexpr EGLint kEglContextCoreProfileBit = 0x0001;
+        constexpr EGLenum kEglPlatformSurfacelessMesa = 0x31DD;
+
+        bool hasExtension(const char *extensions, const char *name)
+        {
+            if (!extensions)
+                return false;
+            const size_t length = std::strlen(name);
+            for (const char *p = extensions; (p = std::strstr(p, name)) != nullptr; p += length)
+            {
+                if ((p == extensions || p[-1] == ' ') && (p[length] == ' ' || p[length] == '\0'))
+                    return true;
+            }
+            return false;
+        }
+
+        double steadySeconds()
+        {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+    }
+
+    struct HeadlessWindow::EGLState
+    {
+        void *library = nullptr;
+        EGLDisplay display = nullptr;
+        EGLContext context = nullptr;
+        EGLSurface surface = nullptr; // surfaceless 时为空
+
+        void *(*getProcAddress)(const char *) = nullptr;
+        EGLint (*getError)() = nullptr;
+        EGLDisplay (*getDisplay)(void *) = nullptr;
+        EGLDisplay (*getPlatformDisplay)(EGLenum, void *, const EGLint *) = nullptr;
+        EGLBoolean (*initialize)(EGLDisplay, EGLint *, EGLint *) = nullptr;
+        EGLBoolean (*terminate)(EGLDisplay) = nullptr;
+        const char *(*queryString)(EGLDisplay, EGLint) = nullptr;
+        EGLBoolean (*chooseConfig)(EGLDisplay, const EGLint *, EGLConfig *, EGLint, EGLint *) = nullptr;
+        EGLBoolean (*bindAPI)(EGLenum) = nullptr;
+        EGLContext (*createContext)(EGLDisplay, EGLConfig, EGLContext, const EGLint *) = nullptr;
+        EGLBoolean (*destroyContext)(EGLDisplay, EGLContext) = nullptr;
+        EGLSurface (*createPbufferSurface)(EGLDisplay, EGLConfig, const EGLint *) = nullptr;
+        EGLBoolean (*destroySurface)(EGLDisplay, EGLSurface) = nullptr;
+        EGLBoolean (*makeCurrent)(EGLDisplay, EGLSurface, EGLSurface, EGLContext) = nullptr;
+
+        ~EGLState()
+        {
+            if (display)
+            {
+                makeCurrent(display, nullptr, nullptr, nullptr);
+                if (surface)
+                    destroySurface(display, surface);
+                if (context)
+                    destroyContext(display, context);
+                terminate(display);
+            }
+#ifndef _WIN32
+            if (library)
+                dlclose(library);
+#endif
+        }
+
+        [[noreturn]] void fail(const char *what)
+        {
+            std::ostringstream message;
+            message << "Headless window: " << what;
+            if (getError)
+                message << " (EGL error 0x" << std::hex << getError() << ")";
+            std::cerr << message.str() << std::endl;
+            throw std::runtime_error(message.str());
+        }
+
+        template <typename T>
+        void load(T &function, const char *name)
+        {
+#ifndef _WIN32
+            function = reinterpret_cast<T>(dlsym(library, name));
+#endif
+            if (!function)
+                fail(name);
+        }
+
+        void open(int width, int height)
+        {
+#ifndef _WIN32
+            library = dlopen("libEGL.so.1", RTLD_NOW | RTLD_LOCAL);
+            if (!library)
+                library = dlopen("libEGL.so", RTLD_NOW | RTLD_LOCAL);
+#endif
+            if (!library)
+                fail("libEGL not found");
+
+            load(getProcAddress, "eglGetProcAddress");
+            load(getError, "eglGetError");
+            load(getDisplay, "eglGetDisplay");
+            load(initialize, "eglInitialize");
+            load(terminate, "eglTerminate");
+            load(queryString, "eglQueryString");
+            load(chooseConfig, "eglChooseConfig");
+            load(bindAPI, "eglBindAPI");
+            load(createContext, "eglCreateContext");
+            load(destroyContext, "eglDestroyContext");
+            load(createPbufferSurface, "eglCreatePbufferSurface");
+            load(destroySurface, "eglDestroySurface");
+            load(makeCurrent, "eglMakeCurrent");
+
+            // 优先 Mesa surfaceless 平台（不需要 X11 / Wayland / DRM 设备），失败时退回默认显示
+            const char *clientExtensions = queryString(nullptr, kEglExtensions);
+            if (hasExtension(clientExtensions, "EGL_MESA_platform_surfaceless") &&
+                hasExtension(clientExtensions, "EGL_EXT_platform_base"))
+            {
+                getPlatformDisplay = reinterpret_cast<decltype(getPlatformDisplay)>(getProcAddress("eglGetPlatformDisplayEXT"));
+                if (getPlatformDisplay)
+                {
+                    display = getPlatformDisplay(kEglPlatformSurfacelessMesa, nullptr, nullptr);
+                    if (display && !initialize(display, nullptr, nullptr))
+                        display = nullptr;
+                }
+            }
+            if (!display)
+            {
+                display = getDisplay(nullptr);
+                if (!display || !initialize(display, nullptr, nullptr))
+                {
+                    display = nullptr;
+                    fail("eglInitialize failed");
+                }
+            }
+
+            if (!bindAPI(kEglOpenGLAPI))
+                fail("OpenGL API not supported");
+
+            const EGLint configAttribs[] = {kEglSurfaceType, kEglPbufferBit,
+                                            kEglRenderableType, kEglOpenGLBit,
+                                            kEglRedSize, 8, kEglGreenSize, 8, kEglBlueSize, 8, kEglAlphaSize, 8,
+                                            kEglNone};
+            EGLConfig config = nullptr;
+            EGLint count = 0;
+            if (!chooseConfig(display, configAttribs, &config, 1, &count) || count == 0)
+            {
+                // 有的 surfaceless 实现不提供 pbuffer 配置，只渲染到 FBO 时不需要
+                if (!chooseConfig(display, configAttribs + 2, &config, 1, &count) || count == 0)
+                    fail("no suitable EGLConfig");
+            }
+
+            const EGLint contextAttribs[] = {kEglContextMajorVersion, 3,
+                                             kEglContextMinorVersion, 3,
+                                             kEglContextProfileMask, kEglContextCoreProfileBit,
+                                             kEglNone};
+            context = createContext(display, config, nullptr, contextAttribs);
+            if (!context)
+                fail("failed to create OpenGL 3.3 core context");
+
+            // 只渲染到 FBO，支持时不创建表面
+            if (!hasExtension(queryString(display, kEglExtensions), "EGL_KHR_surfaceless_context") ||
+                !makeCurrent(display, nullptr, nullptr, context))
+            {
+                const EGLint surfaceAttribs[] = {kEglWidth, width, kEglHeight, height, kEglNone};
+                surface = createPbufferSurface(display, config, surfaceAttribs);
+                if (!surface || !makeCurrent(display, surface, surface, context))
+                    fail("eglMakeCurrent failed");
+            }
+        }
+    };
+
+    HeadlessWindow::HeadlessWindow(int width, int height, std::string title, int samples)
+        : IWindow(width, height, std::move(title)), m_egl(std::make_unique<EGLState>()), m_startTime(steadySeconds())
+    {
+#ifdef _WIN32
+        m_egl->fail("EGL is not available on this platform");
+#endif
+        m_egl->open(width, height);
+        if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(m_egl->getProcAddress)))
+        {
+            std::cerr << "GLAD 初始化失败\n";
+            throw std::runtime_error("Failed to initialize GLAD");
+        }
+        GLContext::getInstance().created(m_egl->context, m_egl->getProcAddress);
+
+        GLint maxSamples = 0;
+        glGetIntegerv(GL_MAX_SAMPLES, &maxSamples);
+        m_samples = std::clamp(samples, 0, static_cast<int>(maxSamples));
+
+        auto createTarget = [width, height](GLuint &framebuffer, GLuint &color, GLuint *depth, int samples)
+        {
+            auto storage = [&](GLenum format)
+            {
+                if (samples > 0)
+                    glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, format, width, height);
+                else
+                    glRenderbufferStorage(GL_RENDERBUFFER, format, width, height);
+            };
+            glGenFramebuffers(1, &framebuffer);
+            glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+            glGenRenderbuffers(1, &color);
+            glBindRenderbuffer(GL_RENDERBUFFER, color);
+            storage(GL_RGBA8);
+            glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, color);
+            if (depth)
+            {
+                glGenRenderbuffers(1, depth);
+                glBindRenderbuffer(GL_RENDERBUFFER, *depth);
+                storage(GL_DEPTH24_STENCIL8);
+                glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, *depth);
+            }
+            if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+                throw std::runtime_error("Headless window: incomplete framebuffer");
+        };
+
+        // 多重采样时另建单采样的解析目标；渲染目标最后绑定，此后一直保持
+        if (m_samples > 0)
+            createTarget(m_resolveFramebuffer, m_resolveBuffer, nullptr, 0);
+        createTarget(m_framebuffer, m_colorBuffer, &m_depthBuffer, m_samples);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        glViewport(0, 0, width, height);
+    }
+
+    HeadlessWindow::~HeadlessWindow()
+    {
+        if (m_egl->context)
+        {
+            m_egl->makeCurrent(m_egl->display, m_egl->surface, m_egl->surface, m_egl->context);
+            GLContext::getInstance().destroying(m_egl->context);
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            GLuint framebuffers[] = {m_framebuffer, m_resolveFramebuffer};
+            GLuint renderbuffers[] = {m_colorBuffer, m_depthBuffer, m_resolveBuffer};
+            glDeleteFramebuffers(2, framebuffers);
+            glDeleteRenderbuffers(3, renderbuffers);
+        }
+    }
+
+    void HeadlessWindow::setViewport(int x, int y, int width, int height)
+    {
+        glViewport(x, y, width, height);
+    }
+
+    bool HeadlessWindow::shouldClose()
+    {
+        return m_shouldClose;
+    }
+
+    void HeadlessWindow::shutdown()
+    {
+        m_shouldClose = true;
+    }
+
+    void HeadlessWindow::swapBuffers()
+    {
+        ++m_frames;
+    }
+
+    void HeadlessWindow::pollEvents()
+    {
+    }
+
+    void HeadlessWindow::setCursorPos(float x, float y)
+    {
+    }
+
+    void HeadlessWindow::setCursorMode(CursorMode mode)
+    {
+    }
+
+    double HeadlessWindow::getTime()
+    {
+        return steadySeconds() - m_startTime;
+    }
+
+    void HeadlessWindow::waitEventsTimeout(double timeout)
+    {
+        // 没有事件可等，按超时休眠，保持 Timer 限帧的行为
+        if (timeout > 0.0)
+            std::this_thread::sleep_for(std::chrono::duration<double>(timeout));
+    }
+
+    void HeadlessWindow::makeContextCurrent(bool current)
+    {
+        if (current)
+        {
+            m_egl->makeCurrent(m_egl->display, m_egl->surface, m_egl->surface, m_egl->context);
+            GLContext::getInstance().madeCurrent(m_egl->context);
+        }
+        else
+            m_egl->makeCurrent(m_egl->display, nullptr, nullptr, nullptr);
+    }
+
+    ImageData HeadlessWindow::readPixels()
+    {
+        if (m_samples == 0)
+            return IWindow::readPixels();
+
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, m_framebuffer);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_resolveFramebuffer);
+        glBlitFramebuffer(0, 0, m_width, m_height, 0, 0, m_width, m_height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, m_resolveFramebuffer);
+        ImageData image = IWindow::readPixels();
+        glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+        return image;
+    }
+}
@@ -0,0 +1,379 @@
+#define STB_IMAGE_IMPLEMENTATION
+#include "OxygenRender/ImageDecoder.h"
+#include "OxygenRender/MappedFile.h"
+#include "OxygenRender/ThreadPool.h"
+#include <stb_image.h>
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iostream>
+
+namespace OxyRender
+{
+    namespace
+    {
+        const size_t kQoiHeaderSize = 14;
+        const unsigned char kQoiEnd[8] = {0, 0, 0, 0, 0, 0, 0, 1};
+
+        enum : unsigned char
+        {
+            QOI_OP_INDEX = 0x00,
+            QOI_OP_DIFF = 0x40,
+            QOI_OP_LUMA = 0x80,
+            QOI_OP_RUN = 0xC0,
+            QOI_OP_RGB = 0xFE,
+            QOI_OP_RGBA = 0xFF,
+            QOI_MASK = 0xC0
+        };
+
+        inline uint32_t readBigEndian(const unsigned char *p)
+        {
+            return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+        }
+
+        inline void writeBigEndian(std::vector<unsigned char> &out, uint32_t v)
+        {
+            out.push_back(uint8_t(v >> 24));
+            out.push_back(uint8_t(v >> 16));
+            out.push_back(uint8_t(v >> 8));
+            out.push_back(uint8_t(v));
+        }
+
+        inline unsigned qoiHash(const unsigned char px[4])
+        {
+            return (px[0] * 3u + px[1] * 5u + px[2] * 7u + px[3] * 11u) % 64u;
+        }
+
+        std::shared_ptr<unsigned char> allocatePixels(size_t bytes)
+        {
+            return std::shared_ptr<unsigned char>(new unsigned char[bytes], std::default_delete<unsigned char[]>());
+        }
+    }
+
+    bool StbImageDecoder::canDecode(const unsigned char *data, size_t size) const noexcept
+    {
+        int width, height, channels;
+        return stbi_info_from_memory(data, static_cast<int>(size), &width, &height, &channels) != 0;
+    }
+
+    ImageData StbImageDecoder::decode(const unsigned char *data, size_t size) const
+    {
+        int width, height, channels;
+        stbi_set_flip_vertically_on_load_thread(0);
+        unsigned char *pixels = stbi_load_from_memory(data, static_cast<int>(size), &width, &height, &channels, 0);
+        if (!pixels)
+        {
+            throw std::runtime_error(std::string("Failed to decode texture: ") + stbi_failure_reason());
+        }
+
+        ImageData image;
+        image.pixels = std::shared_ptr<unsigned char>(pixels, stbi_image_free);
+        image.width = static_cast<uint32_t>(width);
+        image.height = static_cast<uint32_t>(height);
+        image.channels = static_cast<uint32_t>(channels);
+        return image;
+    }
+
+    bool QoiDecoder::canDecode(const unsigned char *data, size_t size) const noexcept
+    {
+        return size >= kQoiHeaderSize + sizeof(kQoiEnd) && std::memcmp(data, "qoif", 4) == 0;
+    }
+
+    ImageData QoiDecoder::decode(const unsigned char *data, size_t size) const
+    {
+        if (!canDecode(data, size))
+            throw std::runtime_error("QOI: invalid header");
+
+        const uint32_t width = readBigEndian(data + 4);
+        const uint32_t height = readBigEndian(data + 8);
+        const uint32_t channels = data[12];
+        if (width == 0 || height == 0 || (channels != 3 && channels != 4) || uint64_t(width) * height > 400000000ull)
+            throw std::runtime_error("QOI: invalid header");
+
+        const size_t pixelCount = size_t(width) * height;
+        ImageData image;
+        image.pixels = allocatePixels(pixelCount * channels);
+        image.width = width;
+        image.height = height;
+        image.channels = channels;
+
+        unsigned char index[64][4] = {};
+        unsigned char px[4] = {0, 0, 0, 255};
+        const unsigned char *p = data + kQoiHeaderSize;
+        const unsigned char *end = data + size - sizeof(kQoiEnd);
+        unsigned char *out = image.pixels.get();
+        unsigned run = 0;
+
+        for (size_t i = 0; i < pixelCount; ++i)
+        {
+            if (run > 0)
+            {
+                --run;
+            }
+            else if (p < end)
+            {
+                const unsigned char op = *p++;
+                if (op == QOI_OP_RGB)
+                {
+                    if (end - p < 3)
+                        throw std::runtime_error("QOI: truncated data");
+                    px[0] = p[0], px[1] = p[1], px[2] = p[2];
+                    p += 3;
+                }
+                else if (op == QOI_OP_RGBA)
+                {
+                    if (end - p < 4)
+                        throw std::runtime_error("QOI: truncated data");
+                    std::memcpy(px, p, 4);
+                    p += 4;
+                }
+                else
+                {
+                    switch (op & QOI_MASK)
+                    {
+                    case QOI_OP_INDEX:
+                        std::memcpy(px, index[op], 4);
+                        break;
+                    case QOI_OP_DIFF:
+                        px[0] = uint8_t(px[0] + ((op >> 4) & 3) - 2);
+                        px[1] = uint8_t(px[1] + ((op >> 2) & 3) - 2);
+                        px[2] = uint8_t(px[2] + (op & 3) - 2);
+                        break;
+                    case QOI_OP_LUMA:
+                    {
+                        if (p >= end)
+                            throw std::runtime_error("QOI: truncated data");
+                        const unsigned char next = *p++;
+                        const int dg = (op & 0x3F) - 32;
+                        px[0] = uint8_t(px[0] + dg - 8 + ((next >> 4) & 0x0F));
+                        px[1] = uint8_t(px[1] + dg);
+                        px[2] = uint8_t(px[2] + dg - 8 + (next & 0x0F));
+                        break;
+                    }
+                    default: // QOI_OP_RUN
+                        run = op & 0x3F;
+                        break;
+                    }
+                }
+                std::memcpy(index[qoiHash(px)], px, 4);
+            }
+            else
+            {
+                throw std::runtime_error("QOI: truncated data");
+            }
+
+            std::memcpy(out, px, channels);
+            out += channels;
+        }
+
+        if (out != image.pixels.get() + pixelCount * channels)
+            throw std::runtime_error("QOI: truncated data");
+        return image;
+    }
+
+    std::vector<unsigned char> QoiDecoder::encode(const ImageData &image)
+    {
+        if (!image.valid() || (image.channels != 3 && image.channels != 4))
+            throw std::runtime_error("QOI: only 3 or 4 channel images can be encoded");
+
+        const size_t pixelCount = size_t(image.width) * image.height;
+        const uint32_t channels = image.channels;
+        std::vector<unsigned char> out;
+        out.reserve(kQoiHeaderSize + pixelCount * (channels + 1) / 2 + sizeof(kQoiEnd));
+        out.insert(out.end(), {'q', 'o', 'i', 'f'});
+        writeBigEndian(out, image.width);
+        writeBigEndian(out, image.height);
+        out.push_back(uint8_t(channels));
+        out.push_back(0); // sRGB + 线性 alpha
+
+        unsigned char index[64][4] = {};
+        unsigned char prev[4] = {0, 0, 0, 255};
+        unsigned char px[4] = {0, 0, 0, 255};
+        unsigned run = 0;
+        const unsigned char *src = image.pixels.get();
+
+        for (size_t i = 0; i < pixelCount; ++i)
+        {
+            std::memcpy(px, src + i * channels, channels);
+            if (std::memcmp(px, prev, 4) == 0)
+            {
+                if (++run == 62 || i + 1 == pixelCount)
+                {
+                    out.push_back(uint8_t(QOI_OP_RUN | (run - 1)));
+                    run = 0;
+                }
+                continue;
+            }
+            if (run > 0)
+            {
+                out.push_back(uint8_t(QOI_OP_RUN | (run - 1)));
+                run = 0;
+            }
+
+            const unsigned hash = qoiHash(px);
+            if (std::memcmp(index[hash], px, 4) == 0)
+            {
+                out.push_back(uint8_t(QOI_OP_INDEX | hash));
+            }
+            else
+            {
+                std::memcpy(index[hash], px, 4);
+                if (px[3] == prev[3])
+                {
+                    const int dr = int8_t(px[0] - prev[0]);
+                    const int dg = int8_t(px[1] - prev[1]);
+                    const int db = int8_t(px[2] - prev[2]);
+                    const int drg = dr - dg, dbg = db - dg;
+                    if (dr > -3 && dr < 2 && dg > -3 && dg < 2 && db > -3 && db < 2)
+                    {
+                        out.push_back(uint8_t(QOI_OP_DIFF | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2)));
+                    }
+                    else if (drg > -9 && drg < 8 && dg > -33 && dg < 32 && dbg > -9 && dbg < 8)
+                    {
+                        out.push_back(uint8_t(QOI_OP_LUMA | (dg + 32)));
+                        out.push_back(uint8_t(((drg + 8) << 4) | (dbg + 8)));
+                    }
+                    else
+                    {
+                        out.insert(out.end(), {QOI_OP_RGB, px[0], px[1], px[2]});
+                    }
+                }
+                else
+                {
+                    out.insert(out.end(), {QOI_OP_RGBA, px[0], px[1], px[2], px[3]});
+                }
+            }
+            std::memcpy(prev, px, 4);
+        }
+        out.insert(out.end(), kQoiEnd, kQoiEnd + sizeof(kQoiEnd));
+        return out;
+    }
+
+    ImageDecoderRegistry &ImageDecoderRegistry::getInstance()
+    {
+        static ImageDecoderRegistry registry;
+        return registry;
+    }
+
+    ImageDecoderRegistry::ImageDecoderRegistry()
+        : m_fallback(std::make_shared<StbImageDecoder>())
+    {
+        m_decoders.push_back(std::make_shared<QoiDecoder>());
+    }
+
+    void ImageDecoderRegistry::registerDecoder(std::shared_ptr<IImageDecoder> decoder)
+    {
+        if (!decoder)
+            return;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_decoders.insert(m_decoders.begin(), std::move(decoder));
+    }
+
+    std::shared_ptr<IImageDecoder> ImageDecoderRegistry::findDecoder(const unsigned char *data, size_t size) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto &decoder : m_decoders)
+            if (decoder->canDecode(data, size))
+                return decoder;
+        return m_fallback;
+    }
+
+    ImageData ImageDecoderRegistry::decode(const unsigned char *data, size_t size, bool flipVertically,
+                                           bool expandChannels) const
+    {
+        return finalize(findDecoder(data, size)->decode(data, size), flipVertically, expandChannels);
+    }
+
+    ImageData ImageDecoderRegistry::decodeFile(const std::string &path, bool flipVertically, bool expandChannels) const
+    {
+        MappedFile file(path);
+        if (!file.isOpen())
+            throw std::runtime_error("Failed to load texture: " + path);
+        return decode(file.data(), file.size(), flipVertically, expandChannels);
+    }
+
+    std::vector<ImageData> ImageDecoderRegistry::decodeFiles(const std::vector<std::string> &paths, bool flipVertically) const
+    {
+        std::vector<ImageData> images(paths.size());
+        std::vector<std::string> errors(paths.size());
+        ThreadPool::getInstance().parallelFor(0, paths.size(), [&](size_t i)
+                                              {
+            try
+            {
+                images[i] = decodeFile(paths[i], flipVertically);
+            }
+            catch (const std::exception &e)
+            {
+                errors[i] = e.what();
+            } });
+
+        for (size_t i = 0; i < paths.size(); ++i)
+            if (!errors[i].empty())
+                std::cerr << "Image failed to decode at path: " << paths[i] << "\n"
+                          << errors[i] << std::endl;
+        return images;
+    }
+
+    ImageData ImageDecoderRegistry::finalize(ImageData image, bool flipVertically, bool expandChannels) const
+    {
+        // 上传路径只接受 3/4 通道，运行时把 1/2 通道扩展为 RGB/RGBA；离线工具保留原通道
+        const uint32_t srcChannels = image.channels;
+        const uint32_t dstChannels = !expandChannels ? srcChannels
+                                                     : (srcChannels == 1 ? 3 : (srcChannels == 2 ? 4 : srcChannels));
+        if (!flipVertically && srcChannels == dstChannels)
+            return image;
+
+        // 按行带分块，减少任务调度开销
+        auto forRows = [this, &image](size_t rows, const std::function<void(size_t, size_t)> &process)
+        {
+            if (size_t(image.width) * image.height < m_parallelRowThreshold)
+            {
+                process(0, rows);
+                return;
+            }
+            const size_t rowsPerBand = 64;
+            const size_t bands = (rows + rowsPerBand - 1) / rowsPerBand;
+            ThreadPool::getInstance().parallelFor(0, bands, [&](size_t band)
+                                                  { process(band * rowsPerBand, std::min<size_t>(rows, (band + 1) * rowsPerBand)); });
+        };
+
+        const size_t srcStride = size_t(image.width) * srcChannels;
+        if (srcChannels == dstChannels)
+        {
+            // 只需翻转：解码结果归本函数所有，原地交换上下对称的行
+            unsigned char *pixels = image.pixels.get();
+            forRows(image.height / 2, [&](size_t begin, size_t end)
+                    {
+                for (size_t y = begin; y < end; ++y)
+                    std::swap_ranges(pixels + y * srcStride, pixels + (y + 1) * srcStride,
+                                     pixels + (image.height - 1 - y) * srcStride); });
+            return image;
+        }
+
+        ImageData result;
+        result.width = image.width;
+        result.height = image.height;
+        result.channels = dstChannels;
+        result.pixels = allocatePixels(size_t(image.width) * image.height * dstChannels);
+
+        const size_t dstStride = size_t(image.width) * dstChannels;
+        const unsigned char *src = image.pixels.get();
+        unsigned char *dst = result.pixels.get();
+        forRows(image.height, [&](size_t begin, size_t end)
+                {
+            for (size_t y = begin; y < end; ++y)
+            {
+                const unsigned char *srcRow = src + (flipVertically ? image.height - 1 - y : y) * srcStride;
+                unsigned char *dstRow = dst + y * dstStride;
+                for (uint32_t x = 0; x < image.width; ++x)
+                {
+                    const unsigned char *s = srcRow + x * srcChannels;
+                    unsigned char *d = dstRow + x * dstChannels;
+                    d[0] = d[1] = d[2] = s[0];
+                    if (srcChannels == 2)
+                        d[3] = s[1];
+                }
+            } });
+        return result;
+    }
+}
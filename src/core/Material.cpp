@@ -0,0 +1,71 @@
+#include "OxygenRender/Material.h"
+#include "OxygenRender/Mesh.h"
+#include <atomic>
+
+namespace OxyRender
+{
+    namespace
+    {
+        // 网格可能在导入线程上创建
+        uint32_t nextMaterialId()
+        {
+            static std::atomic<uint32_t> s_next{1};
+            return s_next.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    Material::Material() : m_id(nextMaterialId())
+    {
+    }
+
+    Material::Material(const std::vector<Texture> &textures) : m_id(nextMaterialId())
+    {
+        // 与 LearnOpenGL 约定一致：同类型纹理按出现顺序编号，纹理单元为槽位序号
+        unsigned int diffuseNr = 1;
+        unsigned int specularNr = 1;
+        unsigned int normalNr = 1;
+        unsigned int heightNr = 1;
+
+        m_slots.reserve(textures.size());
+        for (const auto &texture : textures)
+        {
+            std::string name = texture.type;
+            if (name == "texture_diffuse")
+            {
+                name += std::to_string(diffuseNr++);
+                m_features |= ShaderFeature::Textured;
+            }
+            else if (name == "texture_specular")
+            {
+                name += std::to_string(specularNr++);
+                m_features |= ShaderFeature::SpecularMap;
+            }
+            else if (name == "texture_normal")
+            {
+                name += std::to_string(normalNr++);
+                m_features |= ShaderFeature::NormalMap;
+            }
+            else if (name == "texture_height")
+                name += std::to_string(heightNr++);
+            UniformID id(name);
+            m_slots.push_back(Slot{std::move(name), id, texture.tex});
+        }
+    }
+
+    void Material::setTexture(size_t slot, std::shared_ptr<Texture2D> texture)
+    {
+        if (slot < m_slots.size())
+            m_slots[slot].texture = std::move(texture);
+    }
+
+    void Material::bind(Shader &shader)
+    {
+        for (size_t i = 0; i < m_slots.size(); ++i)
+        {
+            const uint32_t unit = static_cast<uint32_t>(i);
+            shader.setInt(m_slots[i].samplerID, static_cast<int>(unit));
+            if (m_slots[i].texture)
+                m_slots[i].texture->bind(unit);
+        }
+    }
+}
@@ -1,4 +1,7 @@
 #include "OxygenRender/Mesh.h"
+#include "OxygenRender/MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
 
 namespace OxyRender
 {
@@ -11,7 +14,34 @@ namespace OxyRender
           m_VBO(BufferType::Vertex, BufferUsage::StaticDraw),
           m_EBO(BufferType::Index, BufferUsage::StaticDraw)
     {
+        m_Material = Material(this->textures);
+        m_VertexData = this->vertices.data();
+        m_VertexCount = this->vertices.size();
+        m_IndexData = this->indices.data();
+        m_IndexCount = this->indices.size();
         setupMesh();
+        computeBounds();
+        computeUvDensity();
+    }
+
+    Mesh::Mesh(Renderer &renderer, std::shared_ptr<const void> source, const Vertex *vertexData, size_t vertexCount,
+               const unsigned int *indexData, size_t indexCount, std::vector<Texture> textures,
+               const glm::vec3 &boundsMin, const glm::vec3 &boundsMax)
+        : m_Renderer(renderer),
+          textures(std::move(textures)),
+          m_VBO(BufferType::Vertex, BufferUsage::StaticDraw),
+          m_EBO(BufferType::Index, BufferUsage::StaticDraw),
+          m_Source(std::move(source))
+    {
+        m_Material = Material(this->textures);
+        m_VertexData = vertexData;
+        m_VertexCount = vertexCount;
+        m_IndexData = indexData;
+        m_IndexCount = indexCount;
+        setupMesh();
+        m_BoundsCenter = (boundsMin + boundsMax) * 0.5f;
+        m_BoundsRadius = glm::length(boundsMax - boundsMin) * 0.5f;
+        computeUvDensity();
     }
 
     void Mesh::setupMesh()
@@ -25,43 +55,110 @@ namespace OxyRender
         layout.addAttribute("BoneIDs", 5, VertexAttribType::Int4);
         layout.addAttribute("Weights", 6, VertexAttribType::Float4);
 
-        m_VBO.setData(vertices.data(), vertices.size() * sizeof(Vertex));
-        m_EBO.setData(indices.data(), indices.size() * sizeof(unsigned int));
+        m_VBO.setData(m_VertexData, m_VertexCount * sizeof(Vertex));
+        m_EBO.setData(m_IndexData, m_IndexCount * sizeof(unsigned int));
 
         m_VAO.bind();
         m_VAO.setVertexBuffer(m_VBO, layout);
         m_VAO.setIndexBuffer(m_EBO);
         m_VAO.unbind();
+
+        m_Lods.assign(1, MeshLod{0, static_cast<uint32_t>(m_IndexCount), 0.0f});
     }
 
-    void Mesh::Draw(Shader &shader)
+    void Mesh::computeBounds()
     {
-        unsigned int diffuseNr = 1;
-        unsigned int specularNr = 1;
-        unsigned int normalNr = 1;
-        unsigned int heightNr = 1;
+        if (m_VertexCount == 0)
+            return;
+        glm::vec3 minP = m_VertexData[0].Position;
+        glm::vec3 maxP = m_VertexData[0].Position;
+        for (size_t i = 0; i < m_VertexCount; ++i)
+        {
+            minP = glm::min(minP, m_VertexData[i].Position);
+            maxP = glm::max(maxP, m_VertexData[i].Position);
+        }
+        m_BoundsCenter = (minP + maxP) * 0.5f;
+        m_BoundsRadius = 0.0f;
+        for (size_t i = 0; i < m_VertexCount; ++i)
+            m_BoundsRadius = std::max(m_BoundsRadius, glm::length(m_VertexData[i].Position - m_BoundsCenter));
+    }
+
+    void Mesh::setTexture(size_t index, std::shared_ptr<Texture2D> texture)
+    {
+        if (index >= textures.size())
+            return;
+        textures[index].tex = texture;
+        m_Material.setTexture(index, std::move(texture));
+    }
 
-        for (unsigned int i = 0; i < textures.size(); i++)
+    void Mesh::computeUvDensity()
+    {
+        // sqrt(UV 面积 / 几何面积)，退化三角形不参与
+        double uvArea = 0.0, area = 0.0;
+        for (size_t i = 0; i + 2 < m_IndexCount; i += 3)
         {
+            const Vertex &a = m_VertexData[m_IndexData[i]];
+            const Vertex &b = m_VertexData[m_IndexData[i + 1]];
+            const Vertex &c = m_VertexData[m_IndexData[i + 2]];
+            float triangleArea = glm::length(glm::cross(b.Position - a.Position, c.Position - a.Position));
+            glm::vec2 e1 = b.TexCoords - a.TexCoords, e2 = c.TexCoords - a.TexCoords;
+            float triangleUvArea = std::abs(e1.x * e2.y - e1.y * e2.x);
+            if (triangleArea <= 1e-12f || triangleUvArea <= 1e-12f)
+                continue;
+            area += triangleArea;
+            uvArea += triangleUvArea;
+        }
+        m_UvDensity = area > 0.0 ? static_cast<float>(std::sqrt(uvArea / area)) : 0.0f;
+    }
+
+    void Mesh::buildLods(const std::vector<float> &ratios)
+    {
+        if (m_IndexCount == 0 || m_VertexCount == 0)
+            return;
+        std::vector<unsigned int> combined(m_IndexData, m_IndexData + m_IndexCount);
+        m_Lods.assign(1, MeshLod{0, static_cast<uint32_t>(m_IndexCount), 0.0f});
+
+        for (float ratio : ratios)
+        {
+            size_t target = static_cast<size_t>(m_IndexCount * std::clamp(ratio, 0.0f, 1.0f)) / 3 * 3;
+            float error = 0.0f;
+            // 每级都从原网格简化，避免误差逐级累积
+            std::vector<unsigned int> lod = MeshOptimizer::simplify(
+                m_IndexData, m_IndexCount,
+                &m_VertexData[0].Position.x, m_VertexCount, sizeof(Vertex),
+                &m_VertexData[0].TexCoords.x, sizeof(Vertex),
+                target, &error);
+
+            // 简化受边界/接缝限制而无法继续减少时，不再生成更粗的级别
+            const MeshLod &prev = m_Lods.back();
+            if (lod.empty() || lod.size() >= prev.indexCount * 95 / 100)
+                break;
 
-            std::string number;
-            std::string name = textures[i].type;
-            if (name == "texture_diffuse")
-                number = std::to_string(diffuseNr++);
-            else if (name == "texture_specular")
-                number = std::to_string(specularNr++);
-            else if (name == "texture_normal")
-                number = std::to_string(normalNr++);
-            else if (name == "texture_height")
-                number = std::to_string(heightNr++);
-
-            shader.setUniformData(name + number, &i, sizeof(i));
-            
-            if (textures[i].tex)
-                textures[i].tex->bind(i);
+            m_Lods.push_back(MeshLod{static_cast<uint32_t>(combined.size()), static_cast<uint32_t>(lod.size()),
+                                     std::max(error, prev.error)});
+            combined.insert(combined.end(), lod.begin(), lod.end());
         }
 
-        m_Renderer.drawTriangles(m_VAO, indices.size());
+        m_VAO.bind();
+        m_EBO.setData(combined.data(), combined.size() * sizeof(unsigned int));
+        m_VAO.unbind();
+    }
+
+    const MeshLod *Mesh::getLod(int lod) const noexcept
+    {
+        if (m_Lods.empty())
+            return nullptr;
+        return &m_Lods[std::clamp(lod, 0, static_cast<int>(m_Lods.size()) - 1)];
+    }
+
+    void Mesh::Draw(Shader &shader, int lod)
+    {
+        m_Material.bind(shader);
+
+        const MeshLod *level = getLod(lod);
+        if (!level)
+            return;
+        m_Renderer.drawTriangles(m_VAO, level->indexCount, level->indexOffset);
     }
 
 } // namespace OxyRender
\ No newline at end of file
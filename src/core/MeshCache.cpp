@@ -0,0 +1,287 @@
+#include "OxygenRender/MeshCache.h"
+#include "FileStamp.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace OxyRender
+{
+    namespace
+    {
+        constexpr size_t kAlignment = 16;
+
+        inline uint64_t alignUp(uint64_t value)
+        {
+            return (value + kAlignment - 1) & ~uint64_t(kAlignment - 1);
+        }
+
+        uint32_t appendString(std::string &strings, const std::string &value)
+        {
+            uint32_t offset = static_cast<uint32_t>(strings.size());
+            strings += value;
+            return offset;
+        }
+    }
+
+    bool MeshCache::write(const std::string &cachePath, const std::string &sourcePath, const std::vector<Mesh> &meshes,
+                          const std::vector<std::string> &dependencies)
+    {
+        std::vector<CachedMesh> views(meshes.size());
+        for (size_t i = 0; i < meshes.size(); ++i)
+        {
+            views[i].vertices = meshes[i].getVertexData();
+            views[i].vertexCount = meshes[i].getVertexCount();
+            views[i].indices = meshes[i].getIndexData();
+            views[i].indexCount = meshes[i].getIndexCount();
+            for (const auto &tex : meshes[i].textures)
+                views[i].textures.emplace_back(tex.type, tex.path);
+        }
+        return write(cachePath, sourcePath, views, dependencies);
+    }
+
+    bool MeshCache::write(const std::string &cachePath, const std::string &sourcePath, const std::vector<CachedMesh> &meshes,
+                          const std::vector<std::string> &dependencies)
+    {
+        using namespace MeshCacheFormat;
+
+        Header header{};
+        header.magic = MAGIC;
+        header.version = VERSION;
+        header.vertexStride = sizeof(Vertex);
+        header.meshCount = static_cast<uint32_t>(meshes.size());
+        FileStamp::Stamp source = FileStamp::make(sourcePath);
+        if (source.size == 0 && source.mtime == 0)
+            return false;
+        header.sourceSize = source.size;
+        header.sourceMtime = source.mtime;
+        header.sourceHash = source.hash;
+
+        // 依赖文件去重；纹理不影响几何，其过期由 TextureCache / .oxtex 各自处理
+        std::vector<std::string> dependencyPaths;
+        for (const auto &path : dependencies)
+            if (path != sourcePath && std::find(dependencyPaths.begin(), dependencyPaths.end(), path) == dependencyPaths.end())
+                dependencyPaths.push_back(path);
+
+        std::vector<MeshEntry> entries(meshes.size());
+        std::vector<TextureRef> textures;
+        std::string strings;
+        for (size_t i = 0; i < meshes.size(); ++i)
+        {
+            const CachedMesh &mesh = meshes[i];
+            MeshEntry &entry = entries[i];
+            entry.vertexCount = static_cast<uint32_t>(mesh.vertexCount);
+            entry.indexCount = static_cast<uint32_t>(mesh.indexCount);
+
+            glm::vec3 minP(0.0f), maxP(0.0f);
+            if (entry.vertexCount > 0)
+            {
+                minP = maxP = mesh.vertices[0].Position;
+                for (size_t v = 0; v < entry.vertexCount; ++v)
+                {
+                    minP = glm::min(minP, mesh.vertices[v].Position);
+                    maxP = glm::max(maxP, mesh.vertices[v].Position);
+                }
+            }
+            std::memcpy(entry.boundsMin, &minP.x, sizeof(entry.boundsMin));
+            std::memcpy(entry.boundsMax, &maxP.x, sizeof(entry.boundsMax));
+
+            entry.firstTexture = static_cast<uint32_t>(textures.size());
+            entry.textureCount = static_cast<uint32_t>(mesh.textures.size());
+            for (const auto &tex : mesh.textures)
+            {
+                TextureRef ref{};
+                ref.typeOffset = appendString(strings, tex.first);
+                ref.typeLength = static_cast<uint32_t>(tex.first.size());
+                ref.pathOffset = appendString(strings, tex.second);
+                ref.pathLength = static_cast<uint32_t>(tex.second.size());
+                textures.push_back(ref);
+            }
+        }
+
+        std::vector<Dependency> dependencyEntries(dependencyPaths.size());
+        for (size_t i = 0; i < dependencyPaths.size(); ++i)
+        {
+            FileStamp::Stamp stamp = FileStamp::make(dependencyPaths[i]);
+            Dependency &entry = dependencyEntries[i];
+            entry.pathOffset = appendString(strings, dependencyPaths[i]);
+            entry.pathLength = static_cast<uint32_t>(dependencyPaths[i].size());
+            entry.size = stamp.size;
+            entry.mtime = stamp.mtime;
+            entry.hash = stamp.hash;
+        }
+        header.textureCount = static_cast<uint32_t>(textures.size());
+        header.dependencyCount = static_cast<uint32_t>(dependencyEntries.size());
+        header.stringBytes = static_cast<uint32_t>(strings.size());
+
+        // 计算数据区偏移
+        uint64_t offset = alignUp(sizeof(Header) + entries.size() * sizeof(MeshEntry) +
+                                  textures.size() * sizeof(TextureRef) +
+                                  dependencyEntries.size() * sizeof(Dependency) + strings.size());
+        for (size_t i = 0; i < meshes.size(); ++i)
+        {
+            entries[i].vertexOffset = offset;
+            offset = alignUp(offset + uint64_t(entries[i].vertexCount) * sizeof(Vertex));
+            entries[i].indexOffset = offset;
+            offset = alignUp(offset + uint64_t(entries[i].indexCount) * sizeof(unsigned int));
+        }
+
+        // 先写临时文件再改名，避免中途失败留下损坏的缓存
+        std::string tempPath = cachePath + ".tmp";
+        {
+            std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+            if (!out)
+            {
+                std::cerr << "MeshCache: cannot write " << tempPath << std::endl;
+                return false;
+            }
+
+            static const char zeros[kAlignment] = {};
+            auto pad = [&]()
+            {
+                uint64_t pos = static_cast<uint64_t>(out.tellp());
+                out.write(zeros, static_cast<std::streamsize>(alignUp(pos) - pos));
+            };
+
+            out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char *>(entries.data()), entries.size() * sizeof(MeshEntry));
+            out.write(reinterpret_cast<const char *>(textures.data()), textures.size() * sizeof(TextureRef));
+            out.write(reinterpret_cast<const char *>(dependencyEntries.data()), dependencyEntries.size() * sizeof(Dependency));
+            out.write(strings.data(), strings.size());
+            pad();
+            for (size_t i = 0; i < meshes.size(); ++i)
+            {
+                out.write(reinterpret_cast<const char *>(meshes[i].vertices), entries[i].vertexCount * sizeof(Vertex));
+                pad();
+                out.write(reinterpret_cast<const char *>(meshes[i].indices), entries[i].indexCount * sizeof(unsigned int));
+                pad();
+            }
+            if (!out)
+            {
+                std::cerr << "MeshCache: failed writing " << tempPath << std::endl;
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tempPath, cachePath, ec);
+        if (ec)
+        {
+            std::cerr << "MeshCache: cannot replace " << cachePath << ": " << ec.message() << std::endl;
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+        return true;
+    }
+
+    bool MeshCache::open(const std::string &cachePath, const std::string &sourcePath)
+    {
+        using namespace MeshCacheFormat;
+        close();
+
+        if (!m_file.open(cachePath))
+            return false;
+
+        const unsigned char *base = m_file.data();
+        const size_t fileSize = m_file.size();
+        auto fail = [this]()
+        {
+            close();
+            return false;
+        };
+
+        if (fileSize < sizeof(Header))
+            return fail();
+        Header header;
+        std::memcpy(&header, base, sizeof(header));
+        if (header.magic != MAGIC || header.version != VERSION || header.vertexStride != sizeof(Vertex))
+            return fail();
+
+        const size_t tableBytes = sizeof(Header) + size_t(header.meshCount) * sizeof(MeshEntry) +
+                                  size_t(header.textureCount) * sizeof(TextureRef) +
+                                  size_t(header.dependencyCount) * sizeof(Dependency) + header.stringBytes;
+        if (tableBytes > fileSize)
+            return fail();
+
+        const auto *entries = reinterpret_cast<const MeshEntry *>(base + sizeof(Header));
+        const auto *textures = reinterpret_cast<const TextureRef *>(entries + header.meshCount);
+        const auto *dependencies = reinterpret_cast<const Dependency *>(textures + header.textureCount);
+        const char *strings = reinterpret_cast<const char *>(dependencies + header.dependencyCount);
+
+        // 大小必须一致；修改时间不同时再比较内容哈希（如文件仅被 touch 或重新检出），
+        // 内容未变时记下新的修改时间，校验全部通过后写回
+        std::vector<std::pair<uint64_t, int64_t>> refreshed; // (文件内偏移, 新修改时间)
+        auto verify = [&](const std::string &path, uint64_t size, int64_t mtime, uint64_t hash, uint64_t mtimeOffset)
+        {
+            int64_t currentMtime = 0;
+            switch (FileStamp::check(path, FileStamp::Stamp{size, mtime, hash}, currentMtime))
+            {
+            case FileStamp::Result::Match:
+                return true;
+            case FileStamp::Result::Touched:
+                refreshed.emplace_back(mtimeOffset, currentMtime);
+                return true;
+            default:
+                return false;
+            }
+        };
+        if (!verify(sourcePath, header.sourceSize, header.sourceMtime, header.sourceHash, offsetof(Header, sourceMtime)))
+            return fail();
+        for (uint32_t i = 0; i < header.dependencyCount; ++i)
+        {
+            const Dependency &dependency = dependencies[i];
+            if (uint64_t(dependency.pathOffset) + dependency.pathLength > header.stringBytes)
+                return fail();
+            const uint64_t mtimeOffset = reinterpret_cast<const unsigned char *>(&dependency.mtime) - base;
+            if (!verify(std::string(strings + dependency.pathOffset, dependency.pathLength),
+                        dependency.size, dependency.mtime, dependency.hash, mtimeOffset))
+                return fail();
+        }
+
+        m_meshes.resize(header.meshCount);
+        for (uint32_t i = 0; i < header.meshCount; ++i)
+        {
+            // 截断或损坏的缓存不能引起越界读取：偏移须对齐且在文件内，索引须小于顶点数
+            const MeshEntry &entry = entries[i];
+            if (entry.vertexOffset % kAlignment != 0 || entry.indexOffset % kAlignment != 0 ||
+                entry.vertexOffset > fileSize || uint64_t(entry.vertexCount) * sizeof(Vertex) > fileSize - entry.vertexOffset ||
+                entry.indexOffset > fileSize || uint64_t(entry.indexCount) * sizeof(unsigned int) > fileSize - entry.indexOffset ||
+                uint64_t(entry.firstTexture) + entry.textureCount > header.textureCount)
+                return fail();
+            const auto *indices = reinterpret_cast<const unsigned int *>(base + entry.indexOffset);
+            if (std::any_of(indices, indices + entry.indexCount, [&](unsigned int index)
+                            { return index >= entry.vertexCount; }))
+                return fail();
+
+            CachedMesh &mesh = m_meshes[i];
+            mesh.vertices = reinterpret_cast<const Vertex *>(base + entry.vertexOffset);
+            mesh.vertexCount = entry.vertexCount;
+            mesh.indices = indices;
+            mesh.indexCount = entry.indexCount;
+            mesh.boundsMin = glm::vec3(entry.boundsMin[0], entry.boundsMin[1], entry.boundsMin[2]);
+            mesh.boundsMax = glm::vec3(entry.boundsMax[0], entry.boundsMax[1], entry.boundsMax[2]);
+
+            for (uint32_t t = 0; t < entry.textureCount; ++t)
+            {
+                const TextureRef &ref = textures[entry.firstTexture + t];
+                if (uint64_t(ref.typeOffset) + ref.typeLength > header.stringBytes ||
+                    uint64_t(ref.pathOffset) + ref.pathLength > header.stringBytes)
+                    return fail();
+                mesh.textures.emplace_back(std::string(strings + ref.typeOffset, ref.typeLength),
+                                           std::string(strings + ref.pathOffset, ref.pathLength));
+            }
+        }
+
+        for (const auto &[offset, mtime] : refreshed)
+            FileStamp::patch(cachePath, offset, &mtime, sizeof(mtime));
+        return true;
+    }
+
+    void MeshCache::close()
+    {
+        m_meshes.clear();
+        m_file.close();
+    }
+}
@@ -0,0 +1,687 @@
+#include "OxygenRender/MeshOptimizer.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+
+namespace OxyRender
+{
+    namespace MeshOptimizer
+    {
+        namespace
+        {
+            inline const float *attrib(const float *base, size_t stride, size_t index)
+            {
+                return reinterpret_cast<const float *>(reinterpret_cast<const char *>(base) + index * stride);
+            }
+
+            inline uint64_t edgeKey(unsigned int a, unsigned int b)
+            {
+                if (a > b)
+                    std::swap(a, b);
+                return (uint64_t(a) << 32) | uint64_t(b);
+            }
+
+            inline void cross(const float *a, const float *b, const float *c, double n[3])
+            {
+                double e1[3] = {double(b[0]) - a[0], double(b[1]) - a[1], double(b[2]) - a[2]};
+                double e2[3] = {double(c[0]) - a[0], double(c[1]) - a[1], double(c[2]) - a[2]};
+                n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+                n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+                n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+            }
+
+            // 对称 4x4 误差矩阵，w 为累计权重，评估结果为加权平均的平方距离
+            struct Quadric
+            {
+                double a00 = 0, a01 = 0, a02 = 0, a11 = 0, a12 = 0, a22 = 0;
+                double b0 = 0, b1 = 0, b2 = 0, c = 0, w = 0;
+
+                void addPlane(double nx, double ny, double nz, double d, double weight)
+                {
+                    a00 += weight * nx * nx;
+                    a01 += weight * nx * ny;
+                    a02 += weight * nx * nz;
+                    a11 += weight * ny * ny;
+                    a12 += weight * ny * nz;
+                    a22 += weight * nz * nz;
+                    b0 += weight * nx * d;
+                    b1 += weight * ny * d;
+                    b2 += weight * nz * d;
+                    c += weight * d * d;
+                    w += weight;
+                }
+
+                Quadric &operator+=(const Quadric &o)
+                {
+                    a00 += o.a00, a01 += o.a01, a02 += o.a02, a11 += o.a11, a12 += o.a12, a22 += o.a22;
+                    b0 += o.b0, b1 += o.b1, b2 += o.b2, c += o.c, w += o.w;
+                    return *this;
+                }
+
+                double evaluate(const float *p) const
+                {
+                    const double x = p[0], y = p[1], z = p[2];
+                    double r = a00 * x * x + a11 * y * y + a22 * z * z +
+                               2.0 * (a01 * x * y + a02 * x * z + a12 * y * z) +
+                               2.0 * (b0 * x + b1 * y + b2 * z) + c;
+                    return w > 0.0 ? std::max(r, 0.0) / w : 0.0;
+                }
+            };
+
+            enum class VertexKind : uint8_t
+            {
+                Manifold,    // 内部顶点，可折叠到任意邻点
+                Constrained, // 位于边界或 UV 接缝上，只能沿该边界折叠
+                Locked       // 非流形或多条接缝交汇处，不参与折叠
+            };
+
+            struct EdgeInfo
+            {
+                unsigned int count = 0;
+                unsigned int w0 = 0, w1 = 0; // 首次出现时的顶点（按焊接编号排序）
+                bool seam = false;
+            };
+
+            struct Collapse
+            {
+                unsigned int from, to;
+                double cost;
+            };
+
+            constexpr double kBoundaryWeight = 10.0; // 边界/接缝约束平面的权重
+            constexpr int kMaxPasses = 100;
+        }
+
+        std::vector<unsigned int> simplify(const unsigned int *indices, size_t indexCount,
+                                           const float *positions, size_t vertexCount, size_t positionStride,
+                                           const float *texcoords, size_t texcoordStride,
+                                           size_t targetIndexCount, float *outError)
+        {
+            std::vector<unsigned int> tris(indices, indices + indexCount - indexCount % 3);
+            if (outError)
+                *outError = 0.0f;
+            if (tris.size() <= targetIndexCount || vertexCount == 0)
+                return tris;
+
+            auto pos = [&](unsigned int v)
+            { return attrib(positions, positionStride, v); };
+
+            // 按位置焊接：同一位置的多个顶点（UV/法线不同）视为同一拓扑顶点
+            struct PositionHash
+            {
+                size_t operator()(const std::array<uint32_t, 3> &k) const noexcept
+                {
+                    return size_t(k[0] * 73856093u ^ k[1] * 19349663u ^ k[2] * 83492791u);
+                }
+            };
+            std::vector<unsigned int> welded(vertexCount);
+            std::vector<unsigned int> wedgeNext(vertexCount);
+            {
+                std::unordered_map<std::array<uint32_t, 3>, unsigned int, PositionHash> lookup;
+                lookup.reserve(vertexCount);
+                for (unsigned int i = 0; i < vertexCount; ++i)
+                {
+                    std::array<uint32_t, 3> key;
+                    std::memcpy(key.data(), pos(i), sizeof(float) * 3);
+                    unsigned int canonical = lookup.emplace(key, i).first->second;
+                    welded[i] = canonical;
+                    // 同一位置的顶点串成环
+                    if (canonical == i)
+                    {
+                        wedgeNext[i] = i;
+                    }
+                    else
+                    {
+                        wedgeNext[i] = wedgeNext[canonical];
+                        wedgeNext[canonical] = i;
+                    }
+                }
+            }
+
+            auto classifyEdges = [&](std::unordered_map<uint64_t, EdgeInfo> &edges)
+            {
+                edges.clear();
+                edges.reserve(tris.size());
+                for (size_t t = 0; t < tris.size(); t += 3)
+                {
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        unsigned int wa = tris[t + k], wb = tris[t + (k + 1) % 3];
+                        unsigned int a = welded[wa], b = welded[wb];
+                        if (a > b)
+                        {
+                            std::swap(a, b);
+                            std::swap(wa, wb);
+                        }
+                        auto result = edges.try_emplace(edgeKey(a, b), EdgeInfo{0, wa, wb, false});
+                        EdgeInfo &e = result.first->second;
+                        ++e.count;
+                        if (!result.second && (e.w0 != wa || e.w1 != wb))
+                            e.seam = true;
+                    }
+                }
+            };
+
+            auto isConstrained = [](const EdgeInfo &e)
+            { return e.count == 1 || e.seam; };
+
+            // 初始误差矩阵：三角形平面（按面积加权）+ 边界/接缝约束平面
+            std::vector<Quadric> quadrics(vertexCount);
+            std::unordered_map<uint64_t, EdgeInfo> edges;
+            classifyEdges(edges);
+            for (size_t t = 0; t < tris.size(); t += 3)
+            {
+                const unsigned int v[3] = {welded[tris[t]], welded[tris[t + 1]], welded[tris[t + 2]]};
+                double n[3];
+                cross(pos(v[0]), pos(v[1]), pos(v[2]), n);
+                double len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                if (len < 1e-20)
+                    continue;
+                n[0] /= len, n[1] /= len, n[2] /= len;
+                const float *p0 = pos(v[0]);
+                double d = -(n[0] * p0[0] + n[1] * p0[1] + n[2] * p0[2]);
+                double area = 0.5 * len;
+
+                Quadric q;
+                q.addPlane(n[0], n[1], n[2], d, area);
+                for (int k = 0; k < 3; ++k)
+                    quadrics[v[k]] += q;
+
+                for (int k = 0; k < 3; ++k)
+                {
+                    unsigned int a = v[k], b = v[(k + 1) % 3];
+                    auto it = edges.find(edgeKey(a, b));
+                    if (it == edges.end() || !isConstrained(it->second))
+                        continue;
+                    // 过边且垂直于三角形的约束平面
+                    const float *pa = pos(a), *pb = pos(b);
+                    double e[3] = {double(pb[0]) - pa[0], double(pb[1]) - pa[1], double(pb[2]) - pa[2]};
+                    double en[3] = {e[1] * n[2] - e[2] * n[1], e[2] * n[0] - e[0] * n[2], e[0] * n[1] - e[1] * n[0]};
+                    double enLen = std::sqrt(en[0] * en[0] + en[1] * en[1] + en[2] * en[2]);
+                    if (enLen < 1e-20)
+                        continue;
+                    en[0] /= enLen, en[1] /= enLen, en[2] /= enLen;
+                    double ed = -(en[0] * pa[0] + en[1] * pa[1] + en[2] * pa[2]);
+                    double weight = kBoundaryWeight * (e[0] * e[0] + e[1] * e[1] + e[2] * e[2]);
+                    Quadric bq;
+                    bq.addPlane(en[0], en[1], en[2], ed, weight);
+                    quadrics[a] += bq;
+                    quadrics[b] += bq;
+                }
+            }
+
+            std::vector<unsigned int> remap(vertexCount);
+            for (unsigned int i = 0; i < vertexCount; ++i)
+                remap[i] = i;
+            std::vector<VertexKind> kinds(vertexCount);
+            std::vector<uint8_t> constrainedCount(vertexCount);
+            std::vector<uint8_t> marked(vertexCount);
+            std::vector<unsigned int> adjOffsets(vertexCount + 1);
+            std::vector<unsigned int> adjTris;
+            std::vector<Collapse> candidates;
+            double maxCost = 0.0;
+
+            for (int pass = 0; pass < kMaxPasses && tris.size() > targetIndexCount; ++pass)
+            {
+                if (pass > 0)
+                    classifyEdges(edges);
+
+                // 顶点分类
+                std::fill(kinds.begin(), kinds.end(), VertexKind::Manifold);
+                std::fill(constrainedCount.begin(), constrainedCount.end(), 0);
+                for (const auto &kv : edges)
+                {
+                    unsigned int a = unsigned(kv.first >> 32), b = unsigned(kv.first & 0xffffffffu);
+                    if (kv.second.count > 2)
+                    {
+                        kinds[a] = kinds[b] = VertexKind::Locked;
+                    }
+                    else if (isConstrained(kv.second))
+                    {
+                        constrainedCount[a] = uint8_t(std::min(constrainedCount[a] + 1, 255));
+                        constrainedCount[b] = uint8_t(std::min(constrainedCount[b] + 1, 255));
+                    }
+                }
+                for (size_t v = 0; v < vertexCount; ++v)
+                {
+                    if (kinds[v] == VertexKind::Locked || constrainedCount[v] == 0)
+                        continue;
+                    kinds[v] = constrainedCount[v] == 2 ? VertexKind::Constrained : VertexKind::Locked;
+                }
+
+                // 顶点 -> 三角形邻接表
+                std::fill(adjOffsets.begin(), adjOffsets.end(), 0);
+                for (unsigned int w : tris)
+                    ++adjOffsets[welded[w] + 1];
+                for (size_t v = 0; v < vertexCount; ++v)
+                    adjOffsets[v + 1] += adjOffsets[v];
+                adjTris.resize(tris.size());
+                {
+                    std::vector<unsigned int> cursor(adjOffsets.begin(), adjOffsets.end() - 1);
+                    for (size_t t = 0; t < tris.size(); t += 3)
+                        for (int k = 0; k < 3; ++k)
+                            adjTris[cursor[welded[tris[t + k]]]++] = unsigned(t / 3);
+                }
+
+                // 候选折叠：每条边取允许方向中误差较小的一个
+                candidates.clear();
+                for (const auto &kv : edges)
+                {
+                    if (kv.second.count > 2)
+                        continue;
+                    unsigned int a = unsigned(kv.first >> 32), b = unsigned(kv.first & 0xffffffffu);
+                    bool constrained = isConstrained(kv.second);
+                    auto allowed = [&](unsigned int v)
+                    {
+                        return kinds[v] == VertexKind::Manifold || (kinds[v] == VertexKind::Constrained && constrained);
+                    };
+
+                    Quadric q = quadrics[a];
+                    q += quadrics[b];
+                    double costAB = allowed(a) ? q.evaluate(pos(b)) : -1.0;
+                    double costBA = allowed(b) ? q.evaluate(pos(a)) : -1.0;
+                    if (costAB >= 0.0 && (costBA < 0.0 || costAB <= costBA))
+                        candidates.push_back({a, b, costAB});
+                    else if (costBA >= 0.0)
+                        candidates.push_back({b, a, costBA});
+                }
+                std::sort(candidates.begin(), candidates.end(),
+                          [](const Collapse &l, const Collapse &r)
+                          { return l.cost < r.cost; });
+
+                auto corner = [&](unsigned int t, int k)
+                { return remap[welded[tris[t * 3 + k]]]; };
+
+                // 折叠后三角形法线不能翻转
+                auto flips = [&](unsigned int from, unsigned int to)
+                {
+                    const float *target = pos(to);
+                    for (unsigned int i = adjOffsets[from]; i < adjOffsets[from + 1]; ++i)
+                    {
+                        unsigned int t = adjTris[i];
+                        unsigned int c[3] = {corner(t, 0), corner(t, 1), corner(t, 2)};
+                        if (c[0] == to || c[1] == to || c[2] == to)
+                            continue;
+                        const float *p[3] = {pos(c[0]), pos(c[1]), pos(c[2])};
+                        double before[3];
+                        cross(p[0], p[1], p[2], before);
+                        for (int k = 0; k < 3; ++k)
+                            if (c[k] == from)
+                                p[k] = target;
+                        double after[3];
+                        cross(p[0], p[1], p[2], after);
+                        if (before[0] * after[0] + before[1] * after[1] + before[2] * after[2] <= 0.0)
+                            return true;
+                    }
+                    return false;
+                };
+
+                std::fill(marked.begin(), marked.end(), 0);
+                size_t trianglesToRemove = (tris.size() - targetIndexCount) / 3;
+                size_t removed = 0;
+                size_t applied = 0;
+                for (const Collapse &c : candidates)
+                {
+                    if (removed >= trianglesToRemove)
+                        break;
+                    if (marked[c.from] || marked[c.to])
+                        continue;
+                    if (flips(c.from, c.to))
+                        continue;
+
+                    remap[c.from] = c.to;
+                    quadrics[c.to] += quadrics[c.from];
+                    maxCost = std::max(maxCost, c.cost);
+                    ++applied;
+
+                    // 锁定一环邻域，保证同一轮的折叠互不影响
+                    for (unsigned int i = adjOffsets[c.from]; i < adjOffsets[c.from + 1]; ++i)
+                    {
+                        unsigned int t = adjTris[i];
+                        bool hasTarget = false;
+                        for (int k = 0; k < 3; ++k)
+                        {
+                            unsigned int v = corner(t, k);
+                            marked[v] = 1;
+                            hasTarget |= (v == c.to);
+                        }
+                        removed += hasTarget ? 1 : 0;
+                    }
+                    marked[c.from] = marked[c.to] = 1;
+                }
+
+                if (applied == 0)
+                    break;
+
+                // 重写三角形：被折叠的角点改用目标位置上 UV 最接近的顶点
+                std::vector<unsigned int> next;
+                next.reserve(tris.size());
+                for (size_t t = 0; t < tris.size(); t += 3)
+                {
+                    unsigned int out[3];
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        unsigned int w = tris[t + k];
+                        unsigned int target = remap[welded[w]];
+                        if (target == welded[w])
+                        {
+                            out[k] = w;
+                            continue;
+                        }
+                        unsigned int best = target;
+                        if (texcoords)
+                        {
+                            const float *uv = attrib(texcoords, texcoordStride, w);
+                            float bestDist = 1e30f;
+                            unsigned int candidate = target;
+                            do
+                            {
+                                const float *cuv = attrib(texcoords, texcoordStride, candidate);
+                                float du = cuv[0] - uv[0], dv = cuv[1] - uv[1];
+                                float dist = du * du + dv * dv;
+                                if (dist < bestDist)
+                                {
+                                    bestDist = dist;
+                                    best = candidate;
+                                }
+                                candidate = wedgeNext[candidate];
+                            } while (candidate != target);
+                        }
+                        out[k] = best;
+                    }
+                    if (welded[out[0]] == welded[out[1]] || welded[out[1]] == welded[out[2]] || welded[out[0]] == welded[out[2]])
+                        continue;
+                    next.insert(next.end(), out, out + 3);
+                }
+                tris.swap(next);
+
+                for (unsigned int i = 0; i < vertexCount; ++i)
+                    remap[i] = i;
+            }
+
+            if (outError)
+                *outError = float(std::sqrt(maxCost));
+            return tris;
+        }
+
+        VertexCacheStats analyzeVertexCache(const unsigned int *indices, size_t indexCount, size_t vertexCount,
+                                            unsigned int cacheSize)
+        {
+            VertexCacheStats stats;
+            if (indexCount < 3 || vertexCount == 0)
+                return stats;
+
+            // FIFO：只在未命中时写入时间戳，距今不足 cacheSize 次未命中即仍在缓存中
+            std::vector<size_t> stamps(vertexCount, 0);
+            std::vector<uint8_t> used(vertexCount, 0);
+            size_t time = cacheSize + 1;
+            size_t unique = 0;
+            for (size_t i = 0; i < indexCount; ++i)
+            {
+                unsigned int v = indices[i];
+                if (time - stamps[v] > cacheSize)
+                {
+                    stamps[v] = time++;
+                    ++stats.transformed;
+                }
+                if (!used[v])
+                {
+                    used[v] = 1;
+                    ++unique;
+                }
+            }
+            stats.acmr = float(stats.transformed) / float(indexCount / 3);
+            stats.atvr = unique ? float(stats.transformed) / float(unique) : 0.0f;
+            return stats;
+        }
+
+        void optimizeVertexCache(unsigned int *dst, const unsigned int *indices, size_t indexCount, size_t vertexCount,
+                                 unsigned int cacheSize)
+        {
+            const size_t triangleCount = indexCount / 3;
+            if (triangleCount == 0)
+                return;
+
+            // 顶点 -> 三角形邻接，liveCount 为尚未输出的相邻三角形数
+            std::vector<unsigned int> offsets(vertexCount + 1, 0);
+            for (size_t i = 0; i < triangleCount * 3; ++i)
+                ++offsets[indices[i] + 1];
+            for (size_t v = 0; v < vertexCount; ++v)
+                offsets[v + 1] += offsets[v];
+            std::vector<unsigned int> adjacency(triangleCount * 3);
+            std::vector<unsigned int> liveCount(vertexCount, 0);
+            {
+                std::vector<unsigned int> cursor(offsets.begin(), offsets.end() - 1);
+                for (size_t i = 0; i < triangleCount * 3; ++i)
+                {
+                    adjacency[cursor[indices[i]]++] = unsigned(i / 3);
+                    ++liveCount[indices[i]];
+                }
+            }
+
+            std::vector<unsigned int> source(indices, indices + triangleCount * 3); // 允许 dst == indices
+            std::vector<size_t> stamps(vertexCount, 0);
+            std::vector<uint8_t> emitted(triangleCount, 0);
+            std::vector<unsigned int> deadEnd;
+            std::vector<unsigned int> candidates;
+            size_t time = cacheSize + 1;
+            size_t cursor = 0; // 死路时顺序扫描的位置
+            size_t out = 0;
+
+            int fanning = int(source[0]);
+            while (fanning >= 0)
+            {
+                candidates.clear();
+                for (unsigned int i = offsets[fanning]; i < offsets[fanning + 1]; ++i)
+                {
+                    unsigned int t = adjacency[i];
+                    if (emitted[t])
+                        continue;
+                    emitted[t] = 1;
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        unsigned int v = source[t * 3 + k];
+                        dst[out++] = v;
+                        deadEnd.push_back(v);
+                        candidates.push_back(v);
+                        --liveCount[v];
+                        if (time - stamps[v] > cacheSize)
+                            stamps[v] = time++;
+                    }
+                }
+
+                // 选择仍在缓存中且剩余三角形输出后不会被挤出的最旧顶点
+                int next = -1;
+                long bestPriority = -1;
+                for (unsigned int v : candidates)
+                {
+                    if (liveCount[v] == 0)
+                        continue;
+                    long priority = 0;
+                    if (long(time - stamps[v]) + 2 * long(liveCount[v]) <= long(cacheSize))
+                        priority = long(time - stamps[v]);
+                    if (priority > bestPriority)
+                    {
+                        bestPriority = priority;
+                        next = int(v);
+                    }
+                }
+
+                if (next < 0)
+                {
+                    // 死路：先回溯最近输出的顶点，再顺序查找
+                    while (!deadEnd.empty() && next < 0)
+                    {
+                        unsigned int v = deadEnd.back();
+                        deadEnd.pop_back();
+                        if (liveCount[v] > 0)
+                            next = int(v);
+                    }
+                    while (next < 0 && cursor < vertexCount)
+                    {
+                        if (liveCount[cursor] > 0)
+                            next = int(cursor);
+                        ++cursor;
+                    }
+                }
+                fanning = next;
+            }
+        }
+
+        void optimizeOverdraw(unsigned int *dst, const unsigned int *indices, size_t indexCount,
+                              const float *positions, size_t vertexCount, size_t positionStride,
+                              float threshold, unsigned int cacheSize)
+        {
+            const size_t triangleCount = indexCount / 3;
+            if (triangleCount == 0)
+                return;
+            std::vector<unsigned int> source(indices, indices + triangleCount * 3);
+
+            // 模拟缓存，记录每个三角形的未命中数
+            std::vector<size_t> stamps(vertexCount, 0);
+            std::vector<uint8_t> misses(triangleCount);
+            size_t time = cacheSize + 1;
+            for (size_t t = 0; t < triangleCount; ++t)
+            {
+                uint8_t m = 0;
+                for (int k = 0; k < 3; ++k)
+                {
+                    unsigned int v = source[t * 3 + k];
+                    if (time - stamps[v] > cacheSize)
+                    {
+                        stamps[v] = time++;
+                        ++m;
+                    }
+                }
+                misses[t] = m;
+            }
+
+            // 硬断点：三个顶点全部未命中处（缓存已被刷新），在此切分不影响缓存效率
+            std::vector<size_t> hard;
+            for (size_t t = 0; t < triangleCount; ++t)
+                if (t == 0 || misses[t] == 3)
+                    hard.push_back(t);
+            hard.push_back(triangleCount);
+
+            // 软断点：每个簇从空缓存开始模拟，累计 ACMR 不超过整段 ACMR * threshold 时切分，
+            // 保证切分带来的缓存重新预热代价可控
+            std::vector<size_t> clusters;
+            for (size_t h = 0; h + 1 < hard.size(); ++h)
+            {
+                size_t begin = hard[h], end = hard[h + 1];
+                size_t total = 0;
+                for (size_t t = begin; t < end; ++t)
+                    total += misses[t];
+                float limit = float(total) / float(end - begin) * threshold;
+
+                clusters.push_back(begin);
+                size_t clusterStart = begin;
+                size_t clusterMisses = 0;
+                time += cacheSize + 1; // 清空缓存
+                for (size_t t = begin; t < end; ++t)
+                {
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        unsigned int v = source[t * 3 + k];
+                        if (time - stamps[v] > cacheSize)
+                        {
+                            stamps[v] = time++;
+                            ++clusterMisses;
+                        }
+                    }
+                    if (t + 1 < end && float(clusterMisses) / float(t + 1 - clusterStart) <= limit)
+                    {
+                        clusters.push_back(t + 1);
+                        clusterStart = t + 1;
+                        clusterMisses = 0;
+                        time += cacheSize + 1;
+                    }
+                }
+            }
+            clusters.push_back(triangleCount);
+
+            auto pos = [&](unsigned int v)
+            { return attrib(positions, positionStride, v); };
+
+            // 网格中心（面积加权）
+            double meshCenter[3] = {0, 0, 0};
+            double meshArea = 0;
+            for (size_t t = 0; t < triangleCount; ++t)
+            {
+                const float *p0 = pos(source[t * 3]), *p1 = pos(source[t * 3 + 1]), *p2 = pos(source[t * 3 + 2]);
+                double n[3];
+                cross(p0, p1, p2, n);
+                double area = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                for (int d = 0; d < 3; ++d)
+                    meshCenter[d] += area * (double(p0[d]) + p1[d] + p2[d]) / 3.0;
+                meshArea += area;
+            }
+            if (meshArea > 0)
+                for (int d = 0; d < 3; ++d)
+                    meshCenter[d] /= meshArea;
+
+            // 簇排序键：簇中心相对网格中心沿簇平均法线的距离，越朝外越先画
+            const size_t clusterCount = clusters.size() - 1;
+            std::vector<float> keys(clusterCount);
+            for (size_t c = 0; c < clusterCount; ++c)
+            {
+                double center[3] = {0, 0, 0}, normal[3] = {0, 0, 0}, area = 0;
+                for (size_t t = clusters[c]; t < clusters[c + 1]; ++t)
+                {
+                    const float *p0 = pos(source[t * 3]), *p1 = pos(source[t * 3 + 1]), *p2 = pos(source[t * 3 + 2]);
+                    double n[3];
+                    cross(p0, p1, p2, n);
+                    double a = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                    for (int d = 0; d < 3; ++d)
+                    {
+                        center[d] += a * (double(p0[d]) + p1[d] + p2[d]) / 3.0;
+                        normal[d] += n[d];
+                    }
+                    area += a;
+                }
+                double len = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+                if (area <= 0 || len <= 0)
+                {
+                    keys[c] = 0.0f;
+                    continue;
+                }
+                double key = 0;
+                for (int d = 0; d < 3; ++d)
+                    key += (center[d] / area - meshCenter[d]) * normal[d] / len;
+                keys[c] = float(key);
+            }
+
+            std::vector<size_t> order(clusterCount);
+            for (size_t c = 0; c < clusterCount; ++c)
+                order[c] = c;
+            std::stable_sort(order.begin(), order.end(), [&](size_t l, size_t r)
+                             { return keys[l] > keys[r]; });
+
+            size_t out = 0;
+            for (size_t c : order)
+                for (size_t t = clusters[c]; t < clusters[c + 1]; ++t)
+                    for (int k = 0; k < 3; ++k)
+                        dst[out++] = source[t * 3 + k];
+        }
+
+        size_t optimizeVertexFetchRemap(unsigned int *remap, const unsigned int *indices, size_t indexCount,
+                                        size_t vertexCount)
+        {
+            std::fill(remap, remap + vertexCount, ~0u);
+            unsigned int next = 0;
+            for (size_t i = 0; i < indexCount; ++i)
+                if (remap[indices[i]] == ~0u)
+                    remap[indices[i]] = next++;
+            return next;
+        }
+
+        void remapIndexBuffer(unsigned int *dst, const unsigned int *indices, size_t indexCount, const unsigned int *remap)
+        {
+            for (size_t i = 0; i < indexCount; ++i)
+                dst[i] = remap[indices[i]];
+        }
+    }
+}
@@ -1,11 +1,23 @@
 ﻿
 #include "OxygenRender/Model.h"
+#include "OxygenRender/Camera.h"
+#include "OxygenRender/MeshOptimizer.h"
+#include "OxygenRender/MeshCache.h"
+#include "OxygenRender/RenderQueue.h"
+#include "OxygenRender/ThreadPool.h"
+#include "OxygenRender/TextureCache.h"
+#include "OxygenRender/TextureStreamer.h"
+#include "ModelImport.h"
 
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
  #include <stb_image.h>
 #include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <unordered_map>
 #include <glm/gtc/matrix_transform.hpp>
 
 namespace OxyRender
@@ -15,13 +27,17 @@ namespace OxyRender
     {
 
         void loadModel(Model *self, const std::string &path);
-        void processNode(Model *self, aiNode *node, const aiScene *scene);
-        Mesh processMesh(Model *self, aiMesh *mesh, const aiScene *scene);
-        std::vector<Texture> loadMaterialTextures(Model *self, aiMaterial *mat, aiTextureType type, const std::string &typeName);
+        using PendingTextures = std::vector<std::pair<std::string, std::future<DecodedTexture>>>;
+        PendingTextures decodeTextures(Model *self, const std::vector<std::string> &paths, ThreadPool &pool);
+        void uploadTextures(Model *self, PendingTextures &pending);
+        Texture loadTexture(Model *self, const std::string &path, const std::string &typeName);
+        bool loadFromCache(Model *self, const std::string &path, ThreadPool &pool);
     };
 
+    // 着色器模板：TEXTURED / SPECULAR_MAP / NORMAL_MAP 按网格实际拥有的纹理启用
     const char *Model::s_vertexShaderSrc = R"(
 #version 330 core
+)" OXY_FRAME_UNIFORMS_GLSL R"(
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoords;
@@ -29,79 +45,109 @@ layout (location = 3) in vec3 aTangent;
 layout (location = 4) in vec3 aBitangent;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+uniform mat3 normalMatrix; // CPU 预计算的 transpose(inverse(mat3(model)))
 
 out vec3 FragPos;
 out vec2 TexCoords;
+#ifdef NORMAL_MAP
 out mat3 TBN;
+#else
+out vec3 Normal;
+#endif
 
 void main()
 {
     FragPos = vec3(model * vec4(aPos, 1.0));
     TexCoords = aTexCoords;
 
+    vec3 N = normalize(normalMatrix * aNormal);
+#ifdef NORMAL_MAP
     vec3 T = normalize(mat3(model) * aTangent);
     vec3 B = normalize(mat3(model) * aBitangent);
-    vec3 N = normalize(mat3(transpose(inverse(model))) * aNormal);
-
     TBN = mat3(T, B, N);
+#else
+    Normal = N;
+#endif
 
-    gl_Position = projection * view * vec4(FragPos, 1.0);
+    gl_Position = uViewProjection * vec4(FragPos, 1.0);
 }
 )";
 
     const char *Model::s_fragmentShaderSrc = R"(
 #version 330 core
+)" OXY_FRAME_UNIFORMS_GLSL R"(
 out vec4 FragColor;
 
 in vec3 FragPos;
 in vec2 TexCoords;
+#ifdef NORMAL_MAP
 in mat3 TBN;
+uniform sampler2D texture_normal1;
+#else
+in vec3 Normal;
+#endif
 
-struct Light {
-    vec3 position;
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
-};
-
-uniform Light light;
-uniform vec3 viewPos;
+#ifdef TEXTURED
 uniform sampler2D texture_diffuse1;
+#else
+uniform vec3 uBaseColor = vec3(1.0);
+#endif
+#ifdef SPECULAR_MAP
 uniform sampler2D texture_specular1;
-uniform sampler2D texture_normal1;
+#endif
 
 void main()
 {
+#ifdef TEXTURED
     vec3 color = texture(texture_diffuse1, TexCoords).rgb;
-    vec3 specularColor = texture(texture_specular1, TexCoords).rgb;
+#else
+    vec3 color = uBaseColor;
+#endif
 
+#ifdef NORMAL_MAP
     vec3 tangentNormal = texture(texture_normal1, TexCoords).rgb;
     tangentNormal = tangentNormal * 2.0 - 1.0;
     vec3 norm = normalize(TBN * tangentNormal);
+#else
+    vec3 norm = normalize(Normal);
+#endif
 
-    vec3 lightDir = normalize(light.position - FragPos);
-    vec3 viewDir  = normalize(viewPos - FragPos);
+    vec3 viewDir = normalize(uCameraPos.xyz - FragPos);
+    vec3 result = vec3(0.0);
 
-    vec3 halfwayDir = normalize(lightDir + viewDir);
-    float diff = max(dot(norm, lightDir), 0.0);
-    float spec = pow(max(dot(norm, halfwayDir), 0.0), 64.0);
-
-    vec3 ambient = light.ambient * color;
-    vec3 diffuse = light.diffuse * diff * color;
-    vec3 specular = light.specular * spec * specularColor;
-
-    vec3 result = ambient + diffuse + specular;
+    for (int i = 0; i < uLightCount.x; ++i)
+    {
+        vec3 lightDir = normalize(uLights[i].position.xyz - FragPos);
+        float diff = max(dot(norm, lightDir), 0.0);
+        result += uLights[i].ambient.rgb * color + uLights[i].diffuse.rgb * diff * color;
+
+#ifdef SPECULAR_MAP
+        // 没有高光贴图时高光为零，整段省去
+        vec3 halfwayDir = normalize(lightDir + viewDir);
+        float spec = pow(max(dot(norm, halfwayDir), 0.0), 64.0);
+        result += uLights[i].specular.rgb * spec * texture(texture_specular1, TexCoords).rgb;
+#endif
+    }
     result = pow(result, vec3(1.0/2.2));
 
     FragColor = vec4(result, 1.0);
 }
 )";
 
+    namespace
+    {
+        constexpr uint32_t kModelFeatures = ShaderFeature::Textured | ShaderFeature::SpecularMap | ShaderFeature::NormalMap;
+    }
+
     Shader Model::CreateDefaultShader()
     {
-        return Shader("model_shader_builtin", s_vertexShaderSrc, s_fragmentShaderSrc);
+        return Shader("model_shader_builtin", ShaderVariants::applyFeatures(s_vertexShaderSrc, kModelFeatures).c_str(),
+                      ShaderVariants::applyFeatures(s_fragmentShaderSrc, kModelFeatures).c_str());
+    }
+
+    ShaderVariants Model::CreateDefaultShaderVariants()
+    {
+        return ShaderVariants("model_shader_builtin", s_vertexShaderSrc, s_fragmentShaderSrc, kModelFeatures);
     }
     Model::Model(Renderer &renderer, const std::string &path, bool gamma)
         : m_Renderer(renderer), gammaCorrection(gamma), pImpl(std::make_unique<Impl>())
@@ -110,145 +156,343 @@ void main()
         pImpl->loadModel(this, path);
     }
 
+    Model::Model(Renderer &renderer)
+        : m_Renderer(renderer), gammaCorrection(false), pImpl(std::make_unique<Impl>())
+    {
+    }
+
     Model::~Model() = default;
 
+    bool Model::s_meshCacheEnabled = true;
+    bool Model::s_textureStreaming = false;
+    size_t Model::s_importThreadCount = 0;
+
+    namespace
+    {
+        constexpr UniformID kModel("model");
+        constexpr UniformID kNormalMatrix("normalMatrix");
+    }
+
+    void Model::setModelMatrix(Shader &shader, const glm::mat4 &modelMatrix)
+    {
+        shader.setMat4(kModel, modelMatrix);
+        shader.setMat3(kNormalMatrix, glm::transpose(glm::inverse(glm::mat3(modelMatrix))));
+    }
+
     void Model::Draw(Shader &shader)
     {
+        m_Renderer.getFrameUniforms().bind();
         for (unsigned int i = 0; i < meshes.size(); i++)
             meshes[i].Draw(shader);
     }
 
-    void Model::Impl::loadModel(Model *self, const std::string &path)
+    namespace
     {
-        Assimp::Importer importer;
-        const aiScene *scene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_CalcTangentSpace);
-
-        if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
+        // 切换到网格所需的变体；与上一个网格相同时不重复 use 和设置矩阵
+        Shader &useVariant(ShaderVariants &variants, const Mesh &mesh, Shader *&current, const glm::mat4 &modelMatrix)
         {
-            std::cout << "ERROR::ASSIMP:: " << importer.GetErrorString() << std::endl;
-            return;
+            Shader &shader = variants.get(mesh.getMaterial().getFeatures());
+            if (&shader != current)
+            {
+                shader.use();
+                Model::setModelMatrix(shader, modelMatrix);
+                current = &shader;
+            }
+            return shader;
         }
-
-        self->directory = path.substr(0, path.find_last_of('/'));
-        processNode(self, scene->mRootNode, scene);
     }
 
-    void Model::Impl::processNode(Model *self, aiNode *node, const aiScene *scene)
+    void Model::Draw(ShaderVariants &variants, const glm::mat4 &modelMatrix)
     {
-        for (unsigned int i = 0; i < node->mNumMeshes; i++)
-        {
-            aiMesh *mesh = scene->mMeshes[node->mMeshes[i]];
-            self->meshes.push_back(processMesh(self, mesh, scene));
-        }
-
-        for (unsigned int i = 0; i < node->mNumChildren; i++)
-        {
-            processNode(self, node->mChildren[i], scene);
-        }
+        m_Renderer.getFrameUniforms().bind();
+        Shader *current = nullptr;
+        for (auto &mesh : meshes)
+            mesh.Draw(useVariant(variants, mesh, current, modelMatrix));
     }
 
-    Mesh Model::Impl::processMesh(Model *self, aiMesh *mesh, const aiScene *scene)
+    template <typename Visit>
+    void Model::forEachLod(const glm::mat4 &modelMatrix, const Camera &camera, int screenHeight, Visit &&visit)
     {
-        std::vector<Vertex> vertices;
-        std::vector<unsigned int> indices;
-        std::vector<Texture> textures;
-
-        for (unsigned int i = 0; i < mesh->mNumVertices; i++)
+        // 模型矩阵的最大缩放，用于把模型空间误差换算到世界空间
+        float scale = std::sqrt(std::max({glm::dot(glm::vec3(modelMatrix[0]), glm::vec3(modelMatrix[0])),
+                                          glm::dot(glm::vec3(modelMatrix[1]), glm::vec3(modelMatrix[1])),
+                                          glm::dot(glm::vec3(modelMatrix[2]), glm::vec3(modelMatrix[2]))}));
+        // 距离 1 处单位长度对应的像素数
+        float pixelsPerUnit = screenHeight / (2.0f * std::tan(glm::radians(camera.getZoom()) * 0.5f));
+        glm::vec3 eye = camera.getPosition();
+        TextureStreamer &streamer = TextureStreamer::getInstance();
+        const bool streaming = streamer.getTextureCount() > 0;
+
+        for (auto &mesh : meshes)
         {
-            Vertex vertex;
-            glm::vec3 vector;
-
-            vector.x = mesh->mVertices[i].x;
-            vector.y = mesh->mVertices[i].y;
-            vector.z = mesh->mVertices[i].z;
-            vertex.Position = vector;
+            const auto &lods = mesh.getLods();
+            glm::vec3 center = glm::vec3(modelMatrix * glm::vec4(mesh.getBoundsCenter(), 1.0f));
+            float distance = glm::length(center - eye) - mesh.getBoundsRadius() * scale;
 
-            if (mesh->HasNormals())
+            // 位于相机后方的网格不需要纹理细节；距离取包围球最近点，相机在包围球内时按最高精度
+            if (streaming && glm::dot(center - eye, camera.getFront()) > -mesh.getBoundsRadius() * scale)
             {
-                vector.x = mesh->mNormals[i].x;
-                vector.y = mesh->mNormals[i].y;
-                vector.z = mesh->mNormals[i].z;
-                vertex.Normal = vector;
+                float uvPerPixel = mesh.getUvDensity() * std::max(distance, 0.0f) / (scale * pixelsPerUnit);
+                for (const auto &texture : mesh.textures)
+                    if (texture.tex)
+                        streamer.request(*texture.tex, uvPerPixel);
             }
 
-            if (mesh->mTextureCoords[0])
+            int level = 0;
+            if (distance > 0.0f)
             {
-                glm::vec2 vec;
-                vec.x = mesh->mTextureCoords[0][i].x;
-                vec.y = mesh->mTextureCoords[0][i].y;
-                vertex.TexCoords = vec;
-
-                vector.x = mesh->mTangents[i].x;
-                vector.y = mesh->mTangents[i].y;
-                vector.z = mesh->mTangents[i].z;
-                vertex.Tangent = vector;
-
-                vector.x = mesh->mBitangents[i].x;
-                vector.y = mesh->mBitangents[i].y;
-                vector.z = mesh->mBitangents[i].z;
-                vertex.Bitangent = vector;
+                for (int i = static_cast<int>(lods.size()) - 1; i > 0; --i)
+                {
+                    if (lods[i].error * scale / distance * pixelsPerUnit <= m_lodErrorThreshold)
+                    {
+                        level = i;
+                        break;
+                    }
+                }
             }
-            else
+            visit(mesh, level, distance);
+        }
+    }
+
+    void Model::Draw(Shader &shader, const glm::mat4 &modelMatrix, const Camera &camera, int screenHeight)
+    {
+        setModelMatrix(shader, modelMatrix);
+        m_Renderer.getFrameUniforms().bind();
+        forEachLod(modelMatrix, camera, screenHeight, [&](Mesh &mesh, int level, float)
+                   { mesh.Draw(shader, level); });
+    }
+
+    void Model::Draw(ShaderVariants &variants, const glm::mat4 &modelMatrix, const Camera &camera, int screenHeight)
+    {
+        Shader *current = nullptr;
+        m_Renderer.getFrameUniforms().bind();
+        forEachLod(modelMatrix, camera, screenHeight, [&](Mesh &mesh, int level, float)
+                   { mesh.Draw(useVariant(variants, mesh, current, modelMatrix), level); });
+    }
+
+    void Model::Submit(RenderQueue &queue, ShaderVariants &variants, const glm::mat4 &modelMatrix, const Camera &camera,
+                       int screenHeight, const PipelineDesc &pipeline, uint8_t layer)
+    {
+        // 每个变体一条管线，相同描述由 Renderer 去重
+        const PipelineState *pipelines[1u << ShaderFeature::Count] = {};
+        forEachLod(modelMatrix, camera, screenHeight, [&](Mesh &mesh, int level, float distance)
+                   {
+            const MeshLod *lod = mesh.getLod(level);
+            if (!lod)
+                return;
+            const uint32_t features = mesh.getMaterial().getFeatures() & ((1u << ShaderFeature::Count) - 1);
+            if (!pipelines[features])
             {
-                vertex.TexCoords = glm::vec2(0.0f, 0.0f);
+                PipelineDesc desc = pipeline;
+                desc.shader = &variants.get(features);
+                pipelines[features] = m_Renderer.createPipeline(desc);
             }
 
-            vertices.push_back(vertex);
+            DrawPacket packet;
+            packet.pipeline = pipelines[features];
+            packet.material = &mesh.getMaterial();
+            packet.vertexArray = &mesh.getVertexArray();
+            packet.indexCount = lod->indexCount;
+            packet.firstIndex = lod->indexOffset;
+            packet.model = modelMatrix;
+            packet.depth = std::max(distance, 0.0f);
+            packet.layer = layer;
+            packet.translucent = pipeline.blend;
+            queue.submit(packet); });
+    }
+
+    void Model::generateLods(const std::vector<float> &ratios)
+    {
+        m_stats.lodTrianglesFull = 0;
+        m_stats.lodTrianglesCoarsest = 0;
+        for (auto &mesh : meshes)
+        {
+            mesh.buildLods(ratios);
+            m_stats.lodTrianglesFull += mesh.getLods().front().indexCount / 3;
+            m_stats.lodTrianglesCoarsest += mesh.getLods().back().indexCount / 3;
         }
+    }
+
+    void Model::Impl::loadModel(Model *self, const std::string &path)
+    {
+        self->directory = path.substr(0, path.find_last_of('/'));
+
+        // 指定线程数时使用独立线程池（调用线程也参与，故工作线程数减一）
+        std::unique_ptr<ThreadPool> localPool;
+        if (s_importThreadCount > 0)
+            localPool = std::make_unique<ThreadPool>(s_importThreadCount - 1);
+        ThreadPool &pool = localPool ? *localPool : ThreadPool::getInstance();
+        self->m_stats.loadThreads = pool.getThreadCount() + 1;
+
+        auto start = std::chrono::steady_clock::now();
+        auto elapsedMs = [&start]()
+        { return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(); };
 
-        for (unsigned int i = 0; i < mesh->mNumFaces; i++)
+        if (s_meshCacheEnabled && loadFromCache(self, path, pool))
         {
-            aiFace face = mesh->mFaces[i];
-            for (unsigned int j = 0; j < face.mNumIndices; j++)
-                indices.push_back(face.mIndices[j]);
+            self->m_stats.fromMeshCache = true;
+            self->m_stats.loadMs = elapsedMs();
+            return;
         }
 
-        aiMaterial *material = scene->mMaterials[mesh->mMaterialIndex];
+        Assimp::Importer importer;
+        std::vector<std::string> openedFiles;
+        ModelImport::recordOpenedFiles(importer, openedFiles);
+        const aiScene *scene = importer.ReadFile(path, ModelImport::importFlags());
+
+        if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
+        {
+            std::cout << "ERROR::ASSIMP:: " << importer.GetErrorString() << std::endl;
+            return;
+        }
+
+        self->m_stats.parseMs = elapsedMs();
+
+        std::vector<ModelImport::ImportedMesh> imported;
+        ModelImport::collectMeshes(scene->mRootNode, scene, imported);
+
+        // 纹理解码先入队，与网格转换在同一线程池上并行
+        std::vector<std::string> texturePaths;
+        for (const auto &mesh : imported)
+            for (const auto &ref : mesh.textures)
+                texturePaths.push_back(ref.second);
+
+        PendingTextures pending = decodeTextures(self, texturePaths, pool);
+
+        pool.parallelFor(0, imported.size(), [&](size_t i)
+                         {
+                             ModelImport::convertMesh(imported[i]);
+                             ModelImport::optimizeMesh(imported[i]); });
+
+        // GPU 上传只在上下文线程进行
+        uploadTextures(self, pending);
+
+        self->meshes.reserve(self->meshes.size() + imported.size());
+        for (auto &mesh : imported)
+        {
+            std::vector<Texture> textures;
+            textures.reserve(mesh.textures.size());
+            for (const auto &ref : mesh.textures)
+                textures.push_back(loadTexture(self, ref.second, ref.first));
 
-        std::vector<Texture> diffuseMaps = loadMaterialTextures(self, material, aiTextureType_DIFFUSE, "texture_diffuse");
-        textures.insert(textures.end(), diffuseMaps.begin(), diffuseMaps.end());
+            ModelImport::addVertexCacheStats(self->m_stats, mesh);
 
-        std::vector<Texture> specularMaps = loadMaterialTextures(self, material, aiTextureType_SPECULAR, "texture_specular");
-        textures.insert(textures.end(), specularMaps.begin(), specularMaps.end());
+            self->meshes.emplace_back(self->m_Renderer, std::move(mesh.vertices), std::move(mesh.indices), std::move(textures));
+        }
 
-        std::vector<Texture> normalMaps = loadMaterialTextures(self, material, aiTextureType_HEIGHT, "texture_normal");
-        textures.insert(textures.end(), normalMaps.begin(), normalMaps.end());
+        self->m_stats.loadMs = elapsedMs();
 
-        std::vector<Texture> heightMaps = loadMaterialTextures(self, material, aiTextureType_AMBIENT, "texture_height");
-        textures.insert(textures.end(), heightMaps.begin(), heightMaps.end());
+        if (s_meshCacheEnabled)
+            MeshCache::write(MeshCache::cachePathFor(path), path, self->meshes, openedFiles);
+    }
 
-        return Mesh(self->m_Renderer, vertices, indices, textures);
+    bool Model::Impl::loadFromCache(Model *self, const std::string &path, ThreadPool &pool)
+    {
+        // 网格直接从映射内存上传并共享映射，映射随最后一个网格释放
+        auto cache = std::make_shared<MeshCache>();
+        if (!cache->open(MeshCache::cachePathFor(path), path))
+            return false;
+
+        std::vector<std::string> texturePaths;
+        for (const CachedMesh &cached : cache->getMeshes())
+            for (const auto &ref : cached.textures)
+                texturePaths.push_back(ref.second);
+        PendingTextures pending = decodeTextures(self, texturePaths, pool);
+        uploadTextures(self, pending);
+
+        self->meshes.reserve(cache->getMeshes().size());
+        for (const CachedMesh &cached : cache->getMeshes())
+        {
+            std::vector<Texture> textures;
+            textures.reserve(cached.textures.size());
+            for (const auto &ref : cached.textures)
+                textures.push_back(loadTexture(self, ref.second, ref.first));
+
+            self->meshes.emplace_back(self->m_Renderer, cache, cached.vertices, cached.vertexCount,
+                                      cached.indices, cached.indexCount, std::move(textures),
+                                      cached.boundsMin, cached.boundsMax);
+        }
+        return true;
     }
 
-    std::vector<Texture> Model::Impl::loadMaterialTextures(Model *self, aiMaterial *mat, aiTextureType type, const std::string &typeName)
+    Model::Impl::PendingTextures Model::Impl::decodeTextures(Model *self, const std::vector<std::string> &paths, ThreadPool &pool)
     {
-        std::vector<Texture> textures;
-        for (unsigned int i = 0; i < mat->GetTextureCount(type); i++)
+        PendingTextures pending;
+        for (const auto &texPath : paths)
         {
-            aiString str;
-            mat->GetTexture(type, i, &str);
+            bool known = std::any_of(pending.begin(), pending.end(), [&](const auto &p)
+                                     { return p.first == texPath; }) ||
+                         std::any_of(self->textures_loaded.begin(), self->textures_loaded.end(), [&](const Texture &t)
+                                     { return t.path == texPath; });
+            if (known)
+                continue;
+            std::string filename = self->directory + '/' + texPath;
+
+            // 其他模型已加载过的纹理直接复用
+            std::shared_ptr<Texture2D> cached;
+            if (s_textureStreaming)
+                cached = TextureStreamer::getInstance().find(filename);
+            else
+                cached = TextureCache::getInstance().find(filename);
+            if (cached)
+            {
+                Texture texture;
+                texture.tex = cached;
+                texture.path = texPath;
+                self->textures_loaded.push_back(texture);
+                continue;
+            }
+            if (s_textureStreaming)
+                pending.emplace_back(texPath, pool.submit([filename]()
+                                                          { return TextureStreamer::decode(filename); }));
+            else
+                pending.emplace_back(texPath, pool.submit([filename]()
+                                                          { return TextureCache::decode(filename); }));
+        }
+        return pending;
+    }
 
-            bool skip = false;
-            for (unsigned int j = 0; j < self->textures_loaded.size(); j++)
+    void Model::Impl::uploadTextures(Model *self, PendingTextures &pending)
+    {
+        for (auto &entry : pending)
+        {
+            Texture texture;
+            texture.path = entry.first;
+            try
             {
-                if (std::strcmp(self->textures_loaded[j].path.data(), str.C_Str()) == 0)
-                {
-                    textures.push_back(self->textures_loaded[j]);
-                    skip = true;
-                    break;
-                }
+                if (s_textureStreaming)
+                    texture.tex = TextureStreamer::getInstance().insert(entry.second.get());
+                else
+                    texture.tex = TextureCache::getInstance().insert(entry.second.get());
             }
-            if (!skip)
+            catch (const std::exception &e)
             {
-                Texture texture;
-                texture.tex = TextureFromFile(str.C_Str(), self->directory);
+                std::cerr << "Texture failed to load at path: " << self->directory + '/' + entry.first << "\n"
+                          << e.what() << std::endl;
+            }
+            self->textures_loaded.push_back(texture);
+        }
+        pending.clear();
+    }
+
+    Texture Model::Impl::loadTexture(Model *self, const std::string &path, const std::string &typeName)
+    {
+        for (unsigned int j = 0; j < self->textures_loaded.size(); j++)
+        {
+            if (self->textures_loaded[j].path == path)
+            {
+                Texture texture = self->textures_loaded[j];
                 texture.type = typeName;
-                texture.path = str.C_Str();
-                textures.push_back(texture);
-                self->textures_loaded.push_back(texture);
+                return texture;
             }
         }
-        return textures;
+
+        Texture texture;
+        texture.tex = TextureFromFile(path.c_str(), self->directory);
+        texture.type = typeName;
+        texture.path = path;
+        self->textures_loaded.push_back(texture);
+        return texture;
     }
 
     std::shared_ptr<Texture2D> TextureFromFile(const char *path, const std::string &directory, bool gamma)
@@ -256,8 +500,7 @@ void main()
         std::string filename = directory + '/' + std::string(path);
         try
         {
-            auto texture = std::make_shared<Texture2D>(filename);
-            return texture;
+            return TextureCache::getInstance().load(filename);
         }
         catch (const std::exception &e)
         {
@@ -0,0 +1,151 @@
+#include "ModelImport.h"
+
+#include <assimp/DefaultIOSystem.h>
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+#include <algorithm>
+
+namespace OxyRender
+{
+    namespace ModelImport
+    {
+        namespace
+        {
+            class RecordingIOSystem : public Assimp::DefaultIOSystem
+            {
+            public:
+                explicit RecordingIOSystem(std::vector<std::string> &files) : m_files(files) {}
+
+                Assimp::IOStream *Open(const char *file, const char *mode) override
+                {
+                    Assimp::IOStream *stream = Assimp::DefaultIOSystem::Open(file, mode);
+                    if (stream && std::find(m_files.begin(), m_files.end(), file) == m_files.end())
+                        m_files.emplace_back(file);
+                    return stream;
+                }
+
+            private:
+                std::vector<std::string> &m_files;
+            };
+
+            void collectMaterialTextures(const aiMaterial *mat, aiTextureType type, const std::string &typeName, ImportedMesh &out)
+            {
+                for (unsigned int i = 0; i < mat->GetTextureCount(type); i++)
+                {
+                    aiString str;
+                    mat->GetTexture(type, i, &str);
+                    out.textures.emplace_back(typeName, str.C_Str());
+                }
+            }
+        }
+
+        unsigned int importFlags()
+        {
+            return aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_CalcTangentSpace;
+        }
+
+        void recordOpenedFiles(Assimp::Importer &importer, std::vector<std::string> &files)
+        {
+            // 导入器接管 IO 系统的所有权
+            importer.SetIOHandler(new RecordingIOSystem(files));
+        }
+
+        void collectMeshes(const aiNode *node, const aiScene *scene, std::vector<ImportedMesh> &out)
+        {
+            for (unsigned int i = 0; i < node->mNumMeshes; i++)
+            {
+                ImportedMesh imported;
+                imported.source = scene->mMeshes[node->mMeshes[i]];
+
+                const aiMaterial *material = scene->mMaterials[imported.source->mMaterialIndex];
+                collectMaterialTextures(material, aiTextureType_DIFFUSE, "texture_diffuse", imported);
+                collectMaterialTextures(material, aiTextureType_SPECULAR, "texture_specular", imported);
+                collectMaterialTextures(material, aiTextureType_HEIGHT, "texture_normal", imported);
+                collectMaterialTextures(material, aiTextureType_AMBIENT, "texture_height", imported);
+
+                out.push_back(std::move(imported));
+            }
+
+            for (unsigned int i = 0; i < node->mNumChildren; i++)
+            {
+                collectMeshes(node->mChildren[i], scene, out);
+            }
+        }
+
+        void convertMesh(ImportedMesh &imported)
+        {
+            const aiMesh *mesh = imported.source;
+            auto &vertices = imported.vertices;
+            auto &indices = imported.indices;
+
+            vertices.resize(mesh->mNumVertices); // 值初始化，骨骼数据为 0
+            const bool hasNormals = mesh->HasNormals();
+            const bool hasTexCoords = mesh->mTextureCoords[0] != nullptr;
+            const bool hasTangents = hasTexCoords && mesh->mTangents && mesh->mBitangents;
+            for (unsigned int i = 0; i < mesh->mNumVertices; i++)
+            {
+                Vertex &vertex = vertices[i];
+                vertex.Position = glm::vec3(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
+
+                if (hasNormals)
+                    vertex.Normal = glm::vec3(mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z);
+
+                if (hasTexCoords)
+                    vertex.TexCoords = glm::vec2(mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y);
+
+                if (hasTangents)
+                {
+                    vertex.Tangent = glm::vec3(mesh->mTangents[i].x, mesh->mTangents[i].y, mesh->mTangents[i].z);
+                    vertex.Bitangent = glm::vec3(mesh->mBitangents[i].x, mesh->mBitangents[i].y, mesh->mBitangents[i].z);
+                }
+            }
+
+            // 只保留三角形（三角化后残留的点/线图元不参与绘制）
+            size_t triangles = 0;
+            for (unsigned int i = 0; i < mesh->mNumFaces; i++)
+                triangles += mesh->mFaces[i].mNumIndices == 3 ? 1 : 0;
+            indices.resize(triangles * 3);
+            size_t out = 0;
+            for (unsigned int i = 0; i < mesh->mNumFaces; i++)
+            {
+                const aiFace &face = mesh->mFaces[i];
+                if (face.mNumIndices != 3)
+                    continue;
+                indices[out++] = face.mIndices[0];
+                indices[out++] = face.mIndices[1];
+                indices[out++] = face.mIndices[2];
+            }
+        }
+
+        void optimizeMesh(ImportedMesh &mesh)
+        {
+            auto &vertices = mesh.vertices;
+            auto &indices = mesh.indices;
+            if (indices.empty() || vertices.empty())
+                return;
+
+            mesh.before = MeshOptimizer::analyzeVertexCache(indices.data(), indices.size(), vertices.size());
+
+            // 缓存重排 -> 过度绘制排序 -> 按使用顺序重排顶点
+            MeshOptimizer::optimizeVertexCache(indices.data(), indices.data(), indices.size(), vertices.size());
+            MeshOptimizer::optimizeOverdraw(indices.data(), indices.data(), indices.size(),
+                                            &vertices[0].Position.x, vertices.size(), sizeof(Vertex));
+
+            std::vector<unsigned int> remap(vertices.size());
+            size_t unique = MeshOptimizer::optimizeVertexFetchRemap(remap.data(), indices.data(), indices.size(), vertices.size());
+            MeshOptimizer::remapIndexBuffer(indices.data(), indices.data(), indices.size(), remap.data());
+            vertices = MeshOptimizer::remapVertexBuffer(vertices, remap.data(), unique);
+
+            mesh.after = MeshOptimizer::analyzeVertexCache(indices.data(), indices.size(), vertices.size());
+        }
+
+        void addVertexCacheStats(ModelStats &stats, const ImportedMesh &mesh)
+        {
+            stats.triangles += mesh.indices.size() / 3;
+            stats.vertices += mesh.vertices.size();
+            stats.transformedBefore += mesh.before.transformed;
+            stats.transformedAfter += mesh.after.transformed;
+        }
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+// 模型导入的 CPU 端步骤（内部头文件），同步加载与异步加载共用
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "OxygenRender/Mesh.h"
+#include "OxygenRender/MeshOptimizer.h"
+#include "OxygenRender/Model.h"
+
+struct aiNode;
+struct aiScene;
+struct aiMesh;
+namespace Assimp
+{
+    class Importer;
+}
+
+namespace OxyRender
+{
+    namespace ModelImport
+    {
+        // Assimp 后处理标志
+        unsigned int importFlags();
+
+        // 让导入器把 ReadFile 期间打开的文件（如 .obj 引用的 .mtl）记录到 files，供网格缓存校验
+        void recordOpenedFiles(Assimp::Importer &importer, std::vector<std::string> &files);
+
+        // 导入阶段的 CPU 端网格，可在工作线程填充
+        struct ImportedMesh
+        {
+            const aiMesh *source = nullptr;
+            std::vector<Vertex> vertices;
+            std::vector<unsigned int> indices;
+            std::vector<std::pair<std::string, std::string>> textures; // (type, path)
+            MeshOptimizer::VertexCacheStats before;
+            MeshOptimizer::VertexCacheStats after;
+        };
+
+        // 按节点顺序收集网格及其材质纹理引用（只读场景，开销很小）
+        void collectMeshes(const aiNode *node, const aiScene *scene, std::vector<ImportedMesh> &out);
+
+        // 复制顶点/索引（线程安全，source 所属场景需保持有效）
+        void convertMesh(ImportedMesh &mesh);
+
+        // 顶点缓存 -> 过度绘制 -> 顶点拉取优化，并记录前后统计
+        void optimizeMesh(ImportedMesh &mesh);
+
+        // 把网格的顶点缓存统计累计到模型统计（在 optimizeMesh 之后调用）
+        void addVertexCacheStats(ModelStats &stats, const ImportedMesh &mesh);
+    }
+}
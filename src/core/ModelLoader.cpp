@@ -0,0 +1,468 @@
+#include "OxygenRender/ModelLoader.h"
+#include "OxygenRender/GLContext.h"
+#include "OxygenRender/MeshCache.h"
+#include "OxygenRender/ThreadPool.h"
+#include "OxygenRender/TextureCache.h"
+#include "OxygenRender/TextureStreamer.h"
+#include "ModelImport.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <algorithm>
+#include <deque>
+#include <iostream>
+#include <mutex>
+
+namespace OxyRender
+{
+    // 工作线程产出、上下文线程消费的数据
+    struct ModelLoadShared
+    {
+        struct ReadyMesh
+        {
+            std::vector<Vertex> vertices;
+            std::vector<unsigned int> indices;
+            const CachedMesh *cached = nullptr; // 来自缓存时指向映射数据
+            std::vector<std::pair<std::string, std::string>> textures;
+        };
+
+        struct ReadyTexture
+        {
+            std::string path;
+            std::shared_ptr<Texture2D> cached; // 全局缓存命中时无需上传
+            DecodedTexture decoded;
+            std::string error;
+        };
+
+        std::mutex mutex;
+        std::deque<ReadyMesh> meshes;
+        std::deque<ReadyTexture> textures;
+        std::string error;
+        ModelStats totals; // 只累计顶点缓存统计
+
+        bool streamTextures = false; // 创建时确定，之后只读
+
+        // parsed 置位前写入，之后只读
+        size_t meshTotal = 0;
+        size_t textureTotal = 0;
+        double parseMs = 0.0;
+        bool fromCache = false;
+        std::shared_ptr<MeshCache> cache;        // 网格共享映射，全部上传后此处释放引用
+
+        std::atomic<bool> parsed{false};
+        std::atomic<bool> failed{false};
+    };
+
+    namespace
+    {
+        std::vector<std::string> uniqueTexturePaths(const std::vector<std::vector<std::pair<std::string, std::string>>> &refs)
+        {
+            std::vector<std::string> paths;
+            for (const auto &list : refs)
+                for (const auto &ref : list)
+                    if (std::find(paths.begin(), paths.end(), ref.second) == paths.end())
+                        paths.push_back(ref.second);
+            return paths;
+        }
+
+        void decodeTexturesAsync(const std::shared_ptr<ModelLoadShared> &shared, const std::vector<std::string> &paths,
+                                 const std::string &directory)
+        {
+            for (const auto &path : paths)
+            {
+                ThreadPool::getInstance().submit([shared, path, directory]()
+                                                 {
+                    ModelLoadShared::ReadyTexture ready;
+                    ready.path = path;
+                    try
+                    {
+                        std::string filename = directory + '/' + path;
+                        // 流式纹理的去重在上下文线程 insert 时进行
+                        if (shared->streamTextures)
+                            ready.decoded = TextureStreamer::decode(filename);
+                        else if (!(ready.cached = TextureCache::getInstance().find(filename)))
+                            ready.decoded = TextureCache::decode(filename);
+                    }
+                    catch (const std::exception &e)
+                    {
+                        ready.error = e.what();
+                    }
+                    std::lock_guard<std::mutex> lock(shared->mutex);
+                    shared->textures.push_back(std::move(ready)); });
+            }
+        }
+
+        bool loadFromCache(const std::shared_ptr<ModelLoadShared> &shared, const std::string &path, const std::string &directory)
+        {
+            auto cache = std::make_shared<MeshCache>();
+            if (!cache->open(MeshCache::cachePathFor(path), path))
+                return false;
+
+            std::vector<std::vector<std::pair<std::string, std::string>>> refs;
+            for (const CachedMesh &cached : cache->getMeshes())
+                refs.push_back(cached.textures);
+            std::vector<std::string> texturePaths = uniqueTexturePaths(refs);
+
+            shared->cache = cache;
+            shared->fromCache = true;
+            shared->meshTotal = cache->getMeshes().size();
+            shared->textureTotal = texturePaths.size();
+            shared->parsed = true;
+
+            decodeTexturesAsync(shared, texturePaths, directory);
+
+            // 缓存数据已是上传格式，直接全部入队
+            std::lock_guard<std::mutex> lock(shared->mutex);
+            for (const CachedMesh &cached : cache->getMeshes())
+            {
+                ModelLoadShared::ReadyMesh ready;
+                ready.cached = &cached;
+                ready.textures = cached.textures;
+                shared->meshes.push_back(std::move(ready));
+            }
+            return true;
+        }
+
+        void runImport(const std::shared_ptr<ModelLoadShared> &shared, const std::string &path, const std::string &directory)
+        {
+            const bool useCache = Model::isMeshCacheEnabled();
+            if (useCache && loadFromCache(shared, path, directory))
+                return;
+
+            auto start = std::chrono::steady_clock::now();
+            Assimp::Importer importer;
+            std::vector<std::string> openedFiles;
+            ModelImport::recordOpenedFiles(importer, openedFiles);
+            const aiScene *scene = importer.ReadFile(path, ModelImport::importFlags());
+            if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
+            {
+                std::lock_guard<std::mutex> lock(shared->mutex);
+                shared->error = std::string("ERROR::ASSIMP:: ") + importer.GetErrorString();
+                shared->failed = true;
+                return;
+            }
+
+            std::vector<ModelImport::ImportedMesh> imported;
+            ModelImport::collectMeshes(scene->mRootNode, scene, imported);
+
+            std::vector<std::vector<std::pair<std::string, std::string>>> refs;
+            for (const auto &mesh : imported)
+                refs.push_back(mesh.textures);
+            std::vector<std::string> texturePaths = uniqueTexturePaths(refs);
+
+            shared->meshTotal = imported.size();
+            shared->textureTotal = texturePaths.size();
+            shared->parseMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            shared->parsed = true;
+
+            decodeTexturesAsync(shared, texturePaths, directory);
+
+            // 每个网格处理完立即入队，上下文线程可以边处理边上传；
+            // 入队的数据归上下文线程所有（回调中可能修改），缓存从这里保留的副本写出
+            std::vector<ModelImport::ImportedMesh> cacheCopies(useCache ? imported.size() : 0);
+            ThreadPool::getInstance().parallelFor(0, imported.size(), [&](size_t i)
+                                                  {
+                ModelImport::ImportedMesh &mesh = imported[i];
+                ModelImport::convertMesh(mesh);
+                ModelImport::optimizeMesh(mesh);
+                if (useCache)
+                {
+                    cacheCopies[i].vertices = mesh.vertices;
+                    cacheCopies[i].indices = mesh.indices;
+                    cacheCopies[i].textures = mesh.textures;
+                }
+
+                std::lock_guard<std::mutex> lock(shared->mutex);
+                ModelImport::addVertexCacheStats(shared->totals, mesh);
+
+                ModelLoadShared::ReadyMesh ready;
+                ready.vertices = std::move(mesh.vertices);
+                ready.indices = std::move(mesh.indices);
+                ready.textures = std::move(mesh.textures);
+                shared->meshes.push_back(std::move(ready)); });
+
+            if (useCache)
+            {
+                std::vector<CachedMesh> views(cacheCopies.size());
+                for (size_t i = 0; i < cacheCopies.size(); ++i)
+                {
+                    views[i].vertices = cacheCopies[i].vertices.data();
+                    views[i].vertexCount = cacheCopies[i].vertices.size();
+                    views[i].indices = cacheCopies[i].indices.data();
+                    views[i].indexCount = cacheCopies[i].indices.size();
+                    views[i].textures = cacheCopies[i].textures;
+                }
+                MeshCache::write(MeshCache::cachePathFor(path), path, views, openedFiles);
+            }
+        }
+    }
+
+    ModelLoadHandle::ModelLoadHandle(const std::string &path)
+        : m_path(path), m_shared(std::make_shared<ModelLoadShared>()), m_start(std::chrono::steady_clock::now())
+    {
+    }
+
+    float ModelLoadHandle::getProgress() const
+    {
+        if (m_state == ModelLoadState::Ready)
+            return 1.0f;
+        if (!m_shared->parsed)
+            return 0.0f;
+        size_t total = m_shared->meshTotal + m_shared->textureTotal;
+        return total ? float(m_uploadedMeshes + m_uploadedTextures) / float(total) : 1.0f;
+    }
+
+    AsyncModelLoader &AsyncModelLoader::getInstance()
+    {
+        static AsyncModelLoader loader;
+        return loader;
+    }
+
+    AsyncModelLoader::AsyncModelLoader()
+    {
+        GLContext::getInstance().addTeardownCallback([this](uint64_t context)
+                                                     { releaseContext(context); });
+    }
+
+    void AsyncModelLoader::releaseContext(uint64_t context)
+    {
+        // 工作线程只持有 ModelLoadShared，解析结果随之丢弃
+        m_active.erase(std::remove_if(m_active.begin(), m_active.end(), [context](const std::shared_ptr<ModelLoadHandle> &handle)
+                                      { return handle->m_context == context; }),
+                       m_active.end());
+    }
+
+    std::shared_ptr<ModelLoadHandle> AsyncModelLoader::load(Renderer &renderer, const std::string &path)
+    {
+        std::shared_ptr<ModelLoadHandle> handle(new ModelLoadHandle(path));
+        handle->m_context = GLContext::getInstance().getCurrentId();
+        handle->m_model.reset(new Model(renderer));
+        handle->m_model->directory = path.substr(0, path.find_last_of('/'));
+        m_active.push_back(handle);
+
+        auto shared = handle->m_shared;
+        shared->streamTextures = Model::isTextureStreamingEnabled();
+        std::string directory = handle->m_model->directory;
+        ThreadPool::getInstance().submit([shared, path, directory]()
+                                         {
+            try
+            {
+                runImport(shared, path, directory);
+            }
+            catch (const std::exception &e)
+            {
+                std::lock_guard<std::mutex> lock(shared->mutex);
+                shared->error = e.what();
+                shared->failed = true;
+            } });
+        return handle;
+    }
+
+    void AsyncModelLoader::setUploadBudget(size_t bytesPerFrame, double millisecondsPerFrame)
+    {
+        m_budgetBytes = bytesPerFrame;
+        m_budgetMs = millisecondsPerFrame;
+    }
+
+    bool AsyncModelLoader::withinBudget() const
+    {
+        if (m_frameItems == 0)
+            return true;
+        if (m_budgetBytes > 0 && m_frameBytes >= m_budgetBytes)
+            return false;
+        if (m_budgetMs > 0.0 &&
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_frameStart).count() >= m_budgetMs)
+            return false;
+        return true;
+    }
+
+    std::shared_ptr<Texture2D> AsyncModelLoader::placeholderFor(ModelLoadHandle &handle, const std::string &type)
+    {
+        auto it = handle.m_placeholders.find(type);
+        if (it != handle.m_placeholders.end())
+            return it->second;
+
+        // 漫反射为白色，高光为黑色，法线为 (0,0,1)
+        unsigned char texel[4] = {255, 255, 255, 255};
+        if (type == "texture_specular")
+            texel[0] = texel[1] = texel[2] = 0;
+        else if (type == "texture_normal")
+            texel[0] = texel[1] = 128;
+
+        ImageData image;
+        image.pixels = std::shared_ptr<unsigned char>(new unsigned char[4]{texel[0], texel[1], texel[2], texel[3]},
+                                                      std::default_delete<unsigned char[]>());
+        image.width = image.height = 1;
+        image.channels = 4;
+        auto texture = std::make_shared<Texture2D>(image);
+        handle.m_placeholders[type] = texture;
+        return texture;
+    }
+
+    void AsyncModelLoader::update()
+    {
+        m_frameStart = std::chrono::steady_clock::now();
+        m_frameBytes = 0;
+        m_frameItems = 0;
+
+        // 回调中可能发起新的加载，遍历副本；只上传属于当前上下文的加载
+        const uint64_t context = GLContext::getInstance().getCurrentId();
+        auto active = m_active;
+        for (const auto &handle : active)
+        {
+            if (handle->m_context == context && process(handle))
+                m_active.erase(std::remove(m_active.begin(), m_active.end(), handle), m_active.end());
+        }
+    }
+
+    bool AsyncModelLoader::process(const std::shared_ptr<ModelLoadHandle> &handle)
+    {
+        ModelLoadShared &shared = *handle->m_shared;
+        Model &model = *handle->m_model;
+
+        if (shared.failed)
+        {
+            {
+                std::lock_guard<std::mutex> lock(shared.mutex);
+                handle->m_error = shared.error;
+            }
+            handle->m_state = ModelLoadState::Failed;
+            std::cerr << "AsyncModelLoader: failed to load " << handle->m_path << ": " << handle->m_error << std::endl;
+            if (handle->m_onComplete)
+                handle->m_onComplete(*handle);
+            return true;
+        }
+
+        bool progressed = false;
+
+        // 先上传纹理，替换已上传网格中的占位纹理
+        while (withinBudget())
+        {
+            ModelLoadShared::ReadyTexture ready;
+            {
+                std::lock_guard<std::mutex> lock(shared.mutex);
+                if (shared.textures.empty())
+                    break;
+                ready = std::move(shared.textures.front());
+                shared.textures.pop_front();
+            }
+
+            Texture texture;
+            texture.path = ready.path;
+            try
+            {
+                if (!ready.error.empty())
+                    throw std::runtime_error(ready.error);
+                if (ready.cached)
+                {
+                    texture.tex = ready.cached;
+                }
+                else if (shared.streamTextures)
+                {
+                    auto streaming = TextureStreamer::getInstance().insert(ready.decoded);
+                    m_frameBytes += streaming->getResidentBytes();
+                    texture.tex = streaming;
+                }
+                else
+                {
+                    texture.tex = TextureCache::getInstance().insert(ready.decoded);
+                    m_frameBytes += ready.decoded.uploadBytes();
+                }
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << "Texture failed to load at path: " << model.directory + '/' + ready.path << "\n"
+                          << e.what() << std::endl;
+            }
+            model.textures_loaded.push_back(texture);
+
+            if (texture.tex)
+            {
+                for (auto &mesh : model.meshes)
+                    for (size_t i = 0; i < mesh.textures.size(); ++i)
+                        if (mesh.textures[i].path == ready.path)
+                            mesh.setTexture(i, texture.tex);
+            }
+
+            ++handle->m_uploadedTextures;
+            ++m_frameItems;
+            progressed = true;
+        }
+
+        while (withinBudget())
+        {
+            ModelLoadShared::ReadyMesh ready;
+            {
+                std::lock_guard<std::mutex> lock(shared.mutex);
+                if (shared.meshes.empty())
+                    break;
+                ready = std::move(shared.meshes.front());
+                shared.meshes.pop_front();
+            }
+
+            std::vector<Texture> textures;
+            textures.reserve(ready.textures.size());
+            for (const auto &ref : ready.textures)
+            {
+                Texture texture;
+                texture.type = ref.first;
+                texture.path = ref.second;
+                auto loaded = std::find_if(model.textures_loaded.begin(), model.textures_loaded.end(),
+                                           [&](const Texture &t)
+                                           { return t.path == ref.second; });
+                if (loaded != model.textures_loaded.end() && loaded->tex)
+                    texture.tex = loaded->tex;
+                else
+                    texture.tex = placeholderFor(*handle, ref.first);
+                textures.push_back(std::move(texture));
+            }
+
+            if (model.meshes.capacity() < shared.meshTotal)
+                model.meshes.reserve(shared.meshTotal);
+
+            if (ready.cached)
+            {
+                const CachedMesh &cached = *ready.cached;
+                model.meshes.emplace_back(model.m_Renderer, shared.cache, cached.vertices, cached.vertexCount,
+                                          cached.indices, cached.indexCount, std::move(textures),
+                                          cached.boundsMin, cached.boundsMax);
+                m_frameBytes += cached.vertexCount * sizeof(Vertex) + cached.indexCount * sizeof(unsigned int);
+            }
+            else
+            {
+                m_frameBytes += ready.vertices.size() * sizeof(Vertex) + ready.indices.size() * sizeof(unsigned int);
+                model.meshes.emplace_back(model.m_Renderer, std::move(ready.vertices), std::move(ready.indices), std::move(textures));
+            }
+
+            ++handle->m_uploadedMeshes;
+            ++m_frameItems;
+            progressed = true;
+        }
+
+        if (progressed && handle->m_onProgress)
+            handle->m_onProgress(handle->getProgress());
+
+        if (!shared.parsed || handle->m_uploadedMeshes < shared.meshTotal || handle->m_uploadedTextures < shared.textureTotal)
+            return false;
+
+        // 全部上传完成
+        shared.cache.reset();
+        handle->m_state = ModelLoadState::Ready;
+
+        model.m_stats.fromMeshCache = shared.fromCache;
+        model.m_stats.loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - handle->m_start).count();
+        model.m_stats.parseMs = shared.parseMs;
+        model.m_stats.loadThreads = ThreadPool::getInstance().getThreadCount() + 1;
+        {
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            model.m_stats.triangles = shared.totals.triangles;
+            model.m_stats.vertices = shared.totals.vertices;
+            model.m_stats.transformedBefore = shared.totals.transformedBefore;
+            model.m_stats.transformedAfter = shared.totals.transformedAfter;
+        }
+
+        if (handle->m_onComplete)
+            handle->m_onComplete(*handle);
+        return true;
+    }
+}
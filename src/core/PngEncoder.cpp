@@ -0,0 +1,342 @@
+#include "OxygenRender/PngEncoder.h"
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace OxyRender
+{
+    namespace
+    {
+        constexpr uint32_t kWindowSize = 32768;
+        constexpr uint32_t kMaxMatch = 258;
+        constexpr int kHashBits = 15;
+        constexpr uint32_t kMaxInsertLength = 32;
+
+        constexpr uint16_t kLengthBase[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                              35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+        constexpr uint8_t kLengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                              3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+        constexpr uint16_t kDistanceBase[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129,
+                                                193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097,
+                                                6145, 8193, 12289, 16385, 24577};
+        constexpr uint8_t kDistanceExtra[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6,
+                                                6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+        uint32_t reverseBits(uint32_t code, int length)
+        {
+            uint32_t result = 0;
+            for (int i = 0; i < length; ++i)
+                result |= ((code >> i) & 1u) << (length - 1 - i);
+            return result;
+        }
+
+        // 固定 Huffman 表（RFC 1951 3.2.6），码字已按写出顺序反转
+        struct FixedTables
+        {
+            uint16_t literalCode[288];
+            uint8_t literalBits[288];
+            uint8_t distanceCode[30];
+            uint8_t lengthSymbol[kMaxMatch + 1]; // 长度 -> 下标（0~28）
+            uint8_t distanceSymbol[kWindowSize + 1];
+
+            FixedTables()
+            {
+                for (uint32_t s = 0; s < 288; ++s)
+                {
+                    uint32_t code;
+                    int bits;
+                    if (s < 144)
+                        code = 0x30 + s, bits = 8;
+                    else if (s < 256)
+                        code = 0x190 + (s - 144), bits = 9;
+                    else if (s < 280)
+                        code = s - 256, bits = 7;
+                    else
+                        code = 0xC0 + (s - 280), bits = 8;
+                    literalCode[s] = static_cast<uint16_t>(reverseBits(code, bits));
+                    literalBits[s] = static_cast<uint8_t>(bits);
+                }
+                for (uint32_t d = 0; d < 30; ++d)
+                    distanceCode[d] = static_cast<uint8_t>(reverseBits(d, 5));
+                for (uint32_t i = 0, length = 3; length <= kMaxMatch; ++length)
+                {
+                    while (i < 28 && kLengthBase[i + 1] <= length)
+                        ++i;
+                    lengthSymbol[length] = static_cast<uint8_t>(i);
+                }
+                for (uint32_t i = 0, distance = 1; distance <= kWindowSize; ++distance)
+                {
+                    while (i < 29 && kDistanceBase[i + 1] <= distance)
+                        ++i;
+                    distanceSymbol[distance] = static_cast<uint8_t>(i);
+                }
+            }
+        };
+
+        const FixedTables &fixedTables()
+        {
+            static const FixedTables tables;
+            return tables;
+        }
+
+        // 低位在前的位流
+        class BitWriter
+        {
+        public:
+            explicit BitWriter(std::vector<unsigned char> &out) : m_out(out) {}
+
+            void put(uint32_t value, int bits)
+            {
+                m_buffer |= uint64_t(value) << m_count;
+                m_count += bits;
+                while (m_count >= 8)
+                {
+                    m_out.push_back(static_cast<unsigned char>(m_buffer));
+                    m_buffer >>= 8;
+                    m_count -= 8;
+                }
+            }
+
+            void flush()
+            {
+                if (m_count > 0)
+                    m_out.push_back(static_cast<unsigned char>(m_buffer));
+                m_buffer = 0;
+                m_count = 0;
+            }
+
+        private:
+            std::vector<unsigned char> &m_out;
+            uint64_t m_buffer = 0;
+            int m_count = 0;
+        };
+
+        uint32_t adler32(const unsigned char *data, size_t size)
+        {
+            uint32_t a = 1, b = 0;
+            while (size > 0)
+            {
+                // 5552 是 b 不溢出 32 位的最大块长
+                size_t block = std::min<size_t>(size, 5552);
+                size -= block;
+                while (block--)
+                {
+                    a += *data++;
+                    b += a;
+                }
+                a %= 65521;
+                b %= 65521;
+            }
+            return (b << 16) | a;
+        }
+
+        uint32_t crc32(const unsigned char *data, size_t size, uint32_t crc = 0)
+        {
+            static const std::array<uint32_t, 256> table = []()
+            {
+                std::array<uint32_t, 256> t{};
+                for (uint32_t n = 0; n < 256; ++n)
+                {
+                    uint32_t c = n;
+                    for (int k = 0; k < 8; ++k)
+                        c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                    t[n] = c;
+                }
+                return t;
+            }();
+            crc = ~crc;
+            for (size_t i = 0; i < size; ++i)
+                crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+            return ~crc;
+        }
+
+        // zlib 流：单个固定 Huffman 块
+        std::vector<unsigned char> deflate(const unsigned char *data, size_t size)
+        {
+            const FixedTables &tables = fixedTables();
+            std::vector<unsigned char> out;
+            out.reserve(size / 4 + 64);
+            out.push_back(0x78);
+            out.push_back(0x01);
+
+            BitWriter bits(out);
+            bits.put(1, 1); // BFINAL
+            bits.put(1, 2); // BTYPE = 固定 Huffman
+
+            auto literal = [&](uint32_t symbol)
+            {
+                bits.put(tables.literalCode[symbol], tables.literalBits[symbol]);
+            };
+            auto hash = [&](size_t pos)
+            {
+                uint32_t v = uint32_t(data[pos]) | (uint32_t(data[pos + 1]) << 8) | (uint32_t(data[pos + 2]) << 16);
+                return (v * 2654435761u) >> (32 - kHashBits);
+            };
+
+            std::vector<int32_t> head(size_t(1) << kHashBits, -1);
+            size_t pos = 0;
+            while (pos < size)
+            {
+                uint32_t length = 0;
+                size_t distance = 0;
+                if (pos + 3 <= size)
+                {
+                    uint32_t h = hash(pos);
+                    int32_t candidate = head[h];
+                    head[h] = static_cast<int32_t>(pos);
+                    if (candidate >= 0 && pos - size_t(candidate) <= kWindowSize)
+                    {
+                        const size_t maxLength = std::min<size_t>(kMaxMatch, size - pos);
+                        const unsigned char *a = data + candidate;
+                        const unsigned char *b = data + pos;
+                        while (length < maxLength && a[length] == b[length])
+                            ++length;
+                        distance = pos - size_t(candidate);
+                    }
+                }
+
+                if (length < 3)
+                {
+                    literal(data[pos]);
+                    ++pos;
+                    continue;
+                }
+
+                uint32_t li = tables.lengthSymbol[length];
+                literal(257 + li);
+                if (kLengthExtra[li])
+                    bits.put(length - kLengthBase[li], kLengthExtra[li]);
+                uint32_t di = tables.distanceSymbol[distance];
+                bits.put(tables.distanceCode[di], 5);
+                if (kDistanceExtra[di])
+                    bits.put(uint32_t(distance - kDistanceBase[di]), kDistanceExtra[di]);
+
+                // 短匹配内部的位置也登记到哈希表；长匹配（多为大片重复）跳过，省去逐字节登记
+                const size_t end = pos + length;
+                if (length <= kMaxInsertLength)
+                {
+                    for (++pos; pos < end; ++pos)
+                    {
+                        if (pos + 3 <= size)
+                            head[hash(pos)] = static_cast<int32_t>(pos);
+                    }
+                }
+                pos = end;
+            }
+            literal(256);
+            bits.flush();
+
+            uint32_t checksum = adler32(data, size);
+            for (int shift = 24; shift >= 0; shift -= 8)
+                out.push_back(static_cast<unsigned char>(checksum >> shift));
+            return out;
+        }
+
+        void putU32(std::vector<unsigned char> &out, uint32_t value)
+        {
+            for (int shift = 24; shift >= 0; shift -= 8)
+                out.push_back(static_cast<unsigned char>(value >> shift));
+        }
+
+        void putChunk(std::vector<unsigned char> &out, const char type[4], const unsigned char *data, size_t size)
+        {
+            putU32(out, static_cast<uint32_t>(size));
+            size_t start = out.size();
+            out.insert(out.end(), type, type + 4);
+            if (size > 0)
+                out.insert(out.end(), data, data + size);
+            putU32(out, crc32(out.data() + start, size + 4));
+        }
+    }
+
+    std::vector<unsigned char> PngEncoder::encode(const unsigned char *pixels, uint32_t width, uint32_t height,
+                                                  uint32_t channels, bool flipVertically)
+    {
+        if (!pixels || width == 0 || height == 0 || channels < 1 || channels > 4)
+            throw std::runtime_error("PngEncoder: invalid image");
+
+        // 每行前加一个滤波类型字节
+        const size_t stride = size_t(width) * channels;
+        std::vector<unsigned char> filtered((stride + 1) * height);
+        const unsigned char *previous = nullptr;
+        for (uint32_t y = 0; y < height; ++y)
+        {
+            const unsigned char *row = pixels + stride * (flipVertically ? height - 1 - y : y);
+            unsigned char *dst = filtered.data() + (stride + 1) * y;
+
+            // 先只估算三种滤波的代价（有符号残差绝对值和），再写出最小者
+            uint32_t costNone = 0, costSub = 0, costUp = 0;
+            for (size_t x = 0; x < stride; ++x)
+            {
+                unsigned char left = x >= channels ? row[x - channels] : 0;
+                unsigned char up = previous ? previous[x] : 0;
+                costNone += std::abs(int(static_cast<signed char>(row[x])));
+                costSub += std::abs(int(static_cast<signed char>(row[x] - left)));
+                costUp += std::abs(int(static_cast<signed char>(row[x] - up)));
+            }
+
+            unsigned char *out = dst + 1;
+            if (costSub <= costNone && costSub <= costUp)
+            {
+                dst[0] = 1;
+                std::memcpy(out, row, std::min<size_t>(channels, stride));
+                for (size_t x = channels; x < stride; ++x)
+                    out[x] = static_cast<unsigned char>(row[x] - row[x - channels]);
+            }
+            else if (previous && costUp < costNone)
+            {
+                dst[0] = 2;
+                for (size_t x = 0; x < stride; ++x)
+                    out[x] = static_cast<unsigned char>(row[x] - previous[x]);
+            }
+            else
+            {
+                dst[0] = 0;
+                std::memcpy(out, row, stride);
+            }
+            previous = row;
+        }
+
+        static const unsigned char kColorTypes[5] = {0, 0, 4, 2, 6};
+        unsigned char header[13];
+        for (int i = 0; i < 4; ++i)
+        {
+            header[i] = static_cast<unsigned char>(width >> (24 - 8 * i));
+            header[4 + i] = static_cast<unsigned char>(height >> (24 - 8 * i));
+        }
+        header[8] = 8; // 位深
+        header[9] = kColorTypes[channels];
+        header[10] = 0; // deflate
+        header[11] = 0; // 自适应滤波
+        header[12] = 0; // 不隔行
+
+        std::vector<unsigned char> compressed = deflate(filtered.data(), filtered.size());
+
+        static const unsigned char kSignature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        std::vector<unsigned char> png(kSignature, kSignature + 8);
+        png.reserve(compressed.size() + 64);
+        putChunk(png, "IHDR", header, sizeof(header));
+        putChunk(png, "IDAT", compressed.data(), compressed.size());
+        putChunk(png, "IEND", nullptr, 0);
+        return png;
+    }
+
+    std::vector<unsigned char> PngEncoder::encode(const ImageData &image, bool flipVertically)
+    {
+        return encode(image.pixels.get(), image.width, image.height, image.channels, flipVertically);
+    }
+
+    void PngEncoder::write(const std::string &path, const ImageData &image, bool flipVertically)
+    {
+        std::vector<unsigned char> png = encode(image, flipVertically);
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+            throw std::runtime_error("Failed to write PNG: " + path);
+        file.write(reinterpret_cast<const char *>(png.data()), std::streamsize(png.size()));
+        if (!file)
+            throw std::runtime_error("Failed to write PNG: " + path);
+    }
+}
@@ -0,0 +1,473 @@
+#include "OxygenRender/ProgramCache.h"
+#include <glad/glad.h>
+#include "OxygenRender/GLContext.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace OxyRender
+{
+    namespace
+    {
+        // GLAD 只生成了 GL 3.3 core，程序二进制相关入口手动加载
+        constexpr GLenum kProgramBinaryRetrievableHint = 0x8257;
+        constexpr GLenum kProgramBinaryLength = 0x8741;
+        constexpr GLenum kNumProgramBinaryFormats = 0x87FE;
+        constexpr GLenum kCompletionStatus = 0x91B1; // KHR/ARB_parallel_shader_compile
+
+        using GetProgramBinaryFn = void(APIENTRY *)(GLuint, GLsizei, GLsizei *, GLenum *, void *);
+        using ProgramBinaryFn = void(APIENTRY *)(GLuint, GLenum, const void *, GLsizei);
+        using ProgramParameteriFn = void(APIENTRY *)(GLuint, GLenum, GLint);
+        using MaxShaderCompilerThreadsFn = void(APIENTRY *)(GLuint);
+
+        GetProgramBinaryFn s_getProgramBinary = nullptr;
+        ProgramBinaryFn s_programBinary = nullptr;
+        ProgramParameteriFn s_programParameteri = nullptr;
+
+        // .oxprog 文件：Header | 驱动返回的二进制
+        constexpr uint32_t kMagic = 0x4250584F; // "OXPB"
+        constexpr uint32_t kVersion = 1;
+
+        struct Header
+        {
+            uint32_t magic;
+            uint32_t version;
+            uint64_t key;
+            uint32_t binaryFormat;
+            uint32_t binaryLength;
+        };
+
+        void hashBytes(uint64_t &hash, const void *data, size_t size)
+        {
+            const unsigned char *bytes = static_cast<const unsigned char *>(data);
+            for (size_t i = 0; i < size; ++i)
+            {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+        }
+
+        void hashString(uint64_t &hash, const char *str)
+        {
+            // 含结尾 '\0'，避免拼接歧义
+            hashBytes(hash, str ? str : "", str ? std::strlen(str) + 1 : 1);
+        }
+
+        // 只提交编译，不查询结果（查询会等待编译完成）
+        GLuint submitShader(GLenum type, const std::string &source)
+        {
+            GLuint shader = glCreateShader(type);
+            const char *src = source.c_str();
+            glShaderSource(shader, 1, &src, nullptr);
+            glCompileShader(shader);
+            return shader;
+        }
+
+        std::string sourcePrefix(const std::string &source)
+        {
+            std::string prefix = source.substr(0, 120);
+            for (char &ch : prefix) { if (ch == '\n') ch = ' '; }
+            return prefix;
+        }
+
+        // 编译失败时返回错误信息，成功时返回空串
+        std::string shaderError(GLuint shader, const std::string &prefix)
+        {
+            GLint success;
+            glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+            if (success)
+                return std::string();
+            char log[1024] = {0};
+            glGetShaderInfoLog(shader, 1024, nullptr, log);
+            return std::string("Shader compilation failed: ") + log + " | Source prefix: " + prefix;
+        }
+
+        std::string linkError(GLuint program)
+        {
+            GLint success;
+            glGetProgramiv(program, GL_LINK_STATUS, &success);
+            if (success)
+                return std::string();
+            char log[512] = {0};
+            glGetProgramInfoLog(program, 512, nullptr, log);
+            return std::string("Program linking failed: ") + log;
+        }
+    }
+
+    ProgramCache &ProgramCache::getInstance()
+    {
+        static ProgramCache cache;
+        return cache;
+    }
+
+    ProgramCache::ProgramCache()
+    {
+        GLContext::getInstance().addTeardownCallback([this](uint64_t context)
+                                                     { releaseContext(context); });
+    }
+
+    void ProgramCache::releaseContext(uint64_t context)
+    {
+        const std::string prefix = contextPrefix(context);
+        for (auto it = m_programs.begin(); it != m_programs.end();)
+        {
+            if (it->first.compare(0, prefix.size(), prefix) == 0)
+                it = m_programs.erase(it);
+            else
+                ++it;
+        }
+        m_pending.erase(std::remove_if(m_pending.begin(), m_pending.end(), [context](const PendingProgram &pending)
+                                       { return pending.context == context; }),
+                        m_pending.end());
+        m_contextGeneration = 0;
+        syncContext();
+    }
+
+    std::string ProgramCache::contextPrefix(uint64_t context)
+    {
+        return std::to_string(context) + '\0';
+    }
+
+    void ProgramCache::syncContext()
+    {
+        // 能力与入口地址属于上下文，上下文更换后重新检测
+        const uint64_t generation = GLContext::getInstance().getGeneration();
+        if (m_contextGeneration == generation)
+            return;
+        m_contextGeneration = generation;
+        m_binarySupport = -1;
+        m_parallelSupport = -1;
+        s_getProgramBinary = nullptr;
+        s_programBinary = nullptr;
+        s_programParameteri = nullptr;
+    }
+
+    bool ProgramCache::isBinarySupported()
+    {
+        syncContext();
+        if (m_binarySupport >= 0)
+            return m_binarySupport == 1;
+
+        m_binarySupport = 0;
+        GLContext &context = GLContext::getInstance();
+        if (context.hasVersion(4, 1) || context.hasExtension("GL_ARB_get_program_binary"))
+        {
+            s_getProgramBinary = reinterpret_cast<GetProgramBinaryFn>(context.getProcAddress("glGetProgramBinary"));
+            s_programBinary = reinterpret_cast<ProgramBinaryFn>(context.getProcAddress("glProgramBinary"));
+            s_programParameteri = reinterpret_cast<ProgramParameteriFn>(context.getProcAddress("glProgramParameteri"));
+
+            // 部分驱动声明支持但不提供任何二进制格式
+            GLint formats = 0;
+            glGetIntegerv(kNumProgramBinaryFormats, &formats);
+            if (s_getProgramBinary && s_programBinary && s_programParameteri && formats > 0)
+                m_binarySupport = 1;
+        }
+        return m_binarySupport == 1;
+    }
+
+    bool ProgramCache::isParallelCompileSupported()
+    {
+        syncContext();
+        if (m_parallelSupport >= 0)
+            return m_parallelSupport == 1;
+
+        m_parallelSupport = 0;
+        GLContext &context = GLContext::getInstance();
+        const char *entry = nullptr;
+        if (context.hasExtension("GL_KHR_parallel_shader_compile"))
+            entry = "glMaxShaderCompilerThreadsKHR";
+        else if (context.hasExtension("GL_ARB_parallel_shader_compile"))
+            entry = "glMaxShaderCompilerThreadsARB";
+        if (entry)
+        {
+            // 让驱动自行决定编译线程数
+            auto maxThreads = reinterpret_cast<MaxShaderCompilerThreadsFn>(context.getProcAddress(entry));
+            if (maxThreads)
+                maxThreads(0xFFFFFFFFu);
+            m_parallelSupport = 1;
+        }
+        return m_parallelSupport == 1;
+    }
+
+    bool ProgramCache::isReady(OpenGLProgram &program)
+    {
+        if (!program.isPending())
+            return true;
+        if (!isParallelCompileSupported())
+            return false;
+        GLint complete = GL_FALSE;
+        glGetProgramiv(program.getID(), kCompletionStatus, &complete);
+        return complete == GL_TRUE;
+    }
+
+    size_t ProgramCache::getPendingCount()
+    {
+        const uint64_t context = GLContext::getInstance().getCurrentId();
+        size_t count = 0;
+        for (auto it = m_pending.begin(); it != m_pending.end();)
+        {
+            if (it->context != context)
+            {
+                ++it;
+                continue;
+            }
+            auto program = it->program.lock();
+            if (!program || !program->isPending())
+            {
+                it = m_pending.erase(it);
+                continue;
+            }
+            ++count;
+            ++it;
+        }
+        return count;
+    }
+
+    void ProgramCache::finishPending()
+    {
+        // 只等待当前上下文的程序，其他上下文的留给它们自己
+        const uint64_t context = GLContext::getInstance().getCurrentId();
+        std::string firstError;
+        for (auto &entry : m_pending)
+        {
+            auto program = entry.context == context ? entry.program.lock() : nullptr;
+            if (!program)
+                continue;
+            try
+            {
+                program->finish();
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << "ProgramCache: " << e.what() << std::endl;
+                if (firstError.empty())
+                    firstError = e.what();
+            }
+        }
+        m_pending.erase(std::remove_if(m_pending.begin(), m_pending.end(), [context](const PendingProgram &pending)
+                                       { return pending.context == context; }),
+                        m_pending.end());
+        if (!firstError.empty())
+            throw std::runtime_error(firstError);
+    }
+
+    std::shared_ptr<OpenGLProgram> ProgramCache::acquire(const std::string &name, const std::string &vertexSource,
+                                                         const std::string &fragmentSource)
+    {
+        // 程序不能跨上下文共享，键以当前上下文开头
+        std::string sourceKey = contextPrefix(GLContext::getInstance().getCurrentId());
+        sourceKey.reserve(sourceKey.size() + vertexSource.size() + fragmentSource.size() + 1);
+        sourceKey.append(vertexSource).push_back('\0');
+        sourceKey.append(fragmentSource);
+
+        auto it = m_programs.find(sourceKey);
+        if (it != m_programs.end())
+        {
+            if (auto program = it->second.lock())
+            {
+                ++m_stats.shared;
+                return program;
+            }
+        }
+
+        const bool useDisk = !m_directory.empty() && isBinarySupported();
+        uint64_t key = 0;
+        std::string path;
+        GLuint programId = 0;
+        if (useDisk)
+        {
+            key = binaryKey(vertexSource, fragmentSource);
+            path = binaryPath(key);
+            programId = loadBinary(path, key);
+        }
+        std::shared_ptr<OpenGLProgram> program;
+        if (programId)
+        {
+            ++m_stats.diskHits;
+            program = std::make_shared<OpenGLProgram>(name, programId);
+        }
+        else
+        {
+            program = compile(name, vertexSource, fragmentSource, useDisk ? path : std::string(), key);
+        }
+
+        // 顺带清理已释放的条目
+        for (auto entry = m_programs.begin(); entry != m_programs.end();)
+        {
+            if (entry->second.expired())
+                entry = m_programs.erase(entry);
+            else
+                ++entry;
+        }
+        m_programs[std::move(sourceKey)] = program;
+        return program;
+    }
+
+    std::shared_ptr<OpenGLProgram> ProgramCache::compile(const std::string &name, const std::string &vertexSource,
+                                                         const std::string &fragmentSource, const std::string &binaryPath,
+                                                         uint64_t key)
+    {
+        if (m_async)
+            isParallelCompileSupported();
+
+        GLuint vertexShader = submitShader(GL_VERTEX_SHADER, vertexSource);
+        GLuint fragmentShader = submitShader(GL_FRAGMENT_SHADER, fragmentSource);
+        GLuint program = glCreateProgram();
+        glAttachShader(program, vertexShader);
+        glAttachShader(program, fragmentShader);
+        if (!binaryPath.empty())
+            s_programParameteri(program, kProgramBinaryRetrievableHint, GL_TRUE);
+        glLinkProgram(program);
+        // 已附加的着色器只是标记删除，仍可查询编译日志，随程序一起释放；
+        // 异步模式下程序可能在检查结果前就被销毁，不能把删除推迟到 finishLink
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragmentShader);
+        ++m_stats.compiled;
+
+        // 检查编译与链接结果；异步模式下推迟到程序首次使用
+        std::string vertexPrefix = sourcePrefix(vertexSource);
+        std::string fragmentPrefix = sourcePrefix(fragmentSource);
+        auto finishLink = [this, program, vertexShader, fragmentShader, vertexPrefix, fragmentPrefix, binaryPath, key]()
+        {
+            std::string error = shaderError(vertexShader, vertexPrefix);
+            if (error.empty())
+                error = shaderError(fragmentShader, fragmentPrefix);
+            if (error.empty())
+                error = linkError(program);
+            if (!error.empty())
+                throw std::runtime_error(error);
+            if (!binaryPath.empty())
+                storeBinary(program, binaryPath, key);
+        };
+
+        if (!m_async)
+        {
+            try
+            {
+                finishLink();
+            }
+            catch (...)
+            {
+                glDeleteProgram(program);
+                throw;
+            }
+            return std::make_shared<OpenGLProgram>(name, program);
+        }
+
+        auto pending = std::make_shared<OpenGLProgram>(name, program, std::move(finishLink));
+        m_pending.push_back({GLContext::getInstance().getCurrentId(), pending});
+        return pending;
+    }
+
+    uint64_t ProgramCache::binaryKey(const std::string &vertexSource, const std::string &fragmentSource)
+    {
+        // 驱动或显卡变化时二进制不再可用，把它们计入键
+        uint64_t hash = 14695981039346656037ull;
+        hashString(hash, reinterpret_cast<const char *>(glGetString(GL_VENDOR)));
+        hashString(hash, reinterpret_cast<const char *>(glGetString(GL_RENDERER)));
+        hashString(hash, reinterpret_cast<const char *>(glGetString(GL_VERSION)));
+        hashString(hash, vertexSource.c_str());
+        hashString(hash, fragmentSource.c_str());
+        return hash;
+    }
+
+    std::string ProgramCache::binaryPath(uint64_t key) const
+    {
+        char file[32];
+        std::snprintf(file, sizeof(file), "%016llx.oxprog", static_cast<unsigned long long>(key));
+        return (std::filesystem::path(m_directory) / file).string();
+    }
+
+    GLuint ProgramCache::loadBinary(const std::string &path, uint64_t key)
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+            return 0;
+
+        // 长度字段须与文件大小相符，损坏的文件不能导致超大分配
+        std::error_code sizeError;
+        const uintmax_t fileSize = std::filesystem::file_size(path, sizeError);
+        Header header{};
+        in.read(reinterpret_cast<char *>(&header), sizeof(header));
+        std::vector<char> binary;
+        if (in && !sizeError && header.magic == kMagic && header.version == kVersion && header.key == key &&
+            header.binaryLength > 0 && header.binaryLength == fileSize - sizeof(Header))
+        {
+            binary.resize(header.binaryLength);
+            in.read(binary.data(), static_cast<std::streamsize>(binary.size()));
+        }
+        if (!in || binary.empty())
+        {
+            in.close();
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+            ++m_stats.diskRejected;
+            return 0;
+        }
+        in.close();
+
+        GLuint program = glCreateProgram();
+        s_programBinary(program, header.binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+        GLint success = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+        if (!success)
+        {
+            // 驱动更新后旧二进制可能失效，删除后由调用方重新编译并写回
+            glDeleteProgram(program);
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+            ++m_stats.diskRejected;
+            return 0;
+        }
+        return program;
+    }
+
+    void ProgramCache::storeBinary(GLuint program, const std::string &path, uint64_t key)
+    {
+        GLint length = 0;
+        glGetProgramiv(program, kProgramBinaryLength, &length);
+        if (length <= 0)
+            return;
+
+        std::vector<char> binary(static_cast<size_t>(length));
+        GLenum format = 0;
+        GLsizei written = 0;
+        s_getProgramBinary(program, length, &written, &format, binary.data());
+        if (written <= 0)
+            return;
+
+        std::error_code ec;
+        std::filesystem::create_directories(m_directory, ec);
+
+        Header header{kMagic, kVersion, key, format, static_cast<uint32_t>(written)};
+        // 先写临时文件再改名，避免中途失败留下损坏的缓存
+        std::string tempPath = path + ".tmp";
+        {
+            std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+            if (!out)
+            {
+                std::cerr << "ProgramCache: cannot write " << tempPath << std::endl;
+                return;
+            }
+            out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            out.write(binary.data(), written);
+            if (!out)
+            {
+                std::cerr << "ProgramCache: failed writing " << tempPath << std::endl;
+                return;
+            }
+        }
+        std::filesystem::rename(tempPath, path, ec);
+        if (ec)
+        {
+            std::cerr << "ProgramCache: cannot replace " << path << ": " << ec.message() << std::endl;
+            std::filesystem::remove(tempPath, ec);
+            return;
+        }
+        ++m_stats.stored;
+    }
+}
@@ -0,0 +1,154 @@
+#include "OxygenRender/RenderQueue.h"
+#include "OxygenRender/Material.h"
+#include "OxygenRender/Shader.h"
+#include <algorithm>
+#include <chrono>
+
+namespace OxyRender
+{
+    namespace
+    {
+        constexpr UniformID kModel("model");
+        constexpr UniformID kNormalMatrix("normalMatrix");
+        constexpr uint32_t kDepthMax = (1u << 24) - 1;
+    }
+
+    RenderQueue::RenderQueue(Renderer &renderer) : m_renderer(renderer)
+    {
+    }
+
+    void RenderQueue::setDepthRange(float nearDistance, float farDistance)
+    {
+        m_depthNear = nearDistance;
+        m_depthScale = farDistance > nearDistance ? 1.0f / (farDistance - nearDistance) : 0.0f;
+    }
+
+    uint64_t RenderQueue::makeKey(uint8_t layer, bool translucent, uint32_t pipelineId, uint32_t materialId, uint32_t depth24)
+    {
+        uint64_t key = uint64_t(layer & 0xFu) << 60;
+        const uint64_t pipeline = pipelineId & 0xFFFFu;
+        const uint64_t material = materialId & 0xFFFFu;
+        const uint64_t depth = depth24 & kDepthMax;
+        if (!translucent)
+            return key | (pipeline << 43) | (material << 27) | (depth << 3);
+        return key | (uint64_t(1) << 59) | (uint64_t(kDepthMax - depth) << 35) | (pipeline << 19) | (material << 3);
+    }
+
+    void RenderQueue::submit(const DrawPacket &packet)
+    {
+        if (!packet.pipeline || !packet.vertexArray || packet.indexCount == 0)
+            return;
+
+        float normalized = std::clamp((packet.depth - m_depthNear) * m_depthScale, 0.0f, 1.0f);
+        uint32_t depth = static_cast<uint32_t>(normalized * kDepthMax);
+        uint32_t material = packet.material ? packet.material->getId() : 0;
+        m_entries.push_back(Entry{makeKey(packet.layer, packet.translucent, packet.pipeline->getId(), material, depth),
+                                  static_cast<uint32_t>(m_packets.size())});
+        m_packets.push_back(packet);
+    }
+
+    void RenderQueue::clear()
+    {
+        m_packets.clear();
+        m_entries.clear();
+    }
+
+    void RenderQueue::sort()
+    {
+        // LSD 基数排序，每趟 8 位；所有键在该字节相同时跳过这一趟
+        const size_t count = m_entries.size();
+        m_scratch.resize(count);
+        Entry *src = m_entries.data();
+        Entry *dst = m_scratch.data();
+        for (int shift = 0; shift < 64; shift += 8)
+        {
+            size_t offsets[256] = {0};
+            for (size_t i = 0; i < count; ++i)
+                ++offsets[(src[i].key >> shift) & 0xFFu];
+            if (offsets[(src[0].key >> shift) & 0xFFu] == count)
+                continue;
+
+            size_t sum = 0;
+            for (size_t &offset : offsets)
+            {
+                size_t n = offset;
+                offset = sum;
+                sum += n;
+            }
+            for (size_t i = 0; i < count; ++i)
+                dst[offsets[(src[i].key >> shift) & 0xFFu]++] = src[i];
+            std::swap(src, dst);
+        }
+        if (src != m_entries.data())
+            m_entries.swap(m_scratch);
+    }
+
+    void RenderQueue::execute()
+    {
+        const PipelineState *pipeline = nullptr;
+        Shader *shader = nullptr;
+        Material *material = nullptr;
+        const VertexArray *vertexArray = nullptr;
+        const glm::mat4 *model = nullptr;
+
+        for (const Entry &entry : m_entries)
+        {
+            const DrawPacket &packet = m_packets[entry.index];
+            if (packet.pipeline != pipeline)
+            {
+                m_renderer.bindPipeline(*packet.pipeline);
+                pipeline = packet.pipeline;
+                ++m_stats.pipelineChanges;
+                if (pipeline->getDesc().shader != shader)
+                {
+                    // 换了程序，材质采样器与矩阵需重新设置
+                    shader = pipeline->getDesc().shader;
+                    material = nullptr;
+                    model = nullptr;
+                }
+            }
+            if (shader && packet.material && packet.material != material)
+            {
+                packet.material->bind(*shader);
+                material = packet.material;
+                ++m_stats.materialChanges;
+            }
+            if (shader && (!model || *model != packet.model))
+            {
+                shader->setMat4(kModel, packet.model);
+                shader->setMat3(kNormalMatrix, glm::transpose(glm::inverse(glm::mat3(packet.model))));
+                model = &packet.model;
+                ++m_stats.matrixChanges;
+            }
+            if (packet.vertexArray != vertexArray)
+            {
+                vertexArray = packet.vertexArray;
+                ++m_stats.vertexArrayChanges;
+            }
+            m_renderer.drawTriangles(*packet.vertexArray, packet.indexCount, packet.firstIndex);
+        }
+    }
+
+    void RenderQueue::flush()
+    {
+        m_stats = RenderQueueStats();
+        m_stats.packets = m_packets.size();
+        if (m_packets.empty())
+            return;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        sort();
+        auto end = std::chrono::high_resolution_clock::now();
+        m_stats.sortMs = std::chrono::duration<double, std::milli>(end - start).count();
+
+        GLStateCache &state = GLStateCache::getInstance();
+        const RenderStateStats before = state.getFrameStats();
+        m_renderer.getFrameUniforms().bind();
+        execute();
+        const RenderStateStats after = state.getFrameStats();
+        m_stats.glState.issued = after.issued - before.issued;
+        m_stats.glState.skipped = after.skipped - before.skipped;
+
+        clear();
+    }
+}
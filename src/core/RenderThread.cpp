@@ -0,0 +1,250 @@
+#include "OxygenRender/RenderThread.h"
+#include "OxygenRender/ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+
+namespace OxyRender
+{
+    namespace
+    {
+        // 先让出时间片自旋，仍未就绪再短暂休眠，避免空闲一方长期占满一个核心
+        template <typename Pred>
+        void waitUntil(Pred ready)
+        {
+            for (int spins = 0; !ready(); ++spins)
+            {
+                if (spins < 64)
+                    std::this_thread::yield();
+                else
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+        }
+
+        uint64_t elapsedNs(std::chrono::high_resolution_clock::time_point start)
+        {
+            auto end = std::chrono::high_resolution_clock::now();
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        }
+    }
+
+    CommandStream::~CommandStream()
+    {
+        reset();
+    }
+
+    unsigned char *CommandStream::reserve(size_t size)
+    {
+        if (m_blocks.empty())
+        {
+            m_blocks.emplace_back();
+            m_blocks.back().capacity = std::max(kBlockSize, size);
+            m_blocks.back().data.reset(new unsigned char[m_blocks.back().capacity]);
+            m_current = 0;
+        }
+        while (m_blocks[m_current].capacity - m_blocks[m_current].used < size)
+        {
+            // 当前块之后的块都是空的，容量不够时直接替换
+            if (++m_current == m_blocks.size())
+                m_blocks.emplace_back();
+            Block &block = m_blocks[m_current];
+            if (block.capacity < size)
+            {
+                block.capacity = std::max(kBlockSize, size);
+                block.data.reset(new unsigned char[block.capacity]);
+            }
+        }
+        Block &block = m_blocks[m_current];
+        return block.data.get() + block.used;
+    }
+
+    void CommandStream::consume(bool invoke)
+    {
+        std::exception_ptr error;
+        for (size_t i = 0; i < m_blocks.size() && i <= m_current; ++i)
+        {
+            Block &block = m_blocks[i];
+            size_t offset = 0;
+            while (offset < block.used)
+            {
+                Header *header = reinterpret_cast<Header *>(block.data.get() + offset);
+                const uint32_t size = header->size;
+                try
+                {
+                    header->call(block.data.get() + offset + alignUp(sizeof(Header)), invoke && !error);
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+                offset += size;
+            }
+            block.used = 0;
+        }
+        m_current = 0;
+        m_count = 0;
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    void CommandStream::execute()
+    {
+        consume(true);
+    }
+
+    void CommandStream::reset()
+    {
+        consume(false);
+    }
+
+    RenderThread::RenderThread(Window &window) : m_window(window)
+    {
+    }
+
+    RenderThread::~RenderThread()
+    {
+        try
+        {
+            stop();
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "RenderThread: " << e.what() << std::endl;
+        }
+    }
+
+    void RenderThread::start()
+    {
+        if (isRunning())
+            return;
+        m_stop.store(false, std::memory_order_relaxed);
+        m_window.makeContextCurrent(false);
+        m_thread = std::thread([this]()
+                               { threadLoop(); });
+        // 上下文随之移到渲染线程，runOnMainThread 的 GL 任务也改在那里执行
+        ThreadPool::getInstance().setMainThread(m_thread.get_id());
+    }
+
+    void RenderThread::stop()
+    {
+        if (!isRunning())
+            return;
+        // 最后一次 endFrame 之后记录的命令也要执行
+        if (!m_streams[m_submitted.load(std::memory_order_relaxed) & 1].empty())
+            m_submitted.fetch_add(1, std::memory_order_release);
+        m_stop.store(true, std::memory_order_release);
+        m_thread.join();
+        m_thread = std::thread();
+        m_window.makeContextCurrent(true);
+        ThreadPool::getInstance().setMainThread();
+        rethrowError();
+    }
+
+    void RenderThread::threadLoop()
+    {
+        m_window.makeContextCurrent(true);
+        for (;;)
+        {
+            const uint64_t frame = m_completed.load(std::memory_order_relaxed);
+            waitUntil([this, frame]()
+                      { return m_submitted.load(std::memory_order_acquire) > frame || m_stop.load(std::memory_order_acquire); });
+            // stop 之前移交的帧都已可见，执行完才退出
+            if (m_submitted.load(std::memory_order_acquire) <= frame)
+                break;
+
+            auto start = std::chrono::high_resolution_clock::now();
+            try
+            {
+                m_streams[frame & 1].execute();
+            }
+            catch (...)
+            {
+                if (!m_hasError.load(std::memory_order_acquire))
+                {
+                    m_error = std::current_exception();
+                    m_hasError.store(true, std::memory_order_release);
+                }
+                else
+                {
+                    try
+                    {
+                        throw;
+                    }
+                    catch (const std::exception &e)
+                    {
+                        std::cerr << "RenderThread: " << e.what() << std::endl;
+                    }
+                    catch (...)
+                    {
+                        std::cerr << "RenderThread: unknown error" << std::endl;
+                    }
+                }
+            }
+            // 每帧执行一次其他线程交给上下文线程的任务（如异步加载的 GPU 上传）
+            ThreadPool::getInstance().pumpMainThread();
+            m_executeNs.fetch_add(elapsedNs(start), std::memory_order_relaxed);
+            m_completed.store(frame + 1, std::memory_order_release);
+        }
+        ThreadPool::getInstance().pumpMainThread();
+        m_window.makeContextCurrent(false);
+    }
+
+    void RenderThread::submitFrame()
+    {
+        const uint64_t frame = m_submitted.load(std::memory_order_relaxed);
+        m_submitted.store(frame + 1, std::memory_order_release);
+        // 下一帧写入的命令流上次装的是第 frame - 1 帧，须等它执行完
+        waitForCompleted(frame);
+    }
+
+    void RenderThread::waitForCompleted(uint64_t frames)
+    {
+        if (m_completed.load(std::memory_order_acquire) >= frames)
+            return;
+        auto start = std::chrono::high_resolution_clock::now();
+        waitUntil([this, frames]()
+                  { return m_completed.load(std::memory_order_acquire) >= frames; });
+        m_waitNs.fetch_add(elapsedNs(start), std::memory_order_relaxed);
+    }
+
+    void RenderThread::endFrame()
+    {
+        if (!isRunning())
+        {
+            m_window.swapBuffers();
+            return;
+        }
+        enqueue([this]()
+                { m_window.swapBuffers(); });
+        submitFrame();
+        rethrowError();
+    }
+
+    void RenderThread::finish()
+    {
+        if (!isRunning())
+            return;
+        waitForCompleted(m_submitted.load(std::memory_order_relaxed));
+        rethrowError();
+    }
+
+    void RenderThread::rethrowError()
+    {
+        if (!m_hasError.load(std::memory_order_acquire))
+            return;
+        std::exception_ptr error = m_error;
+        m_error = nullptr;
+        m_hasError.store(false, std::memory_order_release);
+        std::rethrow_exception(error);
+    }
+
+    RenderThreadStats RenderThread::getStats() const
+    {
+        RenderThreadStats stats;
+        stats.frames = m_completed.load(std::memory_order_acquire);
+        stats.recordWaitMs = m_waitNs.load(std::memory_order_relaxed) / 1e6;
+        stats.executeMs = m_executeNs.load(std::memory_order_relaxed) / 1e6;
+        return stats;
+    }
+}
@@ -1,4 +1,5 @@
 ﻿#include "OxygenRender/Renderer.h"
+#include "OxygenRender/Shader.h"
 #include <glad/glad.h>
 namespace OxyRender
 {
@@ -38,33 +39,178 @@ namespace OxyRender
             return GL_ONE;
         }
     }
+    GLenum toGLCompareFunc(CompareFunc func)
+    {
+        switch (func)
+        {
+        case CompareFunc::Always:
+            return GL_ALWAYS;
+        case CompareFunc::Equal:
+            return GL_EQUAL;
+        case CompareFunc::Notequal:
+            return GL_NOTEQUAL;
+        case CompareFunc::Less:
+            return GL_LESS;
+        case CompareFunc::Lequal:
+            return GL_LEQUAL;
+        case CompareFunc::Greater:
+            return GL_GREATER;
+        case CompareFunc::Gequal:
+            return GL_GEQUAL;
+        case CompareFunc::Never:
+            return GL_NEVER;
+        default:
+            return GL_ALWAYS;
+        }
+    }
+    GLenum toGLStencilOp(StencilOp op)
+    {
+        switch (op)
+        {
+        case StencilOp::Keep:
+            return GL_KEEP;
+        case StencilOp::Zero:
+            return GL_ZERO;
+        case StencilOp::Replace:
+            return GL_REPLACE;
+        case StencilOp::Incr:
+            return GL_INCR;
+        case StencilOp::IncrWrap:
+            return GL_INCR_WRAP;
+        case StencilOp::Decr:
+            return GL_DECR;
+        case StencilOp::DecrWrap:
+            return GL_DECR_WRAP;
+        case StencilOp::Invert:
+            return GL_INVERT;
+        default:
+            return GL_KEEP;
+        }
+    }
+    GLenum toGLCullMode(CullMode mode)
+    {
+        switch (mode)
+        {
+        case CullMode::Front:
+            return GL_FRONT;
+        case CullMode::FrontAndBack:
+            return GL_FRONT_AND_BACK;
+        default:
+            return GL_BACK;
+        }
+    }
+    GLenum toGLPolygonMode(RenderPolygonMode mode)
+    {
+        switch (mode)
+        {
+        case RenderPolygonMode::Line:
+            return GL_LINE;
+        case RenderPolygonMode::Point:
+            return GL_POINT;
+        default:
+            return GL_FILL;
+        }
+    }
+
+    bool PipelineDesc::operator==(const PipelineDesc &other) const noexcept
+    {
+        return blend == other.blend && srcBlend == other.srcBlend && dstBlend == other.dstBlend &&
+               depthTest == other.depthTest && depthWrite == other.depthWrite && depthFunc == other.depthFunc &&
+               stencilTest == other.stencilTest && stencilFunc == other.stencilFunc && stencilRef == other.stencilRef &&
+               stencilMask == other.stencilMask && stencilFail == other.stencilFail &&
+               stencilDepthFail == other.stencilDepthFail && stencilPass == other.stencilPass &&
+               cullFace == other.cullFace && cullMode == other.cullMode && polygonMode == other.polygonMode &&
+               multisample == other.multisample && programPointSize == other.programPointSize &&
+               shader == other.shader && vertexLayout == other.vertexLayout;
+    }
+
+    uint64_t PipelineDesc::hash() const noexcept
+    {
+        // 逐字段 FNV-1a，避免结构体填充字节参与
+        uint64_t h = 1469598103934665603ull;
+        auto mix = [&h](uint64_t value)
+        {
+            for (int i = 0; i < 8; ++i)
+            {
+                h ^= (value >> (i * 8)) & 0xFFu;
+                h *= 1099511628211ull;
+            }
+        };
+        mix((uint64_t(blend) << 0) | (uint64_t(depthTest) << 1) | (uint64_t(depthWrite) << 2) |
+            (uint64_t(stencilTest) << 3) | (uint64_t(cullFace) << 4) | (uint64_t(multisample) << 5) |
+            (uint64_t(programPointSize) << 6));
+        mix((uint64_t(srcBlend) << 0) | (uint64_t(dstBlend) << 8) | (uint64_t(depthFunc) << 16) |
+            (uint64_t(stencilFunc) << 24) | (uint64_t(stencilFail) << 32) | (uint64_t(stencilDepthFail) << 40) |
+            (uint64_t(stencilPass) << 48) | (uint64_t(cullMode) << 56));
+        mix((uint64_t(uint32_t(stencilRef)) << 32) | stencilMask);
+        mix(uint64_t(polygonMode));
+        mix(reinterpret_cast<uintptr_t>(shader));
+        mix(vertexLayout);
+        return h;
+    }
+
     OpenGLRenderer::OpenGLRenderer()
     {
     }
     void OpenGLRenderer::clear()
     {
+        GLStateCache::getInstance().beginFrame();
         glClearColor(m_clear_color.r, m_clear_color.g, m_clear_color.b, m_clear_color.a);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     }
-    void OpenGLRenderer::drawTriangles(const VertexArray &vao, size_t indexCount)
+    RenderStateStats OpenGLRenderer::getStateStats() const
+    {
+        return GLStateCache::getInstance().getLastFrameStats();
+    }
+    void OpenGLRenderer::bindPipeline(const PipelineState &pipeline)
+    {
+        const PipelineDesc &next = pipeline.getDesc();
+        // 程序可能被管线之外的 Shader::use 切换，总是交给状态缓存判断
+        if (next.shader)
+            next.shader->use();
+
+        // 不依据本渲染器记录的上一个管线跳过：其它 Renderer、直接的状态调用或 GLStateCache::invalidate()
+        // 都会让它过期。每个字段都交给状态缓存与当前 GL 状态比较，只调用有变化的部分
+        GLStateCache &state = GLStateCache::getInstance();
+        state.setEnabled(GL_BLEND, next.blend);
+        state.blendFunc(toGLBlendFunc(next.srcBlend), toGLBlendFunc(next.dstBlend));
+        state.setEnabled(GL_DEPTH_TEST, next.depthTest);
+        state.depthMask(next.depthWrite);
+        state.depthFunc(toGLCompareFunc(next.depthFunc));
+        state.setEnabled(GL_STENCIL_TEST, next.stencilTest);
+        state.stencilFunc(toGLCompareFunc(next.stencilFunc), next.stencilRef, next.stencilMask);
+        state.stencilOp(toGLStencilOp(next.stencilFail), toGLStencilOp(next.stencilDepthFail), toGLStencilOp(next.stencilPass));
+        state.setEnabled(GL_CULL_FACE, next.cullFace);
+        state.cullFace(toGLCullMode(next.cullMode));
+        state.polygonMode(toGLPolygonMode(next.polygonMode));
+        state.setEnabled(GL_MULTISAMPLE, next.multisample);
+        state.setEnabled(GL_PROGRAM_POINT_SIZE, next.programPointSize);
+
+        m_boundPipeline = &pipeline;
+        m_boundEpoch = state.getEpoch();
+    }
+    const PipelineState *OpenGLRenderer::getBoundPipeline() const noexcept
+    {
+        // 状态缓存已重置（如新建上下文）时不再报告之前的管线
+        return m_boundEpoch == GLStateCache::getInstance().getEpoch() ? m_boundPipeline : nullptr;
+    }
+    // VAO 保持绑定，连续绘制同一 VAO 时不再重复绑定
+    void OpenGLRenderer::drawTriangles(const VertexArray &vao, size_t indexCount, size_t firstIndex)
     {
         vao.bind();
-        glDrawElements(GL_TRIANGLES, (GLsizei)indexCount, GL_UNSIGNED_INT, 0);
-        vao.unbind();
+        glDrawElements(GL_TRIANGLES, (GLsizei)indexCount, GL_UNSIGNED_INT, (const void *)(firstIndex * sizeof(uint32_t)));
     }
 
     void OpenGLRenderer::drawLines(const VertexArray &vao, size_t indexCount, float thickness)
     {
         vao.bind();
-        glLineWidth(thickness);
+        GLStateCache::getInstance().lineWidth(thickness);
         glDrawElements(GL_LINES, (GLsizei)indexCount, GL_UNSIGNED_INT, 0);
-        vao.unbind();
     }
     void OpenGLRenderer::drawPoints(const VertexArray &vao, size_t vertexCount)
     {
         vao.bind();
         glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(vertexCount));
-        vao.unbind();
     }
     void OpenGLRenderer::setCapability(RenderCapability cap, bool enable)
     {
@@ -91,29 +237,19 @@ namespace OxyRender
             break;
         }
 
-        if (enable)
-            glEnable(glCap);
-        else
-            glDisable(glCap);
+        GLStateCache::getInstance().setEnabled(glCap, enable);
+        m_boundPipeline = nullptr;
     }
 
     void OpenGLRenderer::setPolygonMode(RenderPolygonMode mod, bool enable)
     {
-        switch (mod)
-        {
-        case RenderPolygonMode::Fill:
-            glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-            break;
-        case RenderPolygonMode::Line:
-            glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-            break;
-        case RenderPolygonMode::Point:
-            glPolygonMode(GL_FRONT_AND_BACK, GL_POINT);
-        }
+        GLStateCache::getInstance().polygonMode(toGLPolygonMode(mod));
+        m_boundPipeline = nullptr;
     }
     void OpenGLRenderer::setBlendFunc(RenderBlendFunc sfactor, RenderBlendFunc dfactor)
     {
-        glBlendFunc(toGLBlendFunc(sfactor), toGLBlendFunc(dfactor));
+        GLStateCache::getInstance().blendFunc(toGLBlendFunc(sfactor), toGLBlendFunc(dfactor));
+        m_boundPipeline = nullptr;
     }
 
     // GLenum OpenGLRenderer::convertStencilFunc(StencilFunc func)
@@ -195,7 +331,9 @@ namespace OxyRender
         default:
             break;
         }
-        setCapability(RenderCapability::DepthTest, true);
+        m_frameUniforms = std::make_unique<FrameUniforms>();
+        m_defaultPipeline = createPipeline(PipelineDesc());
+        bindPipeline(*m_defaultPipeline);
         m_window.setViewport(0, 0, m_window.getWidth(), m_window.getHeight());
     }
     void Renderer::clear()
@@ -203,10 +341,10 @@ namespace OxyRender
         if (renderer)
             renderer->clear();
     }
-    void Renderer::drawTriangles(const VertexArray &vao, size_t indexCount)
+    void Renderer::drawTriangles(const VertexArray &vao, size_t indexCount, size_t firstIndex)
     {
         if (renderer)
-            renderer->drawTriangles(vao, indexCount);
+            renderer->drawTriangles(vao, indexCount, firstIndex);
     }
 
     void Renderer::drawLines(const VertexArray &vao, size_t indexCount, float thickness)
@@ -234,6 +372,36 @@ namespace OxyRender
         if (renderer)
             renderer->setBlendFunc(sfactor, dfactor);
     }
+    RenderStateStats Renderer::getStateStats() const
+    {
+        if (renderer)
+            return renderer->getStateStats();
+        return RenderStateStats();
+    }
+    const PipelineState *Renderer::createPipeline(const PipelineDesc &desc)
+    {
+        uint64_t key = desc.hash();
+        // 哈希冲突时顺延键值
+        for (auto it = m_pipelines.find(key); it != m_pipelines.end(); it = m_pipelines.find(++key))
+        {
+            if (it->second->getDesc() == desc)
+                return it->second.get();
+        }
+        auto pipeline = std::unique_ptr<PipelineState>(
+            new PipelineState(desc, desc.hash(), static_cast<uint32_t>(m_pipelines.size())));
+        const PipelineState *result = pipeline.get();
+        m_pipelines.emplace(key, std::move(pipeline));
+        return result;
+    }
+    void Renderer::bindPipeline(const PipelineState &pipeline)
+    {
+        if (renderer)
+            renderer->bindPipeline(pipeline);
+    }
+    const PipelineState *Renderer::getBoundPipeline() const noexcept
+    {
+        return renderer ? renderer->getBoundPipeline() : nullptr;
+    }
     void Renderer::setClearColor(const OxyColor &color)
     {
         if (renderer)
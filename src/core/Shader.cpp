@@ -1,5 +1,10 @@
 #include "OxygenRender/Shader.h"
+#include "OxygenRender/FrameUniforms.h"
+#include "OxygenRender/GLStateCache.h"
+#include "OxygenRender/ProgramCache.h"
 #include <glad/glad.h>
+#include <cstring>
+#include <iostream>
 namespace OxyRender
 {
 
@@ -24,52 +29,13 @@ namespace OxyRender
     {
         std::string vertexCode = loadFile(m_pathVertex);
         std::string fragmentCode = loadFile(m_pathFragment);
-
-        GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexCode);
-        GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentCode);
-
-        m_programId = glCreateProgram();
-        glAttachShader(m_programId, vertexShader);
-        glAttachShader(m_programId, fragmentShader);
-        glLinkProgram(m_programId);
-
-        GLint success;
-        glGetProgramiv(m_programId, GL_LINK_STATUS, &success);
-        if (!success)
-        {
-            char log[512];
-            glGetProgramInfoLog(m_programId, 512, nullptr, log);
-            glDeleteProgram(m_programId);
-            throw std::runtime_error(std::string("Program linking failed: ") + log);
-        }
-
-        glDeleteShader(vertexShader);
-        glDeleteShader(fragmentShader);
+        m_program = ProgramCache::getInstance().acquire(m_name, vertexCode, fragmentCode);
     }
 
     OpenGLShader::OpenGLShader(std::string name, std::string vertex_source, std::string fragment_source, bool from_source)
         : IShader(std::move(name), std::move(vertex_source), std::move(fragment_source), from_source)
     {
-        GLuint vertexShader = compileShader(GL_VERTEX_SHADER, m_vertexSource);
-        GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, m_fragmentSource);
-
-        m_programId = glCreateProgram();
-        glAttachShader(m_programId, vertexShader);
-        glAttachShader(m_programId, fragmentShader);
-        glLinkProgram(m_programId);
-
-        GLint success;
-        glGetProgramiv(m_programId, GL_LINK_STATUS, &success);
-        if (!success)
-        {
-            char log[512];
-            glGetProgramInfoLog(m_programId, 512, nullptr, log);
-            glDeleteProgram(m_programId);
-            throw std::runtime_error(std::string("Program linking failed: ") + log);
-        }
-
-        glDeleteShader(vertexShader);
-        glDeleteShader(fragmentShader);
+        m_program = ProgramCache::getInstance().acquire(m_name, m_vertexSource, m_fragmentSource);
     }
 
     std::string OpenGLShader::loadFile(const std::string &path)
@@ -142,38 +108,15 @@ namespace OxyRender
         return contents;
     }
 
-    GLuint OpenGLShader::compileShader(unsigned int type, const std::string &source)
-    {
-        GLuint shader = glCreateShader(type);
-        const char *src = source.c_str();
-        glShaderSource(shader, 1, &src, nullptr);
-        glCompileShader(shader);
-
-        GLint success;
-        glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-        if (!success)
-        {
-            char log[1024] = {0};
-            glGetShaderInfoLog(shader, 1024, nullptr, log);
-            glDeleteShader(shader);
-
-          
-            std::string prefix = source.substr(0, 120);
-            for (char &ch : prefix) { if (ch == '\n') ch = ' '; }
-
-            std::string message = std::string("Shader compilation failed: ") + log + " | Source prefix: " + prefix;
-            throw std::runtime_error(message);
-        }
-        return shader;
-    }
     void OpenGLShader::use()
     {
-        glUseProgram(m_programId);
+        m_program->finish();
+        GLStateCache::getInstance().useProgram(m_program->getID());
     }
 
-    OpenGLShader::~OpenGLShader()
+    bool OpenGLShader::isReady()
     {
-        glDeleteProgram(m_programId);
+        return ProgramCache::getInstance().isReady(*m_program);
     }
     // void OpenGLShader::setMat4(const std::string &name, const glm::mat4 &mat)
     // {
@@ -184,29 +127,363 @@ namespace OxyRender
     //         glUniformMatrix4fv(location, 1, GL_FALSE, &mat[0][0]);
     //     }
     // }
+    namespace
+    {
+        // 单个元素的字节数，0 表示不支持的类型（GL 3.3 core 的全部非双精度 uniform 类型）
+        size_t uniformTypeSize(GLenum type)
+        {
+            switch (type)
+            {
+            case GL_FLOAT:
+            case GL_INT:
+            case GL_UNSIGNED_INT:
+            case GL_BOOL:
+                return 4;
+            case GL_FLOAT_VEC2:
+            case GL_INT_VEC2:
+            case GL_UNSIGNED_INT_VEC2:
+            case GL_BOOL_VEC2:
+                return 4 * 2;
+            case GL_FLOAT_VEC3:
+            case GL_INT_VEC3:
+            case GL_UNSIGNED_INT_VEC3:
+            case GL_BOOL_VEC3:
+                return 4 * 3;
+            case GL_FLOAT_VEC4:
+            case GL_INT_VEC4:
+            case GL_UNSIGNED_INT_VEC4:
+            case GL_BOOL_VEC4:
+            case GL_FLOAT_MAT2:
+                return 4 * 4;
+            case GL_FLOAT_MAT2x3:
+            case GL_FLOAT_MAT3x2:
+                return 4 * 6;
+            case GL_FLOAT_MAT2x4:
+            case GL_FLOAT_MAT4x2:
+                return 4 * 8;
+            case GL_FLOAT_MAT3:
+                return 4 * 9;
+            case GL_FLOAT_MAT3x4:
+            case GL_FLOAT_MAT4x3:
+                return 4 * 12;
+            case GL_FLOAT_MAT4:
+                return 4 * 16;
+            case GL_SAMPLER_1D:
+            case GL_SAMPLER_2D:
+            case GL_SAMPLER_3D:
+            case GL_SAMPLER_CUBE:
+            case GL_SAMPLER_1D_SHADOW:
+            case GL_SAMPLER_2D_SHADOW:
+            case GL_SAMPLER_1D_ARRAY:
+            case GL_SAMPLER_2D_ARRAY:
+            case GL_SAMPLER_1D_ARRAY_SHADOW:
+            case GL_SAMPLER_2D_ARRAY_SHADOW:
+            case GL_SAMPLER_CUBE_SHADOW:
+            case GL_SAMPLER_2D_RECT:
+            case GL_SAMPLER_2D_RECT_SHADOW:
+            case GL_SAMPLER_BUFFER:
+            case GL_SAMPLER_2D_MULTISAMPLE:
+            case GL_SAMPLER_2D_MULTISAMPLE_ARRAY:
+            case GL_INT_SAMPLER_1D:
+            case GL_INT_SAMPLER_2D:
+            case GL_INT_SAMPLER_3D:
+            case GL_INT_SAMPLER_CUBE:
+            case GL_INT_SAMPLER_1D_ARRAY:
+            case GL_INT_SAMPLER_2D_ARRAY:
+            case GL_INT_SAMPLER_2D_RECT:
+            case GL_INT_SAMPLER_BUFFER:
+            case GL_INT_SAMPLER_2D_MULTISAMPLE:
+            case GL_INT_SAMPLER_2D_MULTISAMPLE_ARRAY:
+            case GL_UNSIGNED_INT_SAMPLER_1D:
+            case GL_UNSIGNED_INT_SAMPLER_2D:
+            case GL_UNSIGNED_INT_SAMPLER_3D:
+            case GL_UNSIGNED_INT_SAMPLER_CUBE:
+            case GL_UNSIGNED_INT_SAMPLER_1D_ARRAY:
+            case GL_UNSIGNED_INT_SAMPLER_2D_ARRAY:
+            case GL_UNSIGNED_INT_SAMPLER_2D_RECT:
+            case GL_UNSIGNED_INT_SAMPLER_BUFFER:
+            case GL_UNSIGNED_INT_SAMPLER_2D_MULTISAMPLE:
+            case GL_UNSIGNED_INT_SAMPLER_2D_MULTISAMPLE_ARRAY:
+                return sizeof(GLint);
+            default:
+                return 0;
+            }
+        }
+
+        // 内置着色器改用 FrameData 块之前按名字设置的相机/光源 uniform，返回下标，不是时返回 -1
+        int frameBlockNameIndex(const std::string &name)
+        {
+            static const char *const kNames[] = {"view", "projection", "viewPos", "lightPos",
+                                                 "light.position", "light.ambient", "light.diffuse", "light.specular"};
+            for (int i = 0; i < int(sizeof(kNames) / sizeof(kNames[0])); ++i)
+                if (name == kNames[i])
+                    return i;
+            return -1;
+        }
+
+        // setter 期望的类型是否与 uniform 类型一致，GL_INT 表示 int / uint / bool / 采样器
+        bool acceptsType(GLenum type, GLenum expected)
+        {
+            if (expected == GL_INT)
+                return type != GL_FLOAT && uniformTypeSize(type) == sizeof(int);
+            return type == expected;
+        }
+    }
+
+    OpenGLProgram::OpenGLProgram(std::string name, unsigned int programId)
+        : m_name(std::move(name)), m_programId(programId)
+    {
+        try
+        {
+            buildUniformTable();
+        }
+        catch (...)
+        {
+            GLStateCache::getInstance().deleteProgram(m_programId);
+            throw;
+        }
+    }
+
+    OpenGLProgram::OpenGLProgram(std::string name, unsigned int programId, std::function<void()> finishLink)
+        : m_name(std::move(name)), m_programId(programId), m_finishLink(std::move(finishLink))
+    {
+    }
+
+    void OpenGLProgram::finish()
+    {
+        if (!m_error.empty())
+            throw std::runtime_error(m_error);
+        if (!m_finishLink)
+            return;
+
+        auto finishLink = std::move(m_finishLink);
+        m_finishLink = nullptr;
+        try
+        {
+            finishLink();
+        }
+        catch (const std::exception &e)
+        {
+            m_error = std::string("Shader ") + m_name + ": " + e.what();
+            throw std::runtime_error(m_error);
+        }
+        try
+        {
+            buildUniformTable();
+        }
+        catch (const std::exception &e)
+        {
+            m_error = e.what();
+            throw;
+        }
+    }
+
+    OpenGLProgram::~OpenGLProgram()
+    {
+        GLStateCache::getInstance().deleteProgram(m_programId);
+    }
+
+    void OpenGLProgram::buildUniformTable()
+    {
+        m_uniforms.clear();
+        GLint count = 0, maxLength = 0;
+        glGetProgramiv(m_programId, GL_ACTIVE_UNIFORMS, &count);
+        glGetProgramiv(m_programId, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+        std::string name(static_cast<size_t>(std::max(maxLength, 1)), '\0');
+
+        for (GLint i = 0; i < count; ++i)
+        {
+            GLsizei length = 0;
+            GLint arraySize = 0;
+            GLenum type = 0;
+            glGetActiveUniform(m_programId, static_cast<GLuint>(i), maxLength, &length, &arraySize, &type, &name[0]);
+            std::string uniformName(name.data(), static_cast<size_t>(length));
+
+            UniformInfo info;
+            info.location = glGetUniformLocation(m_programId, uniformName.c_str());
+            info.type = type;
+            info.size = uniformTypeSize(type);
+            if (info.location == -1) // uniform block 成员
+                continue;
+
+            auto add = [&](const std::string &key)
+            {
+                // 哈希冲突会让 setter 静默写到另一个 uniform，必须改名
+                auto inserted = m_uniforms.emplace(UniformID(key).hash, info);
+                if (!inserted.second && inserted.first->second.location != info.location)
+                    throw std::runtime_error("Shader " + m_name + ": uniform name hash collision on \"" + key +
+                                             "\", rename the uniform");
+            };
+            add(uniformName);
+            // 数组同时登记 "name" 与 "name[0]"
+            if (uniformName.size() > 3 && uniformName.compare(uniformName.size() - 3, 3, "[0]") == 0)
+                add(uniformName.substr(0, uniformName.size() - 3));
+        }
+
+        // 共享的每帧 uniform 块使用固定绑定点
+        GLuint frameBlock = glGetUniformBlockIndex(m_programId, FrameUniforms::kBlockName);
+        m_frameBlock = frameBlock != GL_INVALID_INDEX;
+        if (m_frameBlock)
+            glUniformBlockBinding(m_programId, frameBlock, FrameUniforms::kBindingPoint);
+    }
+
+    OpenGLProgram::UniformInfo *OpenGLProgram::findUniform(UniformID id)
+    {
+        finish();
+        auto it = m_uniforms.find(id.hash);
+        return it == m_uniforms.end() ? nullptr : &it->second;
+    }
+
+    bool OpenGLProgram::hasUniform(UniformID id)
+    {
+        finish();
+        return m_uniforms.find(id.hash) != m_uniforms.end();
+    }
+
+    bool OpenGLProgram::hasFrameBlock()
+    {
+        finish();
+        return m_frameBlock;
+    }
+
+    bool OpenGLShader::hasUniform(UniformID id) const
+    {
+        return m_program->hasUniform(id);
+    }
+
+    void OpenGLShader::store(UniformInfo &uniform, const void *data, size_t size)
+    {
+        if (uniform.cached && std::memcmp(uniform.value, data, size) == 0)
+            return;
+        // 调用方可能绑定着别的程序；已绑定时 GLStateCache 不重复调用
+        use();
+        std::memcpy(uniform.value, data, size);
+        uniform.cached = true;
+        upload(uniform, data);
+    }
+
+    void OpenGLShader::upload(const UniformInfo &uniform, const void *data)
+    {
+        const GLfloat *f = static_cast<const GLfloat *>(data);
+        const GLint *i = static_cast<const GLint *>(data);
+        const GLuint *u = static_cast<const GLuint *>(data);
+        switch (uniform.type)
+        {
+        case GL_FLOAT:
+            glUniform1fv(uniform.location, 1, f);
+            break;
+        case GL_FLOAT_VEC2:
+            glUniform2fv(uniform.location, 1, f);
+            break;
+        case GL_FLOAT_VEC3:
+            glUniform3fv(uniform.location, 1, f);
+            break;
+        case GL_FLOAT_VEC4:
+            glUniform4fv(uniform.location, 1, f);
+            break;
+        case GL_FLOAT_MAT2:
+            glUniformMatrix2fv(uniform.location, 1, GL_FALSE, f);
+            break;
+        case GL_FLOAT_MAT2x3:
+            glUniformMatrix2x3fv(uniform.location, 1, GL_FALSE, f);
+            break;
+        case GL_FLOAT_MAT2x4:
+            glUniformMatrix2x4fv(uniform.location, 1, GL_FALSE, f);
+            break;
+        case GL_FLOAT_MAT3:
+            glUniformMatrix3fv(uniform.location, 1, GL_FALSE, f);
+            break;
+        case GL_FLOAT_MAT3x2:
+            glUniformMatrix3x2fv(uniform.location, 1, GL_FALSE, f);
+            break;
+        case GL_FLOAT_MAT3x4:
+            glUniformMatrix3x4fv(uniform.location, 1, GL_FALSE, f);
+            break;
+        case GL_FLOAT_MAT4:
+            glUniformMatrix4fv(uniform.location, 1, GL_FALSE, f);
+            break;
+        case GL_FLOAT_MAT4x2:
+            glUniformMatrix4x2fv(uniform.location, 1, GL_FALSE, f);
+            break;
+        case GL_FLOAT_MAT4x3:
+            glUniformMatrix4x3fv(uniform.location, 1, GL_FALSE, f);
+            break;
+        case GL_INT_VEC2:
+        case GL_BOOL_VEC2:
+            glUniform2iv(uniform.location, 1, i);
+            break;
+        case GL_INT_VEC3:
+        case GL_BOOL_VEC3:
+            glUniform3iv(uniform.location, 1, i);
+            break;
+        case GL_INT_VEC4:
+        case GL_BOOL_VEC4:
+            glUniform4iv(uniform.location, 1, i);
+            break;
+        case GL_UNSIGNED_INT:
+            glUniform1uiv(uniform.location, 1, u);
+            break;
+        case GL_UNSIGNED_INT_VEC2:
+            glUniform2uiv(uniform.location, 1, u);
+            break;
+        case GL_UNSIGNED_INT_VEC3:
+            glUniform3uiv(uniform.location, 1, u);
+            break;
+        case GL_UNSIGNED_INT_VEC4:
+            glUniform4uiv(uniform.location, 1, u);
+            break;
+        default: // int / bool / 采样器
+            glUniform1iv(uniform.location, 1, i);
+            break;
+        }
+    }
+
     void OpenGLShader::setUniformData(const std::string &name, const void *data, size_t size)
     {
-        GLint location = glGetUniformLocation(m_programId, name.c_str());
-        if (location == -1)
-            throw std::runtime_error("Uniform not found: " + name);
-
-        if (size == sizeof(float) * 1)
-            glUniform1fv(location, 1, (const GLfloat *)data);
-        else if (size == sizeof(float) * 2)
-            glUniform2fv(location, 1, (const GLfloat *)data);
-        else if (size == sizeof(float) * 3)
-            glUniform3fv(location, 1, (const GLfloat *)data);
-        else if (size == sizeof(float) * 4)
-            glUniform4fv(location, 1, (const GLfloat *)data);
-        else if (size == sizeof(float) * 9)
-            glUniformMatrix3fv(location, 1, GL_FALSE, (const GLfloat *)data);
-        else if (size == sizeof(float) * 16)
-            glUniformMatrix4fv(location, 1, GL_FALSE, (const GLfloat *)data);
-        else if (size == sizeof(int))
-            glUniform1i(location, *(const GLint *)data);
-        else
-            throw std::runtime_error("Unsupported uniform size: " + std::to_string(size));
+        UniformInfo *uniform = m_program->findUniform(UniformID(name));
+        if (!uniform)
+        {
+            const int frameName = m_program->hasFrameBlock() ? frameBlockNameIndex(name) : -1;
+            if (frameName < 0)
+                throw std::runtime_error("Uniform not found: " + name);
+            // 值不会生效：每个名字警告一次，提示改用 FrameUniforms
+            if (!(m_ignoredFrameNames & (1u << frameName)))
+            {
+                m_ignoredFrameNames |= 1u << frameName;
+                std::cerr << "Shader " << m_name << ": uniform \"" << name << "\" is provided by the FrameData block, "
+                          << "the value is ignored; set it through Renderer::getFrameUniforms()" << std::endl;
+            }
+            return;
+        }
+        if (uniform->size == 0 || size != uniform->size)
+            throw std::runtime_error("Unsupported uniform size: " + std::to_string(size) + " for " + name);
+        store(*uniform, data, size);
+    }
+
+    int OpenGLShader::getUniformLocation(const std::string &name)
+    {
+        const UniformInfo *uniform = m_program->findUniform(UniformID(name));
+        return uniform ? uniform->location : -1;
+    }
+
+    template <typename T>
+    void OpenGLShader::setTyped(UniformID id, const T &value, unsigned int glType)
+    {
+        // 类型不符（如对 vec3 调用 setFloat）时同样忽略
+        UniformInfo *uniform = m_program->findUniform(id);
+        if (!uniform || !acceptsType(uniform->type, glType))
+            return;
+        store(*uniform, &value, sizeof(T));
     }
+
+    void OpenGLShader::setInt(UniformID id, int value) { setTyped(id, value, GL_INT); }
+    void OpenGLShader::setFloat(UniformID id, float value) { setTyped(id, value, GL_FLOAT); }
+    void OpenGLShader::setVec2(UniformID id, const glm::vec2 &value) { setTyped(id, value, GL_FLOAT_VEC2); }
+    void OpenGLShader::setVec3(UniformID id, const glm::vec3 &value) { setTyped(id, value, GL_FLOAT_VEC3); }
+    void OpenGLShader::setVec4(UniformID id, const glm::vec4 &value) { setTyped(id, value, GL_FLOAT_VEC4); }
+    void OpenGLShader::setMat3(UniformID id, const glm::mat3 &value) { setTyped(id, value, GL_FLOAT_MAT3); }
+    void OpenGLShader::setMat4(UniformID id, const glm::mat4 &value) { setTyped(id, value, GL_FLOAT_MAT4); }
+
     std::unique_ptr<IShader> ShaderFactory::create(std::string name, std::string path_vertex, std::string path_fragment)
     {
         switch (Backends::OXYG_CurrentBackend)
@@ -0,0 +1,81 @@
+#include "OxygenRender/ShaderVariants.h"
+
+namespace OxyRender
+{
+    const char *ShaderFeature::defineName(uint32_t bit)
+    {
+        switch (bit)
+        {
+        case Textured:
+            return "TEXTURED";
+        case NormalMap:
+            return "NORMAL_MAP";
+        case SpecularMap:
+            return "SPECULAR_MAP";
+        default:
+            return nullptr;
+        }
+    }
+
+    ShaderVariants::ShaderVariants(std::string name, std::string vertexTemplate, std::string fragmentTemplate,
+                                   uint32_t supportedFeatures)
+        : m_name(std::move(name)),
+          m_vertexTemplate(std::move(vertexTemplate)),
+          m_fragmentTemplate(std::move(fragmentTemplate)),
+          m_supported(supportedFeatures)
+    {
+    }
+
+    std::string ShaderVariants::applyFeatures(const std::string &source, uint32_t features)
+    {
+        std::string defines;
+        for (uint32_t i = 0; i < ShaderFeature::Count; ++i)
+        {
+            const uint32_t bit = 1u << i;
+            if (features & bit)
+                defines += std::string("#define ") + ShaderFeature::defineName(bit) + "\n";
+        }
+        if (defines.empty())
+            return source;
+
+        // #version 必须是第一条语句，宏放在它之后
+        size_t insertAt = 0;
+        size_t version = source.find("#version");
+        if (version != std::string::npos)
+        {
+            size_t lineEnd = source.find('\n', version);
+            insertAt = lineEnd == std::string::npos ? source.size() : lineEnd + 1;
+        }
+        std::string result = source.substr(0, insertAt);
+        if (insertAt == source.size() && version != std::string::npos)
+            result += '\n';
+        result += defines;
+        result.append(source, insertAt, std::string::npos);
+        return result;
+    }
+
+    Shader &ShaderVariants::get(uint32_t features)
+    {
+        features &= m_supported;
+        auto it = m_variants.find(features);
+        if (it != m_variants.end())
+            return *it->second;
+
+        std::string name = m_name;
+        for (uint32_t i = 0; i < ShaderFeature::Count; ++i)
+        {
+            const uint32_t bit = 1u << i;
+            if (features & bit)
+                name += std::string(name == m_name ? "[" : "|") + ShaderFeature::defineName(bit);
+        }
+        if (name != m_name)
+            name += "]";
+
+        std::string vertex = applyFeatures(m_vertexTemplate, features);
+        std::string fragment = applyFeatures(m_fragmentTemplate, features);
+        auto shader = std::make_unique<Shader>(name, vertex.c_str(), fragment.c_str());
+        Shader &result = *shader;
+        m_variants.emplace(features, std::move(shader));
+        return result;
+    }
+}
@@ -10,15 +10,15 @@ namespace OxyRender
     #version 330 core
     layout (location = 0) in vec3 aPos;
 
-    out vec3 TexCoords;
+    // projection * 去掉平移的 view，天空盒始终围绕相机
+    uniform mat4 skyboxViewProjection;
 
-    uniform mat4 projection;
-    uniform mat4 view;
+    out vec3 TexCoords;
 
     void main()
     {
         TexCoords = aPos;
-        vec4 pos = projection * view * vec4(aPos, 1.0);
+        vec4 pos = skyboxViewProjection * vec4(aPos, 1.0);
         gl_Position = pos.xyww;
     }
     )";
@@ -38,7 +38,7 @@ namespace OxyRender
     )";
 
     Skybox::Skybox(Renderer &renderer, const std::vector<std::string> &faces)
-        : m_renderer(renderer), m_cubemap(faces),
+        : m_renderer(renderer), m_pipeline(nullptr), m_cubemap(faces),
           m_vbo(BufferType::Vertex, BufferUsage::StaticDraw) 
     {
         setupMesh();
@@ -112,30 +112,40 @@ namespace OxyRender
         m_vao.setVertexBuffer(m_vbo, layout);
 
         m_vao.unbind();
+
+        // 天空盒位于远平面（z = w），用 LEQUAL 通过深度测试且不写深度
+        PipelineDesc desc;
+        desc.depthWrite = false;
+        desc.depthFunc = CompareFunc::Lequal;
+        desc.vertexLayout = layout.getHash();
+        m_pipeline = m_renderer.createPipeline(desc);
+    }
+
+    void Skybox::draw(Shader &shader)
+    {
+        const FrameData &frame = m_renderer.getFrameUniforms().getData();
+        draw(shader, frame.view, frame.projection);
     }
 
     void Skybox::draw(Shader &shader, const glm::mat4 &viewMatrix, const glm::mat4 &projectionMatrix)
     {
-        glDepthMask(GL_FALSE);
-        glDepthFunc(GL_LEQUAL);
+        static constexpr UniformID kViewProjection("skyboxViewProjection");
 
+        // 绘制后恢复之前的管线，不影响之后未绑定管线的绘制（如 Model::Draw）
+        const PipelineState *previous = m_renderer.getBoundPipeline();
+        m_renderer.bindPipeline(*m_pipeline);
         shader.use();
-
-        glm::mat4 view = glm::mat4(glm::mat3(viewMatrix));
-        GLint viewLoc = glGetUniformLocation(shader.getID(), "view");
-        GLint projLoc = glGetUniformLocation(shader.getID(), "projection");
-
-        glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
-        glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(projectionMatrix));
+        // 相机只作为天空盒自己的 uniform 上传，不改动 Renderer 共享的 FrameUniforms；
+        // 自定义着色器仍可读取 FrameData 块
+        shader.setMat4(kViewProjection, projectionMatrix * glm::mat4(glm::mat3(viewMatrix)));
+        m_renderer.getFrameUniforms().bind();
 
         m_cubemap.bind(0);
 
         m_vao.bind();
         glDrawArrays(GL_TRIANGLES, 0, 36); 
-        m_vao.unbind();
 
-        glDepthFunc(GL_LESS);
-        glDepthMask(GL_TRUE);
+        m_renderer.bindPipeline(previous ? *previous : m_renderer.getDefaultPipeline());
     }
 
     Shader Skybox::createDefaultShader()
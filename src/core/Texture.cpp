@@ -1,45 +1,172 @@
-#define STB_IMAGE_IMPLEMENTATION
 #include "OxygenRender/Texture.h"
-#include <stb_image.h>
+#include "OxygenRender/ImageDecoder.h"
+#include "OxygenRender/MappedFile.h"
+#include "OxygenRender/GLStateCache.h"
+#include "OxygenRender/GLContext.h"
 #include <glad/glad.h>
+#include <algorithm>
+#include <cstring>
+
+// GLAD 只生成了 3.3 核心头文件，S3TC / BPTC 枚举需手动定义
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+#define GL_COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#endif
 
 namespace OxyRender
 {
+    ImageData ImageData::load(const std::string &path, bool flipVertically, bool expandChannels)
+    {
+        return ImageDecoderRegistry::getInstance().decodeFile(path, flipVertically, expandChannels);
+    }
+
+    ImageData ImageData::loadFromMemory(const unsigned char *data, size_t size, bool flipVertically, bool expandChannels)
+    {
+        return ImageDecoderRegistry::getInstance().decode(data, size, flipVertically, expandChannels);
+    }
+
+    namespace
+    {
+        GLenum compressedInternalFormat(TextureFormat format)
+        {
+            switch (format)
+            {
+            case TextureFormat::BC1:
+                return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+            case TextureFormat::BC3:
+                return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            case TextureFormat::BC4:
+                return GL_COMPRESSED_RED_RGTC1;
+            case TextureFormat::BC5:
+                return GL_COMPRESSED_RG_RGTC2;
+            case TextureFormat::BC7:
+                return GL_COMPRESSED_RGBA_BPTC_UNORM;
+            default:
+                throw std::runtime_error("Not a compressed texture format");
+            }
+        }
+    }
+
+    namespace
+    {
+        // 预处理数据的内部格式与像素格式，压缩格式的像素格式为 0（不支持 setData）
+        void glFormats(TextureFormat format, uint32_t &internalFormat, uint32_t &pixelFormat)
+        {
+            switch (format)
+            {
+            case TextureFormat::RGBA8:
+                internalFormat = GL_RGBA8, pixelFormat = GL_RGBA;
+                break;
+            case TextureFormat::RGB8:
+                internalFormat = GL_RGB8, pixelFormat = GL_RGB;
+                break;
+            case TextureFormat::R8:
+                internalFormat = GL_R8, pixelFormat = GL_RED;
+                break;
+            default:
+                internalFormat = compressedInternalFormat(format);
+                pixelFormat = 0;
+                break;
+            }
+        }
+    }
+
+    bool OpenGLTexture2D::isFormatSupported(TextureFormat format)
+    {
+        // 扩展列表在上下文创建后不变，每个上下文首次查询时缓存
+        static bool s3tc = false;
+        static bool bptc = false;
+        static uint64_t generation = 0;
+        GLContext &context = GLContext::getInstance();
+        if (generation != context.getGeneration())
+        {
+            generation = context.getGeneration();
+            s3tc = context.hasExtension("GL_EXT_texture_compression_s3tc");
+            bptc = context.hasVersion(4, 2) || context.hasExtension("GL_ARB_texture_compression_bptc");
+        }
+
+        switch (format)
+        {
+        case TextureFormat::BC1:
+        case TextureFormat::BC3:
+            return s3tc;
+        case TextureFormat::BC7:
+            return bptc;
+        default:
+            return true; // RGTC（BC4/BC5）为 GL 3.0 核心功能
+        }
+    }
+
     OpenGLTexture2D::OpenGLTexture2D(const std::string &path,
                                      TextureFilter filter,
                                      TextureWrap wrap)
     {
-        int width, height, channels;
-        stbi_set_flip_vertically_on_load(1); // 翻转Y轴
-        unsigned char *data = stbi_load(path.c_str(), &width, &height, &channels, 0);
-        if (!data)
+        // 文件只映射一次：KTX2 / DDS / .oxtex 容器直接上传预处理数据，其他格式从映射内存解码
+        auto file = std::make_shared<MappedFile>(path);
+        if (!file->isOpen())
         {
             throw std::runtime_error("Failed to load texture: " + path);
         }
+        CompressedImageData container;
+        ImageData image;
+        try
+        {
+            if (CompressedImageData::isContainer(file->data(), file->size()))
+                container = CompressedImageData::parse(file->data(), file->size(), file);
+            else
+                image = ImageData::loadFromMemory(file->data(), file->size(), true); // 翻转Y轴
+        }
+        catch (const std::exception &e)
+        {
+            throw std::runtime_error(std::string(e.what()) + ": " + path);
+        }
+        if (container.valid())
+        {
+            upload(container, filter, wrap);
+            return;
+        }
+        file.reset();
 
-        m_width = width;
-        m_height = height;
-
-        // 根据通道数设置格式
-        switch (channels)
+        if (image.channels != 3 && image.channels != 4)
         {
-        case 3:
-            m_internalFormat = GL_RGB8;
-            m_format = GL_RGB;
-            break;
-        case 4:
-            m_internalFormat = GL_RGBA8;
-            m_format = GL_RGBA;
-            break;
-        default:
-            stbi_image_free(data);
             throw std::runtime_error("Unsupported number of channels in texture: " + path);
         }
+        upload(image, filter, wrap);
+    }
+
+    OpenGLTexture2D::OpenGLTexture2D(const ImageData &image,
+                                     TextureFilter filter,
+                                     TextureWrap wrap)
+    {
+        if (!image.valid() || (image.channels != 3 && image.channels != 4))
+        {
+            throw std::runtime_error("Unsupported image data for texture");
+        }
+        upload(image, filter, wrap);
+    }
 
+    OpenGLTexture2D::OpenGLTexture2D(const CompressedImageData &image,
+                                     TextureFilter filter,
+                                     TextureWrap wrap)
+    {
+        if (!image.valid())
+        {
+            throw std::runtime_error("Invalid compressed image data for texture");
+        }
+        upload(image, filter, wrap);
+    }
+
+    void OpenGLTexture2D::createTexture(TextureFilter filter, TextureWrap wrap)
+    {
         glGenTextures(1, &m_rendererID);
-        glBindTexture(GL_TEXTURE_2D, m_rendererID);
+        GLStateCache::getInstance().bindTexture(GL_TEXTURE_2D, m_rendererID);
 
-        // 设置过滤器（先设置 MAG，MIN 将在生成 mipmap 后设置为合适的模式）
+        // 设置过滤器（先设置 MAG，MIN 在确定 mipmap 后设置）
         m_filter = (filter == TextureFilter::Linear) ? GL_LINEAR : GL_NEAREST;
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_filter);
 
@@ -47,41 +174,479 @@ namespace OxyRender
         m_wrap = (wrap == TextureWrap::Repeat) ? GL_REPEAT : GL_CLAMP_TO_EDGE;
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_wrap);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_wrap);
+    }
+
+    void OpenGLTexture2D::upload(const CompressedImageData &image, TextureFilter filter, TextureWrap wrap)
+    {
+        if (!isFormatSupported(image.format))
+        {
+            throw std::runtime_error("Compressed texture format is not supported by this OpenGL context");
+        }
+
+        m_width = image.width;
+        m_height = image.height;
+        const bool compressed = isCompressedFormat(image.format);
+        glFormats(image.format, m_internalFormat, m_format);
+
+        createTexture(filter, wrap);
+        if (image.format == TextureFormat::R8)
+        {
+            const GLint swizzle[4] = {GL_RED, GL_RED, GL_RED, GL_ONE};
+            glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+        }
+
+        // 逐级上传预计算的 mip 链（直接读取映射内存），并限制最大级别，链不完整也能采样
+        if (!compressed)
+            glPixelStorei(GL_UNPACK_ALIGNMENT, static_cast<GLint>(image.rowAlignment));
+        for (size_t i = 0; i < image.levels.size(); ++i)
+        {
+            const auto &level = image.levels[i];
+            if (compressed)
+                glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), m_internalFormat, level.width, level.height, 0,
+                                       static_cast<GLsizei>(level.size), level.data);
+            else
+                glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), m_internalFormat, level.width, level.height, 0,
+                             m_format, GL_UNSIGNED_BYTE, level.data);
+        }
+        if (!compressed)
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(image.levels.size() - 1));
+
+        GLint minFilter = m_filter;
+        m_mipmapped = image.levels.size() > 1;
+        if (m_mipmapped)
+            minFilter = (filter == TextureFilter::Linear) ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_NEAREST;
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
+
+        GLStateCache::getInstance().bindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    void OpenGLTexture2D::upload(const ImageData &image, TextureFilter filter, TextureWrap wrap)
+    {
+        m_width = image.width;
+        m_height = image.height;
+
+        // 根据通道数设置格式
+        if (image.channels == 3)
+        {
+            m_internalFormat = GL_RGB8;
+            m_format = GL_RGB;
+        }
+        else
+        {
+            m_internalFormat = GL_RGBA8;
+            m_format = GL_RGBA;
+        }
+
+        createTexture(filter, wrap);
 
         // 上传数据
-        glTexImage2D(GL_TEXTURE_2D, 0, m_internalFormat, m_width, m_height, 0, m_format, GL_UNSIGNED_BYTE, data);
+        glTexImage2D(GL_TEXTURE_2D, 0, m_internalFormat, m_width, m_height, 0, m_format, GL_UNSIGNED_BYTE, image.pixels.get());
         // 生成 mipmap 并配置 MIN 过滤
         glGenerateMipmap(GL_TEXTURE_2D);
+        m_mipmapped = true;
         GLint minFilter = (filter == TextureFilter::Linear) ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_NEAREST;
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
 
-        glBindTexture(GL_TEXTURE_2D, 0);
-
-        stbi_image_free(data);
+        GLStateCache::getInstance().bindTexture(GL_TEXTURE_2D, 0);
     }
     OpenGLTexture2D::~OpenGLTexture2D()
     {
-        glDeleteTextures(1, &m_rendererID);
+        GLStateCache::getInstance().deleteTexture(m_rendererID);
     }
 
     void OpenGLTexture2D::bind(uint32_t slot) const noexcept
     {
-        glActiveTexture(GL_TEXTURE0 + slot);
-        glBindTexture(GL_TEXTURE_2D, m_rendererID);
+        GLStateCache::getInstance().bindTexture(GL_TEXTURE_2D, m_rendererID, slot);
     }
 
     void OpenGLTexture2D::unbind() const noexcept
     {
-        glBindTexture(GL_TEXTURE_2D, 0);
+        GLStateCache::getInstance().bindTexture(GL_TEXTURE_2D, 0);
     }
     void OpenGLTexture2D::setData(const void *data, uint32_t width, uint32_t height)
     {
-        m_width = width;
-        m_height = height;
-        glBindTexture(GL_TEXTURE_2D, m_rendererID);
-        glTexImage2D(GL_TEXTURE_2D, 0, m_internalFormat, m_width, m_height, 0, m_format, GL_UNSIGNED_BYTE, data);
-        glBindTexture(GL_TEXTURE_2D, 0);
+        if (m_format == 0)
+        {
+            throw std::runtime_error("setData is not supported on compressed textures");
+        }
+        GLStateCache::getInstance().bindTexture(GL_TEXTURE_2D, m_rendererID);
+        if (width == m_width && height == m_height)
+        {
+            // 尺寸不变时只更新内容，避免重新分配存储
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_width, m_height, m_format, GL_UNSIGNED_BYTE, data);
+        }
+        else
+        {
+            m_width = width;
+            m_height = height;
+            glTexImage2D(GL_TEXTURE_2D, 0, m_internalFormat, m_width, m_height, 0, m_format, GL_UNSIGNED_BYTE, data);
+        }
+        // 较低的 mip 级别由新内容重新生成（尺寸变化时也重新定义各级）
+        if (m_mipmapped)
+            glGenerateMipmap(GL_TEXTURE_2D);
+        GLStateCache::getInstance().bindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    void OpenGLTexture2D::setSubData(const void *data, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+    {
+        if (m_format == 0)
+        {
+            throw std::runtime_error("setSubData is not supported on compressed textures");
+        }
+        if (x + width > m_width || y + height > m_height)
+        {
+            throw std::runtime_error("Texture sub-region out of range");
+        }
+        GLStateCache::getInstance().bindTexture(GL_TEXTURE_2D, m_rendererID);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, m_format, GL_UNSIGNED_BYTE, data);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        if (m_mipmapped)
+            glGenerateMipmap(GL_TEXTURE_2D);
+        GLStateCache::getInstance().bindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    namespace
+    {
+        using TexStorage2DProc = void(APIENTRYP)(GLenum, GLsizei, GLenum, GLsizei, GLsizei);
+
+        // glTexStorage2D 属于 GL 4.2 / ARB_texture_storage，GLAD 未生成，按需加载；
+        // 入口地址随上下文而变，上下文更换后重新检测
+        TexStorage2DProc texStorage2D()
+        {
+            static TexStorage2DProc proc = nullptr;
+            static uint64_t generation = 0;
+            GLContext &context = GLContext::getInstance();
+            if (generation != context.getGeneration())
+            {
+                generation = context.getGeneration();
+                proc = nullptr;
+                if (context.hasVersion(4, 2) || context.hasExtension("GL_ARB_texture_storage"))
+                    proc = reinterpret_cast<TexStorage2DProc>(context.getProcAddress("glTexStorage2D"));
+            }
+            return proc;
+        }
+    }
+
+    OpenGLDynamicTexture2D::OpenGLDynamicTexture2D(uint32_t width, uint32_t height, TextureFormat format,
+                                                   uint32_t bufferCount, TextureFilter filter, TextureWrap wrap)
+        : m_width(width), m_height(height)
+    {
+        switch (format)
+        {
+        case TextureFormat::RGBA8:
+            m_internalFormat = GL_RGBA8, m_format = GL_RGBA, m_bytesPerPixel = 4;
+            break;
+        case TextureFormat::RGB8:
+            m_internalFormat = GL_RGB8, m_format = GL_RGB, m_bytesPerPixel = 3;
+            break;
+        case TextureFormat::R8:
+            m_internalFormat = GL_R8, m_format = GL_RED, m_bytesPerPixel = 1;
+            break;
+        default:
+            throw std::runtime_error("Unsupported format for dynamic texture");
+        }
+        if (width == 0 || height == 0)
+        {
+            throw std::runtime_error("Dynamic texture size must be non-zero");
+        }
+
+        glGenTextures(1, &m_rendererID);
+        GLStateCache::getInstance().bindTexture(GL_TEXTURE_2D, m_rendererID);
+        GLint glFilter = (filter == TextureFilter::Linear) ? GL_LINEAR : GL_NEAREST;
+        GLint glWrap = (wrap == TextureWrap::Repeat) ? GL_REPEAT : GL_CLAMP_TO_EDGE;
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, glFilter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, glFilter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, glWrap);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, glWrap);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+        if (format == TextureFormat::R8)
+        {
+            const GLint swizzle[4] = {GL_RED, GL_RED, GL_RED, GL_ONE};
+            glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+        }
+
+        // 不可变存储；不支持时退回一次性 glTexImage2D，此后只用 glTexSubImage2D 更新
+        if (auto storage = texStorage2D())
+            storage(GL_TEXTURE_2D, 1, m_internalFormat, m_width, m_height);
+        else
+            glTexImage2D(GL_TEXTURE_2D, 0, m_internalFormat, m_width, m_height, 0, m_format, GL_UNSIGNED_BYTE, nullptr);
+        GLStateCache::getInstance().bindTexture(GL_TEXTURE_2D, 0);
+
+        // 每个 PBO 按整张纹理分配，子矩形更新只使用前部
+        m_slots.resize(std::max<uint32_t>(bufferCount, 1));
+        const size_t bytes = size_t(m_width) * m_height * m_bytesPerPixel;
+        for (auto &slot : m_slots)
+        {
+            glGenBuffers(1, &slot.buffer);
+            GLStateCache::getInstance().bindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer);
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STREAM_DRAW);
+        }
+        GLStateCache::getInstance().bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+
+    OpenGLDynamicTexture2D::~OpenGLDynamicTexture2D()
+    {
+        if (m_mapped)
+        {
+            GLStateCache::getInstance().bindBuffer(GL_PIXEL_UNPACK_BUFFER, m_slots[m_next].buffer);
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            GLStateCache::getInstance().bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        }
+        for (auto &slot : m_slots)
+        {
+            if (slot.fence)
+                glDeleteSync(static_cast<GLsync>(slot.fence));
+            GLStateCache::getInstance().deleteBuffer(slot.buffer);
+        }
+        GLStateCache::getInstance().deleteTexture(m_rendererID);
+    }
+
+    void OpenGLDynamicTexture2D::bind(uint32_t slot) const noexcept
+    {
+        GLStateCache::getInstance().bindTexture(GL_TEXTURE_2D, m_rendererID, slot);
+    }
+
+    void OpenGLDynamicTexture2D::unbind() const noexcept
+    {
+        GLStateCache::getInstance().bindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    void *OpenGLDynamicTexture2D::beginUpdate(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+    {
+        if (m_mapped)
+        {
+            throw std::runtime_error("beginUpdate called again before endUpdate");
+        }
+        if (width == 0 || height == 0 || x + width > m_width || y + height > m_height)
+        {
+            throw std::runtime_error("Texture sub-region out of range");
+        }
+
+        Slot &slot = m_slots[m_next];
+        if (slot.fence)
+        {
+            // 先非阻塞查询，仍在传输时才真正等待并计数
+            GLsync fence = static_cast<GLsync>(slot.fence);
+            GLenum status = glClientWaitSync(fence, 0, 0);
+            if (status == GL_TIMEOUT_EXPIRED)
+            {
+                ++m_stats.stalls;
+                // 槽按提交顺序复用，后面的槽只会更晚完成，超时后继续等待，不能在传输未完成时覆写 PBO
+                do
+                {
+                    status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+                } while (status == GL_TIMEOUT_EXPIRED);
+            }
+            if (status == GL_WAIT_FAILED)
+            {
+                throw std::runtime_error("Failed to wait for pixel unpack buffer transfer");
+            }
+            glDeleteSync(fence);
+            slot.fence = nullptr;
+        }
+
+        // 上一次传输已完成，可以无同步映射
+        const size_t bytes = size_t(width) * height * m_bytesPerPixel;
+        GLStateCache::getInstance().bindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer);
+        void *pointer = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(bytes),
+                                         GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        GLStateCache::getInstance().bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        if (!pointer)
+        {
+            throw std::runtime_error("Failed to map pixel unpack buffer");
+        }
+
+        m_mapped = true;
+        m_regionX = x;
+        m_regionY = y;
+        m_regionWidth = width;
+        m_regionHeight = height;
+        return pointer;
+    }
+
+    void OpenGLDynamicTexture2D::endUpdate()
+    {
+        if (!m_mapped)
+        {
+            return;
+        }
+        m_mapped = false;
+
+        Slot &slot = m_slots[m_next];
+        m_next = (m_next + 1) % m_slots.size();
+        GLStateCache::getInstance().bindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer);
+        if (glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_FALSE)
+        {
+            // 映射内容失效（如显示模式切换），丢弃本次更新
+            GLStateCache::getInstance().bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            std::cerr << "Dynamic texture update lost: pixel buffer contents were invalidated" << std::endl;
+            return;
+        }
+
+        // 数据源为 PBO 时调用立即返回，传输由驱动异步完成
+        GLStateCache::getInstance().bindTexture(GL_TEXTURE_2D, m_rendererID);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, m_regionX, m_regionY, m_regionWidth, m_regionHeight, m_format, GL_UNSIGNED_BYTE, nullptr);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        GLStateCache::getInstance().bindTexture(GL_TEXTURE_2D, 0);
+        GLStateCache::getInstance().bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+        ++m_stats.uploads;
+        m_stats.bytes += size_t(m_regionWidth) * m_regionHeight * m_bytesPerPixel;
+    }
+
+    void OpenGLDynamicTexture2D::setSubData(const void *data, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+    {
+        void *pointer = beginUpdate(x, y, width, height);
+        std::memcpy(pointer, data, size_t(width) * height * m_bytesPerPixel);
+        endUpdate();
+    }
+
+    void OpenGLDynamicTexture2D::setData(const void *data, uint32_t width, uint32_t height)
+    {
+        if (width != m_width || height != m_height)
+        {
+            throw std::runtime_error("Dynamic texture size is fixed at creation");
+        }
+        setSubData(data, 0, 0, width, height);
+    }
+
+    OpenGLStreamingTexture2D::OpenGLStreamingTexture2D(const CompressedImageData &source, uint32_t firstLevel,
+                                                       TextureFilter filter, TextureWrap wrap)
+        : m_width(source.width), m_height(source.height), m_sourceFormat(source.format)
+    {
+        if (!source.valid())
+        {
+            throw std::runtime_error("Invalid image data for streaming texture");
+        }
+        if (!OpenGLTexture2D::isFormatSupported(source.format))
+        {
+            throw std::runtime_error("Compressed texture format is not supported by this OpenGL context");
+        }
+        glFormats(source.format, m_internalFormat, m_format);
+
+        const uint32_t levelCount = static_cast<uint32_t>(source.levels.size());
+        m_levelBytes.resize(levelCount);
+        for (uint32_t i = 0; i < levelCount; ++i)
+            m_levelBytes[i] = CompressedImageData::levelSize(source.format, source.levels[i].width, source.levels[i].height);
+        m_residentLevel = std::min(firstLevel, levelCount - 1);
+
+        glGenTextures(1, &m_rendererID);
+        GLStateCache::getInstance().bindTexture(GL_TEXTURE_2D, m_rendererID);
+        const GLint magFilter = (filter == TextureFilter::Linear) ? GL_LINEAR : GL_NEAREST;
+        GLint minFilter = magFilter;
+        if (levelCount > 1)
+            minFilter = (filter == TextureFilter::Linear) ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_NEAREST;
+        const GLint glWrap = (wrap == TextureWrap::Repeat) ? GL_REPEAT : GL_CLAMP_TO_EDGE;
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, glWrap);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, glWrap);
+        if (source.format == TextureFormat::R8)
+        {
+            const GLint swizzle[4] = {GL_RED, GL_RED, GL_RED, GL_ONE};
+            glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+        }
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(levelCount - 1));
+        GLStateCache::getInstance().bindTexture(GL_TEXTURE_2D, 0);
+
+        // 从最粗一级开始上传，BASE_LEVEL 随之下移
+        const uint32_t first = m_residentLevel;
+        m_residentLevel = levelCount;
+        for (uint32_t level = levelCount; level-- > first;)
+            uploadLevel(source, level);
     }
+
+    OpenGLStreamingTexture2D::~OpenGLStreamingTexture2D()
+    {
+        GLStateCache::getInstance().deleteTexture(m_rendererID);
+    }
+
+    void OpenGLStreamingTexture2D::bind(uint32_t slot) const noexcept
+    {
+        GLStateCache::getInstance().bindTexture(GL_TEXTURE_2D, m_rendererID, slot);
+    }
+
+    void OpenGLStreamingTexture2D::unbind() const noexcept
+    {
+        GLStateCache::getInstance().bindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    void OpenGLStreamingTexture2D::setData(const void *, uint32_t, uint32_t)
+    {
+        throw std::runtime_error("setData is not supported on streaming textures");
+    }
+
+    void OpenGLStreamingTexture2D::setSubData(const void *, uint32_t, uint32_t, uint32_t, uint32_t)
+    {
+        throw std::runtime_error("setSubData is not supported on streaming textures");
+    }
+
+    bool OpenGLStreamingTexture2D::isCompatible(const CompressedImageData &source) const noexcept
+    {
+        return source.valid() && source.format == m_sourceFormat && source.width == m_width &&
+               source.height == m_height && source.levels.size() == m_levelBytes.size();
+    }
+
+    void OpenGLStreamingTexture2D::uploadLevel(const CompressedImageData &source, uint32_t level)
+    {
+        if (!isCompatible(source) || level + 1 != m_residentLevel)
+        {
+            throw std::runtime_error("Streaming texture level upload out of order or from a mismatched source");
+        }
+
+        const auto &data = source.levels[level];
+        GLStateCache::getInstance().bindTexture(GL_TEXTURE_2D, m_rendererID);
+        if (m_format == 0)
+        {
+            glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), m_internalFormat, data.width, data.height, 0,
+                                   static_cast<GLsizei>(data.size), data.data);
+        }
+        else
+        {
+            glPixelStorei(GL_UNPACK_ALIGNMENT, static_cast<GLint>(source.rowAlignment));
+            glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), m_internalFormat, data.width, data.height, 0,
+                         m_format, GL_UNSIGNED_BYTE, data.data);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        }
+        // 新级别就绪后再放开采样范围
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(level));
+        GLStateCache::getInstance().bindTexture(GL_TEXTURE_2D, 0);
+        m_residentLevel = level;
+    }
+
+    void OpenGLStreamingTexture2D::evictTo(uint32_t level)
+    {
+        level = std::min(level, getLevelCount() - 1);
+        if (level <= m_residentLevel)
+            return;
+
+        GLStateCache::getInstance().bindTexture(GL_TEXTURE_2D, m_rendererID);
+        // 先收窄采样范围，再把被释放的级别重新指定为 0x0，驱动随之回收存储
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(level));
+        for (uint32_t i = m_residentLevel; i < level; ++i)
+        {
+            if (m_format == 0)
+                glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), m_internalFormat, 0, 0, 0, 0, nullptr);
+            else
+                glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), m_internalFormat, 0, 0, 0, m_format, GL_UNSIGNED_BYTE, nullptr);
+        }
+        GLStateCache::getInstance().bindTexture(GL_TEXTURE_2D, 0);
+        m_residentLevel = level;
+    }
+
+    size_t OpenGLStreamingTexture2D::getResidentBytes() const noexcept
+    {
+        size_t bytes = 0;
+        for (size_t i = m_residentLevel; i < m_levelBytes.size(); ++i)
+            bytes += m_levelBytes[i];
+        return bytes;
+    }
+
     std::unique_ptr<ITexture> TextureFactory::createTexture2D(const std::string &path, TextureFilter filter, TextureWrap wrap)
     {
         if (Backends::OXYG_CurrentBackend == RendererBackend::OpenGL)
@@ -102,29 +667,71 @@ namespace OxyRender
         }
     }
 
+    Texture2D::Texture2D(const ImageData &image, TextureFilter filter, TextureWrap wrap)
+    {
+        if (Backends::OXYG_CurrentBackend == RendererBackend::OpenGL)
+        {
+            m_texture = std::make_shared<OpenGLTexture2D>(image, filter, wrap);
+        }
+        else
+        {
+            throw std::runtime_error("Unsupported backend for Texture2D");
+        }
+    }
+
+    Texture2D::Texture2D(const CompressedImageData &image, TextureFilter filter, TextureWrap wrap)
+    {
+        if (Backends::OXYG_CurrentBackend == RendererBackend::OpenGL)
+        {
+            m_texture = std::make_shared<OpenGLTexture2D>(image, filter, wrap);
+        }
+        else
+        {
+            throw std::runtime_error("Unsupported backend for Texture2D");
+        }
+    }
+
+    namespace
+    {
+        std::shared_ptr<OpenGLDynamicTexture2D> createDynamicTexture(uint32_t width, uint32_t height, TextureFormat format,
+                                                                     uint32_t bufferCount, TextureFilter filter, TextureWrap wrap)
+        {
+            if (Backends::OXYG_CurrentBackend == RendererBackend::OpenGL)
+            {
+                return std::make_shared<OpenGLDynamicTexture2D>(width, height, format, bufferCount, filter, wrap);
+            }
+            throw std::runtime_error("Unsupported backend for DynamicTexture2D");
+        }
+    }
+
+    DynamicTexture2D::DynamicTexture2D(uint32_t width, uint32_t height, TextureFormat format,
+                                       uint32_t bufferCount, TextureFilter filter, TextureWrap wrap)
+        : DynamicTexture2D(createDynamicTexture(width, height, format, bufferCount, filter, wrap))
+    {
+    }
+
     OpenGLCubemap::OpenGLCubemap(const std::vector<std::string> &faces)
     {
+        // 六个面在线程池上并行解码，再依次上传
+        std::vector<ImageData> images = ImageDecoderRegistry::getInstance().decodeFiles(faces, false);
+
         glGenTextures(1, &m_rendererID);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, m_rendererID);
-        stbi_set_flip_vertically_on_load(false);
-        int width, height, nrChannels;
-        for (unsigned int i = 0; i < faces.size(); i++)
+        GLStateCache::getInstance().bindTexture(GL_TEXTURE_CUBE_MAP, m_rendererID);
+        for (unsigned int i = 0; i < images.size(); i++)
         {
-            unsigned char *data = stbi_load(faces[i].c_str(), &width, &height, &nrChannels, 0);
-            if (data)
+            const ImageData &image = images[i];
+            if (image.valid())
             {
                 GLenum format = GL_RGB;
-                if (nrChannels == 4)
+                if (image.channels == 4)
                     format = GL_RGBA;
 
                 glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i,
-                             0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-                stbi_image_free(data);
+                             0, format, image.width, image.height, 0, format, GL_UNSIGNED_BYTE, image.pixels.get());
             }
             else
             {
                 std::cout << "Cubemap texture failed to load at path: " << faces[i] << std::endl;
-                stbi_image_free(data);
             }
         }
 
@@ -137,18 +744,17 @@ namespace OxyRender
 
     OpenGLCubemap::~OpenGLCubemap()
     {
-        glDeleteTextures(1, &m_rendererID);
+        GLStateCache::getInstance().deleteTexture(m_rendererID);
     }
 
     void OpenGLCubemap::bind(uint32_t slot) const noexcept
     {
-        glActiveTexture(GL_TEXTURE0 + slot);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, m_rendererID);
+        GLStateCache::getInstance().bindTexture(GL_TEXTURE_CUBE_MAP, m_rendererID, slot);
     }
 
     void OpenGLCubemap::unbind() const noexcept
     {
-        glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+        GLStateCache::getInstance().bindTexture(GL_TEXTURE_CUBE_MAP, 0);
     }
 
     std::unique_ptr<ICubemap> TextureFactory::createCubemap(const std::vector<std::string> &faces)
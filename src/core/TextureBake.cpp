@@ -0,0 +1,224 @@
+#include "OxygenRender/TextureBake.h"
+#include "OxygenRender/MappedFile.h"
+#include "OxygenRender/TextureCompression.h"
+#include "FileStamp.h"
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace OxyRender
+{
+    namespace
+    {
+        constexpr size_t kAlignment = 16;
+        constexpr uint32_t kRowAlignment = 4; // 与 GL_UNPACK_ALIGNMENT 默认值一致
+
+        inline uint64_t alignUp(uint64_t value)
+        {
+            return (value + kAlignment - 1) & ~uint64_t(kAlignment - 1);
+        }
+
+        bool formatCode(TextureFormat format, uint32_t &code)
+        {
+            using namespace TextureBakeFormat;
+            switch (format)
+            {
+            case TextureFormat::RGBA8:
+                code = FormatCode::RGBA8;
+                return true;
+            case TextureFormat::RGB8:
+                code = FormatCode::RGB8;
+                return true;
+            case TextureFormat::R8:
+                code = FormatCode::R8;
+                return true;
+            case TextureFormat::BC1:
+                code = FormatCode::BC1;
+                return true;
+            case TextureFormat::BC3:
+                code = FormatCode::BC3;
+                return true;
+            case TextureFormat::BC4:
+                code = FormatCode::BC4;
+                return true;
+            case TextureFormat::BC5:
+                code = FormatCode::BC5;
+                return true;
+            case TextureFormat::BC7:
+                code = FormatCode::BC7;
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        // 读取并校验文件头（含源文件一致性），失败返回 false。
+        // 源文件不存在时（只发布烘焙结果）直接接受；内容一致但修改时间不同时写回新的修改时间，下次不再计算哈希
+        bool readHeader(const MappedFile &file, const std::string &bakedPath, const std::string &sourcePath,
+                        TextureBakeFormat::Header &header)
+        {
+            using namespace TextureBakeFormat;
+            if (!file.isOpen() || file.size() < sizeof(Header))
+                return false;
+            std::memcpy(&header, file.data(), sizeof(header));
+            if (header.magic != MAGIC || header.version != VERSION)
+                return false;
+
+            int64_t currentMtime = 0;
+            switch (FileStamp::check(sourcePath, FileStamp::Stamp{header.sourceSize, header.sourceMtime, header.sourceHash},
+                                     currentMtime))
+            {
+            case FileStamp::Result::Match:
+            case FileStamp::Result::Missing:
+                return true;
+            case FileStamp::Result::Touched:
+                header.sourceMtime = currentMtime;
+                FileStamp::patch(bakedPath, offsetof(Header, sourceMtime), &currentMtime, sizeof(currentMtime));
+                return true;
+            default:
+                return false;
+            }
+        }
+    }
+
+    bool TextureBake::write(const std::string &bakedPath, const CompressedImageData &image, const std::string &sourcePath,
+                            bool flipped)
+    {
+        using namespace TextureBakeFormat;
+
+        Header header{};
+        header.magic = MAGIC;
+        header.version = VERSION;
+        if (!image.valid() || !formatCode(image.format, header.format))
+        {
+            std::cerr << "TextureBake: unsupported image for " << bakedPath << std::endl;
+            return false;
+        }
+        header.width = image.width;
+        header.height = image.height;
+        header.levelCount = static_cast<uint32_t>(image.levels.size());
+        header.flags = flipped ? FLAG_FLIPPED : 0;
+        header.rowAlignment = image.rowAlignment;
+        if (!sourcePath.empty())
+        {
+            FileStamp::Stamp source = FileStamp::make(sourcePath);
+            if (source.size == 0 && source.mtime == 0)
+            {
+                std::cerr << "TextureBake: cannot stat " << sourcePath << std::endl;
+                return false;
+            }
+            header.sourceSize = source.size;
+            header.sourceMtime = source.mtime;
+            header.sourceHash = source.hash;
+        }
+
+        std::vector<LevelEntry> entries(image.levels.size());
+        uint64_t offset = alignUp(sizeof(Header) + entries.size() * sizeof(LevelEntry));
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            entries[i].offset = offset;
+            entries[i].size = image.levels[i].size;
+            entries[i].width = image.levels[i].width;
+            entries[i].height = image.levels[i].height;
+            offset = alignUp(offset + entries[i].size);
+        }
+
+        // 先写临时文件再改名，避免中途失败留下损坏的文件
+        std::string tempPath = bakedPath + ".tmp";
+        {
+            std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+            if (!out)
+            {
+                std::cerr << "TextureBake: cannot write " << tempPath << std::endl;
+                return false;
+            }
+
+            static const char zeros[kAlignment] = {};
+            auto pad = [&]()
+            {
+                uint64_t pos = static_cast<uint64_t>(out.tellp());
+                out.write(zeros, static_cast<std::streamsize>(alignUp(pos) - pos));
+            };
+
+            out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char *>(entries.data()), entries.size() * sizeof(LevelEntry));
+            pad();
+            for (const auto &level : image.levels)
+            {
+                out.write(reinterpret_cast<const char *>(level.data), static_cast<std::streamsize>(level.size));
+                pad();
+            }
+            if (!out)
+            {
+                std::cerr << "TextureBake: failed writing " << tempPath << std::endl;
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tempPath, bakedPath, ec);
+        if (ec)
+        {
+            std::cerr << "TextureBake: cannot replace " << bakedPath << ": " << ec.message() << std::endl;
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+        return true;
+    }
+
+    bool TextureBake::bake(const std::string &sourcePath, const std::string &bakedPath, const TextureBakeOptions &options)
+    {
+        try
+        {
+            ImageData image = ImageData::load(sourcePath, options.flipVertically, false);
+            if (isCompressedFormat(options.format))
+            {
+                CompressedImageData compressed = TextureCompression::compress(image, options.format, options.generateMips);
+                return write(bakedPath, compressed, sourcePath, options.flipVertically);
+            }
+
+            // 未压缩：保留源图像的通道，逐级按行对齐后拼接
+            std::vector<ImageData> chain = options.generateMips ? TextureCompression::buildMipChain(image)
+                                                                : std::vector<ImageData>{image};
+            CompressedImageData result = TextureCompression::packMipChain(chain, kRowAlignment);
+            return write(bakedPath, result, sourcePath, options.flipVertically);
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "TextureBake: " << sourcePath << ": " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    bool TextureBake::isUpToDate(const std::string &bakedPath, const std::string &sourcePath)
+    {
+        TextureBakeFormat::Header header;
+        return readHeader(MappedFile(bakedPath), bakedPath, sourcePath, header);
+    }
+
+    CompressedImageData TextureBake::open(const std::string &bakedPath, const std::string &sourcePath,
+                                          bool flipVertically, uint64_t *outSourceHash)
+    {
+        auto file = std::make_shared<MappedFile>(bakedPath);
+        TextureBakeFormat::Header header;
+        if (!readHeader(*file, bakedPath, sourcePath, header))
+            return {};
+        if (((header.flags & TextureBakeFormat::FLAG_FLIPPED) != 0) != flipVertically)
+            return {};
+
+        try
+        {
+            CompressedImageData image = CompressedImageData::parse(file->data(), file->size(), file);
+            if (outSourceHash)
+                *outSourceHash = header.sourceHash;
+            return image;
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "TextureBake: ignoring " << bakedPath << ": " << e.what() << std::endl;
+            return {};
+        }
+    }
+}
@@ -0,0 +1,250 @@
+#include "OxygenRender/TextureCache.h"
+#include "OxygenRender/GLContext.h"
+#include "OxygenRender/MappedFile.h"
+#include "OxygenRender/ResourcesManager.h"
+#include "OxygenRender/TextureBake.h"
+#include <filesystem>
+
+namespace OxyRender
+{
+    namespace
+    {
+        uint64_t fnv1a(const unsigned char *data, size_t size)
+        {
+            uint64_t hash = 14695981039346656037ull;
+            for (size_t i = 0; i < size; ++i)
+            {
+                hash ^= data[i];
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+    }
+
+    TextureCache &TextureCache::getInstance()
+    {
+        static TextureCache cache;
+        return cache;
+    }
+
+    TextureCache::TextureCache()
+    {
+        GLContext::getInstance().addTeardownCallback([this](uint64_t context)
+                                                     { releaseContext(context); });
+    }
+
+    void TextureCache::releaseContext(uint64_t context)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<Entry *> owned;
+        for (const auto &entry : m_byContent)
+            if (entry.second->context == context)
+                owned.push_back(entry.second.get());
+        for (Entry *entry : owned)
+            erase(entry);
+    }
+
+    std::string TextureCache::resolvePath(const std::string &path)
+    {
+        namespace fs = std::filesystem;
+        std::error_code ec;
+        fs::path resolved(path);
+        if (!fs::exists(resolved, ec))
+            resolved = ResourcesManager::getInstance().resolve(path);
+        fs::path canonical = fs::weakly_canonical(resolved, ec);
+        return ec ? resolved.lexically_normal().string() : canonical.string();
+    }
+
+    std::string TextureCache::keySuffix(TextureFilter filter, TextureWrap wrap)
+    {
+        // 纹理不能跨上下文使用，键里带上当前上下文
+        std::string suffix = "|";
+        suffix += filter == TextureFilter::Linear ? 'L' : 'N';
+        suffix += wrap == TextureWrap::Repeat ? 'R' : 'C';
+        suffix += '@' + std::to_string(GLContext::getInstance().getCurrentId());
+        return suffix;
+    }
+
+    DecodedTexture TextureCache::decode(const std::string &path, bool flipVertically)
+    {
+        DecodedTexture decoded;
+        decoded.key = resolvePath(path);
+
+        // 已烘焙且与源文件一致时只需映射，内容键沿用源文件哈希
+        if (getInstance().isBakedTexturesEnabled())
+        {
+            std::error_code ec;
+            const std::string baked = TextureBake::bakedPathFor(decoded.key);
+            if (std::filesystem::exists(baked, ec))
+            {
+                decoded.compressed = TextureBake::open(baked, decoded.key, flipVertically, &decoded.contentHash);
+                if (decoded.compressed.valid())
+                    return decoded;
+            }
+        }
+
+        // 一次映射同时完成哈希和解码
+        auto file = std::make_shared<MappedFile>(decoded.key);
+        if (!file->isOpen())
+            throw std::runtime_error("Failed to load texture: " + path);
+        decoded.contentHash = fnv1a(file->data(), file->size());
+        if (CompressedImageData::isContainer(file->data(), file->size()))
+        {
+            // 压缩容器直接引用映射内存，上传前不再拷贝
+            decoded.compressed = CompressedImageData::parse(file->data(), file->size(), file);
+            return decoded;
+        }
+        decoded.image = ImageData::loadFromMemory(file->data(), file->size(), flipVertically);
+        return decoded;
+    }
+
+    std::shared_ptr<Texture2D> TextureCache::find(const std::string &path, TextureFilter filter, TextureWrap wrap)
+    {
+        std::string key;
+        try
+        {
+            key = resolvePath(path) + keySuffix(filter, wrap);
+        }
+        catch (const std::exception &)
+        {
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_byPath.find(key);
+        if (it == m_byPath.end())
+            return nullptr;
+        ++m_stats.hits;
+        touch(*it->second);
+        return it->second->texture;
+    }
+
+    std::shared_ptr<Texture2D> TextureCache::load(const std::string &path, TextureFilter filter, TextureWrap wrap)
+    {
+        if (auto texture = find(path, filter, wrap))
+            return texture;
+        return insert(decode(path), filter, wrap);
+    }
+
+    std::shared_ptr<Texture2D> TextureCache::insert(const DecodedTexture &decoded, TextureFilter filter, TextureWrap wrap)
+    {
+        const std::string suffix = keySuffix(filter, wrap);
+        const std::string pathKey = decoded.key + suffix;
+        const std::string contentKey = std::to_string(decoded.contentHash) + suffix;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto byPath = m_byPath.find(pathKey);
+        if (byPath != m_byPath.end())
+        {
+            ++m_stats.hits;
+            touch(*byPath->second);
+            return byPath->second->texture;
+        }
+
+        // 不同路径、相同内容：记录路径别名，共享同一纹理
+        auto byContent = m_byContent.find(contentKey);
+        if (byContent != m_byContent.end())
+        {
+            ++m_stats.hits;
+            Entry &existing = *byContent->second;
+            existing.pathKeys.push_back(pathKey);
+            m_byPath.emplace(pathKey, &existing);
+            touch(existing);
+            return existing.texture;
+        }
+
+        ++m_stats.misses;
+        auto entry = std::make_unique<Entry>();
+        if (decoded.compressed.valid())
+        {
+            entry->texture = std::make_shared<Texture2D>(decoded.compressed, filter, wrap);
+            entry->bytes = decoded.compressed.totalBytes();
+        }
+        else
+        {
+            entry->texture = std::make_shared<Texture2D>(decoded.image, filter, wrap);
+            // 按 4 字节/像素估算（驱动通常把 RGB8 扩展为 4 字节），mipmap 额外 1/3
+            entry->bytes = size_t(decoded.image.width) * decoded.image.height * 4 * 4 / 3;
+        }
+        entry->contentKey = contentKey;
+        entry->context = GLContext::getInstance().getCurrentId();
+        entry->pathKeys.push_back(pathKey);
+        m_lru.push_front(entry.get());
+        entry->lru = m_lru.begin();
+
+        m_stats.residentBytes += entry->bytes;
+        ++m_stats.textureCount;
+        auto texture = entry->texture;
+        m_byPath.emplace(pathKey, entry.get());
+        m_byContent.emplace(contentKey, std::move(entry));
+
+        if (m_budget > 0 && m_stats.residentBytes > m_budget)
+            evict(m_budget);
+        return texture;
+    }
+
+    void TextureCache::touch(Entry &entry)
+    {
+        m_lru.splice(m_lru.begin(), m_lru, entry.lru);
+    }
+
+    void TextureCache::erase(Entry *entry)
+    {
+        m_lru.erase(entry->lru);
+        for (const auto &key : entry->pathKeys)
+            m_byPath.erase(key);
+        m_stats.residentBytes -= entry->bytes;
+        --m_stats.textureCount;
+        m_byContent.erase(entry->contentKey); // 销毁条目及纹理
+    }
+
+    void TextureCache::evict(size_t targetBytes)
+    {
+        // 从最久未使用端开始，只释放缓存之外无人引用的纹理
+        for (auto it = m_lru.end(); it != m_lru.begin() && m_stats.residentBytes > targetBytes;)
+        {
+            Entry *entry = *--it;
+            if (entry->texture.use_count() > 1)
+                continue;
+            it = std::next(it);
+            erase(entry);
+            ++m_stats.evictions;
+        }
+    }
+
+    void TextureCache::setMemoryBudget(size_t bytes)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_budget = bytes;
+        if (m_budget > 0)
+            evict(m_budget);
+    }
+
+    void TextureCache::collectGarbage()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_budget > 0)
+            evict(m_budget);
+    }
+
+    void TextureCache::clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        evict(0);
+    }
+
+    TextureCacheStats TextureCache::getStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+
+    void TextureCache::resetStats()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.hits = 0;
+        m_stats.misses = 0;
+        m_stats.evictions = 0;
+    }
+}
@@ -0,0 +1,816 @@
+#include "OxygenRender/TextureCompression.h"
+#include "OxygenRender/ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+namespace OxyRender
+{
+    namespace TextureCompression
+    {
+        namespace
+        {
+            // 取 4x4 块，越界像素复制边界
+            void fetchBlock(const unsigned char *rgba, uint32_t width, uint32_t height, uint32_t bx, uint32_t by,
+                            unsigned char block[16][4])
+            {
+                for (uint32_t y = 0; y < 4; ++y)
+                {
+                    uint32_t sy = std::min(by * 4 + y, height - 1);
+                    for (uint32_t x = 0; x < 4; ++x)
+                    {
+                        uint32_t sx = std::min(bx * 4 + x, width - 1);
+                        std::memcpy(block[y * 4 + x], rgba + (size_t(sy) * width + sx) * 4, 4);
+                    }
+                }
+            }
+
+            // 主成分方向（幂迭代），channels 为参与计算的通道数（3 或 4）
+            void principalAxis(const unsigned char block[16][4], int channels, float mean[4], float axis[4])
+            {
+                for (int c = 0; c < 4; ++c)
+                    mean[c] = 0.0f;
+                for (int i = 0; i < 16; ++i)
+                    for (int c = 0; c < channels; ++c)
+                        mean[c] += block[i][c] / 16.0f;
+
+                float cov[4][4] = {};
+                for (int i = 0; i < 16; ++i)
+                    for (int a = 0; a < channels; ++a)
+                        for (int b = 0; b < channels; ++b)
+                            cov[a][b] += (block[i][a] - mean[a]) * (block[i][b] - mean[b]);
+
+                float v[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+                for (int iteration = 0; iteration < 8; ++iteration)
+                {
+                    float next[4] = {};
+                    for (int a = 0; a < channels; ++a)
+                        for (int b = 0; b < channels; ++b)
+                            next[a] += cov[a][b] * v[b];
+                    float length = 0.0f;
+                    for (int c = 0; c < channels; ++c)
+                        length = std::max(length, std::fabs(next[c]));
+                    if (length < 1e-6f)
+                        break;
+                    for (int c = 0; c < channels; ++c)
+                        v[c] = next[c] / length;
+                }
+                for (int c = 0; c < 4; ++c)
+                    axis[c] = c < channels ? v[c] : 0.0f;
+            }
+
+            inline uint16_t packRGB565(const float c[3])
+            {
+                int r = std::min(31, std::max(0, int(c[0] * 31.0f / 255.0f + 0.5f)));
+                int g = std::min(63, std::max(0, int(c[1] * 63.0f / 255.0f + 0.5f)));
+                int b = std::min(31, std::max(0, int(c[2] * 31.0f / 255.0f + 0.5f)));
+                return uint16_t((r << 11) | (g << 5) | b);
+            }
+
+            inline void unpackRGB565(uint16_t v, int out[3])
+            {
+                int r = (v >> 11) & 31, g = (v >> 5) & 63, b = v & 31;
+                out[0] = (r << 3) | (r >> 2);
+                out[1] = (g << 2) | (g >> 4);
+                out[2] = (b << 3) | (b >> 2);
+            }
+
+            // BC1 颜色块；allowTransparent 时 alpha < 128 的像素使用三色模式的透明索引
+            void encodeColorBlock(const unsigned char block[16][4], bool allowTransparent, unsigned char *out)
+            {
+                bool transparent[16];
+                bool anyTransparent = false;
+                for (int i = 0; i < 16; ++i)
+                {
+                    transparent[i] = allowTransparent && block[i][3] < 128;
+                    anyTransparent |= transparent[i];
+                }
+
+                float mean[4], axis[4];
+                principalAxis(block, 3, mean, axis);
+
+                // 沿主轴取投影极值作为端点
+                float minT = 1e30f, maxT = -1e30f;
+                for (int i = 0; i < 16; ++i)
+                {
+                    if (transparent[i])
+                        continue;
+                    float t = 0.0f;
+                    for (int c = 0; c < 3; ++c)
+                        t += (block[i][c] - mean[c]) * axis[c];
+                    minT = std::min(minT, t);
+                    maxT = std::max(maxT, t);
+                }
+                if (minT > maxT)
+                    minT = maxT = 0.0f;
+
+                float e0[3], e1[3];
+                for (int c = 0; c < 3; ++c)
+                {
+                    e0[c] = std::min(255.0f, std::max(0.0f, mean[c] + axis[c] * maxT));
+                    e1[c] = std::min(255.0f, std::max(0.0f, mean[c] + axis[c] * minT));
+                }
+
+                uint16_t c0 = packRGB565(e0);
+                uint16_t c1 = packRGB565(e1);
+                // 四色模式要求 c0 > c1，三色（带透明）模式要求 c0 <= c1
+                if (anyTransparent ? c0 > c1 : c0 < c1)
+                    std::swap(c0, c1);
+                if (!anyTransparent && c0 == c1)
+                {
+                    // 纯色块：四色模式无法表示，全部使用索引 0
+                    std::memcpy(out, &c0, 2);
+                    std::memcpy(out + 2, &c1, 2);
+                    std::memset(out + 4, 0, 4);
+                    return;
+                }
+
+                int p[4][3];
+                unpackRGB565(c0, p[0]);
+                unpackRGB565(c1, p[1]);
+                const int paletteSize = anyTransparent ? 3 : 4;
+                for (int c = 0; c < 3; ++c)
+                {
+                    if (anyTransparent)
+                    {
+                        p[2][c] = (p[0][c] + p[1][c]) / 2;
+                    }
+                    else
+                    {
+                        p[2][c] = (2 * p[0][c] + p[1][c]) / 3;
+                        p[3][c] = (p[0][c] + 2 * p[1][c]) / 3;
+                    }
+                }
+
+                uint32_t indices = 0;
+                for (int i = 0; i < 16; ++i)
+                {
+                    int best = 3;
+                    if (!transparent[i])
+                    {
+                        int bestError = 1 << 30;
+                        for (int k = 0; k < paletteSize; ++k)
+                        {
+                            int dr = block[i][0] - p[k][0], dg = block[i][1] - p[k][1], db = block[i][2] - p[k][2];
+                            int error = dr * dr + dg * dg + db * db;
+                            if (error < bestError)
+                            {
+                                bestError = error;
+                                best = k;
+                            }
+                        }
+                    }
+                    indices |= uint32_t(best) << (i * 2);
+                }
+
+                std::memcpy(out, &c0, 2);
+                std::memcpy(out + 2, &c1, 2);
+                std::memcpy(out + 4, &indices, 4);
+            }
+
+            // BC4 单通道块（八值模式）
+            void encodeChannelBlock(const unsigned char block[16][4], int channel, unsigned char *out)
+            {
+                int lo = 255, hi = 0;
+                for (int i = 0; i < 16; ++i)
+                {
+                    lo = std::min(lo, int(block[i][channel]));
+                    hi = std::max(hi, int(block[i][channel]));
+                }
+
+                out[0] = uint8_t(hi);
+                out[1] = uint8_t(lo);
+                uint64_t indices = 0;
+                if (hi != lo)
+                {
+                    int palette[8];
+                    palette[0] = hi;
+                    palette[1] = lo;
+                    for (int k = 0; k < 6; ++k)
+                        palette[k + 2] = ((6 - k) * hi + (k + 1) * lo) / 7;
+
+                    for (int i = 0; i < 16; ++i)
+                    {
+                        int best = 0, bestError = 1 << 30;
+                        for (int k = 0; k < 8; ++k)
+                        {
+                            int error = std::abs(int(block[i][channel]) - palette[k]);
+                            if (error < bestError)
+                            {
+                                bestError = error;
+                                best = k;
+                            }
+                        }
+                        indices |= uint64_t(best) << (i * 3);
+                    }
+                }
+                for (int b = 0; b < 6; ++b)
+                    out[2 + b] = uint8_t(indices >> (b * 8));
+            }
+
+            // BC7 只使用模式 6（单分区，RGBA 7 位端点 + 各端点 1 位 P，4 位索引），速度与质量较平衡
+            const int kWeights4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+            struct Mode6Endpoints
+            {
+                int q[2][4]; // 7 位量化值
+                int p[2];    // P 位
+            };
+
+            // 量化一个端点，选择误差较小的 P 位
+            void quantizeMode6(const float e[4], int q[4], int &p)
+            {
+                float bestError = 1e30f;
+                for (int pbit = 0; pbit < 2; ++pbit)
+                {
+                    float error = 0.0f;
+                    int candidate[4];
+                    for (int c = 0; c < 4; ++c)
+                    {
+                        candidate[c] = std::min(127, std::max(0, int((e[c] - pbit) / 2.0f + 0.5f)));
+                        float d = float((candidate[c] << 1) | pbit) - e[c];
+                        error += d * d;
+                    }
+                    if (error < bestError)
+                    {
+                        bestError = error;
+                        p = pbit;
+                        std::memcpy(q, candidate, sizeof(candidate));
+                    }
+                }
+            }
+
+            // 按当前端点选最近索引，返回总平方误差
+            int assignMode6(const unsigned char block[16][4], const Mode6Endpoints &ep, int indices[16])
+            {
+                int palette[16][4];
+                for (int c = 0; c < 4; ++c)
+                {
+                    int a = (ep.q[0][c] << 1) | ep.p[0];
+                    int b = (ep.q[1][c] << 1) | ep.p[1];
+                    for (int k = 0; k < 16; ++k)
+                        palette[k][c] = ((64 - kWeights4[k]) * a + kWeights4[k] * b + 32) >> 6;
+                }
+
+                int total = 0;
+                for (int i = 0; i < 16; ++i)
+                {
+                    int best = 0, bestError = 1 << 30;
+                    for (int k = 0; k < 16; ++k)
+                    {
+                        int error = 0;
+                        for (int c = 0; c < 4; ++c)
+                        {
+                            int d = block[i][c] - palette[k][c];
+                            error += d * d;
+                        }
+                        if (error < bestError)
+                        {
+                            bestError = error;
+                            best = k;
+                        }
+                    }
+                    indices[i] = best;
+                    total += bestError;
+                }
+                return total;
+            }
+
+            class BitWriter
+            {
+            public:
+                explicit BitWriter(unsigned char *out) : m_out(out) { std::memset(out, 0, 16); }
+                void write(uint32_t value, int bits)
+                {
+                    for (int i = 0; i < bits; ++i, ++m_pos)
+                        if (value & (1u << i))
+                            m_out[m_pos >> 3] |= uint8_t(1u << (m_pos & 7));
+                }
+
+            private:
+                unsigned char *m_out;
+                int m_pos = 0;
+            };
+
+            void encodeBC7Block(const unsigned char block[16][4], unsigned char *out)
+            {
+                float mean[4], axis[4];
+                principalAxis(block, 4, mean, axis);
+
+                float minT = 1e30f, maxT = -1e30f;
+                for (int i = 0; i < 16; ++i)
+                {
+                    float t = 0.0f;
+                    for (int c = 0; c < 4; ++c)
+                        t += (block[i][c] - mean[c]) * axis[c];
+                    minT = std::min(minT, t);
+                    maxT = std::max(maxT, t);
+                }
+
+                float e[2][4];
+                for (int c = 0; c < 4; ++c)
+                {
+                    e[0][c] = std::min(255.0f, std::max(0.0f, mean[c] + axis[c] * minT));
+                    e[1][c] = std::min(255.0f, std::max(0.0f, mean[c] + axis[c] * maxT));
+                }
+
+                Mode6Endpoints ep;
+                quantizeMode6(e[0], ep.q[0], ep.p[0]);
+                quantizeMode6(e[1], ep.q[1], ep.p[1]);
+                int indices[16];
+                int error = assignMode6(block, ep, indices);
+
+                // 以当前索引做一次最小二乘端点拟合，误差更小时采用
+                float aa = 0.0f, ab = 0.0f, bb = 0.0f, ax[4] = {}, bx[4] = {};
+                for (int i = 0; i < 16; ++i)
+                {
+                    float w = kWeights4[indices[i]] / 64.0f;
+                    aa += (1.0f - w) * (1.0f - w);
+                    ab += (1.0f - w) * w;
+                    bb += w * w;
+                    for (int c = 0; c < 4; ++c)
+                    {
+                        ax[c] += (1.0f - w) * block[i][c];
+                        bx[c] += w * block[i][c];
+                    }
+                }
+                float det = aa * bb - ab * ab;
+                if (std::fabs(det) > 1e-6f)
+                {
+                    float refined[2][4];
+                    for (int c = 0; c < 4; ++c)
+                    {
+                        refined[0][c] = std::min(255.0f, std::max(0.0f, (ax[c] * bb - bx[c] * ab) / det));
+                        refined[1][c] = std::min(255.0f, std::max(0.0f, (bx[c] * aa - ax[c] * ab) / det));
+                    }
+                    Mode6Endpoints candidate;
+                    quantizeMode6(refined[0], candidate.q[0], candidate.p[0]);
+                    quantizeMode6(refined[1], candidate.q[1], candidate.p[1]);
+                    int candidateIndices[16];
+                    int candidateError = assignMode6(block, candidate, candidateIndices);
+                    if (candidateError < error)
+                    {
+                        ep = candidate;
+                        std::memcpy(indices, candidateIndices, sizeof(indices));
+                    }
+                }
+
+                // 锚点（第 0 个索引）最高位隐含为 0，必要时交换端点
+                if (indices[0] >= 8)
+                {
+                    std::swap(ep.q[0], ep.q[1]);
+                    std::swap(ep.p[0], ep.p[1]);
+                    for (int &index : indices)
+                        index = 15 - index;
+                }
+
+                BitWriter writer(out);
+                writer.write(1u << 6, 7); // 模式 6
+                for (int c = 0; c < 4; ++c)
+                {
+                    writer.write(uint32_t(ep.q[0][c]), 7);
+                    writer.write(uint32_t(ep.q[1][c]), 7);
+                }
+                writer.write(uint32_t(ep.p[0]), 1);
+                writer.write(uint32_t(ep.p[1]), 1);
+                writer.write(uint32_t(indices[0]), 3);
+                for (int i = 1; i < 16; ++i)
+                    writer.write(uint32_t(indices[i]), 4);
+            }
+
+            void encodeBlock(const unsigned char block[16][4], TextureFormat format, unsigned char *out)
+            {
+                switch (format)
+                {
+                case TextureFormat::BC1:
+                    encodeColorBlock(block, true, out);
+                    break;
+                case TextureFormat::BC3:
+                    encodeChannelBlock(block, 3, out);
+                    encodeColorBlock(block, false, out + 8);
+                    break;
+                case TextureFormat::BC4:
+                    encodeChannelBlock(block, 0, out);
+                    break;
+                case TextureFormat::BC5:
+                    encodeChannelBlock(block, 0, out);
+                    encodeChannelBlock(block, 1, out + 8);
+                    break;
+                case TextureFormat::BC7:
+                    encodeBC7Block(block, out);
+                    break;
+                default:
+                    throw std::runtime_error("Not a compressed texture format");
+                }
+            }
+
+            // BC5 只取前两个通道，2 通道源按 RG（如法线 XY）展开，其余格式按灰度 + alpha 展开
+            std::vector<unsigned char> toRGBA(const ImageData &image, TextureFormat format)
+            {
+                const size_t pixelCount = size_t(image.width) * image.height;
+                std::vector<unsigned char> rgba(pixelCount * 4);
+                const unsigned char *src = image.pixels.get();
+                for (size_t i = 0; i < pixelCount; ++i)
+                {
+                    const unsigned char *p = src + i * image.channels;
+                    unsigned char *d = &rgba[i * 4];
+                    switch (image.channels)
+                    {
+                    case 1:
+                        d[0] = d[1] = d[2] = p[0];
+                        d[3] = 255;
+                        break;
+                    case 2:
+                        if (format == TextureFormat::BC5)
+                        {
+                            d[0] = p[0], d[1] = p[1], d[2] = 0;
+                            d[3] = 255;
+                        }
+                        else
+                        {
+                            d[0] = d[1] = d[2] = p[0];
+                            d[3] = p[1];
+                        }
+                        break;
+                    case 3:
+                        d[0] = p[0], d[1] = p[1], d[2] = p[2];
+                        d[3] = 255;
+                        break;
+                    default:
+                        std::memcpy(d, p, 4);
+                        break;
+                    }
+                }
+                return rgba;
+            }
+
+            // 2x2 盒式滤波，奇数边长时复制边界
+            ImageData downsample(const ImageData &src)
+            {
+                const uint32_t width = src.width, height = src.height, channels = src.channels;
+                ImageData dst;
+                dst.width = std::max<uint32_t>(width / 2, 1);
+                dst.height = std::max<uint32_t>(height / 2, 1);
+                dst.channels = channels;
+                dst.pixels = std::shared_ptr<unsigned char>(new unsigned char[size_t(dst.width) * dst.height * channels],
+                                                            std::default_delete<unsigned char[]>());
+                const unsigned char *in = src.pixels.get();
+                unsigned char *out = dst.pixels.get();
+                for (uint32_t y = 0; y < dst.height; ++y)
+                {
+                    uint32_t y0 = std::min(y * 2, height - 1), y1 = std::min(y * 2 + 1, height - 1);
+                    for (uint32_t x = 0; x < dst.width; ++x)
+                    {
+                        uint32_t x0 = std::min(x * 2, width - 1), x1 = std::min(x * 2 + 1, width - 1);
+                        for (uint32_t c = 0; c < channels; ++c)
+                        {
+                            int sum = in[(size_t(y0) * width + x0) * channels + c] + in[(size_t(y0) * width + x1) * channels + c] +
+                                      in[(size_t(y1) * width + x0) * channels + c] + in[(size_t(y1) * width + x1) * channels + c];
+                            out[(size_t(y) * dst.width + x) * channels + c] = uint8_t((sum + 2) / 4);
+                        }
+                    }
+                }
+                return dst;
+            }
+
+            void put32(std::vector<unsigned char> &out, uint32_t value)
+            {
+                for (int i = 0; i < 4; ++i)
+                    out.push_back(uint8_t(value >> (i * 8)));
+            }
+
+            void put64(std::vector<unsigned char> &out, uint64_t value)
+            {
+                for (int i = 0; i < 8; ++i)
+                    out.push_back(uint8_t(value >> (i * 8)));
+            }
+
+            void align(std::vector<unsigned char> &out, size_t alignment)
+            {
+                while (out.size() % alignment)
+                    out.push_back(0);
+            }
+
+            bool writeFile(const std::string &path, const std::vector<unsigned char> &header, const CompressedImageData &image,
+                           bool smallestFirst, size_t levelAlignment)
+            {
+                std::ofstream file(path, std::ios::binary | std::ios::trunc);
+                if (!file)
+                    return false;
+                file.write(reinterpret_cast<const char *>(header.data()), std::streamsize(header.size()));
+                size_t offset = header.size();
+                const size_t levelCount = image.levels.size();
+                for (size_t n = 0; n < levelCount; ++n)
+                {
+                    const auto &level = image.levels[smallestFirst ? levelCount - 1 - n : n];
+                    static const char padding[16] = {};
+                    size_t pad = (levelAlignment - offset % levelAlignment) % levelAlignment;
+                    file.write(padding, std::streamsize(pad));
+                    file.write(reinterpret_cast<const char *>(level.data), std::streamsize(level.size));
+                    offset += pad + level.size;
+                }
+                return bool(file);
+            }
+        }
+
+        std::vector<unsigned char> compress(const unsigned char *rgba, uint32_t width, uint32_t height, TextureFormat format)
+        {
+            if (!isCompressedFormat(format))
+                throw std::runtime_error("Not a compressed texture format");
+
+            const uint32_t blocksX = (width + 3) / 4;
+            const uint32_t blocksY = (height + 3) / 4;
+            const size_t blockBytes = CompressedImageData::blockBytes(format);
+            std::vector<unsigned char> out(size_t(blocksX) * blocksY * blockBytes);
+
+            ThreadPool::getInstance().parallelFor(0, blocksY, [&](size_t by)
+                                                  {
+                unsigned char block[16][4];
+                for (uint32_t bx = 0; bx < blocksX; ++bx)
+                {
+                    fetchBlock(rgba, width, height, bx, uint32_t(by), block);
+                    encodeBlock(block, format, &out[(by * blocksX + bx) * blockBytes]);
+                } });
+            return out;
+        }
+
+        std::vector<ImageData> buildMipChain(const ImageData &image)
+        {
+            if (!image.valid())
+                throw std::runtime_error("Invalid image data for mip generation");
+            std::vector<ImageData> chain{image};
+            while (chain.back().width > 1 || chain.back().height > 1)
+                chain.push_back(downsample(chain.back()));
+            return chain;
+        }
+
+        CompressedImageData packMipChain(const std::vector<ImageData> &chain, uint32_t rowAlignment)
+        {
+            if (chain.empty() || !chain.front().valid())
+                throw std::runtime_error("Invalid mip chain");
+
+            CompressedImageData result;
+            switch (chain.front().channels)
+            {
+            case 1:
+                result.format = TextureFormat::R8;
+                break;
+            case 3:
+                result.format = TextureFormat::RGB8;
+                break;
+            case 2: // 灰度 + alpha 没有对应的上传格式，与运行时加载一致地展开为 RGBA
+            case 4:
+                result.format = TextureFormat::RGBA8;
+                break;
+            default:
+                throw std::runtime_error("Unsupported channel count for mip chain");
+            }
+            result.width = chain.front().width;
+            result.height = chain.front().height;
+            result.rowAlignment = rowAlignment;
+
+            size_t total = 0;
+            for (const auto &level : chain)
+                total += CompressedImageData::levelSize(result.format, level.width, level.height, rowAlignment);
+            auto storage = std::make_shared<std::vector<unsigned char>>(total, 0);
+
+            // 逐行拷贝到对齐后的行距
+            size_t offset = 0;
+            for (const auto &level : chain)
+            {
+                const size_t size = CompressedImageData::levelSize(result.format, level.width, level.height, rowAlignment);
+                const size_t rowBytes = size_t(level.width) * level.channels;
+                const size_t rowPitch = size / level.height;
+                for (uint32_t y = 0; y < level.height; ++y)
+                {
+                    unsigned char *dst = storage->data() + offset + y * rowPitch;
+                    const unsigned char *src = level.pixels.get() + y * rowBytes;
+                    if (level.channels != 2)
+                    {
+                        std::memcpy(dst, src, rowBytes);
+                        continue;
+                    }
+                    for (uint32_t x = 0; x < level.width; ++x, src += 2, dst += 4)
+                    {
+                        dst[0] = dst[1] = dst[2] = src[0];
+                        dst[3] = src[1];
+                    }
+                }
+
+                CompressedImageData::Level entry;
+                entry.data = storage->data() + offset;
+                entry.size = size;
+                entry.width = level.width;
+                entry.height = level.height;
+                result.levels.push_back(entry);
+                offset += size;
+            }
+            result.storage = storage;
+            return result;
+        }
+
+        CompressedImageData compress(const ImageData &image, TextureFormat format, bool generateMips)
+        {
+            if (!image.valid() || image.channels < 1 || image.channels > 4)
+                throw std::runtime_error("Unsupported image data for compression");
+
+            std::vector<ImageData> chain = generateMips ? buildMipChain(image) : std::vector<ImageData>{image};
+
+            // 先压缩每一级，再拼接到同一块存储中
+            std::vector<std::vector<unsigned char>> blocks;
+            for (const auto &level : chain)
+            {
+                std::vector<unsigned char> rgba = toRGBA(level, format);
+                blocks.push_back(compress(rgba.data(), level.width, level.height, format));
+            }
+
+            size_t total = 0;
+            for (const auto &level : blocks)
+                total += level.size();
+            auto storage = std::make_shared<std::vector<unsigned char>>();
+            storage->reserve(total);
+            for (const auto &level : blocks)
+                storage->insert(storage->end(), level.begin(), level.end());
+
+            CompressedImageData result;
+            result.format = format;
+            result.width = image.width;
+            result.height = image.height;
+            size_t offset = 0;
+            for (size_t i = 0; i < blocks.size(); ++i)
+            {
+                CompressedImageData::Level level;
+                level.data = storage->data() + offset;
+                level.size = blocks[i].size();
+                level.width = chain[i].width;
+                level.height = chain[i].height;
+                result.levels.push_back(level);
+                offset += level.size;
+            }
+            result.storage = storage;
+            return result;
+        }
+
+        bool writeKTX2(const std::string &path, const CompressedImageData &image)
+        {
+            if (!image.valid())
+                return false;
+
+            uint32_t vkFormat = 0;
+            uint32_t colorModel = 0; // KHR_DF_MODEL_BC*
+            std::vector<std::pair<uint32_t, uint32_t>> samples; // (channelType, bitOffset)
+            switch (image.format)
+            {
+            case TextureFormat::BC1:
+                vkFormat = 133, colorModel = 128, samples = {{1, 0}}; // 含 1 位 alpha
+                break;
+            case TextureFormat::BC3:
+                vkFormat = 137, colorModel = 130, samples = {{15, 0}, {0, 64}};
+                break;
+            case TextureFormat::BC4:
+                vkFormat = 139, colorModel = 131, samples = {{0, 0}};
+                break;
+            case TextureFormat::BC5:
+                vkFormat = 141, colorModel = 132, samples = {{0, 0}, {1, 64}};
+                break;
+            case TextureFormat::BC7:
+                vkFormat = 145, colorModel = 134, samples = {{0, 0}};
+                break;
+            default:
+                return false;
+            }
+            const uint32_t blockBytes = uint32_t(CompressedImageData::blockBytes(image.format));
+            const uint32_t sampleBits = image.format == TextureFormat::BC7 ? 128 : 64;
+
+            // 数据格式描述符（Khronos Basic DFD）
+            std::vector<unsigned char> dfd;
+            const uint32_t blockSize = 24 + 16 * uint32_t(samples.size());
+            put32(dfd, 4 + blockSize);
+            put32(dfd, 0);                  // vendorId / descriptorType
+            put32(dfd, 2 | (blockSize << 16)); // versionNumber / descriptorBlockSize
+            put32(dfd, colorModel | (1u << 8) | (1u << 16)); // BT.709 原色、线性传输、直通 alpha
+            put32(dfd, 3 | (3u << 8));      // 块尺寸 4x4x1x1（各减 1）
+            put32(dfd, blockBytes);         // bytesPlane0
+            put32(dfd, 0);
+            for (const auto &sample : samples)
+            {
+                put32(dfd, sample.second | ((sampleBits - 1) << 16) | (sample.first << 24));
+                put32(dfd, 0);
+                put32(dfd, 0);
+                put32(dfd, 0xFFFFFFFFu);
+            }
+
+            // 键值数据：行序自下而上
+            std::vector<unsigned char> kvd;
+            const char entry[] = "KTXorientation\0ru";
+            put32(kvd, sizeof(entry));
+            kvd.insert(kvd.end(), entry, entry + sizeof(entry));
+            align(kvd, 4);
+
+            const uint32_t levelCount = uint32_t(image.levels.size());
+            const size_t indexEnd = 80 + size_t(levelCount) * 24;
+            const size_t dfdOffset = indexEnd;
+            const size_t kvdOffset = dfdOffset + dfd.size();
+            size_t dataOffset = kvdOffset + kvd.size();
+
+            // 级别数据按从小到大排列，各级按块大小对齐
+            std::vector<uint64_t> offsets(levelCount);
+            for (uint32_t n = 0; n < levelCount; ++n)
+            {
+                uint32_t i = levelCount - 1 - n;
+                dataOffset = (dataOffset + blockBytes - 1) / blockBytes * blockBytes;
+                offsets[i] = dataOffset;
+                dataOffset += image.levels[i].size;
+            }
+
+            std::vector<unsigned char> header = {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+            put32(header, vkFormat);
+            put32(header, 1); // typeSize
+            put32(header, image.width);
+            put32(header, image.height);
+            put32(header, 0); // pixelDepth
+            put32(header, 0); // layerCount
+            put32(header, 1); // faceCount
+            put32(header, levelCount);
+            put32(header, 0); // supercompressionScheme
+            put32(header, uint32_t(dfdOffset));
+            put32(header, uint32_t(dfd.size()));
+            put32(header, uint32_t(kvdOffset));
+            put32(header, uint32_t(kvd.size()));
+            put64(header, 0); // sgd
+            put64(header, 0);
+            for (uint32_t i = 0; i < levelCount; ++i)
+            {
+                put64(header, offsets[i]);
+                put64(header, image.levels[i].size);
+                put64(header, image.levels[i].size);
+            }
+            header.insert(header.end(), dfd.begin(), dfd.end());
+            header.insert(header.end(), kvd.begin(), kvd.end());
+            return writeFile(path, header, image, true, blockBytes);
+        }
+
+        bool writeDDS(const std::string &path, const CompressedImageData &image)
+        {
+            if (!image.valid())
+                return false;
+
+            const char *fourCC = nullptr;
+            uint32_t dxgiFormat = 0;
+            switch (image.format)
+            {
+            case TextureFormat::BC1:
+                fourCC = "DXT1";
+                break;
+            case TextureFormat::BC3:
+                fourCC = "DXT5";
+                break;
+            case TextureFormat::BC4:
+                fourCC = "ATI1";
+                break;
+            case TextureFormat::BC5:
+                fourCC = "ATI2";
+                break;
+            case TextureFormat::BC7:
+                fourCC = "DX10";
+                dxgiFormat = 98; // DXGI_FORMAT_BC7_UNORM
+                break;
+            default:
+                return false;
+            }
+
+            const uint32_t levelCount = uint32_t(image.levels.size());
+            std::vector<unsigned char> header = {'D', 'D', 'S', ' '};
+            put32(header, 124);
+            // CAPS | HEIGHT | WIDTH | PIXELFORMAT | LINEARSIZE (| MIPMAPCOUNT)
+            put32(header, 0x1 | 0x2 | 0x4 | 0x1000 | 0x80000 | (levelCount > 1 ? 0x20000 : 0));
+            put32(header, image.height);
+            put32(header, image.width);
+            put32(header, uint32_t(image.levels[0].size));
+            put32(header, 0); // depth
+            put32(header, levelCount);
+            for (int i = 0; i < 11; ++i)
+                put32(header, 0);
+            // DDS_PIXELFORMAT
+            put32(header, 32);
+            put32(header, 0x4); // DDPF_FOURCC
+            header.insert(header.end(), fourCC, fourCC + 4);
+            for (int i = 0; i < 5; ++i)
+                put32(header, 0);
+            // TEXTURE (| COMPLEX | MIPMAP)
+            put32(header, 0x1000 | (levelCount > 1 ? 0x8 | 0x400000 : 0));
+            for (int i = 0; i < 4; ++i)
+                put32(header, 0);
+            if (dxgiFormat)
+            {
+                put32(header, dxgiFormat);
+                put32(header, 3); // TEXTURE2D
+                put32(header, 0);
+                put32(header, 1); // arraySize
+                put32(header, 0);
+            }
+            return writeFile(path, header, image, false, 1);
+        }
+    }
+}
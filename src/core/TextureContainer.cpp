@@ -0,0 +1,473 @@
+#include "OxygenRender/Texture.h"
+#include "OxygenRender/MappedFile.h"
+#include "OxygenRender/TextureBake.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace OxyRender
+{
+    namespace
+    {
+        const unsigned char kKtx2Identifier[12] = {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+        template <typename T>
+        T readValue(const unsigned char *data)
+        {
+            T value;
+            std::memcpy(&value, data, sizeof(T));
+            return value;
+        }
+
+        constexpr uint32_t fourCC(char a, char b, char c, char d)
+        {
+            return uint32_t(uint8_t(a)) | (uint32_t(uint8_t(b)) << 8) | (uint32_t(uint8_t(c)) << 16) | (uint32_t(uint8_t(d)) << 24);
+        }
+
+        // VkFormat 中的 BC 格式（sRGB 变体按线性格式上传，与未压缩纹理的处理一致）
+        bool formatFromVulkan(uint32_t vkFormat, TextureFormat &format)
+        {
+            switch (vkFormat)
+            {
+            case 131: // BC1_RGB_UNORM
+            case 132: // BC1_RGB_SRGB
+            case 133: // BC1_RGBA_UNORM
+            case 134: // BC1_RGBA_SRGB
+                format = TextureFormat::BC1;
+                return true;
+            case 137: // BC3_UNORM
+            case 138: // BC3_SRGB
+                format = TextureFormat::BC3;
+                return true;
+            case 139: // BC4_UNORM
+                format = TextureFormat::BC4;
+                return true;
+            case 141: // BC5_UNORM
+                format = TextureFormat::BC5;
+                return true;
+            case 145: // BC7_UNORM
+            case 146: // BC7_SRGB
+                format = TextureFormat::BC7;
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        bool formatFromDxgi(uint32_t dxgiFormat, TextureFormat &format)
+        {
+            switch (dxgiFormat)
+            {
+            case 70: // BC1_TYPELESS
+            case 71: // BC1_UNORM
+            case 72: // BC1_UNORM_SRGB
+                format = TextureFormat::BC1;
+                return true;
+            case 76: // BC3_TYPELESS
+            case 77: // BC3_UNORM
+            case 78: // BC3_UNORM_SRGB
+                format = TextureFormat::BC3;
+                return true;
+            case 79: // BC4_TYPELESS
+            case 80: // BC4_UNORM
+                format = TextureFormat::BC4;
+                return true;
+            case 82: // BC5_TYPELESS
+            case 83: // BC5_UNORM
+                format = TextureFormat::BC5;
+                return true;
+            case 97: // BC7_TYPELESS
+            case 98: // BC7_UNORM
+            case 99: // BC7_UNORM_SRGB
+                format = TextureFormat::BC7;
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        bool formatFromBakeCode(uint32_t code, TextureFormat &format)
+        {
+            using namespace TextureBakeFormat;
+            switch (code)
+            {
+            case FormatCode::RGBA8:
+                format = TextureFormat::RGBA8;
+                return true;
+            case FormatCode::RGB8:
+                format = TextureFormat::RGB8;
+                return true;
+            case FormatCode::R8:
+                format = TextureFormat::R8;
+                return true;
+            case FormatCode::BC1:
+                format = TextureFormat::BC1;
+                return true;
+            case FormatCode::BC3:
+                format = TextureFormat::BC3;
+                return true;
+            case FormatCode::BC4:
+                format = TextureFormat::BC4;
+                return true;
+            case FormatCode::BC5:
+                format = TextureFormat::BC5;
+                return true;
+            case FormatCode::BC7:
+                format = TextureFormat::BC7;
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        // BC1 颜色块：前 rows 行的索引各占 1 字节（第 4~7 字节）
+        void flipColorBlock(unsigned char *block, uint32_t rows)
+        {
+            std::reverse(block + 4, block + 4 + rows);
+        }
+
+        // BC4 单通道块：2 字节端点后是 48 位索引，每行 12 位
+        void flipAlphaBlock(unsigned char *block, uint32_t rows)
+        {
+            uint64_t bits = 0;
+            for (int i = 0; i < 6; ++i)
+                bits |= uint64_t(block[2 + i]) << (8 * i);
+            uint64_t flipped = bits;
+            for (uint32_t y = 0; y < rows; ++y)
+            {
+                const uint32_t target = rows - 1 - y;
+                flipped &= ~(uint64_t(0xFFF) << (12 * target));
+                flipped |= ((bits >> (12 * y)) & 0xFFF) << (12 * target);
+            }
+            for (int i = 0; i < 6; ++i)
+                block[2 + i] = static_cast<unsigned char>(flipped >> (8 * i));
+        }
+
+        // 高度不是 4 的倍数（且大于 4）时有效行跨块无法对齐，BC7 的索引布局随模式变化，都无法按块翻转
+        bool canFlipLevel(TextureFormat format, const CompressedImageData::Level &level)
+        {
+            return format != TextureFormat::BC7 && (level.height <= 4 || level.height % 4 == 0);
+        }
+
+        // 上下翻转一级块压缩数据（须 canFlipLevel）。块行整体倒序，块内再翻转有效行
+        void flipLevel(TextureFormat format, const CompressedImageData::Level &level, unsigned char *out)
+        {
+            const size_t blockBytes = CompressedImageData::blockBytes(format);
+            const size_t rowBytes = size_t((level.width + 3) / 4) * blockBytes;
+            const uint32_t blockRows = (level.height + 3) / 4;
+            const uint32_t rows = std::min<uint32_t>(level.height, 4);
+            for (uint32_t y = 0; y < blockRows; ++y)
+            {
+                unsigned char *row = out + size_t(blockRows - 1 - y) * rowBytes;
+                std::memcpy(row, level.data + size_t(y) * rowBytes, rowBytes);
+                for (unsigned char *block = row; block < row + rowBytes; block += blockBytes)
+                {
+                    switch (format)
+                    {
+                    case TextureFormat::BC1:
+                        flipColorBlock(block, rows);
+                        break;
+                    case TextureFormat::BC3:
+                        flipAlphaBlock(block, rows);
+                        flipColorBlock(block + 8, rows);
+                        break;
+                    case TextureFormat::BC4:
+                        flipAlphaBlock(block, rows);
+                        break;
+                    case TextureFormat::BC5:
+                        flipAlphaBlock(block, rows);
+                        flipAlphaBlock(block + 8, rows);
+                        break;
+                    default:
+                        break;
+                    }
+                }
+            }
+        }
+
+        // 读取 KTX2 键值数据中的 KTXorientation，第二个字符为 'd' 表示首行是图像顶部（KTX2 的默认值 "rd"）
+        bool isKTX2TopDown(const unsigned char *data, size_t size)
+        {
+            const uint32_t kvdOffset = readValue<uint32_t>(data + 56);
+            const uint32_t kvdLength = readValue<uint32_t>(data + 60);
+            if (kvdLength == 0 || kvdOffset > size || kvdLength > size - kvdOffset)
+                return true;
+
+            const char key[] = "KTXorientation";
+            const unsigned char *p = data + kvdOffset;
+            const unsigned char *end = p + kvdLength;
+            while (end - p >= 4)
+            {
+                const uint32_t length = readValue<uint32_t>(p);
+                p += 4;
+                if (length > size_t(end - p))
+                    break;
+                if (length > sizeof(key) && std::memcmp(p, key, sizeof(key)) == 0)
+                    return length < sizeof(key) + 2 || p[sizeof(key) + 1] != 'u';
+                p += (length + 3) & ~3u;
+            }
+            return true;
+        }
+
+        CompressedImageData parseOxtex(const unsigned char *data, size_t size)
+        {
+            using namespace TextureBakeFormat;
+            Header header;
+            if (size < sizeof(Header))
+                throw std::runtime_error("oxtex: truncated header");
+            std::memcpy(&header, data, sizeof(header));
+
+            CompressedImageData image;
+            if (header.version != VERSION)
+                throw std::runtime_error("oxtex: unsupported version " + std::to_string(header.version));
+            if (!formatFromBakeCode(header.format, image.format))
+                throw std::runtime_error("oxtex: unsupported format");
+            const uint32_t alignment = header.rowAlignment;
+            if (header.width == 0 || header.height == 0 || header.levelCount == 0 || header.levelCount > 32 ||
+                (alignment != 1 && alignment != 2 && alignment != 4 && alignment != 8) ||
+                sizeof(Header) + size_t(header.levelCount) * sizeof(LevelEntry) > size)
+                throw std::runtime_error("oxtex: invalid header");
+
+            image.width = header.width;
+            image.height = header.height;
+            image.rowAlignment = isCompressedFormat(image.format) ? 1 : alignment;
+            const auto *entries = data + sizeof(Header);
+            for (uint32_t i = 0; i < header.levelCount; ++i)
+            {
+                LevelEntry entry;
+                std::memcpy(&entry, entries + size_t(i) * sizeof(LevelEntry), sizeof(entry));
+
+                CompressedImageData::Level level;
+                level.width = entry.width;
+                level.height = entry.height;
+                level.size = CompressedImageData::levelSize(image.format, level.width, level.height, image.rowAlignment);
+                if (level.width != std::max<uint32_t>(header.width >> i, 1) ||
+                    level.height != std::max<uint32_t>(header.height >> i, 1) ||
+                    entry.size < level.size || entry.offset > size || entry.size > size - entry.offset)
+                    throw std::runtime_error("oxtex: level " + std::to_string(i) + " out of range");
+                level.data = data + entry.offset;
+                image.levels.push_back(level);
+            }
+            return image;
+        }
+
+        CompressedImageData parseKTX2(const unsigned char *data, size_t size)
+        {
+            // 头部 80 字节，随后是每级 24 字节的 level index
+            if (size < 80)
+                throw std::runtime_error("KTX2: truncated header");
+
+            const uint32_t vkFormat = readValue<uint32_t>(data + 12);
+            const uint32_t width = readValue<uint32_t>(data + 20);
+            const uint32_t height = readValue<uint32_t>(data + 24);
+            const uint32_t depth = readValue<uint32_t>(data + 28);
+            const uint32_t layerCount = readValue<uint32_t>(data + 32);
+            const uint32_t faceCount = readValue<uint32_t>(data + 36);
+            const uint32_t levelCount = std::max<uint32_t>(readValue<uint32_t>(data + 40), 1);
+            const uint32_t supercompression = readValue<uint32_t>(data + 44);
+
+            CompressedImageData image;
+            if (!formatFromVulkan(vkFormat, image.format))
+                throw std::runtime_error("KTX2: unsupported vkFormat " + std::to_string(vkFormat));
+            if (supercompression != 0)
+                throw std::runtime_error("KTX2: supercompressed files are not supported");
+            if (depth > 1 || layerCount > 1 || faceCount != 1)
+                throw std::runtime_error("KTX2: only single 2D textures are supported");
+            if (width == 0 || height == 0 || levelCount > 32 || 80 + size_t(levelCount) * 24 > size)
+                throw std::runtime_error("KTX2: invalid header");
+
+            image.width = width;
+            image.height = height;
+            for (uint32_t i = 0; i < levelCount; ++i)
+            {
+                const unsigned char *entry = data + 80 + size_t(i) * 24;
+                const uint64_t offset = readValue<uint64_t>(entry);
+                const uint64_t length = readValue<uint64_t>(entry + 8);
+
+                CompressedImageData::Level level;
+                level.width = std::max<uint32_t>(width >> i, 1);
+                level.height = std::max<uint32_t>(height >> i, 1);
+                level.size = CompressedImageData::levelSize(image.format, level.width, level.height);
+                if (length < level.size || offset > size || length > size - offset)
+                    throw std::runtime_error("KTX2: level " + std::to_string(i) + " out of range");
+                level.data = data + offset;
+                image.levels.push_back(level);
+            }
+
+            // 运行时约定行序自下而上（与 ImageData::load 的默认翻转一致），自上而下的文件在此翻转到自有内存；
+            // 任一级无法翻转（BC7、非 4 倍数高度）时整条 mip 链保持原样，记录 topDown 并警告
+            if (!isKTX2TopDown(data, size))
+                return image;
+            if (!std::all_of(image.levels.begin(), image.levels.end(), [&](const CompressedImageData::Level &level)
+                             { return canFlipLevel(image.format, level); }))
+            {
+                image.topDown = true;
+                std::cerr << "KTX2: top-down (KTXorientation \"rd\") data of this format or size cannot be flipped, "
+                             "loaded as is; export with KTXorientation \"ru\" for consistent orientation"
+                          << std::endl;
+                return image;
+            }
+            auto flipped = std::make_shared<std::vector<unsigned char>>(image.totalBytes());
+            unsigned char *out = flipped->data();
+            for (auto &level : image.levels)
+            {
+                flipLevel(image.format, level, out);
+                level.data = out;
+                out += level.size;
+            }
+            image.storage = flipped;
+            return image;
+        }
+
+        CompressedImageData parseDDS(const unsigned char *data, size_t size)
+        {
+            // "DDS " + 124 字节 DDS_HEADER，DX10 扩展头另有 20 字节
+            if (size < 128 || readValue<uint32_t>(data + 4) != 124)
+                throw std::runtime_error("DDS: truncated header");
+
+            const uint32_t flags = readValue<uint32_t>(data + 8);
+            const uint32_t height = readValue<uint32_t>(data + 12);
+            const uint32_t width = readValue<uint32_t>(data + 16);
+            const uint32_t mipCount = readValue<uint32_t>(data + 28);
+            const uint32_t pixelFormatFlags = readValue<uint32_t>(data + 80);
+            const uint32_t formatCode = readValue<uint32_t>(data + 84);
+            const uint32_t caps2 = readValue<uint32_t>(data + 112);
+
+            CompressedImageData image;
+            size_t offset = 128;
+            if (!(pixelFormatFlags & 0x4)) // DDPF_FOURCC
+                throw std::runtime_error("DDS: only block-compressed files are supported");
+            if (caps2 & 0x200) // DDSCAPS2_CUBEMAP
+                throw std::runtime_error("DDS: cubemaps are not supported");
+
+            switch (formatCode)
+            {
+            case fourCC('D', 'X', 'T', '1'):
+                image.format = TextureFormat::BC1;
+                break;
+            case fourCC('D', 'X', 'T', '5'):
+                image.format = TextureFormat::BC3;
+                break;
+            case fourCC('A', 'T', 'I', '1'):
+            case fourCC('B', 'C', '4', 'U'):
+                image.format = TextureFormat::BC4;
+                break;
+            case fourCC('A', 'T', 'I', '2'):
+            case fourCC('B', 'C', '5', 'U'):
+                image.format = TextureFormat::BC5;
+                break;
+            case fourCC('D', 'X', '1', '0'):
+            {
+                if (size < 148)
+                    throw std::runtime_error("DDS: truncated DX10 header");
+                const uint32_t dxgiFormat = readValue<uint32_t>(data + 128);
+                const uint32_t dimension = readValue<uint32_t>(data + 132);
+                const uint32_t arraySize = readValue<uint32_t>(data + 140);
+                if (!formatFromDxgi(dxgiFormat, image.format))
+                    throw std::runtime_error("DDS: unsupported DXGI format " + std::to_string(dxgiFormat));
+                if (dimension != 3 || arraySize > 1) // D3D10_RESOURCE_DIMENSION_TEXTURE2D
+                    throw std::runtime_error("DDS: only single 2D textures are supported");
+                offset = 148;
+                break;
+            }
+            default:
+                throw std::runtime_error("DDS: unsupported FourCC");
+            }
+
+            const uint32_t levelCount = (flags & 0x20000) && mipCount > 0 ? mipCount : 1; // DDSD_MIPMAPCOUNT
+            if (width == 0 || height == 0 || levelCount > 32)
+                throw std::runtime_error("DDS: invalid header");
+
+            image.width = width;
+            image.height = height;
+            for (uint32_t i = 0; i < levelCount; ++i)
+            {
+                CompressedImageData::Level level;
+                level.width = std::max<uint32_t>(width >> i, 1);
+                level.height = std::max<uint32_t>(height >> i, 1);
+                level.size = CompressedImageData::levelSize(image.format, level.width, level.height);
+                if (level.size > size - offset)
+                    throw std::runtime_error("DDS: level " + std::to_string(i) + " out of range");
+                level.data = data + offset;
+                offset += level.size;
+                image.levels.push_back(level);
+            }
+            return image;
+        }
+    }
+
+    size_t CompressedImageData::blockBytes(TextureFormat format) noexcept
+    {
+        switch (format)
+        {
+        case TextureFormat::RGBA8:
+            return 4;
+        case TextureFormat::RGB8:
+            return 3;
+        case TextureFormat::R8:
+            return 1;
+        case TextureFormat::BC1:
+        case TextureFormat::BC4:
+            return 8;
+        default:
+            return 16;
+        }
+    }
+
+    size_t CompressedImageData::levelSize(TextureFormat format, uint32_t width, uint32_t height, uint32_t rowAlignment) noexcept
+    {
+        if (!isCompressedFormat(format))
+        {
+            const size_t rowPitch = (size_t(width) * blockBytes(format) + rowAlignment - 1) / rowAlignment * rowAlignment;
+            return rowPitch * height;
+        }
+        return size_t((width + 3) / 4) * ((height + 3) / 4) * blockBytes(format);
+    }
+
+    size_t CompressedImageData::totalBytes() const noexcept
+    {
+        size_t total = 0;
+        for (const auto &level : levels)
+            total += level.size;
+        return total;
+    }
+
+    bool CompressedImageData::isContainer(const unsigned char *data, size_t size) noexcept
+    {
+        if (size >= sizeof(kKtx2Identifier) && std::memcmp(data, kKtx2Identifier, sizeof(kKtx2Identifier)) == 0)
+            return true;
+        return size >= 4 && (std::memcmp(data, "DDS ", 4) == 0 || readValue<uint32_t>(data) == TextureBakeFormat::MAGIC);
+    }
+
+    CompressedImageData CompressedImageData::parse(const unsigned char *data, size_t size, std::shared_ptr<const void> storage)
+    {
+        CompressedImageData image;
+        if (size >= sizeof(kKtx2Identifier) && std::memcmp(data, kKtx2Identifier, sizeof(kKtx2Identifier)) == 0)
+            image = parseKTX2(data, size);
+        else if (size >= 4 && std::memcmp(data, "DDS ", 4) == 0)
+            image = parseDDS(data, size);
+        else if (size >= 4 && readValue<uint32_t>(data) == TextureBakeFormat::MAGIC)
+            image = parseOxtex(data, size);
+        else
+            throw std::runtime_error("Unknown compressed texture container");
+        // 解析时已复制到自有内存（如翻转过的 KTX2）则不再引用原数据
+        if (!image.storage)
+            image.storage = std::move(storage);
+        return image;
+    }
+
+    CompressedImageData CompressedImageData::load(const std::string &path)
+    {
+        auto file = std::make_shared<MappedFile>(path);
+        if (!file->isOpen())
+            throw std::runtime_error("Failed to load texture: " + path);
+        try
+        {
+            return parse(file->data(), file->size(), file);
+        }
+        catch (const std::exception &e)
+        {
+            throw std::runtime_error(std::string(e.what()) + ": " + path);
+        }
+    }
+}
@@ -0,0 +1,330 @@
+#include "OxygenRender/TextureStreamer.h"
+#include "OxygenRender/TextureCompression.h"
+#include "OxygenRender/ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+namespace OxyRender
+{
+    namespace
+    {
+        std::string streamingKey(const std::string &resolvedPath, TextureFilter filter, TextureWrap wrap)
+        {
+            std::string key = resolvedPath + "|";
+            key += filter == TextureFilter::Linear ? 'L' : 'N';
+            key += wrap == TextureWrap::Repeat ? 'R' : 'C';
+            return key;
+        }
+    }
+
+    TextureStreamer &TextureStreamer::getInstance()
+    {
+        static TextureStreamer streamer;
+        return streamer;
+    }
+
+    DecodedTexture TextureStreamer::decode(const std::string &path, bool flipVertically)
+    {
+        DecodedTexture decoded = TextureCache::decode(path, flipVertically);
+        if (!decoded.compressed.valid())
+        {
+            // 普通图片：在工作线程生成完整 mip 链，之后按级上传
+            decoded.compressed = TextureCompression::packMipChain(TextureCompression::buildMipChain(decoded.image));
+            decoded.image = ImageData();
+        }
+        return decoded;
+    }
+
+    std::shared_ptr<StreamingTexture2D> TextureStreamer::find(const std::string &path, TextureFilter filter, TextureWrap wrap)
+    {
+        auto it = m_records.find(streamingKey(TextureCache::resolvePath(path), filter, wrap));
+        return it == m_records.end() ? nullptr : it->second->owner.lock();
+    }
+
+    std::shared_ptr<StreamingTexture2D> TextureStreamer::load(const std::string &path, TextureFilter filter, TextureWrap wrap)
+    {
+        if (auto texture = find(path, filter, wrap))
+            return texture;
+        return insert(decode(path), filter, wrap);
+    }
+
+    uint32_t TextureStreamer::initialLevel(const CompressedImageData &source) const
+    {
+        for (uint32_t i = 0; i < source.levels.size(); ++i)
+        {
+            if (std::max(source.levels[i].width, source.levels[i].height) <= m_initialResolution)
+                return i;
+        }
+        return static_cast<uint32_t>(source.levels.size() - 1);
+    }
+
+    std::shared_ptr<StreamingTexture2D> TextureStreamer::insert(const DecodedTexture &decoded, TextureFilter filter, TextureWrap wrap)
+    {
+        if (!decoded.compressed.valid())
+            throw std::runtime_error("Streaming textures need a decoded mip chain: " + decoded.key);
+
+        const std::string key = streamingKey(decoded.key, filter, wrap);
+        auto it = m_records.find(key);
+        if (it != m_records.end())
+        {
+            if (auto existing = it->second->owner.lock())
+                return existing;
+            m_byTexture.erase(it->second->handle);
+            m_records.erase(it);
+        }
+
+        auto gl = std::make_shared<OpenGLStreamingTexture2D>(decoded.compressed, initialLevel(decoded.compressed), filter, wrap);
+        std::shared_ptr<StreamingTexture2D> texture(new StreamingTexture2D(gl));
+
+        auto record = std::make_unique<Record>();
+        record->owner = texture;
+        record->handle = texture.get();
+        record->texture = gl.get();
+        record->key = key;
+        record->path = decoded.key;
+        record->source = decoded.compressed; // 刚加载的纹理很可能马上需要更多细节，先保留
+        record->minLevel = gl->getResidentLevel();
+        record->targetLevel = record->minLevel;
+        record->lastDetailFrame = m_frame;
+
+        m_byTexture[record->handle] = record.get();
+        m_records.emplace(key, std::move(record));
+        return texture;
+    }
+
+    void TextureStreamer::request(const Texture2D &texture, float uvPerPixel)
+    {
+        auto it = m_byTexture.find(&texture);
+        if (it == m_byTexture.end())
+            return;
+        Record &record = *it->second;
+
+        // 所需级别：该级一个纹素约覆盖一个像素
+        const float size = static_cast<float>(std::max(texture.getWidth(), texture.getHeight()));
+        const float level = std::max(std::log2(std::max(uvPerPixel * size, 1e-6f)) + m_levelBias, 0.0f);
+        if (record.lastRequestFrame != m_frame)
+        {
+            record.lastRequestFrame = m_frame;
+            record.requestedLevel = level;
+        }
+        else
+        {
+            record.requestedLevel = std::min(record.requestedLevel, level);
+        }
+    }
+
+    void TextureStreamer::computeTargets()
+    {
+        for (auto &entry : m_records)
+        {
+            Record &record = *entry.second;
+            const uint32_t resident = record.texture->getResidentLevel();
+
+            // 本帧不可见的纹理只需最粗部分；三线性过滤会同时采样 floor(level) 与下一级
+            uint32_t needed = record.minLevel;
+            if (record.lastRequestFrame == m_frame)
+                needed = std::min(static_cast<uint32_t>(record.requestedLevel), record.minLevel);
+            if (record.failed)
+                needed = std::max(needed, resident);
+
+            if (needed <= resident)
+                record.lastDetailFrame = m_frame;
+            else if (m_frame - record.lastDetailFrame < m_evictionDelay)
+                needed = resident; // 暂缓释放
+            record.targetLevel = needed;
+        }
+    }
+
+    void TextureStreamer::applyBudget()
+    {
+        size_t total = 0;
+        for (const auto &entry : m_records)
+        {
+            const Record &record = *entry.second;
+            for (uint32_t i = record.targetLevel; i < record.texture->getLevelCount(); ++i)
+                total += record.texture->getLevelBytes(i);
+        }
+        m_stats.requiredBytes = total;
+        m_stats.budgetLimited = 0;
+        if (m_budget == 0 || total <= m_budget)
+            return;
+
+        // 堆顶为最先降级的纹理：最久未被需要，其次是最精细一级占用最大
+        auto lessDroppable = [](const Record *a, const Record *b)
+        {
+            if (a->lastRequestFrame != b->lastRequestFrame)
+                return a->lastRequestFrame > b->lastRequestFrame;
+            return a->texture->getLevelBytes(a->targetLevel) < b->texture->getLevelBytes(b->targetLevel);
+        };
+        std::vector<Record *> heap;
+        for (auto &entry : m_records)
+        {
+            if (entry.second->targetLevel < entry.second->minLevel)
+                heap.push_back(entry.second.get());
+        }
+        std::make_heap(heap.begin(), heap.end(), lessDroppable);
+
+        std::vector<Record *> limited;
+        while (total > m_budget && !heap.empty())
+        {
+            std::pop_heap(heap.begin(), heap.end(), lessDroppable);
+            Record *record = heap.back();
+            heap.pop_back();
+
+            total -= record->texture->getLevelBytes(record->targetLevel);
+            ++record->targetLevel;
+            limited.push_back(record);
+            if (record->targetLevel < record->minLevel)
+            {
+                heap.push_back(record);
+                std::push_heap(heap.begin(), heap.end(), lessDroppable);
+            }
+        }
+        std::sort(limited.begin(), limited.end());
+        m_stats.budgetLimited = static_cast<size_t>(std::unique(limited.begin(), limited.end()) - limited.begin());
+    }
+
+    bool TextureStreamer::ensureSource(Record &record)
+    {
+        if (record.source.valid())
+            return true;
+        if (record.pending.valid())
+        {
+            if (record.pending.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                return false;
+            try
+            {
+                DecodedTexture decoded = record.pending.get();
+                if (record.texture->isCompatible(decoded.compressed))
+                    record.source = std::move(decoded.compressed);
+                else
+                {
+                    std::cerr << "TextureStreamer: " << record.path << " changed on disk, streaming disabled for it" << std::endl;
+                    record.failed = true;
+                }
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << "TextureStreamer: failed to reload " << record.path << "\n"
+                          << e.what() << std::endl;
+                record.failed = true;
+            }
+            return record.source.valid();
+        }
+        if (record.failed)
+            return false;
+
+        std::string path = record.path;
+        record.pending = ThreadPool::getInstance().submit([path]()
+                                                          { return decode(path); });
+        return false;
+    }
+
+    void TextureStreamer::update()
+    {
+        // 清理已被释放的纹理
+        for (auto it = m_records.begin(); it != m_records.end();)
+        {
+            if (it->second->owner.expired())
+            {
+                m_byTexture.erase(it->second->handle);
+                it = m_records.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        computeTargets();
+        applyBudget();
+
+        // 先释放多余细节，腾出预算再调入
+        std::vector<Record *> wanting;
+        for (auto &entry : m_records)
+        {
+            Record &record = *entry.second;
+            OpenGLStreamingTexture2D &texture = *record.texture;
+            const uint32_t resident = texture.getResidentLevel();
+            if (record.targetLevel > resident)
+            {
+                for (uint32_t i = resident; i < record.targetLevel; ++i)
+                    m_stats.evictedBytes += texture.getLevelBytes(i);
+                m_stats.evictedLevels += record.targetLevel - resident;
+                texture.evictTo(record.targetLevel);
+            }
+            else if (record.targetLevel < resident)
+            {
+                wanting.push_back(&record);
+            }
+        }
+
+        // 最近被需要、差距最大的纹理优先
+        std::sort(wanting.begin(), wanting.end(), [](const Record *a, const Record *b)
+                  {
+                      if (a->lastRequestFrame != b->lastRequestFrame)
+                          return a->lastRequestFrame > b->lastRequestFrame;
+                      return a->texture->getResidentLevel() - a->targetLevel > b->texture->getResidentLevel() - b->targetLevel; });
+
+        size_t frameBytes = 0;
+        bool uploaded = false;
+        for (Record *record : wanting)
+        {
+            // 预算用完后仍提交后台读取，下一帧即可直接上传
+            if (!ensureSource(*record))
+                continue;
+            OpenGLStreamingTexture2D &texture = *record->texture;
+            while (texture.getResidentLevel() > record->targetLevel)
+            {
+                const uint32_t level = texture.getResidentLevel() - 1;
+                const size_t bytes = texture.getLevelBytes(level);
+                if (m_uploadBudget != 0 && uploaded && frameBytes + bytes > m_uploadBudget)
+                    break;
+                texture.uploadLevel(record->source, level);
+                frameBytes += bytes;
+                uploaded = true;
+                ++m_stats.uploadedLevels;
+                m_stats.uploadedBytes += bytes;
+            }
+        }
+
+        // 已达到目标且暂时不会需要更多细节时释放源数据（映射或解码后的内存）
+        for (auto &entry : m_records)
+        {
+            Record &record = *entry.second;
+            if (!record.source.valid() || record.texture->getResidentLevel() > record.targetLevel)
+                continue;
+            if (record.texture->getResidentLevel() == 0 || m_frame - record.lastRequestFrame > m_evictionDelay)
+                record.source = CompressedImageData();
+        }
+
+        ++m_frame;
+    }
+
+    TextureStreamerStats TextureStreamer::getStats() const
+    {
+        TextureStreamerStats stats = m_stats;
+        stats.textureCount = m_records.size();
+        stats.residentBytes = 0;
+        stats.pendingLoads = 0;
+        for (const auto &entry : m_records)
+        {
+            if (entry.second->owner.expired())
+                continue;
+            stats.residentBytes += entry.second->texture->getResidentBytes();
+            if (entry.second->pending.valid())
+                ++stats.pendingLoads;
+        }
+        return stats;
+    }
+
+    void TextureStreamer::resetStats()
+    {
+        m_stats.uploadedLevels = 0;
+        m_stats.uploadedBytes = 0;
+        m_stats.evictedLevels = 0;
+        m_stats.evictedBytes = 0;
+    }
+}
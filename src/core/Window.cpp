@@ -3,10 +3,16 @@
 #include <GLFW/glfw3.h>
 #include "OxygenRender/Window.h"
 #include "OxygenRender/EventSystem.h"
+#include "OxygenRender/GLContext.h"
+#include "OxygenRender/PngEncoder.h"
+#include "OxygenRender/ThreadPool.h"
 #include <iostream>
 
 namespace OxyRender
 {
+    // 存活的 GLFW 窗口数，最后一个窗口关闭时才 glfwTerminate
+    static int s_glfwWindowCount = 0;
+
     static void keyCallback(GLFWwindow *window, int key, int scancode, int action, int mods)
     {
         Event e;
@@ -65,6 +71,18 @@ namespace OxyRender
     IWindow::IWindow(int width, int height, std::string title) : m_width(width), m_height(height), m_title(std::move(title))
     {
     }
+
+    ImageData IWindow::readPixels()
+    {
+        ImageData image;
+        image.width = static_cast<uint32_t>(m_width);
+        image.height = static_cast<uint32_t>(m_height);
+        image.channels = 4;
+        image.pixels = std::shared_ptr<unsigned char>(new unsigned char[size_t(m_width) * m_height * 4],
+                                                      std::default_delete<unsigned char[]>());
+        glReadPixels(0, 0, m_width, m_height, GL_RGBA, GL_UNSIGNED_BYTE, image.pixels.get());
+        return image;
+    }
     GLFWWindow::GLFWWindow(int width, int height, std::string title) : IWindow(width, height, title)
     {
         if (!glfwInit())
@@ -82,9 +100,11 @@ namespace OxyRender
         if (!m_window)
         {
             std::cerr << "窗口创建失败\n";
-            glfwTerminate();
+            if (s_glfwWindowCount == 0)
+                glfwTerminate();
             throw std::runtime_error("Failed to create GLFW window");
         }
+        ++s_glfwWindowCount;
         glfwMakeContextCurrent(m_window);
         // // 默认开启垂直同步
         // glfwSwapInterval(1);
@@ -93,6 +113,7 @@ namespace OxyRender
             std::cerr << "GLAD 初始化失败\n";
             throw std::runtime_error("Failed to initialize GLAD");
         }
+        GLContext::getInstance().created(m_window, reinterpret_cast<GLContext::ProcLoader>(glfwGetProcAddress));
 
         glfwSetKeyCallback(m_window, keyCallback);
         glfwSetMouseButtonCallback(m_window, mouseButtonCallback);
@@ -103,8 +124,12 @@ namespace OxyRender
 
     GLFWWindow::~GLFWWindow()
     {
+        // 先在仍为当前的上下文中释放各缓存持有的 GL 对象
+        glfwMakeContextCurrent(m_window);
+        GLContext::getInstance().destroying(m_window);
         glfwDestroyWindow(m_window);
-        glfwTerminate();
+        if (--s_glfwWindowCount == 0)
+            glfwTerminate();
     }
 
     void GLFWWindow::setViewport(int x, int y, int width, int height)
@@ -158,15 +183,33 @@ namespace OxyRender
         glfwWaitEventsTimeout(timeout);
     }
 
-    Window::Window(int width, int height, std::string title)
+    void GLFWWindow::makeContextCurrent(bool current)
     {
-        m_window = WindowFactory::createWindow(width, height, std::move(title));
+        glfwMakeContextCurrent(current ? m_window : nullptr);
+        if (current)
+            GLContext::getInstance().madeCurrent(m_window);
+    }
+
+    Window::Window(int width, int height, std::string title, WindowBackend backend)
+    {
+        m_window = WindowFactory::createWindow(width, height, std::move(title), backend);
 
         if (!m_window)
         {
             std::cerr << "窗口创建失败\n";
             throw std::runtime_error("Failed to create window");
         }
+        // 上下文在当前线程创建，runOnMainThread 的 GL 任务交给这里
+        ThreadPool::getInstance().setMainThread();
+    }
+    Window::Window(std::unique_ptr<IWindow> window) : m_window(std::move(window))
+    {
+        if (!m_window)
+        {
+            std::cerr << "窗口创建失败\n";
+            throw std::runtime_error("Failed to create window");
+        }
+        ThreadPool::getInstance().setMainThread();
     }
     void Window::setViewport(int x, int y, int width, int height)
     {
@@ -215,10 +258,31 @@ namespace OxyRender
     {
         m_window->waitEventsTimeout(timeout);
     }
+    void Window::makeContextCurrent(bool current)
+    {
+        m_window->makeContextCurrent(current);
+    }
+
+    ImageData Window::readPixels()
+    {
+        return m_window->readPixels();
+    }
+    void Window::saveFrame(const std::string &path)
+    {
+        PngEncoder::write(path, m_window->readPixels(), true);
+    }
+    std::future<void> Window::saveFrameAsync(const std::string &path)
+    {
+        ImageData image = m_window->readPixels();
+        return ThreadPool::getInstance().submit([path, image]()
+                                                { PngEncoder::write(path, image, true); });
+    }
 
     void Window::update()
     {
         pollEvents();
+        // RenderThread 运行期间上下文不在本线程，此时由渲染线程执行
+        ThreadPool::getInstance().pumpMainThread();
         swapBuffers();
     }
 
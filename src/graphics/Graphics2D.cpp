@@ -6,90 +6,58 @@ namespace OxyRender
     {
         return glm::vec2(vec.x, vec.y);
     }
-    // 硬编码的着色器源码
+    // 硬编码的着色器模板，TEXTURED 变体用于纹理批次
     const char *Graphics2D::m_vertexShaderSrc = R"(
     #version 330 core
     layout(location = 0) in vec3 aPos;
     layout(location = 1) in vec4 aColor;
-
-    out vec4 vColor;
-    out vec2 vLocalPos;   
-
-    uniform mat4 model;
-    uniform mat4 view;
-    uniform mat4 projection;
-
-    void main()
-    {
-        gl_Position = projection * view * model * vec4(aPos, 1.0);
-
-        vColor = aColor;
-        vLocalPos = aPos.xy;   
-    }
-    )";
-
-    const char *Graphics2D::m_fragmentShaderSrc = R"(
-    #version 330 core
-    in vec4 vColor;
-    out vec4 FragColor;
-
-    void main()
-    {
-        FragColor = vColor;
-    }
-    )";
-
-    const char *Graphics2D::m_textureVertexShaderSrc = R"(
-    #version 330 core
-    layout(location = 0) in vec3 aPos;
-    layout(location = 1) in vec4 aColor;
+    #ifdef TEXTURED
     layout(location = 2) in vec2 aTexCoord;
+    out vec2 vTexCoord;
+    #endif
 
     out vec4 vColor;
-    out vec2 vTexCoord;
     out vec2 vLocalPos;   
 
-    uniform mat4 model;
-    uniform mat4 view;
-    uniform mat4 projection;
+    uniform mat4 uViewProjection; // CPU 上合并的正交 projection * view
 
     void main()
     {
-        gl_Position = projection * view * model * vec4(aPos, 1.0);
+        gl_Position = uViewProjection * vec4(aPos, 1.0);
 
         vColor = aColor;
+    #ifdef TEXTURED
         vTexCoord = aTexCoord;
+    #endif
         vLocalPos = aPos.xy;   
     }
     )";
 
-    const char *Graphics2D::m_textureFragmentShaderSrc = R"(
+    const char *Graphics2D::m_fragmentShaderSrc = R"(
     #version 330 core
     in vec4 vColor;
+    #ifdef TEXTURED
     in vec2 vTexCoord;
-    out vec4 FragColor;
-
     uniform sampler2D uTexture;
-    uniform bool uUseTexture;
+    #endif
+    out vec4 FragColor;
 
     void main()
     {
-        if (uUseTexture)
-        {
-            FragColor = texture(uTexture, vTexCoord) * vColor;
-        }
-        else
-        {
-            FragColor = vColor;
-        }
+    #ifdef TEXTURED
+        FragColor = texture(uTexture, vTexCoord) * vColor;
+    #else
+        FragColor = vColor;
+    #endif
     }
     )";
     Graphics2D::Graphics2D(Window &window, Renderer &renderer)
         : m_window(window),
           m_renderer(renderer),
           m_camera(glm::vec3(0, 0, 10.0f)),
-          m_shader("default", m_vertexShaderSrc, m_fragmentShaderSrc),
-          m_textureShader("texture", m_textureVertexShaderSrc, m_textureFragmentShaderSrc),
+          m_shaders("Graphics2D", m_vertexShaderSrc, m_fragmentShaderSrc, ShaderFeature::Textured),
+          m_shader(m_shaders.get(0)),
+          m_textureShader(m_shaders.get(ShaderFeature::Textured)),
           m_vbo(BufferType::Vertex, BufferUsage::DynamicDraw),
           m_ebo(BufferType::Index, BufferUsage::DynamicDraw)
     {
@@ -103,10 +71,14 @@ namespace OxyRender
         m_vao.setVertexBuffer(m_vbo, layout);
         m_vao.setIndexBuffer(m_ebo);
 
-        // 初始化渲染
-        m_renderer.setCapability(RenderCapability::DepthTest, true);
-        m_renderer.setCapability(RenderCapability::Blend, true);
-        m_renderer.setBlendFunc(RenderBlendFunc::SrcAlpha, RenderBlendFunc::OneMinusSrcAlpha);
+        // 初始化渲染管线
+        m_pipelineDesc.blend = true;
+        m_pipelineDesc.srcBlend = RenderBlendFunc::SrcAlpha;
+        m_pipelineDesc.dstBlend = RenderBlendFunc::OneMinusSrcAlpha;
+        m_pipelineDesc.depthTest = false;
+        m_pipelineDesc.vertexLayout = layout.getHash();
+        m_pipeline = createPipeline(m_shader);
+        m_texturePipeline = createPipeline(m_textureShader);
 
         // 初始化相机
         m_camera.setZoom(1.0);
@@ -123,6 +95,22 @@ namespace OxyRender
     {
         return m_camera;
     }
+    const PipelineState *Graphics2D::createPipeline(Shader &shader)
+    {
+        PipelineDesc desc = m_pipelineDesc;
+        desc.shader = &shader;
+        return m_renderer.createPipeline(desc);
+    }
+    void Graphics2D::setShader(Shader *shader)
+    {
+        m_customShader = shader;
+        m_pipeline = createPipeline(shader ? *shader : m_shader);
+    }
+    void Graphics2D::setTextureShader(Shader *shader)
+    {
+        m_customTextureShader = shader;
+        m_texturePipeline = createPipeline(shader ? *shader : m_textureShader);
+    }
     void Graphics2D::begin()
     {
         m_triVertices.clear();
@@ -605,27 +593,40 @@ namespace OxyRender
         }
     }
 
+    namespace
+    {
+        constexpr UniformID kViewProjection("uViewProjection");
+        constexpr UniformID kModel("model");
+        constexpr UniformID kView("view");
+        constexpr UniformID kProjection("projection");
+        constexpr UniformID kUseTexture("uUseTexture");
+    }
+
+    void Graphics2D::setCameraUniforms(Shader &shader)
+    {
+        glm::mat4 view = m_camera.getOrthoViewMatrix2D();
+        glm::mat4 projection = m_camera.getOrthoProjectionMatrix2D(m_window.getWidth(), m_window.getHeight());
+        shader.setMat4(kViewProjection, projection * view);
+
+        // 兼容按 model/view/projection 声明的自定义着色器，内置着色器中不存在时直接跳过
+        if (&shader == m_customShader || &shader == m_customTextureShader)
+        {
+            shader.setMat4(kModel, glm::mat4(1.0f));
+            shader.setMat4(kView, view);
+            shader.setMat4(kProjection, projection);
+        }
+    }
+
     void Graphics2D::flush()
     {
         if (m_triIndexCount == 0 && m_lineBatches.empty())
             return;
 
-        m_renderer.setCapability(RenderCapability::Multisample, true);
-        m_renderer.setCapability(RenderCapability::Blend, true);
-        m_renderer.setCapability(RenderCapability::DepthTest, false);
-        m_renderer.setCapability(RenderCapability::StencilTest, false);
-
         Shader *shaderToUse = m_customShader ? m_customShader : &m_shader;
-        shaderToUse->use();
+        m_renderer.bindPipeline(*m_pipeline);
 
-        // MVP变换
-        glm::mat4 model = glm::mat4(1.0f);
-        glm::mat4 view = m_camera.getOrthoViewMatrix2D();
-        glm::mat4 projection = m_camera.getOrthoProjectionMatrix2D(m_window.getWidth(), m_window.getHeight());
-
-        shaderToUse->setUniformData("model", &model, sizeof(glm::mat4));
-        shaderToUse->setUniformData("view", &view, sizeof(glm::mat4));
-        shaderToUse->setUniformData("projection", &projection, sizeof(glm::mat4));
+        // 2D 使用自己的正交相机，不走共享的 3D 每帧 uniform 块
+        setCameraUniforms(*shaderToUse);
 
         m_vao.bind();
 
@@ -648,8 +649,6 @@ namespace OxyRender
             m_renderer.drawTriangles(m_vao, m_triIndexCount);
         }
 
-        m_vao.unbind();
-
         m_triIndexCount = 0;
         m_lineBatches.clear();
 
@@ -662,16 +661,13 @@ namespace OxyRender
         if (m_textureBatches.empty())
             return;
         Shader *shaderToUse = m_customTextureShader ? m_customTextureShader : &m_textureShader;
-        shaderToUse->use();
+        m_renderer.bindPipeline(*m_texturePipeline);
 
-        // MVP变换
-        glm::mat4 model = glm::mat4(1.0f);
-        glm::mat4 view = m_camera.getOrthoViewMatrix2D();
-        glm::mat4 projection = m_camera.getOrthoProjectionMatrix2D(m_window.getWidth(), m_window.getHeight());
-
-        shaderToUse->setUniformData("model", &model, sizeof(glm::mat4));
-        shaderToUse->setUniformData("view", &view, sizeof(glm::mat4));
-        shaderToUse->setUniformData("projection", &projection, sizeof(glm::mat4));
+        // 2D 使用自己的正交相机，不走共享的 3D 每帧 uniform 块
+        setCameraUniforms(*shaderToUse);
+        // 内置着色器的纹理分支已在编译期确定，仅兼容按 uUseTexture 分支的自定义着色器
+        if (m_customTextureShader)
+            shaderToUse->setInt(kUseTexture, 1);
 
         m_vao.bind();
 
@@ -682,8 +678,6 @@ namespace OxyRender
 
             // 绑定纹理
             batch.texture->bind(0);
-            int useTexture = 1;
-            shaderToUse->setUniformData("uUseTexture", &useTexture, sizeof(int));
 
             // 设置顶点数据
             m_vbo.setData(batch.vertices.data(), batch.vertices.size() * sizeof(Vertex));
@@ -692,8 +686,6 @@ namespace OxyRender
             // 绘制
             m_renderer.drawTriangles(m_vao, batch.indexCount);
         }
-
-        m_vao.unbind();
     }
 
 }
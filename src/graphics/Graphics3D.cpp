@@ -1,4 +1,5 @@
 #include "OxygenRender/Graphics3D.h"
+#include "OxygenRender/ThreadPool.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/matrix_access.hpp>
@@ -69,11 +70,39 @@ namespace OxyRender
             }
             return true;
         }
+
+        // 图元 LOD 参数
+        constexpr float kLodFullDetailRadius = 160.0f; // 投影半径（像素）不小于该值时使用最高级别
+        constexpr float kLodHysteresis = 0.2f;         // 级别切换的滞后量（以级别为单位）
+        constexpr int kMinSphereStacks = 4;
+        constexpr int kMinSlices = 6;
+
+        inline uint64_t hashCombine(uint64_t h, uint64_t v)
+        {
+            return h ^ (v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2));
+        }
+
+        // 以 1/64 单位量化后的图元标识，用于在帧间识别同一个图元
+        inline uint64_t primitiveKey(uint64_t kind, const Vec3 &center, float a, float b)
+        {
+            auto q = [](float v)
+            { return static_cast<uint64_t>(static_cast<int64_t>(std::lround(v * 64.0f))); };
+            uint64_t h = kind;
+            h = hashCombine(h, q(center.x));
+            h = hashCombine(h, q(center.y));
+            h = hashCombine(h, q(center.z));
+            h = hashCombine(h, q(a));
+            h = hashCombine(h, q(b));
+            return h;
+        }
     }
 
+    float Graphics3D::s_lodBias = 0.0f;
+
     // 硬编码的着色器源码
     const char *Graphics3D::m_vertexShaderSrc = R"(
 #version 330 core
+)" OXY_FRAME_UNIFORMS_GLSL R"(
 layout(location = 0) in vec3 aPos;
 layout(location = 1) in vec4 aColor;
 layout(location = 2) in vec3 aNormal;
@@ -83,8 +112,7 @@ out vec3 vNormal;
 out vec4 vColor;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+uniform mat3 normalMatrix; // CPU 预计算的 transpose(inverse(mat3(model)))
 uniform float uPointSize; // point size supplied from CPU when drawing points
 
 void main()
@@ -92,47 +120,48 @@ void main()
     vec4 worldPos = model * vec4(aPos, 1.0);
     vFragPos = worldPos.xyz;
     
-    vNormal = mat3(transpose(inverse(model))) * aNormal;
+    vNormal = normalMatrix * aNormal;
     
     vColor = aColor;
     
-    gl_Position = projection * view * worldPos;
+    gl_Position = uViewProjection * worldPos;
     gl_PointSize = uPointSize; // effective when rendering GL_POINTS
 }
 )";
 
     const char *Graphics3D::m_fragmentShaderSrc = R"(
 #version 330 core
+)" OXY_FRAME_UNIFORMS_GLSL R"(
 in vec3 vFragPos;
 in vec3 vNormal;
 in vec4 vColor;
 
 out vec4 FragColor;
 
-uniform vec3 lightPos = vec3(5.0, 5.0, 5.0);
-uniform vec3 viewPos;
-uniform vec3 lightColor = vec3(1.0, 1.0, 1.0);
-
 void main()
 {
-    // 环境光
-    float ambientStrength = 0.2;
-    vec3 ambient = ambientStrength * lightColor;
-
-    // 漫反射
     vec3 norm = normalize(vNormal);
-    vec3 lightDir = normalize(lightPos - vFragPos);
-    float diff = max(dot(norm, lightDir), 0.0);
-    vec3 diffuse = diff * lightColor;
-
-    // 镜面反射
-    vec3 viewDir = normalize(viewPos - vFragPos);
-    vec3 halfwayDir = normalize(lightDir + viewDir);
-    float spec = pow(max(dot(norm, halfwayDir), 0.0), 32.0);
-    vec3 specular = spec * lightColor;
-
-    vec3 result = (ambient + diffuse + specular) * vColor.rgb;
-    FragColor = vec4(result, vColor.a);
+    vec3 viewDir = normalize(uCameraPos.xyz - vFragPos);
+    vec3 result = vec3(0.0);
+
+    for (int i = 0; i < uLightCount.x; ++i)
+    {
+        // 环境光
+        vec3 ambient = uLights[i].ambient.rgb;
+
+        // 漫反射
+        vec3 lightDir = normalize(uLights[i].position.xyz - vFragPos);
+        float diff = max(dot(norm, lightDir), 0.0);
+        vec3 diffuse = diff * uLights[i].diffuse.rgb;
+
+        // 镜面反射
+        vec3 halfwayDir = normalize(lightDir + viewDir);
+        float spec = pow(max(dot(norm, halfwayDir), 0.0), 32.0);
+        vec3 specular = spec * uLights[i].specular.rgb;
+
+        result += ambient + diffuse + specular;
+    }
+    FragColor = vec4(result * vColor.rgb, vColor.a);
 }
 )";
     Graphics3D::Graphics3D(Window &window, Renderer &renderer)
@@ -152,9 +181,12 @@ void main()
         m_vao.setVertexBuffer(m_vbo, layout);
         m_vao.setIndexBuffer(m_ebo);
 
-        m_renderer.setCapability(RenderCapability::DepthTest, true);
-        m_renderer.setCapability(RenderCapability::Blend, true);
-        m_renderer.setBlendFunc(RenderBlendFunc::SrcAlpha, RenderBlendFunc::OneMinusSrcAlpha);
+        m_pipelineDesc.blend = true;
+        m_pipelineDesc.srcBlend = RenderBlendFunc::SrcAlpha;
+        m_pipelineDesc.dstBlend = RenderBlendFunc::OneMinusSrcAlpha;
+        m_pipelineDesc.depthTest = true;
+        m_pipelineDesc.vertexLayout = layout.getHash();
+        createPipelines(m_shader);
 
         // 默认相机参数
         m_camera.setZoom(45.0f);
@@ -165,18 +197,45 @@ void main()
         return m_camera;
     }
 
+    template <typename F>
+    void Graphics3D::submitGL(F &&func)
+    {
+        if (m_renderThread)
+            m_renderThread->enqueue(std::forward<F>(func));
+        else
+            func();
+    }
+
     void Graphics3D::clear()
     {
-        m_renderer.clear();
+        submitGL([this]()
+                 { m_renderer.clear(); });
     }
 
     void Graphics3D::setClearColor(const OxyColor &color)
     {
-        m_renderer.setClearColor(color);
+        submitGL([this, color]()
+                 { m_renderer.setClearColor(color); });
+    }
+
+    void Graphics3D::createPipelines(Shader &shader)
+    {
+        PipelineDesc desc = m_pipelineDesc;
+        desc.shader = &shader;
+        m_pipeline = m_renderer.createPipeline(desc);
+        desc.programPointSize = true;
+        m_pointPipeline = m_renderer.createPipeline(desc);
+    }
+
+    void Graphics3D::setShader(Shader *shader)
+    {
+        m_customShader = shader;
+        createPipelines(shader ? *shader : m_shader);
     }
 
     void Graphics3D::begin()
     {
+        ++m_frameIndex;
         m_triVertices.clear();
         m_triVertices.reserve(4096);
         m_triIndices.clear();
@@ -186,34 +245,211 @@ void main()
         m_lineBatches.clear();
         m_pointBatches.clear();
 
-        // 更新当前帧的视锥体平面
-        if (m_frustumCullingEnabled)
+        // 本帧相机写入共享 uniform 块，flush 时统一上传；按值捕获，渲染线程执行时相机可能已在更新下一帧
+        submitGL([this, camera = m_camera, width = m_window.getWidth(), height = m_window.getHeight()]()
+                 { m_renderer.getFrameUniforms().setCamera(camera, width, height); });
+
+        // 更新当前帧的视锥体平面与遮挡缓冲
+        if (m_frustumCullingEnabled || m_occlusionCullingEnabled)
         {
             glm::mat4 view = m_camera.getViewMatrix();
             glm::mat4 projection = m_camera.getPerspectiveProjectionMatrix(m_window.getWidth(), m_window.getHeight());
             glm::mat4 vp = projection * view;
-            extractFrustumPlanes(vp, m_frustumPlanes);
+            if (m_frustumCullingEnabled)
+                extractFrustumPlanes(vp, m_frustumPlanes);
+            if (m_occlusionCullingEnabled)
+                m_occlusionCuller.beginFrame(vp);
+        }
+
+        // LOD 所需的相机参数，并清理上一帧未出现的图元状态
+        if (m_autoLodEnabled)
+        {
+            glm::vec3 eye = m_camera.getPosition();
+            m_lodEye = Vec3(eye.x, eye.y, eye.z);
+            m_lodProjScale = float(m_window.getHeight()) / (2.0f * std::tan(glm::radians(m_camera.getZoom()) * 0.5f));
+            for (auto it = m_lodStates.begin(); it != m_lodStates.end();)
+            {
+                if (it->second.frame + 1 < m_frameIndex)
+                    it = m_lodStates.erase(it);
+                else
+                    ++it;
+            }
         }
     }
 
-    void Graphics3D::drawTriangle(const Vec3 &p1,
-                                  const Vec3 &p2,
-                                  const Vec3 &p3,
-                                  OxyColor color)
+    int Graphics3D::selectLod(uint64_t key, const Vec3 &center, float radius)
+    {
+        if (!m_autoLodEnabled)
+            return 0;
+
+        float dist = (center - m_lodEye).length();
+        if (dist <= radius)
+            return 0;
+
+        // 投影半径每减半，降低一个级别
+        float pixelRadius = std::max(radius * m_lodProjScale / dist, 1e-3f);
+        float value = std::log2(kLodFullDetailRadius / pixelRadius) + s_lodBias;
+        int level = std::clamp(static_cast<int>(std::floor(value)), 0, LOD_LEVELS - 1);
+
+        auto it = m_lodStates.find(key);
+        if (it != m_lodStates.end())
+        {
+            int prev = it->second.level;
+            if (level > prev && value < float(prev + 1) + kLodHysteresis)
+                level = prev;
+            else if (level < prev && value > float(prev) - kLodHysteresis)
+                level = prev;
+            it->second = {level, m_frameIndex};
+        }
+        else
+        {
+            m_lodStates.emplace(key, LodState{level, m_frameIndex});
+        }
+        return level;
+    }
+
+    const Graphics3D::PrimitiveMesh &Graphics3D::getSphereMesh(int stacks, int slices)
+    {
+        uint64_t key = (1ULL << 56) | (uint64_t(stacks) << 28) | uint64_t(slices);
+        auto it = m_primitiveCache.find(key);
+        if (it != m_primitiveCache.end())
+            return it->second;
+
+        PrimitiveMesh mesh;
+        mesh.positions.reserve(size_t(stacks + 1) * size_t(slices + 1));
+        mesh.normals.reserve(size_t(stacks + 1) * size_t(slices + 1));
+        for (int i = 0; i <= stacks; ++i)
+        {
+            float phi = glm::pi<float>() * float(i) / float(stacks);
+            for (int j = 0; j <= slices; ++j)
+            {
+                float theta = glm::two_pi<float>() * float(j) / float(slices);
+                Vec3 p(std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta));
+                mesh.positions.push_back(p);
+                mesh.normals.push_back(p);
+            }
+        }
+
+        mesh.indices.reserve(size_t(stacks) * size_t(slices) * 6);
+        for (int i = 0; i < stacks; ++i)
+        {
+            for (int j = 0; j < slices; ++j)
+            {
+                unsigned int p1 = i * (slices + 1) + j;
+                unsigned int p2 = (i + 1) * (slices + 1) + j;
+                unsigned int p3 = p2 + 1;
+                unsigned int p4 = p1 + 1;
+                mesh.indices.insert(mesh.indices.end(), {p1, p2, p3, p3, p4, p1});
+            }
+        }
+        return m_primitiveCache.emplace(key, std::move(mesh)).first->second;
+    }
+
+    const Graphics3D::PrimitiveMesh &Graphics3D::getCylinderMesh(int slices, bool capped)
+    {
+        uint64_t key = (2ULL << 56) | (uint64_t(slices) << 1) | (capped ? 1ULL : 0ULL);
+        auto it = m_primitiveCache.find(key);
+        if (it != m_primitiveCache.end())
+            return it->second;
+
+        PrimitiveMesh mesh;
+        // 侧面：底圈与顶圈
+        for (int ring = 0; ring < 2; ++ring)
+        {
+            float y = ring == 0 ? -0.5f : 0.5f;
+            for (int j = 0; j <= slices; ++j)
+            {
+                float theta = glm::two_pi<float>() * float(j) / float(slices);
+                Vec3 n(std::cos(theta), 0.0f, std::sin(theta));
+                mesh.positions.push_back(Vec3(n.x, y, n.z));
+                mesh.normals.push_back(n);
+            }
+        }
+        for (int j = 0; j < slices; ++j)
+        {
+            unsigned int p1 = j;
+            unsigned int p2 = j + 1;
+            unsigned int p3 = (slices + 1) + j + 1;
+            unsigned int p4 = (slices + 1) + j;
+            mesh.indices.insert(mesh.indices.end(), {p1, p2, p3, p3, p4, p1});
+        }
+
+        if (capped)
+        {
+            for (int cap = 0; cap < 2; ++cap)
+            {
+                float y = cap == 0 ? 0.5f : -0.5f;
+                Vec3 n(0.0f, cap == 0 ? 1.0f : -1.0f, 0.0f);
+                unsigned int centerBase = (unsigned int)mesh.positions.size();
+                mesh.positions.push_back(Vec3(0.0f, y, 0.0f));
+                mesh.normals.push_back(n);
+                for (int j = 0; j < slices; ++j)
+                {
+                    float theta = glm::two_pi<float>() * float(j) / float(slices);
+                    mesh.positions.push_back(Vec3(std::cos(theta), y, std::sin(theta)));
+                    mesh.normals.push_back(n);
+                }
+                for (int j = 0; j < slices; ++j)
+                {
+                    unsigned int i1 = centerBase + 1 + j;
+                    unsigned int i2 = centerBase + 1 + ((j + 1) % slices);
+                    // 顶面与底面绕序相反，保证法线朝外
+                    if (cap == 0)
+                        mesh.indices.insert(mesh.indices.end(), {centerBase, i1, i2});
+                    else
+                        mesh.indices.insert(mesh.indices.end(), {centerBase, i2, i1});
+                }
+            }
+        }
+        return m_primitiveCache.emplace(key, std::move(mesh)).first->second;
+    }
+
+    void Graphics3D::appendPrimitive(const PrimitiveMesh &mesh, const Vec3 &center, const Vec3 &scale, const OxyColor &color)
+    {
+        unsigned int base = (unsigned int)m_triVertices.size();
+        for (size_t i = 0; i < mesh.positions.size(); ++i)
+        {
+            const Vec3 &p = mesh.positions[i];
+            m_triVertices.push_back({Vec3(center.x + p.x * scale.x, center.y + p.y * scale.y, center.z + p.z * scale.z),
+                                     color, mesh.normals[i]});
+        }
+        for (unsigned int idx : mesh.indices)
+            m_triIndices.push_back(base + idx);
+        m_triIndexCount += mesh.indices.size();
+    }
+
+    void Graphics3D::addOccluder(const Vec3 &center, const Vec3 &size)
+    {
+        if (!m_occlusionCullingEnabled)
+            return;
+        m_occlusionCuller.addOccluderBox(toGlm(center), toGlm(size * 0.5f));
+    }
+
+    bool Graphics3D::appendTriangle(std::vector<Vertex> &out, const Vec3 &p1, const Vec3 &p2, const Vec3 &p3, const OxyColor &color) const
     {
         if (m_frustumCullingEnabled)
         {
             glm::vec3 c = (toGlm(p1) + toGlm(p2) + toGlm(p3)) / 3.0f;
             float r = glm::max(glm::length(c - toGlm(p1)), glm::max(glm::length(c - toGlm(p2)), glm::length(c - toGlm(p3))));
             if (!sphereInFrustum(m_frustumPlanes, c, r))
-                return;
+                return false;
         }
         auto n = (p2 - p1).cross(p3 - p1).normalize();
         // glm::vec3 n = glm::normalize(glm::cross(p2 - p1, p3 - p1));
+        out.push_back({p1, color, n});
+        out.push_back({p2, color, n});
+        out.push_back({p3, color, n});
+        return true;
+    }
+
+    void Graphics3D::drawTriangle(const Vec3 &p1,
+                                  const Vec3 &p2,
+                                  const Vec3 &p3,
+                                  OxyColor color)
+    {
         unsigned int start = (unsigned int)m_triVertices.size();
-        m_triVertices.push_back({p1, color, n});
-        m_triVertices.push_back({p2, color, n});
-        m_triVertices.push_back({p3, color, n});
+        if (!appendTriangle(m_triVertices, p1, p2, p3, color))
+            return;
 
         m_triIndices.push_back(start + 0);
         m_triIndices.push_back(start + 1);
@@ -377,6 +613,8 @@ void main()
             if (!aabbInFrustum(m_frustumPlanes, c, half))
                 return;
         }
+        if (m_occlusionCullingEnabled && !m_occlusionCuller.isAABBVisible(toGlm(center), toGlm(size * 0.5f)))
+            return;
         Vec3 half = size * 0.5f;
 
         Vec3 p[8] = {
@@ -427,63 +665,17 @@ void main()
             if (!sphereInFrustum(m_frustumPlanes, toGlm(center), radius))
                 return;
         }
+        if (m_occlusionCullingEnabled && !m_occlusionCuller.isSphereVisible(toGlm(center), radius))
+            return;
         if (stacks < 2)
             stacks = 2;
         if (slices < 3)
             slices = 3;
 
-        for (int i = 0; i < stacks; ++i)
-        {
-            float phi1 = glm::pi<float>() * float(i) / float(stacks);
-            float phi2 = glm::pi<float>() * float(i + 1) / float(stacks);
-
-            for (int j = 0; j < slices; ++j)
-            {
-                float theta1 = glm::two_pi<float>() * float(j) / float(slices);
-                float theta2 = glm::two_pi<float>() * float(j + 1) / float(slices);
-
-                Vec3 p1 = center + radius * Vec3(
-                                                std::sin(phi1) * std::cos(theta1),
-                                                std::cos(phi1),
-                                                std::sin(phi1) * std::sin(theta1));
-                Vec3 p2 = center + radius * Vec3(
-                                                std::sin(phi2) * std::cos(theta1),
-                                                std::cos(phi2),
-                                                std::sin(phi2) * std::sin(theta1));
-                Vec3 p3 = center + radius * Vec3(
-                                                std::sin(phi2) * std::cos(theta2),
-                                                std::cos(phi2),
-                                                std::sin(phi2) * std::sin(theta2));
-                Vec3 p4 = center + radius * Vec3(
-                                                std::sin(phi1) * std::cos(theta2),
-                                                std::cos(phi1),
-                                                std::sin(phi1) * std::sin(theta2));
-
-                Vec3 n1 = (p1 - center).normalize();
-                Vec3 n2 = (p2 - center).normalize();
-                Vec3 n3 = (p3 - center).normalize();
-                Vec3 n4 = (p4 - center).normalize();
-
-                unsigned int base = (unsigned int)m_triVertices.size();
-                // 第一个三角形
-                m_triVertices.push_back({p1, color, n1});
-                m_triVertices.push_back({p2, color, n2});
-                m_triVertices.push_back({p3, color, n3});
-                m_triIndices.push_back(base + 0);
-                m_triIndices.push_back(base + 1);
-                m_triIndices.push_back(base + 2);
-                m_triIndexCount += 3;
-
-                // 第二个三角形
-                m_triVertices.push_back({p3, color, n3});
-                m_triVertices.push_back({p4, color, n4});
-                m_triVertices.push_back({p1, color, n1});
-                m_triIndices.push_back(base + 3);
-                m_triIndices.push_back(base + 4);
-                m_triIndices.push_back(base + 5);
-                m_triIndexCount += 3;
-            }
-        }
+        int level = selectLod(primitiveKey(1, center, radius, 0.0f), center, radius);
+        int lodStacks = std::max(stacks >> level, std::min(stacks, kMinSphereStacks));
+        int lodSlices = std::max(slices >> level, std::min(slices, kMinSlices));
+        appendPrimitive(getSphereMesh(lodStacks, lodSlices), center, Vec3(radius, radius, radius), color);
     }
 
     void Graphics3D::drawCylinder(const Vec3 &center,
@@ -500,107 +692,17 @@ void main()
             if (!aabbInFrustum(m_frustumPlanes, c, half))
                 return;
         }
+        if (m_occlusionCullingEnabled && !m_occlusionCuller.isAABBVisible(toGlm(center), glm::vec3(radius, height * 0.5f, radius)))
+            return;
         if (radius <= 0.0f || height <= 0.0f)
             return;
         if (slices < 3)
             slices = 3;
 
-        float halfH = 0.5f * height;
-        float yTop = center.y + halfH;
-        float yBottom = center.y - halfH;
-
-        for (int j = 0; j < slices; ++j)
-        {
-            float theta1 = glm::two_pi<float>() * float(j) / float(slices);
-            float theta2 = glm::two_pi<float>() * float(j + 1) / float(slices);
-
-            Vec3 p1(center.x + radius * std::cos(theta1), yBottom, center.z + radius * std::sin(theta1));
-            Vec3 p2(center.x + radius * std::cos(theta2), yBottom, center.z + radius * std::sin(theta2));
-            Vec3 p3(center.x + radius * std::cos(theta2), yTop, center.z + radius * std::sin(theta2));
-            Vec3 p4(center.x + radius * std::cos(theta1), yTop, center.z + radius * std::sin(theta1));
-
-            // Vec3 n1 = glm::normalize(glm::vec3(p1.x - center.x, 0.0f, p1.z - center.z));
-            // Vec3 n2 = glm::normalize(glm::vec3(p2.x - center.x, 0.0f, p2.z - center.z));
-            // Vec3 n3 = glm::normalize(glm::vec3(p3.x - center.x, 0.0f, p3.z - center.z));
-            // Vec3 n4 = glm::normalize(glm::vec3(p4.x - center.x, 0.0f, p4.z - center.z));
-
-            Vec3 n1 = Vec3(p1.x - center.x, 0.0f, p1.z - center.z).normalize();
-            Vec3 n2 = Vec3(p2.x - center.x, 0.0f, p2.z - center.z).normalize();
-            Vec3 n3 = Vec3(p3.x - center.x, 0.0f, p3.z - center.z).normalize();
-            Vec3 n4 = Vec3(p4.x - center.x, 0.0f, p4.z - center.z).normalize();
-
-            unsigned int base = (unsigned int)m_triVertices.size();
-
-            m_triVertices.push_back({p1, color, n1});
-            m_triVertices.push_back({p2, color, n2});
-            m_triVertices.push_back({p3, color, n3});
-            m_triIndices.push_back(base + 0);
-            m_triIndices.push_back(base + 1);
-            m_triIndices.push_back(base + 2);
-            m_triIndexCount += 3;
-
-            m_triVertices.push_back({p3, color, n3});
-            m_triVertices.push_back({p4, color, n4});
-            m_triVertices.push_back({p1, color, n1});
-            m_triIndices.push_back(base + 3);
-            m_triIndices.push_back(base + 4);
-            m_triIndices.push_back(base + 5);
-            m_triIndexCount += 3;
-        }
-
-        if (capped)
-        {
-
-            {
-                Vec3 nTop(0.0f, 1.0f, 0.0f);
-                unsigned int centerBase = (unsigned int)m_triVertices.size();
-
-                m_triVertices.push_back({Vec3(center.x, yTop, center.z), color, nTop});
-
-                for (int j = 0; j < slices; ++j)
-                {
-                    float theta = glm::two_pi<float>() * float(j) / float(slices);
-                    Vec3 p(center.x + radius * std::cos(theta), yTop, center.z + radius * std::sin(theta));
-                    m_triVertices.push_back({p, color, nTop});
-                }
-
-                for (int j = 0; j < slices; ++j)
-                {
-                    unsigned int i0 = centerBase + 0;
-                    unsigned int i1 = centerBase + 1 + j;
-                    unsigned int i2 = centerBase + 1 + ((j + 1) % slices);
-                    m_triIndices.push_back(i0);
-                    m_triIndices.push_back(i1);
-                    m_triIndices.push_back(i2);
-                    m_triIndexCount += 3;
-                }
-            }
-
-            {
-                Vec3 nBot(0.0f, -1.0f, 0.0f);
-                unsigned int centerBase = (unsigned int)m_triVertices.size();
-
-                m_triVertices.push_back({Vec3(center.x, yBottom, center.z), color, nBot});
-
-                for (int j = 0; j < slices; ++j)
-                {
-                    float theta = glm::two_pi<float>() * float(j) / float(slices);
-                    Vec3 p(center.x + radius * std::cos(theta), yBottom, center.z + radius * std::sin(theta));
-                    m_triVertices.push_back({p, color, nBot});
-                }
-
-                for (int j = 0; j < slices; ++j)
-                {
-                    unsigned int i0 = centerBase + 0;
-                    unsigned int i1 = centerBase + 1 + ((j + 1) % slices);
-                    unsigned int i2 = centerBase + 1 + j;
-                    m_triIndices.push_back(i0);
-                    m_triIndices.push_back(i1);
-                    m_triIndices.push_back(i2);
-                    m_triIndexCount += 3;
-                }
-            }
-        }
+        float boundRadius = std::sqrt(radius * radius + 0.25f * height * height);
+        int level = selectLod(primitiveKey(capped ? 3 : 2, center, radius, height), center, boundRadius);
+        int lodSlices = std::max(slices >> level, std::min(slices, kMinSlices));
+        appendPrimitive(getCylinderMesh(lodSlices, capped), center, Vec3(radius, height, radius), color);
     }
 
     void Graphics3D::drawFunction(
@@ -609,7 +711,8 @@ void main()
         const std::function<float(float, float)> &func,
         const OxyColor &color,
         const float &dx,
-        const float &dz)
+        const float &dz,
+        bool parallel)
     {
         Vec2 xRange = xDomain;
         Vec2 zRange = zDomain;
@@ -620,97 +723,178 @@ void main()
         xRange.y = xRange.x + nx * dx;
         zRange.y = zRange.x + nz * dz;
 
-        for (int i = 0; i < nx; ++i)
+        if (nx <= 0 || nz <= 0)
+            return;
+
+        // 小网格的调度开销大于收益，直接在调用线程完成
+        ThreadPool &pool = ThreadPool::getInstance();
+        const size_t cells = size_t(nx) * size_t(nz);
+        const size_t chunks = cells < 4096 ? 1 : std::min<size_t>(nx, (pool.getThreadCount() + 1) * 4);
+
+        // 每个格点只求值一次（相邻格子共享顶点）
+        const int stride = nz + 1;
+        std::vector<float> heights(size_t(nx + 1) * stride);
+        auto evaluateRow = [&](size_t i)
+        {
+            float x = xRange.x + i * dx;
+            for (int j = 0; j <= nz; ++j)
+                heights[i * stride + j] = func(x, zRange.x + j * dz);
+        };
+        // 用户回调只有在调用方声明可并发时才并行求值
+        if (chunks == 1 || !parallel)
+        {
+            for (int i = 0; i <= nx; ++i)
+                evaluateRow(i);
+        }
+        else
+            pool.parallelFor(0, nx + 1, evaluateRow);
+
+        // 按行分块细分（含视锥裁剪与法线），各块写入自己的缓冲，再按原顺序拼接
+        std::vector<std::vector<Vertex>> parts(chunks);
+        auto tessellate = [&](size_t chunk)
         {
-            for (int j = 0; j < nz; ++j)
+            std::vector<Vertex> &out = parts[chunk];
+            int rowBegin = int(chunk * nx / chunks);
+            int rowEnd = int((chunk + 1) * nx / chunks);
+            out.reserve(size_t(rowEnd - rowBegin) * nz * 6);
+            for (int i = rowBegin; i < rowEnd; ++i)
             {
-                float x1 = xRange.x + i * dx;
-                float x2 = xRange.x + (i + 1) * dx;
-                float z1 = zRange.x + j * dz;
-                float z2 = zRange.x+ (j + 1) * dz;
-
-                Vec3 p1(x1, func(x1, z1), z1);
-                Vec3 p2(x2, func(x2, z1), z1);
-                Vec3 p3(x2, func(x2, z2), z2);
-                Vec3 p4(x1, func(x1, z2), z2);
-
-                drawTriangle(p1, p2, p4, color);
-                drawTriangle(p2, p3, p4, color);
+                for (int j = 0; j < nz; ++j)
+                {
+                    float x1 = xRange.x + i * dx;
+                    float x2 = xRange.x + (i + 1) * dx;
+                    float z1 = zRange.x + j * dz;
+                    float z2 = zRange.x + (j + 1) * dz;
+
+                    Vec3 p1(x1, heights[i * stride + j], z1);
+                    Vec3 p2(x2, heights[(i + 1) * stride + j], z1);
+                    Vec3 p3(x2, heights[(i + 1) * stride + j + 1], z2);
+                    Vec3 p4(x1, heights[i * stride + j + 1], z2);
+
+                    appendTriangle(out, p1, p2, p4, color);
+                    appendTriangle(out, p2, p3, p4, color);
+                }
             }
+        };
+        if (chunks == 1)
+            tessellate(0);
+        else
+            pool.parallelFor(0, chunks, tessellate, 1);
+
+        for (const auto &part : parts)
+        {
+            unsigned int start = (unsigned int)m_triVertices.size();
+            m_triVertices.insert(m_triVertices.end(), part.begin(), part.end());
+            for (unsigned int k = 0; k < part.size(); ++k)
+                m_triIndices.push_back(start + k);
+            m_triIndexCount += part.size();
         }
     }
 
+    namespace
+    {
+        constexpr UniformID kModel("model");
+        constexpr UniformID kNormalMatrix("normalMatrix");
+        constexpr UniformID kView("view");
+        constexpr UniformID kProjection("projection");
+        constexpr UniformID kLightPos("lightPos");
+        constexpr UniformID kViewPos("viewPos");
+        constexpr UniformID kPointSize("uPointSize");
+    }
+
     void Graphics3D::flush()
     {
         if (m_triIndexCount == 0 && m_lineBatches.empty() && m_pointBatches.empty())
             return;
 
-        m_renderer.setCapability(RenderCapability::Multisample, true);
-        m_renderer.setCapability(RenderCapability::Blend, true);
-        m_renderer.setCapability(RenderCapability::DepthTest, true);
-        m_renderer.setCapability(RenderCapability::StencilTest, false);
+        FrameBatch batch;
+        batch.shader = m_customShader ? m_customShader : &m_shader;
+        batch.pipeline = m_pipeline;
+        batch.pointPipeline = m_pointPipeline;
+        batch.triVertices.swap(m_triVertices);
+        batch.triIndices.swap(m_triIndices);
+        batch.triIndexCount = m_triIndexCount;
+        batch.lineBatches.swap(m_lineBatches);
+        batch.pointBatches.swap(m_pointBatches);
+
+        if (m_renderThread && m_renderThread->isRunning())
+        {
+            // 整批移交渲染线程，下一帧 begin() 重新分配
+            m_renderThread->enqueue([this, batch = std::move(batch)]()
+                                    { drawBatch(batch); });
+        }
+        else
+        {
+            drawBatch(batch);
+            // 交还三角形缓冲以保留容量
+            batch.triVertices.swap(m_triVertices);
+            batch.triIndices.swap(m_triIndices);
+        }
 
-        Shader *shaderToUse = m_customShader ? m_customShader : &m_shader;
-        shaderToUse->use();
+        // 清空批次
+        m_triIndexCount = 0;
+        m_triVertices.clear();
+        m_triIndices.clear();
+        m_lineBatches.clear();
+        m_pointBatches.clear();
+    }
 
-        // 3D MVP
-        glm::mat4 model = glm::mat4(1.0f);
-        glm::mat4 view = m_camera.getViewMatrix();
-        glm::mat4 projection = m_camera.getPerspectiveProjectionMatrix(m_window.getWidth(), m_window.getHeight());
+    void Graphics3D::drawBatch(const FrameBatch &batch)
+    {
+        Shader *shaderToUse = batch.shader;
+        m_renderer.bindPipeline(*batch.pipeline);
+
+        // 相机与光照在 begin() 中写入共享的每帧 uniform 块，这里只做一次上传/绑定
+        FrameUniforms &frame = m_renderer.getFrameUniforms();
+        frame.bind();
 
-        shaderToUse->setUniformData("model", &model, sizeof(glm::mat4));
-        shaderToUse->setUniformData("view", &view, sizeof(glm::mat4));
-        shaderToUse->setUniformData("projection", &projection, sizeof(glm::mat4));
+        // 顶点已在世界空间，模型矩阵与法线矩阵均为单位阵（值未变时不会调用 GL）
+        shaderToUse->setMat4(kModel, glm::mat4(1.0f));
+        shaderToUse->setMat3(kNormalMatrix, glm::mat3(1.0f));
 
-        // 设置光照和相机位置
-        glm::vec3 lightPos(5.0f, 5.0f, 5.0f);
-        glm::vec3 camPos = m_camera.getPosition();
-        shaderToUse->setUniformData("lightPos", &lightPos, sizeof(glm::vec3));
-        shaderToUse->setUniformData("viewPos", &camPos, sizeof(glm::vec3));
+        // 兼容仍按名字声明 view/projection/lightPos/viewPos 的自定义着色器，内置着色器中不存在时直接跳过
+        if (shaderToUse != &m_shader)
+        {
+            const FrameData &data = frame.getData();
+            shaderToUse->setMat4(kView, data.view);
+            shaderToUse->setMat4(kProjection, data.projection);
+            shaderToUse->setVec3(kLightPos, glm::vec3(data.lights[0].position));
+            shaderToUse->setVec3(kViewPos, glm::vec3(data.cameraPos));
+        }
 
         m_vao.bind();
 
         // 线绘制
-        for (auto &batch : m_lineBatches)
+        for (auto &line : batch.lineBatches)
         {
-            if (batch.indexCount == 0)
+            if (line.indexCount == 0)
                 continue;
-            m_vbo.setData(batch.vertices.data(), batch.vertices.size() * sizeof(Vertex));
-            m_ebo.setData(batch.indices.data(), batch.indices.size() * sizeof(unsigned int));
-            m_renderer.drawLines(m_vao, batch.indexCount, batch.thickness);
+            m_vbo.setData(line.vertices.data(), line.vertices.size() * sizeof(Vertex));
+            m_ebo.setData(line.indices.data(), line.indices.size() * sizeof(unsigned int));
+            m_renderer.drawLines(m_vao, line.indexCount, line.thickness);
         }
 
         // 面绘制
-        if (m_triIndexCount > 0)
+        if (batch.triIndexCount > 0)
         {
-            m_vbo.setData(m_triVertices.data(), m_triVertices.size() * sizeof(Vertex));
-            m_ebo.setData(m_triIndices.data(), m_triIndices.size() * sizeof(unsigned int));
-            m_renderer.drawTriangles(m_vao, m_triIndexCount);
+            m_vbo.setData(batch.triVertices.data(), batch.triVertices.size() * sizeof(Vertex));
+            m_ebo.setData(batch.triIndices.data(), batch.triIndices.size() * sizeof(unsigned int));
+            m_renderer.drawTriangles(m_vao, batch.triIndexCount);
         }
 
         // 点绘制
-        if (!m_pointBatches.empty())
+        if (!batch.pointBatches.empty())
         {
-            m_renderer.setCapability(RenderCapability::ProgramPointSize, true);
-            for (auto &pb : m_pointBatches)
+            m_renderer.bindPipeline(*batch.pointPipeline);
+            for (auto &pb : batch.pointBatches)
             {
                 if (pb.vertices.empty())
                     continue;
                 m_vbo.setData(pb.vertices.data(), pb.vertices.size() * sizeof(Vertex));
-                float size = pb.size;
-                shaderToUse->setUniformData("uPointSize", &size, sizeof(float));
+                shaderToUse->setFloat(kPointSize, pb.size);
                 m_renderer.drawPoints(m_vao, static_cast<uint32_t>(pb.vertices.size()));
             }
-            m_renderer.setCapability(RenderCapability::ProgramPointSize, false);
+            m_renderer.bindPipeline(*batch.pipeline);
         }
-
-        m_vao.unbind();
-
-        // 清空批次
-        m_triIndexCount = 0;
-        m_triVertices.clear();
-        m_triIndices.clear();
-        m_lineBatches.clear();
-        m_pointBatches.clear();
     }
 }
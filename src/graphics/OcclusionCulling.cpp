@@ -0,0 +1,344 @@
+#include "OxygenRender/OcclusionCulling.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define OXY_OCCLUSION_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define OXY_TARGET_AVX2
+#else
+#define OXY_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#endif
+#endif
+
+namespace OxyRender
+{
+    namespace
+    {
+        // 近平面阈值：任一顶点 w 小于该值时三角形/包围盒被保守处理
+        constexpr float kNearW = 1e-4f;
+        // 包围盒测试的相对容差，避免遮挡体被自身剔除
+        constexpr float kDepthSlack = 1.0001f;
+
+        // 三角形光栅化参数（屏幕空间边函数 + 1/w 平面）
+        struct TriangleSetup
+        {
+            float a[3], b[3], c[3]; // E_i(x, y) = a*x + b*y + c，三角形内部 E_i >= 0
+            float za, zb, zc;       // 1/w(x, y) = za*x + zb*y + zc
+            float zBias;            // 像素范围内 1/w 的最大下降量
+            float zMin;             // 三个顶点中最小的 1/w
+            int minX, maxX, minY, maxY;
+        };
+
+        inline void setupEdge(TriangleSetup &t, int i, float ax, float ay, float bx, float by)
+        {
+            t.a[i] = ay - by;
+            t.b[i] = bx - ax;
+            t.c[i] = ax * by - ay * bx;
+        }
+
+        void rasterizeScalar(const TriangleSetup &t, float *depth, int width)
+        {
+            for (int y = t.minY; y <= t.maxY; ++y)
+            {
+                const float py = float(y) + 0.5f;
+                float *row = depth + size_t(y) * size_t(width);
+                for (int x = t.minX; x <= t.maxX; ++x)
+                {
+                    const float px = float(x) + 0.5f;
+                    const float e0 = t.a[0] * px + t.b[0] * py + t.c[0];
+                    const float e1 = t.a[1] * px + t.b[1] * py + t.c[1];
+                    const float e2 = t.a[2] * px + t.b[2] * py + t.c[2];
+                    if (e0 < 0.0f || e1 < 0.0f || e2 < 0.0f)
+                        continue;
+                    const float z = std::max(t.za * px + t.zb * py + t.zc - t.zBias, t.zMin);
+                    if (z > row[x])
+                        row[x] = z;
+                }
+            }
+        }
+
+#ifdef OXY_OCCLUSION_X86
+        // 每次处理一行中对齐的 8 个像素
+        OXY_TARGET_AVX2 void rasterizeAVX2(const TriangleSetup &t, float *depth, int width)
+        {
+            const __m256 laneOffsets = _mm256_setr_ps(0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f);
+            const __m256 zero = _mm256_setzero_ps();
+            const __m256 a0 = _mm256_set1_ps(t.a[0]);
+            const __m256 a1 = _mm256_set1_ps(t.a[1]);
+            const __m256 a2 = _mm256_set1_ps(t.a[2]);
+            const __m256 za = _mm256_set1_ps(t.za);
+            const __m256 zMin = _mm256_set1_ps(t.zMin);
+            const __m256 xLo = _mm256_set1_ps(float(t.minX));
+            const __m256 xHi = _mm256_set1_ps(float(t.maxX + 1));
+            const int xStart = t.minX & ~(OcclusionCuller::TILE_SIZE - 1);
+
+            for (int y = t.minY; y <= t.maxY; ++y)
+            {
+                const float py = float(y) + 0.5f;
+                const __m256 r0 = _mm256_set1_ps(t.b[0] * py + t.c[0]);
+                const __m256 r1 = _mm256_set1_ps(t.b[1] * py + t.c[1]);
+                const __m256 r2 = _mm256_set1_ps(t.b[2] * py + t.c[2]);
+                const __m256 rz = _mm256_set1_ps(t.zb * py + t.zc - t.zBias);
+                float *row = depth + size_t(y) * size_t(width);
+
+                for (int x = xStart; x <= t.maxX; x += OcclusionCuller::TILE_SIZE)
+                {
+                    const __m256 px = _mm256_add_ps(_mm256_set1_ps(float(x)), laneOffsets);
+                    const __m256 e0 = _mm256_fmadd_ps(a0, px, r0);
+                    const __m256 e1 = _mm256_fmadd_ps(a1, px, r1);
+                    const __m256 e2 = _mm256_fmadd_ps(a2, px, r2);
+
+                    __m256 inside = _mm256_and_ps(_mm256_cmp_ps(e0, zero, _CMP_GE_OQ), _mm256_cmp_ps(e1, zero, _CMP_GE_OQ));
+                    inside = _mm256_and_ps(inside, _mm256_cmp_ps(e2, zero, _CMP_GE_OQ));
+                    inside = _mm256_and_ps(inside, _mm256_cmp_ps(px, xLo, _CMP_GE_OQ));
+                    inside = _mm256_and_ps(inside, _mm256_cmp_ps(px, xHi, _CMP_LT_OQ));
+                    if (_mm256_movemask_ps(inside) == 0)
+                        continue;
+
+                    const __m256 z = _mm256_max_ps(_mm256_fmadd_ps(za, px, rz), zMin);
+                    const __m256 old = _mm256_loadu_ps(row + x);
+                    const __m256 merged = _mm256_blendv_ps(old, _mm256_max_ps(old, z), inside);
+                    _mm256_storeu_ps(row + x, merged);
+                }
+            }
+        }
+#endif
+    }
+
+    OcclusionCuller::OcclusionCuller(int width, int height)
+    {
+        m_useAVX2 = hasAVX2();
+        resize(width, height);
+    }
+
+    bool OcclusionCuller::hasAVX2()
+    {
+#if defined(OXY_OCCLUSION_X86) && defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7)
+            return false;
+        __cpuid(info, 1);
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        const bool fma = (info[2] & (1 << 12)) != 0;
+        if (!osxsave || !fma || (_xgetbv(0) & 0x6) != 0x6)
+            return false;
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#elif defined(OXY_OCCLUSION_X86)
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+        return false;
+#endif
+    }
+
+    void OcclusionCuller::resize(int width, int height)
+    {
+        auto roundUp = [](int v)
+        { return std::max(TILE_SIZE, (v + TILE_SIZE - 1) / TILE_SIZE * TILE_SIZE); };
+
+        m_width = roundUp(width);
+        m_height = roundUp(height);
+        m_tilesX = m_width / TILE_SIZE;
+        m_tilesY = m_height / TILE_SIZE;
+        m_depth.assign(size_t(m_width) * size_t(m_height), 0.0f);
+        m_tileMin.assign(size_t(m_tilesX) * size_t(m_tilesY), 0.0f);
+        m_hizDirty = false;
+    }
+
+    void OcclusionCuller::beginFrame(const glm::mat4 &viewProjection)
+    {
+        m_viewProjection = viewProjection;
+        std::fill(m_depth.begin(), m_depth.end(), 0.0f);
+        std::fill(m_tileMin.begin(), m_tileMin.end(), 0.0f);
+        m_hizDirty = false;
+        m_stats = OcclusionStats{};
+    }
+
+    void OcclusionCuller::addOccluderTriangles(const glm::vec3 *vertices, const uint32_t *indices, size_t triangleCount)
+    {
+        for (size_t i = 0; i < triangleCount; ++i)
+        {
+            const glm::vec4 c0 = m_viewProjection * glm::vec4(vertices[indices[i * 3 + 0]], 1.0f);
+            const glm::vec4 c1 = m_viewProjection * glm::vec4(vertices[indices[i * 3 + 1]], 1.0f);
+            const glm::vec4 c2 = m_viewProjection * glm::vec4(vertices[indices[i * 3 + 2]], 1.0f);
+            rasterizeTriangle(c0, c1, c2);
+        }
+    }
+
+    void OcclusionCuller::addOccluderBox(const glm::vec3 &center, const glm::vec3 &halfExtents)
+    {
+        const glm::vec3 corners[8] = {
+            center + glm::vec3(-halfExtents.x, -halfExtents.y, -halfExtents.z),
+            center + glm::vec3(halfExtents.x, -halfExtents.y, -halfExtents.z),
+            center + glm::vec3(halfExtents.x, halfExtents.y, -halfExtents.z),
+            center + glm::vec3(-halfExtents.x, halfExtents.y, -halfExtents.z),
+            center + glm::vec3(-halfExtents.x, -halfExtents.y, halfExtents.z),
+            center + glm::vec3(halfExtents.x, -halfExtents.y, halfExtents.z),
+            center + glm::vec3(halfExtents.x, halfExtents.y, halfExtents.z),
+            center + glm::vec3(-halfExtents.x, halfExtents.y, halfExtents.z)};
+
+        static const uint32_t indices[36] = {
+            0, 1, 2, 2, 3, 0, // -Z
+            4, 5, 6, 6, 7, 4, // +Z
+            0, 4, 7, 7, 3, 0, // -X
+            1, 5, 6, 6, 2, 1, // +X
+            3, 2, 6, 6, 7, 3, // +Y
+            0, 1, 5, 5, 4, 0  // -Y
+        };
+        addOccluderTriangles(corners, indices, 12);
+    }
+
+    void OcclusionCuller::rasterizeTriangle(const glm::vec4 &c0, const glm::vec4 &c1, const glm::vec4 &c2)
+    {
+        // 跨越近平面的三角形直接跳过（少写遮挡只会让结果更保守）
+        if (c0.w <= kNearW || c1.w <= kNearW || c2.w <= kNearW)
+            return;
+
+        const float iw[3] = {1.0f / c0.w, 1.0f / c1.w, 1.0f / c2.w};
+        const glm::vec4 *clip[3] = {&c0, &c1, &c2};
+        float sx[3], sy[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            sx[i] = (clip[i]->x * iw[i] * 0.5f + 0.5f) * float(m_width);
+            sy[i] = (clip[i]->y * iw[i] * 0.5f + 0.5f) * float(m_height);
+        }
+
+        float area = (sx[1] - sx[0]) * (sy[2] - sy[0]) - (sx[2] - sx[0]) * (sy[1] - sy[0]);
+        if (std::fabs(area) < 1e-6f)
+            return;
+        // 统一为逆时针，使内部的边函数为正
+        int i1 = 1, i2 = 2;
+        if (area < 0.0f)
+        {
+            std::swap(i1, i2);
+            area = -area;
+        }
+
+        TriangleSetup t;
+        t.minX = std::max(0, int(std::floor(std::min({sx[0], sx[1], sx[2]}))));
+        t.maxX = std::min(m_width - 1, int(std::floor(std::max({sx[0], sx[1], sx[2]}))));
+        t.minY = std::max(0, int(std::floor(std::min({sy[0], sy[1], sy[2]}))));
+        t.maxY = std::min(m_height - 1, int(std::floor(std::max({sy[0], sy[1], sy[2]}))));
+        if (t.minX > t.maxX || t.minY > t.maxY)
+            return;
+
+        setupEdge(t, 0, sx[0], sy[0], sx[i1], sy[i1]);
+        setupEdge(t, 1, sx[i1], sy[i1], sx[i2], sy[i2]);
+        setupEdge(t, 2, sx[i2], sy[i2], sx[0], sy[0]);
+
+        const float dx1 = sx[i1] - sx[0], dy1 = sy[i1] - sy[0];
+        const float dx2 = sx[i2] - sx[0], dy2 = sy[i2] - sy[0];
+        const float dz1 = iw[i1] - iw[0], dz2 = iw[i2] - iw[0];
+        t.za = (dz1 * dy2 - dz2 * dy1) / area;
+        t.zb = (dz2 * dx1 - dz1 * dx2) / area;
+        t.zc = iw[0] - t.za * sx[0] - t.zb * sy[0];
+        t.zBias = 0.5f * (std::fabs(t.za) + std::fabs(t.zb));
+        t.zMin = std::min({iw[0], iw[1], iw[2]});
+
+#ifdef OXY_OCCLUSION_X86
+        if (m_useAVX2)
+            rasterizeAVX2(t, m_depth.data(), m_width);
+        else
+#endif
+            rasterizeScalar(t, m_depth.data(), m_width);
+
+        ++m_stats.occluderTriangles;
+        m_hizDirty = true;
+    }
+
+    void OcclusionCuller::updateHiZ()
+    {
+        for (int ty = 0; ty < m_tilesY; ++ty)
+        {
+            for (int tx = 0; tx < m_tilesX; ++tx)
+            {
+                float tileMin = m_depth[size_t(ty * TILE_SIZE) * m_width + tx * TILE_SIZE];
+                for (int y = 0; y < TILE_SIZE; ++y)
+                {
+                    const float *row = m_depth.data() + size_t(ty * TILE_SIZE + y) * m_width + tx * TILE_SIZE;
+                    for (int x = 0; x < TILE_SIZE; ++x)
+                        tileMin = std::min(tileMin, row[x]);
+                }
+                m_tileMin[size_t(ty) * m_tilesX + tx] = tileMin;
+            }
+        }
+        m_hizDirty = false;
+    }
+
+    bool OcclusionCuller::isAABBVisible(const glm::vec3 &center, const glm::vec3 &halfExtents)
+    {
+        ++m_stats.tested;
+        if (m_hizDirty)
+            updateHiZ();
+
+        float minX = 1e30f, minY = 1e30f, maxX = -1e30f, maxY = -1e30f;
+        float nearestInvW = 0.0f;
+        for (int i = 0; i < 8; ++i)
+        {
+            const glm::vec3 corner(center.x + ((i & 1) ? halfExtents.x : -halfExtents.x),
+                                   center.y + ((i & 2) ? halfExtents.y : -halfExtents.y),
+                                   center.z + ((i & 4) ? halfExtents.z : -halfExtents.z));
+            const glm::vec4 clip = m_viewProjection * glm::vec4(corner, 1.0f);
+            // 包围盒与近平面相交时无法可靠判断，视为可见
+            if (clip.w <= kNearW)
+                return true;
+
+            const float iw = 1.0f / clip.w;
+            const float sx = (clip.x * iw * 0.5f + 0.5f) * float(m_width);
+            const float sy = (clip.y * iw * 0.5f + 0.5f) * float(m_height);
+            minX = std::min(minX, sx);
+            maxX = std::max(maxX, sx);
+            minY = std::min(minY, sy);
+            maxY = std::max(maxY, sy);
+            nearestInvW = std::max(nearestInvW, iw);
+        }
+
+        const int x0 = std::max(0, int(std::floor(minX)));
+        const int x1 = std::min(m_width - 1, int(std::floor(maxX)));
+        const int y0 = std::max(0, int(std::floor(minY)));
+        const int y1 = std::min(m_height - 1, int(std::floor(maxY)));
+        if (x0 > x1 || y0 > y1)
+        {
+            // 完全在屏幕外，与遮挡无关，单独计数
+            ++m_stats.offscreen;
+            return false;
+        }
+
+        const float threshold = nearestInvW * kDepthSlack;
+        for (int ty = y0 / TILE_SIZE; ty <= y1 / TILE_SIZE; ++ty)
+        {
+            for (int tx = x0 / TILE_SIZE; tx <= x1 / TILE_SIZE; ++tx)
+            {
+                // 块内最远深度仍比包围盒最近点更近：整块遮挡
+                if (m_tileMin[size_t(ty) * m_tilesX + tx] > threshold)
+                    continue;
+
+                const int px0 = std::max(x0, tx * TILE_SIZE);
+                const int px1 = std::min(x1, tx * TILE_SIZE + TILE_SIZE - 1);
+                const int py0 = std::max(y0, ty * TILE_SIZE);
+                const int py1 = std::min(y1, ty * TILE_SIZE + TILE_SIZE - 1);
+                for (int y = py0; y <= py1; ++y)
+                {
+                    const float *row = m_depth.data() + size_t(y) * m_width;
+                    for (int x = px0; x <= px1; ++x)
+                    {
+                        if (row[x] <= threshold)
+                            return true;
+                    }
+                }
+            }
+        }
+
+        ++m_stats.culled;
+        return false;
+    }
+
+    bool OcclusionCuller::isSphereVisible(const glm::vec3 &center, float radius)
+    {
+        return isAABBVisible(center, glm::vec3(radius));
+    }
+}
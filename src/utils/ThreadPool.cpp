@@ -0,0 +1,279 @@
+#include "OxygenRender/ThreadPool.h"
+#include <algorithm>
+
+namespace OxyRender
+{
+    namespace
+    {
+        // 当前线程所属的线程池与队列下标，非工作线程为空
+        struct WorkerContext
+        {
+            const ThreadPool *pool = nullptr;
+            size_t index = 0;
+        };
+        thread_local WorkerContext t_worker;
+    }
+
+    void JobCounter::add()
+    {
+        m_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void JobCounter::fail(std::exception_ptr error)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_error)
+            m_error = error;
+    }
+
+    bool JobCounter::release()
+    {
+        std::vector<std::function<void()>> continuations;
+        {
+            // 持锁递减：等待方在 wait 返回前会取一次锁，保证这里之后不再访问计数器
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_count.fetch_sub(1, std::memory_order_seq_cst) != 1)
+                return false;
+            continuations.swap(m_continuations);
+        }
+        for (auto &continuation : continuations)
+            continuation();
+        return true;
+    }
+
+    void JobCounter::then(std::function<void()> continuation)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_count.load(std::memory_order_acquire) != 0)
+            {
+                m_continuations.push_back(std::move(continuation));
+                return;
+            }
+        }
+        continuation();
+    }
+
+    ThreadPool::ThreadPool(size_t threadCount)
+    {
+        for (size_t i = 0; i <= threadCount; ++i)
+            m_queues.push_back(std::make_unique<WorkQueue>());
+        m_workers.reserve(threadCount);
+        for (size_t i = 0; i < threadCount; ++i)
+            m_workers.emplace_back([this, i]()
+                                   { workerLoop(i); });
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+            m_stop = true;
+        }
+        m_condition.notify_all();
+        for (auto &worker : m_workers)
+            worker.join();
+    }
+
+    ThreadPool &ThreadPool::getInstance()
+    {
+        static ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+        return pool;
+    }
+
+    void ThreadPool::setMainThread(std::thread::id id) noexcept
+    {
+        m_mainThread.store(id, std::memory_order_release);
+    }
+
+    bool ThreadPool::isMainThread() const noexcept
+    {
+        const std::thread::id mainThread = m_mainThread.load(std::memory_order_acquire);
+        return mainThread != std::thread::id() && std::this_thread::get_id() == mainThread;
+    }
+
+    void ThreadPool::wakeWaiters()
+    {
+        // 与 wait 中先登记等待者、再检查条件的顺序配对，二者之间不会错过唤醒
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_waiters.load(std::memory_order_relaxed) == 0)
+            return;
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+        }
+        m_waitCondition.notify_all();
+    }
+
+    void ThreadPool::push(std::function<void()> task)
+    {
+        if (m_workers.empty())
+        {
+            task();
+            return;
+        }
+        WorkQueue &queue = t_worker.pool == this ? *m_queues[t_worker.index] : *m_queues.back();
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+        m_pending.fetch_add(1, std::memory_order_seq_cst);
+        // 空取一次锁，避免工作线程检查条件后、进入等待前错过通知
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+        }
+        m_condition.notify_one();
+        // 工作线程可能都在嵌套的 wait 中阻塞，它们也要能取到新任务
+        wakeWaiters();
+    }
+
+    bool ThreadPool::pop(std::function<void()> &task)
+    {
+        if (m_pending.load(std::memory_order_acquire) == 0)
+            return false;
+
+        const size_t workerCount = m_workers.size();
+        const bool isWorker = t_worker.pool == this;
+        const size_t self = isWorker ? t_worker.index : workerCount;
+
+        auto take = [&](WorkQueue &queue, bool back)
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty())
+                return false;
+            if (back)
+            {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            }
+            else
+            {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+            m_pending.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        };
+
+        if (isWorker && take(*m_queues[self], true))
+            return true;
+        if (take(*m_queues[workerCount], false))
+            return true;
+        for (size_t k = 1; k <= workerCount; ++k)
+        {
+            size_t victim = (self + k) % (workerCount + 1);
+            if (victim == workerCount || victim == self)
+                continue;
+            if (take(*m_queues[victim], false))
+            {
+                m_steals.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool ThreadPool::runOne()
+    {
+        std::function<void()> task;
+        if (!pop(task))
+            return false;
+        task();
+        return true;
+    }
+
+    void ThreadPool::workerLoop(size_t index)
+    {
+        t_worker.pool = this;
+        t_worker.index = index;
+        for (;;)
+        {
+            if (runOne())
+                continue;
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            m_condition.wait(lock, [this]()
+                             { return m_stop || m_pending.load(std::memory_order_acquire) > 0; });
+            if (m_stop && m_pending.load(std::memory_order_acquire) == 0)
+                return;
+        }
+    }
+
+    void ThreadPool::wait(JobCounter &counter)
+    {
+        const bool mainThread = isMainThread();
+        int idle = 0;
+        while (!counter.isDone())
+        {
+            if (runOne() || (mainThread && pumpMainThread() > 0))
+            {
+                idle = 0;
+                continue;
+            }
+            // 剩余任务正由其他线程执行：先短暂让出时间片，仍未完成再阻塞，避免长任务期间占满一个核心
+            if (++idle < 64)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            m_waiters.fetch_add(1, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            m_waitCondition.wait(lock, [&]()
+                                 { return counter.isDone() || m_pending.load(std::memory_order_seq_cst) > 0 ||
+                                          (mainThread && m_mainPending.load(std::memory_order_seq_cst) > 0); });
+            m_waiters.fetch_sub(1, std::memory_order_relaxed);
+            idle = 0;
+        }
+        std::exception_ptr error;
+        {
+            std::lock_guard<std::mutex> lock(counter.m_mutex);
+            error = counter.m_error;
+            counter.m_error = nullptr;
+        }
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    size_t ThreadPool::pumpMainThread()
+    {
+        if (!isMainThread())
+            return 0;
+        std::deque<std::function<void()>> tasks;
+        {
+            std::lock_guard<std::mutex> lock(m_mainMutex);
+            tasks.swap(m_mainTasks);
+            m_mainPending.fetch_sub(tasks.size(), std::memory_order_relaxed);
+        }
+        for (auto &task : tasks)
+            task();
+        return tasks.size();
+    }
+
+    void ThreadPool::parallelFor(size_t begin, size_t end, const std::function<void(size_t)> &func, size_t grain)
+    {
+        if (begin >= end)
+            return;
+
+        const size_t total = end - begin;
+        if (m_workers.empty() || total == 1)
+        {
+            for (size_t i = begin; i < end; ++i)
+                func(i);
+            return;
+        }
+
+        // 默认每个参与线程约 8 个任务，兼顾负载均衡与调度开销；元素少时逐个提交
+        if (grain == 0)
+            grain = std::max<size_t>(1, total / ((m_workers.size() + 1) * 8));
+
+        JobCounter counter;
+        for (size_t first = begin; first < end; first += grain)
+        {
+            const size_t last = std::min(end, first + grain);
+            run(counter, [&func, first, last]()
+                {
+                    for (size_t i = first; i < last; ++i)
+                        func(i); });
+        }
+        wait(counter);
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include "OxygenRender/OxygenRender.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <iostream>
+
+namespace OxyRender
+{
+    // 异步渐进式模型加载示例：窗口立即响应，网格按每帧预算逐步出现
+    class AsyncModelLoad
+    {
+    public:
+        static void execute()
+        {
+            Window window(800, 600, "OxygenRender - Async Model Load");
+            Renderer renderer(window);
+            Shader modelProgram = Model::CreateDefaultShader();
+            Camera camera(glm::vec3(0.0f, 0.0f, 3.0f));
+
+            auto &loader = AsyncModelLoader::getInstance();
+            loader.setUploadBudget(4 * 1024 * 1024, 2.0); // 每帧最多 4MB / 2ms
+
+            auto handle = loader.load(renderer, "../resources/objects/backpack/backpack.obj");
+            handle->setProgressCallback([](float progress)
+                                        { std::cout << "loading " << int(progress * 100.0f) << "%" << std::endl; });
+            handle->setCompleteCallback([](ModelLoadHandle &h)
+                                        {
+                                            if (!h.isReady())
+                                            {
+                                                std::cout << h.getPath() << " failed: " << h.getError() << std::endl;
+                                                return;
+                                            }
+                                            const ModelStats &stats = h.getModel().getStats();
+                                            std::cout << h.getPath() << " ready in " << stats.loadMs << " ms"
+                                                      << (stats.fromMeshCache ? " (from cache)" : "") << std::endl; });
+
+            EventSystem &eventSystem = EventSystem::getInstance();
+            auto &timer = Timer::getInstance();
+
+            while (!window.shouldClose())
+            {
+                timer.update(window);
+                eventSystem.handleEvent();
+                if (eventSystem.isKeyDown(KeyCode::Escape))
+                    window.shutdown();
+
+                loader.update();
+
+                glm::mat4 view = camera.getViewMatrix();
+                glm::mat4 projection = glm::perspective(glm::radians(camera.getZoom()), 800.0f / 600.0f, 0.1f, 100.0f);
+                glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -5.0f));
+                model = glm::rotate(model, float(timer.totalTime()) * 0.5f, glm::vec3(0.0f, 1.0f, 0.0f));
+
+                glm::vec3 lightPos = camera.getPosition();
+                glm::vec3 lightAmbient(0.1f, 0.1f, 0.1f);
+                glm::vec3 lightDiffuse(0.8f, 0.8f, 0.8f);
+                glm::vec3 lightSpecular(1.0f, 1.0f, 1.0f);
+
+                // 相机与光源每帧写入一次共享 uniform 块
+                FrameUniforms &frame = renderer.getFrameUniforms();
+                frame.setCamera(view, projection);
+                frame.setLight(0, lightPos, lightAmbient, lightDiffuse, lightSpecular);
+
+                renderer.clear();
+                modelProgram.use();
+                Model::setModelMatrix(modelProgram, model);
+
+                // 加载过程中也可以绘制，已上传的网格会逐步出现
+                handle->getModel().Draw(modelProgram);
+
+                window.swapBuffers();
+                window.pollEvents();
+            }
+        }
+    };
+}
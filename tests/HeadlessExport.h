@@ -0,0 +1,64 @@
+#pragma once
+#include "OxygenRender/OxygenRender.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <future>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace OxyRender
+{
+    // 无显示器批量导出：离屏渲染 Graphics3D 场景，每帧读回并保存为 PNG（编码在 ThreadPool 上），
+    // 输出每分钟导出的图像数。可在只有 Mesa llvmpipe 的服务器上运行。
+    class HeadlessExport
+    {
+    public:
+        static void execute(int imageCount = 600, const std::string &outputDir = "headless_out")
+        {
+            std::filesystem::create_directories(outputDir);
+
+            Window window(640, 480, "OxygenRender - Headless", WindowBackend::Headless);
+            Renderer renderer(window);
+            Graphics3D graphics3D(window, renderer);
+            graphics3D.setClearColor({1.0f, 1.0f, 1.0f, 1.0f});
+            graphics3D.getCamera().setPosition({0.0f, 2.0f, 8.0f});
+
+            std::vector<std::future<void>> pending;
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int i = 0; i < imageCount; ++i)
+            {
+                // 每帧场景不同：球体绕盒子运动
+                float angle = 6.2831853f * i / imageCount;
+                graphics3D.clear();
+                graphics3D.begin();
+                graphics3D.drawPlane({0.0f, -1.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {20.0f, 20.0f}, {0.8f, 0.8f, 0.8f, 1.0f});
+                graphics3D.drawBox({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}, {0.8f, 0.2f, 0.2f, 1.0f});
+                graphics3D.drawSphere({2.5f * std::cos(angle), 0.0f, 2.5f * std::sin(angle)}, 0.7f);
+                graphics3D.drawCylinder({-2.0f, 0.0f, 0.0f}, 0.5f, 1.5f, 24, {0.2f, 0.6f, 0.3f, 1.0f}, true);
+                graphics3D.flush();
+
+                char name[32];
+                std::snprintf(name, sizeof(name), "/frame_%05d.png", i);
+                pending.push_back(window.saveFrameAsync(outputDir + name));
+                window.swapBuffers();
+
+                // 限制在途的编码任务数，避免读回的帧堆积占用内存
+                if (pending.size() >= 32)
+                {
+                    pending.front().get();
+                    pending.erase(pending.begin());
+                }
+            }
+            for (auto &task : pending)
+                task.get();
+            auto end = std::chrono::high_resolution_clock::now();
+
+            double seconds = std::chrono::duration<double>(end - start).count();
+            std::cout << "HeadlessExport: " << imageCount << " images (640x480) in " << seconds << " s, "
+                      << imageCount / seconds * 60.0 << " images/min -> " << outputDir << std::endl;
+        }
+    };
+}
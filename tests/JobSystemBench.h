@@ -0,0 +1,93 @@
+#pragma once
+#include "OxygenRender/ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace OxyRender
+{
+    // 任务系统扩展性基准：1..N 个线程（含调用线程）分别运行
+    //   1. parallelFor 求值 2048x2048 高度场（与 Graphics3D::drawFunction 相同的负载形态）
+    //   2. 四级依赖图，每级 64 个任务，下一级在上一级全部完成后开始
+    // 输出耗时、相对单线程的加速比与窃取次数。不需要窗口。
+    class JobSystemBench
+    {
+    public:
+        static void execute()
+        {
+            const size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+            const size_t size = 2048;
+            const int repeats = 5;
+            std::vector<float> heights(size * size);
+
+            auto field = [&](ThreadPool &pool)
+            {
+                pool.parallelFor(0, size, [&](size_t i)
+                                 {
+                    float x = -15.0f + 30.0f * i / size;
+                    for (size_t j = 0; j < size; ++j)
+                    {
+                        float z = -15.0f + 30.0f * j / size;
+                        heights[i * size + j] = std::sin(std::sqrt(x * x + z * z)) + std::cos(x * 0.5f) * std::sin(z * 0.5f);
+                    } });
+            };
+
+            auto graph = [&](ThreadPool &pool)
+            {
+                const int stages = 4;
+                const int width = 64;
+                JobCounter counters[stages];
+                for (int s = 0; s < stages; ++s)
+                {
+                    for (int k = 0; k < width; ++k)
+                    {
+                        auto job = [&heights, s, k, size]()
+                        {
+                            // 每个任务处理高度场中的一段
+                            size_t rows = size / width;
+                            float acc = 0.0f;
+                            for (size_t i = k * rows; i < (k + 1) * rows; ++i)
+                                for (size_t j = 0; j < size; ++j)
+                                    acc += std::sqrt(std::abs(heights[i * size + j]) + float(s));
+                            heights[k * rows * size] += acc * 1e-9f;
+                        };
+                        if (s == 0)
+                            pool.run(counters[0], job);
+                        else
+                            pool.runAfter(counters[s - 1], counters[s], job);
+                    }
+                }
+                pool.wait(counters[stages - 1]);
+            };
+
+            auto measure = [&](ThreadPool &pool, auto &&workload)
+            {
+                workload(pool); // 预热
+                auto start = std::chrono::high_resolution_clock::now();
+                for (int r = 0; r < repeats; ++r)
+                    workload(pool);
+                auto end = std::chrono::high_resolution_clock::now();
+                return std::chrono::duration<double, std::milli>(end - start).count() / repeats;
+            };
+
+            std::cout << "JobSystemBench: 1.." << maxThreads << " threads" << std::endl;
+            double baseField = 0.0, baseGraph = 0.0;
+            for (size_t threads = 1; threads <= maxThreads; ++threads)
+            {
+                ThreadPool pool(threads - 1);
+                double fieldMs = measure(pool, field);
+                double graphMs = measure(pool, graph);
+                if (threads == 1)
+                {
+                    baseField = fieldMs;
+                    baseGraph = graphMs;
+                }
+                std::cout << "  " << threads << " threads: parallelFor " << fieldMs << " ms (x" << baseField / fieldMs
+                          << "), dependency graph " << graphMs << " ms (x" << baseGraph / graphMs
+                          << "), steals " << pool.getStealCount() << std::endl;
+            }
+        }
+    };
+}
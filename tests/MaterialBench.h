@@ -0,0 +1,131 @@
+#pragma once
+#include <glad/glad.h>
+#include "OxygenRender/OxygenRender.h"
+#include <glm/glm.hpp>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+namespace OxyRender
+{
+    // 每网格绘制开销基准：逐次拼接 uniform 名 + glGetUniformLocation（旧 Mesh::Draw）与预解析的 Material 对比
+    // 只统计 CPU 提交耗时，两条路径绘制相同的网格
+    class MaterialBench
+    {
+    public:
+        static void execute()
+        {
+            const int meshCount = 4096;
+            const int frames = 200;
+
+            Window window(800, 600, "OxygenRender - Material Bench");
+            Renderer renderer(window);
+            Shader shader = Model::CreateDefaultShader();
+
+            // 所有“网格”共用一个小三角形，开销集中在状态设置上
+            const float vertices[] = {-0.01f, -0.01f, 0.0f, 0.01f, -0.01f, 0.0f, 0.0f, 0.01f, 0.0f};
+            const unsigned int indices[] = {0, 1, 2};
+            Buffer vbo(BufferType::Vertex, BufferUsage::StaticDraw);
+            Buffer ebo(BufferType::Index, BufferUsage::StaticDraw);
+            vbo.setData(vertices, sizeof(vertices));
+            ebo.setData(indices, sizeof(indices));
+            VertexLayout layout;
+            layout.addAttribute("Position", 0, VertexAttribType::Float3);
+            VertexArray vao;
+            vao.bind();
+            vao.setVertexBuffer(vbo, layout);
+            vao.setIndexBuffer(ebo);
+            vao.unbind();
+
+            // 8 张小纹理轮流分配给漫反射/高光/法线槽位
+            std::vector<std::shared_ptr<Texture2D>> pool;
+            std::vector<unsigned char> pixels(16 * 16 * 4);
+            for (int i = 0; i < 8; ++i)
+            {
+                for (size_t p = 0; p < pixels.size(); ++p)
+                    pixels[p] = static_cast<unsigned char>(p * (i + 1));
+                ImageData image;
+                image.pixels = std::shared_ptr<unsigned char>(pixels.data(), [](unsigned char *) {});
+                image.width = 16;
+                image.height = 16;
+                image.channels = 4;
+                pool.push_back(std::make_shared<Texture2D>(image));
+            }
+
+            std::vector<std::vector<Texture>> meshTextures(meshCount);
+            std::vector<Material> materials;
+            materials.reserve(meshCount);
+            for (int i = 0; i < meshCount; ++i)
+            {
+                const char *types[] = {"texture_diffuse", "texture_specular", "texture_normal"};
+                for (int t = 0; t < 3; ++t)
+                    meshTextures[i].push_back(Texture{pool[(i + t) % pool.size()], types[t], ""});
+                materials.emplace_back(meshTextures[i]);
+            }
+
+            glm::mat4 identity(1.0f);
+            renderer.getFrameUniforms().setCamera(identity, identity);
+            renderer.getFrameUniforms().bind();
+            shader.use();
+            Model::setModelMatrix(shader, identity);
+
+            // 旧实现：每个纹理每次绘制都拼接名字、glGetUniformLocation 查询并无条件 glUniform1i。
+            // 直接调用 GL，不经过 Shader 的 uniform 表与值缓存，保持旧 Mesh::Draw 的开销
+            const GLuint program = shader.getID();
+            auto legacyBind = [&](const std::vector<Texture> &textures)
+            {
+                unsigned int diffuseNr = 1;
+                unsigned int specularNr = 1;
+                unsigned int normalNr = 1;
+                unsigned int heightNr = 1;
+                for (unsigned int i = 0; i < textures.size(); i++)
+                {
+                    std::string number;
+                    std::string name = textures[i].type;
+                    if (name == "texture_diffuse")
+                        number = std::to_string(diffuseNr++);
+                    else if (name == "texture_specular")
+                        number = std::to_string(specularNr++);
+                    else if (name == "texture_normal")
+                        number = std::to_string(normalNr++);
+                    else if (name == "texture_height")
+                        number = std::to_string(heightNr++);
+                    glUniform1i(glGetUniformLocation(program, (name + number).c_str()), static_cast<GLint>(i));
+                    if (textures[i].tex)
+                        textures[i].tex->bind(i);
+                }
+            };
+
+            auto run = [&](const char *name, const std::function<void(int)> &bind)
+            {
+                double submitMs = 0.0;
+                for (int frame = 0; frame < frames && !window.shouldClose(); ++frame)
+                {
+                    renderer.clear();
+                    shader.use();
+                    auto start = std::chrono::high_resolution_clock::now();
+                    for (int i = 0; i < meshCount; ++i)
+                    {
+                        bind(i);
+                        renderer.drawTriangles(vao, 3);
+                    }
+                    auto end = std::chrono::high_resolution_clock::now();
+                    submitMs += std::chrono::duration<double, std::milli>(end - start).count();
+                    window.swapBuffers();
+                    window.pollEvents();
+                }
+                double perMeshNs = submitMs * 1e6 / (double(frames) * meshCount);
+                std::cout << "  " << name << ": " << submitMs / frames << " ms/frame, " << perMeshNs << " ns/mesh" << std::endl;
+                return perMeshNs;
+            };
+
+            std::cout << "MaterialBench: " << meshCount << " meshes x 3 textures, " << frames << " frames" << std::endl;
+            double before = run("string uniforms", [&](int i)
+                                { legacyBind(meshTextures[i]); });
+            double after = run("material", [&](int i)
+                               { materials[i].bind(shader); });
+            std::cout << "  speedup: " << before / after << "x" << std::endl;
+        }
+    };
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include "OxygenRender/OxygenRender.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+namespace OxyRender
+{
+    // mip 级纹理流送示例：模型在远近之间往返，观察驻留显存随屏幕尺寸变化
+    class MipStreaming
+    {
+    public:
+        static void execute()
+        {
+            Window window(800, 600, "OxygenRender - Mip Streaming");
+            Renderer renderer(window);
+            Shader modelProgram = Model::CreateDefaultShader();
+            Camera camera(glm::vec3(0.0f, 0.0f, 3.0f));
+
+            auto &streamer = TextureStreamer::getInstance();
+            streamer.setMemoryBudget(32 * 1024 * 1024);
+            streamer.setUploadBudget(4 * 1024 * 1024);
+            streamer.setEvictionDelay(60);
+
+            Model::setMeshCacheEnabled(false);
+            Model::setTextureStreamingEnabled(true);
+            auto start = std::chrono::steady_clock::now();
+            Model backpack(renderer, "../resources/objects/backpack/backpack.obj");
+            auto loaded = std::chrono::steady_clock::now();
+            TextureStreamerStats initial = streamer.getStats();
+            std::cout << "MipStreaming: loaded in " << std::chrono::duration<double, std::milli>(loaded - start).count()
+                      << " ms, " << initial.textureCount << " textures, " << initial.residentBytes / 1024 << " KB resident" << std::endl;
+
+            EventSystem &eventSystem = EventSystem::getInstance();
+            auto &timer = Timer::getInstance();
+            double lastReport = 0.0;
+
+            while (!window.shouldClose())
+            {
+                timer.update(window);
+                eventSystem.handleEvent();
+                if (eventSystem.isKeyDown(KeyCode::Escape))
+                    window.shutdown();
+
+                // 距离在 3 到 60 之间往返
+                float t = float(timer.totalTime());
+                float distance = 3.0f + 57.0f * (0.5f - 0.5f * std::cos(t * 0.4f));
+                glm::mat4 view = camera.getViewMatrix();
+                glm::mat4 projection = glm::perspective(glm::radians(camera.getZoom()), 800.0f / 600.0f, 0.1f, 200.0f);
+                glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -distance));
+                model = glm::rotate(model, t * 0.5f, glm::vec3(0.0f, 1.0f, 0.0f));
+
+                glm::vec3 lightPos = camera.getPosition();
+                glm::vec3 lightAmbient(0.1f, 0.1f, 0.1f);
+                glm::vec3 lightDiffuse(0.8f, 0.8f, 0.8f);
+                glm::vec3 lightSpecular(1.0f, 1.0f, 1.0f);
+
+                FrameUniforms &frame = renderer.getFrameUniforms();
+                frame.setCamera(view, projection);
+                frame.setLight(0, lightPos, lightAmbient, lightDiffuse, lightSpecular);
+
+                renderer.clear();
+                modelProgram.use();
+
+                // 带相机的 Draw 设置模型矩阵并上报所需精度，update 按预算调入或释放
+                backpack.Draw(modelProgram, model, camera, 600);
+                streamer.update();
+
+                if (timer.totalTime() - lastReport >= 1.0)
+                {
+                    lastReport = timer.totalTime();
+                    TextureStreamerStats stats = streamer.getStats();
+                    std::cout << "distance " << int(distance) << ": resident " << stats.residentBytes / 1024 << " KB, required "
+                              << stats.requiredBytes / 1024 << " KB, pending " << stats.pendingLoads << ", uploaded "
+                              << stats.uploadedLevels << " levels, evicted " << stats.evictedLevels << " levels" << std::endl;
+                    streamer.resetStats();
+                }
+
+                window.swapBuffers();
+                window.pollEvents();
+            }
+            Model::setTextureStreamingEnabled(false);
+        }
+    };
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include "OxygenRender/OxygenRender.h"
+#include "OxygenRender/TextureCache.h"
+#include "OxygenRender/ThreadPool.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace OxyRender
+{
+    // 模型导入并行扩展性测试：分别用 1/2/4/8 个线程导入同一模型
+    // （不使用网格缓存与烘焙纹理，每次导入前清空纹理缓存，使每次都完整解码）
+    class ModelImportBench
+    {
+    public:
+        static void execute(const std::string &path = "../resources/objects/backpack/backpack.obj")
+        {
+            Window window(320, 240, "ModelImportBench");
+            Renderer renderer(window);
+
+            TextureCache &textureCache = TextureCache::getInstance();
+            bool cacheEnabled = Model::isMeshCacheEnabled();
+            bool bakedEnabled = textureCache.isBakedTexturesEnabled();
+            Model::setMeshCacheEnabled(false);
+            textureCache.setBakedTexturesEnabled(false);
+
+            std::cout << "ModelImportBench: " << path << ", hardware threads "
+                      << std::thread::hardware_concurrency() << std::endl;
+
+            double baseline = 0.0;
+            for (size_t threads : {1, 2, 4, 8})
+            {
+                Model::setImportThreadCount(threads);
+                textureCache.clear();
+                auto start = std::chrono::steady_clock::now();
+                ModelStats stats;
+                {
+                    Model model(renderer, path);
+                    stats = model.getStats();
+                }
+                double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                if (threads == 1)
+                    baseline = ms;
+                std::cout << "  " << threads << " threads: " << ms << " ms (parse " << stats.parseMs << " ms), speedup "
+                          << baseline / ms << "x, ACMR " << stats.acmrBefore() << " -> " << stats.acmrAfter() << std::endl;
+            }
+
+            Model::setImportThreadCount(0);
+            Model::setMeshCacheEnabled(cacheEnabled);
+            textureCache.setBakedTexturesEnabled(bakedEnabled);
+        }
+    };
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include "OxygenRender/OxygenRender.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <chrono>
+#include <iostream>
+#include <random>
+
+namespace OxyRender
+{
+    // 室内场景遮挡剔除基准（纯 CPU，无需窗口）
+    class OcclusionCullingBench
+    {
+    public:
+        static void execute()
+        {
+            const int rooms = 8;          // 8x8 个房间
+            const float roomSize = 10.0f; // 房间边长
+            const int objectsPerRoom = 24;
+            const int frames = 240;
+
+            struct Box
+            {
+                glm::vec3 center;
+                glm::vec3 half;
+            };
+
+            // 墙体（每面墙中间留一个门洞）
+            std::vector<Box> walls;
+            for (int i = 0; i <= rooms; ++i)
+            {
+                for (int j = 0; j < rooms; ++j)
+                {
+                    float fixed = i * roomSize;
+                    float start = j * roomSize;
+                    float segment = roomSize * 0.4f;
+                    // 沿 X 方向的墙
+                    walls.push_back({{start + segment * 0.5f, 1.5f, fixed}, {segment * 0.5f, 1.5f, 0.1f}});
+                    walls.push_back({{start + roomSize - segment * 0.5f, 1.5f, fixed}, {segment * 0.5f, 1.5f, 0.1f}});
+                    // 沿 Z 方向的墙
+                    walls.push_back({{fixed, 1.5f, start + segment * 0.5f}, {0.1f, 1.5f, segment * 0.5f}});
+                    walls.push_back({{fixed, 1.5f, start + roomSize - segment * 0.5f}, {0.1f, 1.5f, segment * 0.5f}});
+                }
+            }
+
+            // 房间内的物体
+            std::mt19937 rng(42);
+            std::uniform_real_distribution<float> offset(1.0f, roomSize - 1.0f);
+            std::uniform_real_distribution<float> extent(0.1f, 0.5f);
+            std::vector<Box> objects;
+            for (int i = 0; i < rooms; ++i)
+                for (int j = 0; j < rooms; ++j)
+                    for (int k = 0; k < objectsPerRoom; ++k)
+                    {
+                        float e = extent(rng);
+                        objects.push_back({{i * roomSize + offset(rng), e, j * roomSize + offset(rng)}, glm::vec3(e)});
+                    }
+
+            OcclusionCuller culler(256, 128);
+            std::cout << "OcclusionCullingBench: " << walls.size() << " occluders, "
+                      << objects.size() << " occludees, AVX2 " << (OcclusionCuller::hasAVX2() ? "on" : "off") << std::endl;
+
+            glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+            double totalMs = 0.0;
+            double totalFraction = 0.0;
+            size_t totalVisible = 0;
+
+            for (int f = 0; f < frames; ++f)
+            {
+                // 相机沿房间中心线行走并缓慢转向
+                float t = float(f) / float(frames);
+                glm::vec3 eye(roomSize * 0.5f + t * roomSize * (rooms - 1), 1.6f, roomSize * 0.5f);
+                float yaw = t * glm::two_pi<float>();
+                glm::vec3 target = eye + glm::vec3(std::cos(yaw), 0.0f, std::sin(yaw));
+                glm::mat4 view = glm::lookAt(eye, target, glm::vec3(0.0f, 1.0f, 0.0f));
+
+                auto start = std::chrono::high_resolution_clock::now();
+
+                culler.beginFrame(projection * view);
+                for (const auto &w : walls)
+                    culler.addOccluderBox(w.center, w.half);
+                size_t visible = 0;
+                for (const auto &o : objects)
+                    visible += culler.isAABBVisible(o.center, o.half) ? 1 : 0;
+
+                auto end = std::chrono::high_resolution_clock::now();
+                totalMs += std::chrono::duration<double, std::milli>(end - start).count();
+                totalFraction += culler.getStats().culledFraction();
+                totalVisible += visible;
+            }
+
+            std::cout << "  avg time per frame: " << totalMs / frames << " ms" << std::endl;
+            std::cout << "  avg culled fraction: " << totalFraction / frames * 100.0 << " %" << std::endl;
+            std::cout << "  avg visible occludees: " << double(totalVisible) / frames << std::endl;
+        }
+    };
+}
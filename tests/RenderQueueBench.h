@@ -0,0 +1,138 @@
+#pragma once
+#include "OxygenRender/OxygenRender.h"
+#include "OxygenRender/RenderQueue.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace OxyRender
+{
+    // 渲染队列基准：随机顺序提交的网格（4 种几何 x 16 种材质 x 不透明/半透明），
+    // 对比按提交顺序立即绘制与排序后执行的 CPU 提交耗时与状态切换次数
+    class RenderQueueBench
+    {
+    public:
+        static void execute()
+        {
+            const int objectCount = 8192;
+            const int frames = 200;
+
+            Window window(800, 600, "OxygenRender - Render Queue Bench");
+            Renderer renderer(window);
+            Shader shader = Model::CreateDefaultShader();
+
+            // 4 种几何：不同大小的三角形，各自一个 VAO
+            struct Geometry
+            {
+                Buffer vbo{BufferType::Vertex, BufferUsage::StaticDraw};
+                Buffer ebo{BufferType::Index, BufferUsage::StaticDraw};
+                VertexArray vao;
+            };
+            std::vector<std::unique_ptr<Geometry>> geometries;
+            for (int g = 0; g < 4; ++g)
+            {
+                const float s = 0.01f * (g + 1);
+                const float vertices[] = {-s, -s, 0.0f, s, -s, 0.0f, 0.0f, s, 0.0f};
+                const unsigned int indices[] = {0, 1, 2};
+                auto geometry = std::make_unique<Geometry>();
+                geometry->vbo.setData(vertices, sizeof(vertices));
+                geometry->ebo.setData(indices, sizeof(indices));
+                VertexLayout layout;
+                layout.addAttribute("Position", 0, VertexAttribType::Float3);
+                geometry->vao.bind();
+                geometry->vao.setVertexBuffer(geometry->vbo, layout);
+                geometry->vao.setIndexBuffer(geometry->ebo);
+                geometry->vao.unbind();
+                geometries.push_back(std::move(geometry));
+            }
+
+            std::vector<unsigned char> pixels(16 * 16 * 4, 255);
+            std::vector<Material> materials;
+            for (int m = 0; m < 16; ++m)
+            {
+                ImageData image;
+                image.pixels = std::shared_ptr<unsigned char>(pixels.data(), [](unsigned char *) {});
+                image.width = 16;
+                image.height = 16;
+                image.channels = 4;
+                materials.emplace_back(std::vector<Texture>{Texture{std::make_shared<Texture2D>(image), "texture_diffuse", ""}});
+            }
+
+            PipelineDesc opaqueDesc;
+            opaqueDesc.shader = &shader;
+            PipelineDesc translucentDesc = opaqueDesc;
+            translucentDesc.blend = true;
+            translucentDesc.depthWrite = false;
+            const PipelineState *opaque = renderer.createPipeline(opaqueDesc);
+            const PipelineState *translucent = renderer.createPipeline(translucentDesc);
+
+            std::mt19937 rng(7);
+            std::uniform_real_distribution<float> position(-1.0f, 1.0f);
+            std::vector<DrawPacket> packets(objectCount);
+            for (auto &packet : packets)
+            {
+                packet.translucent = rng() % 4 == 0;
+                packet.pipeline = packet.translucent ? translucent : opaque;
+                packet.material = &materials[rng() % materials.size()];
+                packet.vertexArray = &geometries[rng() % geometries.size()]->vao;
+                packet.indexCount = 3;
+                glm::vec3 p(position(rng), position(rng), position(rng));
+                packet.model = glm::translate(glm::mat4(1.0f), p);
+                packet.depth = 2.0f + p.z;
+            }
+
+            glm::mat4 identity(1.0f);
+            renderer.getFrameUniforms().setCamera(identity, identity);
+            RenderQueue queue(renderer);
+            queue.setDepthRange(0.0f, 4.0f);
+
+            std::cout << "RenderQueueBench: " << objectCount << " objects, " << frames << " frames" << std::endl;
+
+            // 按提交顺序立即绘制
+            double immediateMs = 0.0;
+            for (int frame = 0; frame < frames && !window.shouldClose(); ++frame)
+            {
+                renderer.clear();
+                auto start = std::chrono::high_resolution_clock::now();
+                renderer.getFrameUniforms().bind();
+                for (auto &packet : packets)
+                {
+                    renderer.bindPipeline(*packet.pipeline);
+                    packet.material->bind(shader);
+                    Model::setModelMatrix(shader, packet.model);
+                    renderer.drawTriangles(*packet.vertexArray, packet.indexCount);
+                }
+                auto end = std::chrono::high_resolution_clock::now();
+                immediateMs += std::chrono::duration<double, std::milli>(end - start).count();
+                window.swapBuffers();
+                window.pollEvents();
+            }
+            renderer.clear();
+            RenderStateStats immediateState = renderer.getStateStats();
+            std::cout << "  immediate: " << immediateMs / frames << " ms/frame, GL state calls "
+                      << immediateState.issued << " issued / " << immediateState.skipped << " skipped" << std::endl;
+
+            // 排序队列
+            double queuedMs = 0.0;
+            for (int frame = 0; frame < frames && !window.shouldClose(); ++frame)
+            {
+                renderer.clear();
+                auto start = std::chrono::high_resolution_clock::now();
+                for (const auto &packet : packets)
+                    queue.submit(packet);
+                queue.flush();
+                auto end = std::chrono::high_resolution_clock::now();
+                queuedMs += std::chrono::duration<double, std::milli>(end - start).count();
+                window.swapBuffers();
+                window.pollEvents();
+            }
+            const RenderQueueStats &stats = queue.getStats();
+            std::cout << "  queued:    " << queuedMs / frames << " ms/frame (sort " << stats.sortMs << " ms), GL state calls "
+                      << stats.glState.issued << " issued / " << stats.glState.skipped << " skipped" << std::endl;
+            std::cout << "    changes per frame: " << stats.pipelineChanges << " pipeline, " << stats.materialChanges << " material, "
+                      << stats.vertexArrayChanges << " vertex array, " << stats.matrixChanges << " matrix" << std::endl;
+        }
+    };
+}
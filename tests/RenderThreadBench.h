@@ -0,0 +1,74 @@
+#pragma once
+#include "OxygenRender/OxygenRender.h"
+#include "OxygenRender/RenderThread.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+namespace OxyRender
+{
+    // 渲染线程基准：CPU 密集的 Graphics3D 场景（大量球体 + 细分函数曲面，每帧重新生成几何），
+    // 先在单线程下运行，再启用渲染线程运行同样帧数，比较平均帧时间
+    class RenderThreadBench
+    {
+    public:
+        static void execute()
+        {
+            const int frames = 300;
+
+            Window window(1280, 720, "OxygenRender - Render Thread Bench");
+            Renderer renderer(window);
+            Graphics3D graphics3D(window, renderer);
+            graphics3D.setClearColor({0.9f, 0.9f, 0.9f, 1.0f});
+            graphics3D.setAutoLodEnabled(false);
+            graphics3D.getCamera().setPosition({0.0f, 8.0f, 30.0f});
+
+            RenderThread renderThread(window);
+            graphics3D.setRenderThread(&renderThread);
+
+            auto runFrames = [&](const char *label)
+            {
+                auto start = std::chrono::high_resolution_clock::now();
+                int frame = 0;
+                for (; frame < frames && !window.shouldClose(); ++frame)
+                {
+                    // 模拟：帧间变化的场景，几何在主线程生成
+                    float t = frame * 0.02f;
+                    graphics3D.clear();
+                    graphics3D.begin();
+                    for (int x = -10; x < 10; ++x)
+                    {
+                        for (int z = -10; z < 10; ++z)
+                        {
+                            float y = std::sin(t + x * 0.3f) * std::cos(t + z * 0.3f);
+                            graphics3D.drawSphere({x * 1.5f, y, z * 1.5f}, 0.5f, 16, 24, {0.2f, 0.6f, 0.9f, 1.0f});
+                        }
+                    }
+                    graphics3D.drawFunction({-15.0f, 15.0f}, {-15.0f, 15.0f}, [t](float x, float z)
+                                            { return std::sin(std::sqrt(x * x + z * z) - t) - 3.0f; }, {0.2f, 0.8f, 0.2f, 1.0f}, 0.1f, 0.1f, true);
+                    graphics3D.flush();
+
+                    renderThread.endFrame();
+                    window.pollEvents();
+                }
+                renderThread.finish();
+                auto end = std::chrono::high_resolution_clock::now();
+                double ms = std::chrono::duration<double, std::milli>(end - start).count();
+                std::cout << "  " << label << ": " << (frame ? ms / frame : 0.0) << " ms/frame" << std::endl;
+            };
+
+            std::cout << "RenderThreadBench: " << frames << " frames" << std::endl;
+            runFrames("single thread");
+
+            renderThread.start();
+            runFrames("render thread");
+            RenderThreadStats stats = renderThread.getStats();
+            renderThread.stop();
+            if (stats.frames > 0)
+            {
+                std::cout << "    render thread busy " << stats.executeMs / stats.frames << " ms/frame, main thread waited "
+                          << stats.recordWaitMs / stats.frames << " ms/frame" << std::endl;
+            }
+        }
+    };
+}
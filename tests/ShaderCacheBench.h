@@ -0,0 +1,54 @@
+#pragma once
+#include "OxygenRender/OxygenRender.h"
+#include "OxygenRender/Skybox.h"
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace OxyRender
+{
+    // 着色器启动耗时：多个 Graphics2D/Graphics3D 实例与内置着色器的创建时间。
+    // 第一次运行编译并写入 shader_cache，再次运行应全部命中磁盘二进制；同一进程内相同源码只链接一次。
+    // async 为 true 时只提交编译，创建耗时与等待链接完成的耗时分开统计
+    class ShaderCacheBench
+    {
+    public:
+        static void execute(bool async = true)
+        {
+            Window window(800, 600, "OxygenRender - Shader Cache Bench");
+            Renderer renderer(window);
+            ProgramCache &cache = ProgramCache::getInstance();
+            cache.setDirectory("shader_cache");
+            std::cout << "ShaderCacheBench: program binary "
+                      << (cache.isBinarySupported() ? "supported" : "not supported") << ", cache dir '" << cache.getDirectory() << "'" << std::endl;
+            cache.setAsyncCompilation(async);
+            if (async)
+                std::cout << "  async compilation, parallel compile "
+                          << (cache.isParallelCompileSupported() ? "supported" : "not supported") << std::endl;
+
+            auto start = std::chrono::high_resolution_clock::now();
+            std::vector<std::unique_ptr<Graphics2D>> graphics2D;
+            std::vector<std::unique_ptr<Graphics3D>> graphics3D;
+            for (int i = 0; i < 4; ++i)
+            {
+                graphics2D.push_back(std::make_unique<Graphics2D>(window, renderer));
+                graphics3D.push_back(std::make_unique<Graphics3D>(window, renderer));
+            }
+            Shader modelShader = Model::CreateDefaultShader();
+            Shader skyboxShader = Skybox::createDefaultShader();
+            auto end = std::chrono::high_resolution_clock::now();
+            size_t pending = cache.getPendingCount();
+            cache.finishPending();
+            auto linked = std::chrono::high_resolution_clock::now();
+
+            ProgramCacheStats stats = cache.getStats();
+            std::cout << "  created in " << std::chrono::duration<double, std::milli>(end - start).count() << " ms: "
+                      << stats.compiled << " compiled, " << stats.diskHits << " from disk, " << stats.diskRejected << " rejected, "
+                      << stats.shared << " shared, " << stats.stored << " stored" << std::endl;
+            std::cout << "  waited " << std::chrono::duration<double, std::milli>(linked - end).count() << " ms for "
+                      << pending << " pending programs" << std::endl;
+            cache.setAsyncCompilation(false);
+        }
+    };
+}
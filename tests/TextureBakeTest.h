@@ -0,0 +1,85 @@
+#pragma once
+#include "OxygenRender/OxygenRender.h"
+#include "OxygenRender/PngEncoder.h"
+#include "OxygenRender/TextureBake.h"
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+namespace OxyRender
+{
+    // 烘焙 1~4 通道的 PNG（默认选项与各 BC 格式），检查 .oxtex 能打开且格式、级别数与像素正确。
+    // 不需要窗口
+    class TextureBakeTest
+    {
+    public:
+        static void execute(const std::string &outputDir = "bake_test")
+        {
+            std::filesystem::create_directories(outputDir);
+            const uint32_t size = 16;
+            size_t failures = 0;
+
+            for (uint32_t channels = 1; channels <= 4; ++channels)
+            {
+                ImageData image;
+                image.width = image.height = size;
+                image.channels = channels;
+                image.pixels = std::shared_ptr<unsigned char>(new unsigned char[size * size * channels],
+                                                              std::default_delete<unsigned char[]>());
+                for (uint32_t i = 0; i < size * size * channels; ++i)
+                    image.pixels.get()[i] = static_cast<unsigned char>(i * 7 + channels);
+
+                const std::string source = outputDir + "/source_" + std::to_string(channels) + ".png";
+                PngEncoder::write(source, image);
+
+                for (TextureFormat format : {TextureFormat::RGBA8, TextureFormat::BC1, TextureFormat::BC4,
+                                             TextureFormat::BC5, TextureFormat::BC7})
+                {
+                    TextureBakeOptions options;
+                    options.format = format;
+                    const std::string baked = TextureBake::bakedPathFor(source);
+                    std::string error;
+                    if (!TextureBake::bake(source, baked, options))
+                        error = "bake failed";
+                    else if (!check(TextureBake::open(baked, source), image, format))
+                        error = "unexpected content";
+
+                    std::cout << "TextureBakeTest: " << channels << " channels -> format " << int(format) << ": "
+                              << (error.empty() ? "ok" : error) << std::endl;
+                    failures += error.empty() ? 0 : 1;
+                }
+            }
+            std::cout << "TextureBakeTest: " << (failures ? std::to_string(failures) + " failed" : "all passed") << std::endl;
+        }
+
+    private:
+        static bool check(const CompressedImageData &baked, const ImageData &source, TextureFormat format)
+        {
+            if (!baked.valid() || baked.width != source.width || baked.levels.size() != 5)
+                return false;
+            if (isCompressedFormat(format))
+                return baked.format == format;
+
+            // 未压缩：1/3/4 通道保持原样，灰度 + alpha 展开为 RGBA（与运行时加载一致）；默认选项上下翻转
+            const uint32_t expected = source.channels == 2 ? 4 : source.channels;
+            const uint32_t channels = static_cast<uint32_t>(CompressedImageData::blockBytes(baked.format));
+            if (channels != expected)
+                return false;
+            const auto &level = baked.levels[0];
+            const size_t pitch = level.size / level.height;
+            for (uint32_t y = 0; y < source.height; ++y)
+                for (uint32_t x = 0; x < source.width; ++x)
+                {
+                    const unsigned char *s = source.pixels.get() + (size_t(source.height - 1 - y) * source.width + x) * source.channels;
+                    const unsigned char *d = level.data + y * pitch + size_t(x) * channels;
+                    for (uint32_t c = 0; c < channels; ++c)
+                    {
+                        const unsigned char want = source.channels == 2 ? s[c == 3 ? 1 : 0] : s[c];
+                        if (d[c] != want)
+                            return false;
+                    }
+                }
+            return true;
+        }
+    };
+}
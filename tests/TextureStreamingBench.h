@@ -0,0 +1,114 @@
+#pragma once
+#include "OxygenRender/OxygenRender.h"
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+namespace OxyRender
+{
+    // 动态纹理上传吞吐基准：同步 glTexSubImage2D 与 PBO 环形缓冲对比
+    class TextureStreamingBench
+    {
+    public:
+        static void execute()
+        {
+            const uint32_t width = 1920, height = 1080;
+            const int frames = 300;
+
+            Window window(1280, 720, "OxygenRender - Texture Streaming Bench");
+            Renderer renderer(window);
+            Graphics2D graphics2D(window, renderer);
+
+            // 预先生成两帧内容交替上传，避免把生成耗时计入
+            std::vector<std::vector<unsigned char>> sources(2, std::vector<unsigned char>(size_t(width) * height * 4));
+            for (size_t f = 0; f < sources.size(); ++f)
+                for (uint32_t y = 0; y < height; ++y)
+                    for (uint32_t x = 0; x < width; ++x)
+                    {
+                        unsigned char *p = &sources[f][(size_t(y) * width + x) * 4];
+                        p[0] = static_cast<unsigned char>(x + f * 64);
+                        p[1] = static_cast<unsigned char>(y);
+                        p[2] = static_cast<unsigned char>((x ^ y) + f * 32);
+                        p[3] = 255;
+                    }
+
+            std::vector<unsigned char> initial(size_t(width) * height * 4, 0);
+            ImageData image;
+            image.pixels = std::shared_ptr<unsigned char>(initial.data(), [](unsigned char *) {});
+            image.width = width;
+            image.height = height;
+            image.channels = 4;
+
+            std::cout << "TextureStreamingBench: " << width << "x" << height << " RGBA8, " << frames << " frames" << std::endl;
+
+            // 执行 frames 帧：上传 + 绘制 + 交换，结束时 glFinish 保证传输完成
+            auto run = [&](const char *name, const Texture2D &texture, const std::function<void(int)> &update, size_t bytesPerFrame,
+                           const DynamicTexture2D *dynamic)
+            {
+                double uploadMs = 0.0;
+                auto start = std::chrono::high_resolution_clock::now();
+                for (int f = 0; f < frames && !window.shouldClose(); ++f)
+                {
+                    auto uploadStart = std::chrono::high_resolution_clock::now();
+                    update(f);
+                    uploadMs += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - uploadStart).count();
+
+                    graphics2D.clear();
+                    graphics2D.begin();
+                    graphics2D.drawRect(-640, -360, 1280, 720, texture, {1.0f, 1.0f, 1.0f, 1.0f});
+                    graphics2D.flush();
+                    window.swapBuffers();
+                    window.pollEvents();
+                }
+                glFinish();
+                double totalMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+                double megabytes = double(bytesPerFrame) * frames / (1024.0 * 1024.0);
+
+                std::cout << "  " << name << ": " << megabytes / (totalMs / 1000.0) << " MB/s, "
+                          << "CPU upload " << uploadMs / frames << " ms/frame, total " << totalMs / frames << " ms/frame";
+                if (dynamic)
+                    std::cout << ", stalls " << dynamic->getStats().stalls;
+                std::cout << std::endl;
+            };
+
+            const size_t fullBytes = size_t(width) * height * 4;
+            {
+                Texture2D texture(image, TextureFilter::Linear, TextureWrap::ClampToEdge);
+                run("sync glTexSubImage2D", texture, [&](int f)
+                    { texture.setData(sources[f % 2].data(), width, height); }, fullBytes, nullptr);
+            }
+
+            for (uint32_t buffers = 1; buffers <= 3; ++buffers)
+            {
+                DynamicTexture2D texture(width, height, TextureFormat::RGBA8, buffers);
+                std::string name = "PBO ring x" + std::to_string(buffers) + " (memcpy)";
+                run(name.c_str(), texture, [&](int f)
+                    { texture.setData(sources[f % 2].data(), width, height); }, fullBytes, &texture);
+            }
+
+            {
+                // 直接写入映射内存，省去一次拷贝
+                DynamicTexture2D texture(width, height, TextureFormat::RGBA8, 2);
+                run("PBO ring x2 (beginUpdate)", texture, [&](int f)
+                    {
+                        void *dst = texture.beginUpdate(0, 0, width, height);
+                        std::memcpy(dst, sources[f % 2].data(), fullBytes);
+                        texture.endUpdate(); }, fullBytes, &texture);
+            }
+
+            {
+                // 子矩形更新：每帧只刷新 1/4 区域（如热力图局部变化）
+                const uint32_t subWidth = width / 2, subHeight = height / 2;
+                std::vector<unsigned char> region(size_t(subWidth) * subHeight * 4);
+                DynamicTexture2D texture(width, height, TextureFormat::RGBA8, 2);
+                run("PBO ring x2 (quarter sub-rect)", texture, [&](int f)
+                    {
+                        uint32_t x = (f % 2) * subWidth, y = ((f / 2) % 2) * subHeight;
+                        std::memcpy(region.data(), sources[f % 2].data(), region.size());
+                        texture.setSubData(region.data(), x, y, subWidth, subHeight); }, region.size(), &texture);
+            }
+        }
+    };
+}
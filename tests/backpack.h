@@ -19,7 +19,8 @@ namespace OxyRender
 
             auto &res = ResourcesManager::getInstance();
 
-            Shader modelProgram = Model::CreateDefaultShader();
+            // 按网格实际拥有的贴图选择着色器变体
+            ShaderVariants modelShaders = Model::CreateDefaultShaderVariants();
 
             Camera camera(glm::vec3(0.0f, 0.0f, 3.0f));
 
@@ -106,29 +107,26 @@ namespace OxyRender
                 glm::mat4 view = camera.getViewMatrix();
                 glm::mat4 projection = glm::perspective(glm::radians(camera.getZoom()), 800.0f / 600.0f, 0.1f, 100.0f);
 
-                renderer.clear();
-                skybox.draw(skyboxShader, view, projection);
                 // 添加光照参数
                 glm::vec3 lightPos = camera.getPosition();
                 glm::vec3 lightAmbient(0.1f, 0.1f, 0.1f);
                 glm::vec3 lightDiffuse(0.8f, 0.8f, 0.8f);
                 glm::vec3 lightSpecular(1.0f, 1.0f, 1.0f);
 
-                modelProgram.use();
-                modelProgram.setUniformData("light.position", glm::value_ptr(lightPos), sizeof(lightPos));
-                modelProgram.setUniformData("light.ambient", glm::value_ptr(lightAmbient), sizeof(lightAmbient));
-                modelProgram.setUniformData("light.diffuse", glm::value_ptr(lightDiffuse), sizeof(lightDiffuse));
-                modelProgram.setUniformData("light.specular", glm::value_ptr(lightSpecular), sizeof(lightSpecular));
-                modelProgram.setUniformData("viewPos", glm::value_ptr(camera.getPosition()), sizeof(glm::vec3));
+                // 相机、光源与时间每帧写入一次，天空盒与模型共享
+                FrameUniforms &frame = renderer.getFrameUniforms();
+                frame.setCamera(view, projection);
+                frame.setLight(0, lightPos, lightAmbient, lightDiffuse, lightSpecular);
+                frame.setTime(float(timer.totalTime()), float(timer.deltaTime()));
+
+                renderer.clear();
+                skybox.draw(skyboxShader);
 
                 glm::mat4 model = glm::mat4(1.0f);
                 model = glm::translate(model, glm::vec3(0.0f, 0.0f, -5.0f));
                 model = glm::scale(model, glm::vec3(1.0f, 1.0f, 1.0f));
-                modelProgram.setUniformData("view", glm::value_ptr(view), sizeof(view));
-                modelProgram.setUniformData("projection", glm::value_ptr(projection), sizeof(projection));
-                modelProgram.setUniformData("model", glm::value_ptr(model), sizeof(model));
                 renderer.setPolygonMode(RenderPolygonMode::Fill, true);
-                backpackModel.Draw(modelProgram);
+                backpackModel.Draw(modelShaders, model);
 
                 window.swapBuffers();
                 window.pollEvents();
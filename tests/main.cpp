@@ -4,6 +4,18 @@
 #include "Texture2DTest.h"
 #include "simple2D.h"
 #include "CustomShader2d.h"
+#include "OcclusionCullingBench.h"
+#include "ModelImportBench.h"
+#include "AsyncModelLoad.h"
+#include "TextureStreamingBench.h"
+#include "MipStreaming.h"
+#include "MaterialBench.h"
+#include "ShaderCacheBench.h"
+#include "RenderQueueBench.h"
+#include "RenderThreadBench.h"
+#include "JobSystemBench.h"
+#include "HeadlessExport.h"
+#include "TextureBakeTest.h"
 
 using namespace OxyRender;
 
@@ -15,6 +27,18 @@ int main()
   // Texture2DTest::execute();
   // Simple2D::execute();
   // CustomShader2d::execute();
+  // OcclusionCullingBench::execute();
+  // ModelImportBench::execute();
+  // AsyncModelLoad::execute();
+  // TextureStreamingBench::execute();
+  // MipStreaming::execute();
+  // MaterialBench::execute();
+  // ShaderCacheBench::execute();
+  // RenderQueueBench::execute();
+  // RenderThreadBench::execute();
+  // JobSystemBench::execute();
+  // HeadlessExport::execute();
+  // TextureBakeTest::execute();
 
   return 0;
 }
\ No newline at end of file
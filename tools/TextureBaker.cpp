@@ -0,0 +1,139 @@
+// OxyTexBake：把图片资源烘焙为 .oxtex（与源文件同目录，<文件名>.oxtex），运行时由 TextureCache 自动使用
+// 用法：OxyTexBake [--format rgba8|bc1|bc3|bc4|bc5|bc7] [--no-mips] [--force] 文件或目录...
+// 目录会递归扫描 png/jpg/jpeg/tga/bmp/qoi；已是最新的文件默认跳过
+#include "OxygenRender/TextureBake.h"
+#include "OxygenRender/ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace OxyRender;
+
+namespace
+{
+    const std::map<std::string, TextureFormat> kFormats = {
+        {"rgba8", TextureFormat::RGBA8},
+        {"bc1", TextureFormat::BC1},
+        {"bc3", TextureFormat::BC3},
+        {"bc4", TextureFormat::BC4},
+        {"bc5", TextureFormat::BC5},
+        {"bc7", TextureFormat::BC7},
+    };
+
+    bool isImageFile(const std::filesystem::path &path)
+    {
+        std::string ext = path.extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c)
+                       { return static_cast<char>(std::tolower(c)); });
+        return ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".tga" || ext == ".bmp" || ext == ".qoi";
+    }
+
+    void printUsage()
+    {
+        std::cout << "Usage: OxyTexBake [--format rgba8|bc1|bc3|bc4|bc5|bc7] [--no-mips] [--force] path...\n";
+    }
+}
+
+int main(int argc, char **argv)
+{
+    namespace fs = std::filesystem;
+
+    TextureBakeOptions options;
+    bool force = false;
+    std::vector<std::string> sources;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--format" && i + 1 < argc)
+        {
+            auto it = kFormats.find(argv[++i]);
+            if (it == kFormats.end())
+            {
+                std::cerr << "Unknown format: " << argv[i] << std::endl;
+                return 1;
+            }
+            options.format = it->second;
+        }
+        else if (arg == "--no-mips")
+        {
+            options.generateMips = false;
+        }
+        else if (arg == "--force")
+        {
+            force = true;
+        }
+        else if (arg == "--help" || arg == "-h")
+        {
+            printUsage();
+            return 0;
+        }
+        else
+        {
+            std::error_code ec;
+            if (fs::is_directory(arg, ec))
+            {
+                for (const auto &entry : fs::recursive_directory_iterator(arg, ec))
+                    if (entry.is_regular_file() && isImageFile(entry.path()))
+                        sources.push_back(entry.path().string());
+            }
+            else
+            {
+                sources.push_back(arg);
+            }
+        }
+    }
+
+    if (sources.empty())
+    {
+        printUsage();
+        return 1;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<int> results(sources.size(), 0); // 0 跳过，1 成功，-1 失败
+    std::atomic<uint64_t> bakedBytes{0};
+
+    // 按文件并行；BC 压缩内部也会并行，线程池支持嵌套
+    ThreadPool::getInstance().parallelFor(0, sources.size(), [&](size_t i)
+                                          {
+        const std::string baked = TextureBake::bakedPathFor(sources[i]);
+        if (!force && TextureBake::isUpToDate(baked, sources[i]))
+            return;
+        if (!TextureBake::bake(sources[i], baked, options))
+        {
+            results[i] = -1;
+            return;
+        }
+        results[i] = 1;
+        std::error_code ec;
+        bakedBytes += fs::file_size(baked, ec); });
+
+    size_t baked = 0, skipped = 0, failed = 0;
+    for (size_t i = 0; i < sources.size(); ++i)
+    {
+        if (results[i] == 1)
+        {
+            ++baked;
+            std::cout << "baked   " << sources[i] << std::endl;
+        }
+        else if (results[i] == 0)
+        {
+            ++skipped;
+        }
+        else
+        {
+            ++failed;
+        }
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << baked << " baked (" << bakedBytes / (1024 * 1024) << " MB), " << skipped << " up to date, "
+              << failed << " failed in " << std::chrono::duration<double>(end - start).count() << " s" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,165 @@
+// OxyTexConv：把 PNG/JPG 等图片离线压缩为 BC 格式的 KTX2 / DDS 文件，或无损转为 QOI
+// 用法：OxyTexConv [--format bc1|bc3|bc4|bc5|bc7] [--container ktx2|dds|qoi] [--no-mips] [--output-dir 目录] 输入...
+// 未指定格式时按通道数选择：1 通道 BC4，2 通道 BC5，3 通道 BC1，4 通道 BC7
+#include "OxygenRender/ImageDecoder.h"
+#include "OxygenRender/Texture.h"
+#include "OxygenRender/TextureCompression.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace OxyRender;
+
+namespace
+{
+    const std::map<std::string, TextureFormat> kFormats = {
+        {"bc1", TextureFormat::BC1},
+        {"bc3", TextureFormat::BC3},
+        {"bc4", TextureFormat::BC4},
+        {"bc5", TextureFormat::BC5},
+        {"bc7", TextureFormat::BC7},
+    };
+
+    const char *formatName(TextureFormat format)
+    {
+        for (const auto &item : kFormats)
+            if (item.second == format)
+                return item.first.c_str();
+        return "?";
+    }
+
+    TextureFormat defaultFormat(uint32_t channels)
+    {
+        switch (channels)
+        {
+        case 1:
+            return TextureFormat::BC4;
+        case 2:
+            return TextureFormat::BC5;
+        case 3:
+            return TextureFormat::BC1;
+        default:
+            return TextureFormat::BC7;
+        }
+    }
+
+    void printUsage()
+    {
+        std::cout << "Usage: OxyTexConv [--format bc1|bc3|bc4|bc5|bc7] [--container ktx2|dds|qoi] [--no-mips]\n"
+                  << "                  [--output-dir dir] input...\n";
+    }
+}
+
+int main(int argc, char **argv)
+{
+    namespace fs = std::filesystem;
+
+    bool hasFormat = false;
+    TextureFormat format = TextureFormat::BC7;
+    std::string container = "ktx2";
+    bool mips = true;
+    std::string outputDir;
+    std::vector<std::string> inputs;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--format" && i + 1 < argc)
+        {
+            auto it = kFormats.find(argv[++i]);
+            if (it == kFormats.end())
+            {
+                std::cerr << "Unknown format: " << argv[i] << std::endl;
+                return 1;
+            }
+            format = it->second;
+            hasFormat = true;
+        }
+        else if (arg == "--container" && i + 1 < argc)
+        {
+            container = argv[++i];
+            if (container != "ktx2" && container != "dds" && container != "qoi")
+            {
+                std::cerr << "Unknown container: " << container << std::endl;
+                return 1;
+            }
+        }
+        else if (arg == "--no-mips")
+        {
+            mips = false;
+        }
+        else if (arg == "--output-dir" && i + 1 < argc)
+        {
+            outputDir = argv[++i];
+        }
+        else if (arg == "--help" || arg == "-h")
+        {
+            printUsage();
+            return 0;
+        }
+        else
+        {
+            inputs.push_back(arg);
+        }
+    }
+
+    if (inputs.empty())
+    {
+        printUsage();
+        return 1;
+    }
+
+    int failures = 0;
+    for (const auto &input : inputs)
+    {
+        fs::path output = fs::path(input).replace_extension("." + container);
+        if (!outputDir.empty())
+            output = fs::path(outputDir) / output.filename();
+
+        try
+        {
+            auto start = std::chrono::high_resolution_clock::now();
+
+            if (container == "qoi")
+            {
+                // QOI 按标准自上而下存储，加载时再统一翻转
+                std::vector<unsigned char> encoded = QoiDecoder::encode(ImageData::load(input, false));
+                std::ofstream file(output, std::ios::binary | std::ios::trunc);
+                if (!file.write(reinterpret_cast<const char *>(encoded.data()), std::streamsize(encoded.size())))
+                    throw std::runtime_error("Failed to write " + output.string());
+                auto end = std::chrono::high_resolution_clock::now();
+                std::cout << input << " -> " << output.string() << " (qoi, " << encoded.size() / 1024 << " KB, "
+                          << std::chrono::duration<double, std::milli>(end - start).count() << " ms)" << std::endl;
+                continue;
+            }
+
+            // 与运行时一致地翻转 Y 轴，压缩结果可直接上传；保留原通道数以便按通道选择格式
+            ImageData image = ImageData::load(input, true, false);
+            TextureFormat target = hasFormat ? format : defaultFormat(image.channels);
+            CompressedImageData compressed = TextureCompression::compress(image, target, mips);
+
+            bool written = container == "dds" ? TextureCompression::writeDDS(output.string(), compressed)
+                                              : TextureCompression::writeKTX2(output.string(), compressed);
+            if (!written)
+                throw std::runtime_error("Failed to write " + output.string());
+
+            auto end = std::chrono::high_resolution_clock::now();
+            size_t sourceBytes = size_t(image.width) * image.height * 4 * 4 / 3;
+            std::cout << input << " -> " << output.string() << " (" << formatName(target) << ", "
+                      << image.width << "x" << image.height << ", " << compressed.levels.size() << " levels, "
+                      << compressed.totalBytes() / 1024 << " KB, "
+                      << double(sourceBytes) / double(compressed.totalBytes()) << "x smaller than RGBA8, "
+                      << std::chrono::duration<double, std::milli>(end - start).count() << " ms)" << std::endl;
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << input << ": " << e.what() << std::endl;
+            ++failures;
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}